@@ -126,6 +126,20 @@ struct zerobit_counter<Integer, 8> {
 };
 #endif
 
+/// Number of bits set in a word. It maps to a single instruction when the target supports it (e.g. POPCNT)
+inline size_t popcount(uint64_t value)
+{
+#ifdef __GNUC__
+  return __builtin_popcountll(value);
+#else
+  size_t c = 0;
+  for (; value > 0; c++) {
+    value &= value - 1;
+  }
+  return c;
+#endif
+}
+
 } // namespace detail
 
 /// uses lsb as zero position
@@ -218,14 +232,17 @@ public:
   bounded_bitset<N, reversed>& fill(size_t startpos, size_t endpos, bool value = true)
   {
     assert_range_bounds_(startpos, endpos);
-    // NOTE: can be optimized
-    if (value) {
-      for (size_t i = startpos; i < endpos; ++i) {
-        set_(i);
-      }
-    } else {
-      for (size_t i = startpos; i < endpos; ++i) {
-        reset_(i);
+    if (startpos == endpos) {
+      return *this;
+    }
+    size_t bitstart, bitend;
+    get_bitrange_(startpos, endpos, bitstart, bitend);
+    for (size_t i = bitstart / bits_per_word; i <= (bitend - 1) / bits_per_word; ++i) {
+      word_t mask = range_mask_(i, bitstart, bitend);
+      if (value) {
+        buffer[i] |= mask;
+      } else {
+        buffer[i] &= ~mask;
       }
     }
     return *this;
@@ -273,9 +290,28 @@ public:
   {
     assert_within_bounds_(start, false);
     assert_within_bounds_(stop, false);
-    // NOTE: can be optimized
-    for (size_t i = start; i < stop; ++i) {
-      if (test_(i)) {
+    if (start >= stop) {
+      return false;
+    }
+    size_t bitstart, bitend;
+    get_bitrange_(start, stop, bitstart, bitend);
+    for (size_t i = bitstart / bits_per_word; i <= (bitend - 1) / bits_per_word; ++i) {
+      if ((buffer[i] & range_mask_(i, bitstart, bitend)) != static_cast<word_t>(0)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Checks whether any bit is set in both bitsets, without computing their intersection
+  bool intersects(const bounded_bitset<N, reversed>& other) const
+  {
+    srsran_assert(other.size() == size(),
+                  "ERROR: intersects called for bitsets of different sizes (%zd!=%zd)",
+                  size(),
+                  other.size());
+    for (size_t i = 0; i < nof_words_(); ++i) {
+      if ((buffer[i] & other.buffer[i]) != static_cast<word_t>(0)) {
         return true;
       }
     }
@@ -288,13 +324,23 @@ public:
   {
     size_t result = 0;
     for (size_t i = 0; i < nof_words_(); i++) {
-      //      result += __builtin_popcountl(buffer[i]);
-      // Note: use an "int" for count triggers popcount optimization if SSE instructions are enabled.
-      int c = 0;
-      for (word_t w = buffer[i]; w > 0; c++) {
-        w &= w - 1;
-      }
-      result += c;
+      result += detail::popcount(buffer[i]);
+    }
+    return result;
+  }
+
+  /// Number of bits set within the range [startpos, endpos)
+  size_t count(size_t startpos, size_t endpos) const
+  {
+    assert_range_bounds_(startpos, endpos);
+    if (startpos == endpos) {
+      return 0;
+    }
+    size_t bitstart, bitend;
+    get_bitrange_(startpos, endpos, bitstart, bitend);
+    size_t result = 0;
+    for (size_t i = bitstart / bits_per_word; i <= (bitend - 1) / bits_per_word; ++i) {
+      result += detail::popcount(buffer[i] & range_mask_(i, bitstart, bitend));
     }
     return result;
   }
@@ -412,6 +458,26 @@ private:
 
   size_t get_bitidx_(size_t bitpos) const noexcept { return reversed ? size() - 1 - bitpos : bitpos; }
 
+  /// Converts the range of positions [startpos, endpos) into the range of bit indexes [bitstart, bitend)
+  void get_bitrange_(size_t startpos, size_t endpos, size_t& bitstart, size_t& bitend) const noexcept
+  {
+    bitstart = reversed ? size() - endpos : startpos;
+    bitend   = reversed ? size() - startpos : endpos;
+  }
+
+  /// Mask with the bits of the word "word_idx" that fall within the range of bit indexes [bitstart, bitend)
+  static word_t range_mask_(size_t word_idx, size_t bitstart, size_t bitend) noexcept
+  {
+    word_t mask = ~static_cast<word_t>(0);
+    if (word_idx == bitstart / bits_per_word) {
+      mask &= mask_lsb_zeros<word_t>(bitstart % bits_per_word);
+    }
+    if (word_idx == (bitend - 1) / bits_per_word) {
+      mask &= mask_lsb_ones<word_t>((bitend - 1) % bits_per_word + 1);
+    }
+    return mask;
+  }
+
   bool test_(size_t bitpos) const noexcept
   {
     bitpos = get_bitidx_(bitpos);
@@ -0,0 +1,45 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_CACHE_LINE_H
+#define SRSRAN_CACHE_LINE_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace srsran {
+
+namespace detail {
+
+/// Size of a CPU cache line, used to avoid false sharing between data accessed by different threads
+const static size_t cache_line_size = 64;
+
+/// Atomic index padded to occupy a full cache line
+struct padded_atomic_index {
+  std::atomic<size_t> value{0};
+  char                padding[cache_line_size - sizeof(std::atomic<size_t>)];
+};
+
+} // namespace detail
+
+} // namespace srsran
+
+#endif // SRSRAN_CACHE_LINE_H
@@ -0,0 +1,175 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_MPSC_QUEUE_H
+#define SRSRAN_MPSC_QUEUE_H
+
+#include "srsran/adt/detail/cache_line.h"
+#include "srsran/adt/detail/type_storage.h"
+#include "srsran/support/srsran_assert.h"
+#include <atomic>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Bounded lock-free multi-producer/single-consumer queue with the following features:
+ * - any number of threads may call the producer methods (try_push) concurrently. The consumer methods (try_pop,
+ *   clear) must be called from a single thread at a time, or be externally serialized.
+ * - no allocations while pushing/popping new elements. The buffer is allocated at construction or in set_size()
+ * - each slot carries a sequence number that tells producers whether the slot is free and the consumer whether the
+ *   slot has been written. Producers only contend on the CAS of the enqueue index.
+ * - if a producer is preempted between claiming and publishing a slot, the consumer sees the queue as empty from that
+ *   slot onwards until the element is published, so FIFO order across producers is preserved.
+ * @tparam T type of the objects stored in the queue
+ */
+template <typename T>
+class dyn_mpsc_queue
+{
+  struct slot_t {
+    std::atomic<size_t>     seq{0};
+    detail::type_storage<T> data;
+  };
+
+public:
+  explicit dyn_mpsc_queue(size_t capacity = 0) : buffer(capacity) { reset_slots(); }
+  dyn_mpsc_queue(const dyn_mpsc_queue&) = delete;
+  dyn_mpsc_queue(dyn_mpsc_queue&&)      = delete;
+  dyn_mpsc_queue& operator=(const dyn_mpsc_queue&) = delete;
+  dyn_mpsc_queue& operator=(dyn_mpsc_queue&&) = delete;
+  ~dyn_mpsc_queue() { clear(); }
+
+  /// Producer: pushes new element. Returns false and leaves "t" untouched, if the queue is full
+  bool try_push(T&& t)
+  {
+    size_t  pos  = enqueue_idx.value.load(std::memory_order_relaxed);
+    slot_t* slot = nullptr;
+    while (true) {
+      if (buffer.empty()) {
+        return false;
+      }
+      slot        = &buffer[pos % buffer.size()];
+      size_t seq  = slot->seq.load(std::memory_order_acquire);
+      auto   diff = static_cast<std::ptrdiff_t>(seq - pos);
+      if (diff == 0) {
+        // Slot is free. Claim it, unless another producer got there first
+        if (enqueue_idx.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // The consumer has not released the slot yet
+        return false;
+      } else {
+        pos = enqueue_idx.value.load(std::memory_order_relaxed);
+      }
+    }
+    slot->data.emplace(std::move(t));
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+  bool try_push(const T& t)
+  {
+    T copy(t);
+    return try_push(std::move(copy));
+  }
+
+  /// Consumer: pops the oldest published element. Returns false if the queue is empty
+  bool try_pop(T& t)
+  {
+    if (buffer.empty()) {
+      return false;
+    }
+    size_t  pos  = dequeue_idx.value.load(std::memory_order_relaxed);
+    slot_t& slot = buffer[pos % buffer.size()];
+    if (slot.seq.load(std::memory_order_acquire) != pos + 1) {
+      return false;
+    }
+    t = std::move(slot.data.get());
+    slot.data.destroy();
+    slot.seq.store(pos + buffer.size(), std::memory_order_release);
+    dequeue_idx.value.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer: pops all the elements of the queue, calling func for each of them from the oldest to the newest.
+  /// Returns the number of elements popped
+  template <typename F>
+  size_t consume_all(const F& func)
+  {
+    size_t count = 0;
+    T      t;
+    while (try_pop(t)) {
+      func(t);
+      ++count;
+    }
+    return count;
+  }
+
+  /// Consumer: pops all the elements of the queue
+  void clear()
+  {
+    T t;
+    while (try_pop(t)) {
+    }
+  }
+
+  /// Resizes the queue. Must not be called concurrently with any other method
+  void set_size(size_t capacity)
+  {
+    srsran_assert(empty(), "The queue must be empty before being resized");
+    std::vector<slot_t>(capacity).swap(buffer);
+    reset_slots();
+  }
+
+  /// Returns the number of elements in the queue, including the ones being pushed. The value may be outdated if called
+  /// concurrently with push/pop
+  size_t size() const
+  {
+    size_t r = dequeue_idx.value.load(std::memory_order_acquire);
+    size_t w = enqueue_idx.value.load(std::memory_order_acquire);
+    return w >= r ? w - r : 0;
+  }
+  bool   empty() const { return size() == 0; }
+  bool   full() const { return size() >= buffer.size(); }
+  size_t capacity() const { return buffer.size(); }
+
+private:
+  void reset_slots()
+  {
+    for (size_t i = 0; i < buffer.size(); ++i) {
+      buffer[i].seq.store(i, std::memory_order_relaxed);
+    }
+    enqueue_idx.value.store(0, std::memory_order_relaxed);
+    dequeue_idx.value.store(0, std::memory_order_relaxed);
+  }
+
+  std::vector<slot_t> buffer;
+
+  // Shared by the producers
+  detail::padded_atomic_index enqueue_idx;
+
+  // Consumer state
+  detail::padded_atomic_index dequeue_idx;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_MPSC_QUEUE_H
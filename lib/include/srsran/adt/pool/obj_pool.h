@@ -25,6 +25,7 @@
 #include "batch_mem_pool.h"
 #include "memblock_cache.h"
 #include "pool_interface.h"
+#include <condition_variable>
 
 namespace srsran {
 
@@ -94,11 +95,8 @@ public:
   void allocate_batch()
   {
     uint8_t* batch_payload = static_cast<uint8_t*>(allocated.allocate_block());
-    for (size_t i = 0; i < objs_per_batch; ++i) {
-      void* cache_node = batch_payload + (i * cache.memblock_size);
-      cache.push(cache_node);
-      init_oper(cache.top());
-    }
+    init_batch_(batch_payload);
+    push_batch_(batch_payload);
   }
 
   size_t cache_size() const { return cache.size(); }
@@ -106,6 +104,20 @@ public:
 private:
   friend class background_obj_pool<T>;
 
+  /// Constructs the objects of a batch, without touching the pool state
+  void init_batch_(uint8_t* batch_payload)
+  {
+    for (size_t i = 0; i < objs_per_batch; ++i) {
+      init_oper(batch_payload + (i * cache.memblock_size) + cache.header_size);
+    }
+  }
+  void push_batch_(uint8_t* batch_payload)
+  {
+    for (size_t i = 0; i < objs_per_batch; ++i) {
+      cache.push(batch_payload + (i * cache.memblock_size));
+    }
+  }
+
   T* do_allocate()
   {
     if (cache.empty()) {
@@ -135,6 +147,8 @@ private:
 /**
  * Thread-safe object pool specialized in allocating batches of objects in a preemptive way in a background thread
  * to minimize latency.
+ * Optionally, the recycling of released objects (e.g. resetting large buffers) is also deferred to a background thread,
+ * so that releasing an object becomes as cheap as allocating one.
  * Note: The dispatched allocation jobs may outlive the pool. To handle this, the pool state is passed to jobs via a
  *       shared ptr.
  */
@@ -147,19 +161,30 @@ public:
 
   explicit background_obj_pool(size_t          nof_objs_per_batch,
                                size_t          thres_,
-                               int             init_size     = -1,
-                               init_mem_oper_t init_oper_    = detail::inplace_default_ctor_operator<T>{},
-                               recycle_oper_t  recycle_oper_ = detail::noop_operator{}) :
+                               int             init_size              = -1,
+                               init_mem_oper_t init_oper_             = detail::inplace_default_ctor_operator<T>{},
+                               recycle_oper_t  recycle_oper_          = detail::noop_operator{},
+                               bool            recycle_in_background_ = false) :
     thres(thres_),
+    recycle_in_background(recycle_in_background_),
     state(std::make_shared<detached_pool_state>(this)),
-    grow_pool(nof_objs_per_batch, init_size, std::move(init_oper_), std::move(recycle_oper_))
+    grow_pool(nof_objs_per_batch, init_size, std::move(init_oper_), std::move(recycle_oper_)),
+    dirty(sizeof(T), alignof(T))
   {
     srsran_assert(thres_ > 1, "The provided threshold=%zd is not valid", thres_);
   }
   ~background_obj_pool()
   {
-    std::lock_guard<std::mutex> lock(state->mutex);
+    std::unique_lock<std::mutex> lock(state->mutex);
     state->pool = nullptr;
+    // Wait for the background jobs that are constructing or recycling objects outside the lock
+    while (state->nof_unlocked_jobs > 0) {
+      state->cvar.wait(lock);
+    }
+    // Objects still pending recycling are destroyed as they are
+    while (not dirty.empty()) {
+      grow_pool.cache.steal_top(dirty);
+    }
     grow_pool.clear();
   }
 
@@ -171,13 +196,26 @@ public:
     });
   }
 
-  size_t cache_size() const { return grow_pool.cache_size(); }
+  /// Number of objects ready to be allocated. It does not include released objects still pending recycling
+  size_t cache_size() const
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return grow_pool.cache_size();
+  }
 
 private:
   T* do_allocate()
   {
     std::lock_guard<std::mutex> lock(state->mutex);
-    T*                          obj = grow_pool.do_allocate();
+    T*                          obj = nullptr;
+    if (grow_pool.cache.empty() and not dirty.empty()) {
+      // Recycling an object is cheaper than constructing a new batch
+      obj = static_cast<T*>(dirty.top());
+      dirty.pop();
+      grow_pool.recycle_oper(*obj);
+    } else {
+      obj = grow_pool.do_allocate();
+    }
     if (grow_pool.cache_size() < thres) {
       allocate_batch_in_background_();
     }
@@ -186,7 +224,40 @@ private:
   void do_deallocate(T* ptr)
   {
     std::lock_guard<std::mutex> lock(state->mutex);
-    return grow_pool.do_deallocate(ptr);
+    if (not recycle_in_background) {
+      grow_pool.do_deallocate(ptr);
+      return;
+    }
+    dirty.push(dirty.get_node_header(static_cast<void*>(ptr)));
+    recycle_in_background_();
+  }
+
+  void recycle_in_background_()
+  {
+    if (state->recycle_dispatched) {
+      // the ongoing job will also recycle this object
+      return;
+    }
+    state->recycle_dispatched                       = true;
+    std::shared_ptr<detached_pool_state> state_sptr = state;
+    get_background_workers().push_task([state_sptr]() {
+      std::unique_lock<std::mutex> lock(state_sptr->mutex);
+      while (state_sptr->pool != nullptr and not state_sptr->pool->dirty.empty()) {
+        auto* pool = state_sptr->pool;
+        T*    obj  = static_cast<T*>(pool->dirty.top());
+        pool->dirty.pop();
+
+        // The object is recycled without holding the lock, so that allocations are not blocked meanwhile
+        state_sptr->nof_unlocked_jobs++;
+        lock.unlock();
+        pool->grow_pool.recycle_oper(*obj);
+        lock.lock();
+        pool->grow_pool.cache.push(pool->grow_pool.cache.get_node_header(static_cast<void*>(obj)));
+        state_sptr->nof_unlocked_jobs--;
+        state_sptr->cvar.notify_all();
+      }
+      state_sptr->recycle_dispatched = false;
+    });
   }
 
   void allocate_batch_in_background_()
@@ -198,29 +269,43 @@ private:
     state->dispatched                               = true;
     std::shared_ptr<detached_pool_state> state_sptr = state;
     get_background_workers().push_task([state_sptr]() {
-      std::lock_guard<std::mutex> lock(state_sptr->mutex);
+      std::unique_lock<std::mutex> lock(state_sptr->mutex);
       if (state_sptr->pool != nullptr) {
         auto* pool = state_sptr->pool;
         do {
-          pool->grow_pool.allocate_batch();
-        } while (pool->grow_pool.cache_size() < pool->thres);
+          // The objects are constructed without holding the lock, so that allocations are not blocked meanwhile
+          uint8_t* batch = static_cast<uint8_t*>(pool->grow_pool.allocated.allocate_block());
+          state_sptr->nof_unlocked_jobs++;
+          lock.unlock();
+          pool->grow_pool.init_batch_(batch);
+          lock.lock();
+          pool->grow_pool.push_batch_(batch);
+          state_sptr->nof_unlocked_jobs--;
+          state_sptr->cvar.notify_all();
+        } while (state_sptr->pool != nullptr and pool->grow_pool.cache_size() < pool->thres);
       }
       state_sptr->dispatched = false;
     });
   }
 
   size_t thres;
+  bool   recycle_in_background;
 
   // state of pool is detached because pool may be destroyed while batches are being allocated in the background
   struct detached_pool_state {
     std::mutex              mutex;
+    std::condition_variable cvar;
     background_obj_pool<T>* pool;
-    bool                    dispatched = false;
+    bool                    dispatched         = false;
+    bool                    recycle_dispatched = false;
+    uint32_t                nof_unlocked_jobs  = 0;
     explicit detached_pool_state(background_obj_pool<T>* pool_) : pool(pool_) {}
   };
   std::shared_ptr<detached_pool_state> state;
 
   growing_batch_obj_pool<T> grow_pool;
+  /// Released objects pending recycling
+  memblock_node_list dirty;
 };
 
 } // namespace srsran
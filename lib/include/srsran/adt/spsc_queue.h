@@ -0,0 +1,166 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SPSC_QUEUE_H
+#define SRSRAN_SPSC_QUEUE_H
+
+#include "srsran/adt/detail/cache_line.h"
+#include "srsran/adt/detail/type_storage.h"
+#include "srsran/support/srsran_assert.h"
+#include <atomic>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Bounded wait-free single-producer/single-consumer queue with the following features:
+ * - one thread may call the producer methods (try_push) while another thread calls the consumer methods (try_pop,
+ *   front, for_each). If there is more than one consumer (or producer), they must be externally serialized.
+ * - no allocations while pushing/popping new elements. The buffer is allocated at construction or in set_size()
+ * - the producer and consumer indexes live in separate cache lines, and each side caches the last observed index of
+ *   the other side to minimize cache line transfers
+ * @tparam T type of the objects stored in the queue
+ */
+template <typename T>
+class dyn_spsc_queue
+{
+  using storage_t = detail::type_storage<T>;
+
+public:
+  explicit dyn_spsc_queue(size_t capacity = 0) : buffer(capacity) {}
+  dyn_spsc_queue(const dyn_spsc_queue&) = delete;
+  dyn_spsc_queue(dyn_spsc_queue&&)      = delete;
+  dyn_spsc_queue& operator=(const dyn_spsc_queue&) = delete;
+  dyn_spsc_queue& operator=(dyn_spsc_queue&&) = delete;
+  ~dyn_spsc_queue() { clear(); }
+
+  /// Producer: pushes new element. Returns false and leaves "t" untouched, if the queue is full
+  bool try_push(T&& t)
+  {
+    size_t w = write_idx.value.load(std::memory_order_relaxed);
+    if (w - cached_read_idx >= buffer.size()) {
+      cached_read_idx = read_idx.value.load(std::memory_order_acquire);
+      if (w - cached_read_idx >= buffer.size()) {
+        return false;
+      }
+    }
+    buffer[w % buffer.size()].emplace(std::move(t));
+    write_idx.value.store(w + 1, std::memory_order_release);
+    return true;
+  }
+  bool try_push(const T& t)
+  {
+    T copy(t);
+    return try_push(std::move(copy));
+  }
+
+  /// Consumer: pops the oldest element. Returns false if the queue is empty
+  bool try_pop(T& t)
+  {
+    T* front_elem = front();
+    if (front_elem == nullptr) {
+      return false;
+    }
+    t = std::move(*front_elem);
+    pop();
+    return true;
+  }
+
+  /// Consumer: returns pointer to the oldest element or nullptr if the queue is empty
+  T* front()
+  {
+    size_t r = read_idx.value.load(std::memory_order_relaxed);
+    if (r == cached_write_idx) {
+      cached_write_idx = write_idx.value.load(std::memory_order_acquire);
+      if (r == cached_write_idx) {
+        return nullptr;
+      }
+    }
+    return &buffer[r % buffer.size()].get();
+  }
+
+  /// Consumer: removes the oldest element. The queue must not be empty
+  void pop()
+  {
+    size_t r = read_idx.value.load(std::memory_order_relaxed);
+    srsran_assert(r != write_idx.value.load(std::memory_order_acquire), "Cannot pop from empty queue");
+    buffer[r % buffer.size()].destroy();
+    read_idx.value.store(r + 1, std::memory_order_release);
+  }
+
+  /// Consumer: visits all the elements currently visible to the consumer, from the oldest to the newest. The
+  /// elements may be modified in-place, as the producer does not access them until they are popped
+  template <typename F>
+  void for_each(const F& func)
+  {
+    size_t r         = read_idx.value.load(std::memory_order_relaxed);
+    cached_write_idx = write_idx.value.load(std::memory_order_acquire);
+    for (; r != cached_write_idx; ++r) {
+      func(buffer[r % buffer.size()].get());
+    }
+  }
+
+  /// Consumer: pops all the elements of the queue
+  void clear()
+  {
+    while (front() != nullptr) {
+      pop();
+    }
+  }
+
+  /// Resizes the queue. Must not be called concurrently with any other method
+  void set_size(size_t capacity)
+  {
+    srsran_assert(empty(), "The queue must be empty before being resized");
+    std::vector<storage_t>(capacity).swap(buffer);
+    read_idx.value.store(0, std::memory_order_relaxed);
+    write_idx.value.store(0, std::memory_order_relaxed);
+    cached_read_idx  = 0;
+    cached_write_idx = 0;
+  }
+
+  /// Returns the number of elements in the queue. The value may be outdated if called concurrently with push/pop
+  size_t size() const
+  {
+    size_t r = read_idx.value.load(std::memory_order_acquire);
+    size_t w = write_idx.value.load(std::memory_order_acquire);
+    return w >= r ? w - r : 0;
+  }
+  bool   empty() const { return size() == 0; }
+  bool   full() const { return size() >= buffer.size(); }
+  size_t capacity() const { return buffer.size(); }
+
+private:
+  std::vector<storage_t> buffer;
+
+  // Consumer state
+  detail::padded_atomic_index read_idx;
+  size_t                      cached_write_idx = 0;
+  char                        consumer_padding[detail::cache_line_size - sizeof(size_t)];
+
+  // Producer state
+  detail::padded_atomic_index write_idx;
+  size_t                      cached_read_idx = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_SPSC_QUEUE_H
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_TRIPLE_BUFFER_H
+#define SRSRAN_TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace srsran {
+
+/**
+ * Wait-free single-producer/single-consumer snapshot buffer, i.e. a double buffer where the swap is done via a third,
+ * intermediate buffer, so that neither side ever waits for the other:
+ * - the producer fills the write buffer and publishes it as the latest snapshot, getting the previous intermediate
+ *   buffer in exchange. The write buffer holds stale data after publishing, and has to be fully rewritten
+ * - the consumer fetches the latest published snapshot, if any, and reads it for as long as it needs. Snapshots
+ *   published in the meantime replace each other, without ever touching the buffer being read
+ * No allocations are made, and the objects are reused, e.g. vectors keep their capacity.
+ * @tparam T type of the snapshots
+ */
+template <typename T>
+class triple_buffer
+{
+public:
+  triple_buffer() = default;
+  explicit triple_buffer(const T& init_val) : buffers{{init_val, init_val, init_val}} {}
+  triple_buffer(const triple_buffer&) = delete;
+  triple_buffer& operator=(const triple_buffer&) = delete;
+
+  /// Producer: buffer where the next snapshot is written
+  T& write_buffer() { return buffers[back]; }
+
+  /// Producer: publishes the write buffer as the latest snapshot
+  void publish()
+  {
+    uint8_t prev = middle.exchange(back | dirty_flag, std::memory_order_acq_rel);
+    back         = prev & index_mask;
+  }
+
+  /// Consumer: fetches the latest published snapshot into the read buffer. Returns false if no snapshot was published
+  /// since the previous fetch, in which case the read buffer is left unchanged
+  bool fetch()
+  {
+    if ((middle.load(std::memory_order_relaxed) & dirty_flag) == 0) {
+      return false;
+    }
+    uint8_t prev = middle.exchange(front, std::memory_order_acq_rel);
+    front        = prev & index_mask;
+    return true;
+  }
+
+  /// Consumer: last fetched snapshot
+  const T& read_buffer() const { return buffers[front]; }
+
+private:
+  const static uint8_t index_mask = 0x3;
+  const static uint8_t dirty_flag = 0x4;
+
+  std::array<T, 3>     buffers;
+  uint8_t              back   = 0; ///< Owned by the producer
+  uint8_t              front  = 1; ///< Owned by the consumer
+  std::atomic<uint8_t> middle{2};  ///< Index of the intermediate buffer, plus the flag of a pending snapshot
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_TRIPLE_BUFFER_H
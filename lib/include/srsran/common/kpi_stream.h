@@ -0,0 +1,173 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_KPI_STREAM_H
+#define SRSRAN_KPI_STREAM_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Binary, append-only columnar stream of KPIs.
+ *
+ * The KPIs are organized in groups, each with a fixed schema of named columns, and each row of a group is identified
+ * by a key (e.g. the RNTI of the UE). Every report of a group is written as one block with the rows of all its keys,
+ * stored column by column. Counters are encoded as the varint difference with the value of the same key in the
+ * previous block of the group, so that slowly changing values take one or two bytes, while gauges are stored as raw
+ * floats. Blocks are self-delimited records, and the stream can be read while it is being written.
+ *
+ * File layout (integers in little-endian, "varint" is LEB128 and signed values are zigzag encoded):
+ * - header:  "SRSKPI" magic, version (u8), reserved (u8)
+ * - records: type (u8), payload length (u32), payload
+ *   - schema: group id (varint), group name, key name, nof columns (varint), and per column kind (u8) and name.
+ *             Strings are a varint length followed by the characters
+ *   - block:  group id (varint), timestamp in usec since the previous block of the group (signed varint), nof rows
+ *             (varint), keys as signed varint differences with the previous key of the block, and the columns
+ */
+namespace kpi_stream {
+
+const static uint8_t kpi_stream_version = 1;
+
+enum class column_kind_t : uint8_t { counter = 0, gauge = 1 };
+
+struct column_t {
+  std::string   name;
+  column_kind_t kind;
+};
+
+struct group_schema_t {
+  std::string           name;
+  std::string           key_name;
+  std::vector<column_t> columns;
+};
+
+/// One report of a group. The values of column c for the key keys[i] are in values[c][i]. Counters are integers
+/// stored in doubles, hence exact up to 2^53
+struct block_t {
+  uint32_t                         group_id     = 0;
+  uint64_t                         timestamp_us = 0;
+  std::vector<uint32_t>            keys;
+  std::vector<std::vector<double> > values;
+};
+
+/**
+ * Writer of a KPI stream. Blocks are built row by row, encoded in a reusable buffer and written with a single call,
+ * hence a report costs a few bytes per value, without any text formatting. Not thread-safe.
+ */
+class writer
+{
+public:
+  writer() = default;
+  writer(const writer&) = delete;
+  writer& operator=(const writer&) = delete;
+  ~writer() { close(); }
+
+  bool open(const std::string& filename);
+  void close();
+  bool is_open() const { return file != nullptr; }
+
+  /// Defines a new group and writes its schema. Returns the id of the group
+  uint32_t add_group(const group_schema_t& schema);
+
+  /// Starts the block of a group. The rows added until end_block() are written together
+  void begin_block(uint32_t group_id, uint64_t timestamp_us);
+  /// Adds a row to the current block, with all values set to zero
+  void add_row(uint32_t key);
+  /// Sets a value of the last row added
+  void set_counter(uint32_t column, int64_t value);
+  void set_gauge(uint32_t column, float value);
+  /// Encodes and writes the current block
+  void end_block();
+
+  void     flush();
+  uint64_t get_nof_bytes() const { return nof_bytes; }
+
+private:
+  struct group_ctxt_t {
+    group_schema_t schema;
+    uint64_t       last_timestamp_us = 0;
+    // Last value of the counters of each key, in column order
+    std::unordered_map<uint32_t, std::vector<int64_t> > last_counters;
+  };
+
+  void write_record(uint8_t type);
+
+  FILE*                     file = nullptr;
+  std::vector<group_ctxt_t> groups;
+  uint64_t                  nof_bytes = 0;
+
+  // Current block
+  uint32_t              cur_group        = 0;
+  uint64_t              cur_timestamp_us = 0;
+  std::vector<uint32_t> cur_keys;
+  std::vector<int64_t>  cur_counters; ///< Row-major, with one entry per column of the group
+  std::vector<float>    cur_gauges;   ///< Row-major, with one entry per column of the group
+  std::vector<uint8_t>  buffer;
+};
+
+/**
+ * Sequential reader of a KPI stream. The schemas are parsed as they are found, and the blocks are returned with the
+ * decoded values.
+ */
+class reader
+{
+public:
+  reader() = default;
+  reader(const reader&) = delete;
+  reader& operator=(const reader&) = delete;
+  ~reader() { close(); }
+
+  bool open(const std::string& filename);
+  void close();
+
+  /// Reads the next block. Returns false at the end of the stream or if it is malformed, see has_error()
+  bool read_block(block_t& block);
+  bool has_error() const { return error; }
+
+  size_t                nof_groups() const { return groups.size(); }
+  const group_schema_t& get_schema(uint32_t group_id) const { return groups[group_id].schema; }
+
+private:
+  struct group_ctxt_t {
+    group_schema_t                                      schema;
+    uint64_t                                            last_timestamp_us = 0;
+    std::unordered_map<uint32_t, std::vector<int64_t> > last_counters;
+  };
+
+  bool parse_schema(const uint8_t* data, size_t len);
+  bool parse_block(const uint8_t* data, size_t len, block_t& block);
+
+  FILE*                     file  = nullptr;
+  bool                      error = false;
+  std::vector<group_ctxt_t> groups;
+  std::vector<uint8_t>      buffer;
+};
+
+} // namespace kpi_stream
+
+} // namespace srsran
+
+#endif // SRSRAN_KPI_STREAM_H
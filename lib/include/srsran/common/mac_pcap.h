@@ -24,6 +24,7 @@
 
 #include "srsran/common/common.h"
 #include "srsran/common/mac_pcap_base.h"
+#include "srsran/common/pcap_writer.h"
 #include "srsran/srsran.h"
 
 namespace srsran {
@@ -32,14 +33,17 @@ class mac_pcap : public mac_pcap_base
 public:
   mac_pcap();
   ~mac_pcap();
-  uint32_t open(std::string filename, uint32_t ue_id = 0);
+  uint32_t open(std::string filename, uint32_t ue_id = 0, const pcap_writer_args_t& args = {});
   uint32_t close();
 
 private:
-  void write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  /// Interface IDs of the LTE and NR MAC PDUs
+  enum { lte_if_id = 0, nr_if_id = 1 };
 
-  FILE*       pcap_file = nullptr;
-  uint32_t    dlt       = 0; // The DLT used for the PCAP file
+  bool queue_pdu(pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len) override;
+
+  pcap_writer writer;
+  uint32_t    dlt = 0; // The DLT used for the PCAP file
   std::string filename;
 };
 } // namespace srsran
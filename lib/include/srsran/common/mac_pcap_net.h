@@ -25,10 +25,12 @@
 #include "srsran/common/common.h"
 #include "srsran/common/mac_pcap_base.h"
 #include "srsran/common/network_utils.h"
+#include "srsran/common/pcap_capture_ring.h"
+#include "srsran/common/threads.h"
 #include "srsran/srsran.h"
 
 namespace srsran {
-class mac_pcap_net : public mac_pcap_base
+class mac_pcap_net : public mac_pcap_base, protected srsran::thread
 {
 public:
   mac_pcap_net();
@@ -41,12 +43,16 @@ public:
   uint32_t close();
 
 private:
-  void write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu);
-  void write_mac_lte_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
-  void write_mac_nr_pdu_to_net(srsran::mac_pcap_base::pcap_pdu_t& pdu);
+  /// Maximum number of datagrams sent in a single call to sendmmsg
+  const static size_t max_batch_size = 64;
+
+  bool queue_pdu(pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len) override;
+  void run_thread() override;
+  bool send_batch();
 
   srsran::unique_socket socket;
   struct sockaddr_in    client_addr;
+  pcap_capture_ring     ring;
 };
 } // namespace srsran
 
@@ -24,6 +24,7 @@
 
 #include "srsran/common/common.h"
 #include "srsran/common/pcap.h"
+#include "srsran/common/pcap_writer.h"
 #include <string>
 
 namespace srsran {
@@ -31,23 +32,29 @@ namespace srsran {
 class nas_pcap
 {
 public:
-  nas_pcap()
+  nas_pcap() : writer("PCAP_WRITER_NAS")
   {
     enable_write = false;
     ue_id        = 0;
-    pcap_file    = NULL;
   }
-  void enable();
-  uint32_t open(std::string filename_, uint32_t ue_id = 0, srsran_rat_t rat_type = srsran_rat_t::lte);
-  void close();
-  void write_nas(uint8_t* pdu, uint32_t pdu_len_bytes);
+  void     enable();
+  uint32_t open(std::string               filename_,
+                uint32_t                  ue_id    = 0,
+                srsran_rat_t              rat_type = srsran_rat_t::lte,
+                const pcap_writer_args_t& args     = {});
+  void     close();
+  void     write_nas(uint8_t* pdu, uint32_t pdu_len_bytes);
 
 private:
+  /// Size of the capture ring slots and default number of PDUs in the ring
+  const static uint32_t ring_slot_size    = 8192;
+  const static uint32_t default_ring_size = 256;
+
   bool        enable_write;
   std::string filename;
-  FILE*       pcap_file;
+  pcap_writer writer;
+  uint32_t    dlt = NAS_LTE_DLT;
   uint32_t    ue_id;
-  void        pack_and_write(uint8_t* pdu, uint32_t pdu_len_bytes);
 };
 
 } // namespace srsran
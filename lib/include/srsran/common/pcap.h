@@ -199,6 +199,20 @@ FILE* DLT_PCAP_Open(uint32_t DLT, const char* fileName);
 /* Close the PCAP file */
 void DLT_PCAP_Close(FILE* fd);
 
+/* Pack the dummy UDP header, start string and context that precede the PDU in the UDP framing of each protocol */
+int LTE_PCAP_PACK_MAC_UDP_CONTEXT_TO_BUFFER(MAC_Context_Info_t* context,
+                                            uint8_t*            buffer,
+                                            unsigned int        length,
+                                            unsigned int        pdu_length);
+int NR_PCAP_PACK_MAC_UDP_CONTEXT_TO_BUFFER(mac_nr_context_info_t* context,
+                                           uint8_t*               buffer,
+                                           unsigned int           length,
+                                           unsigned int           pdu_length);
+int LTE_PCAP_PACK_RLC_CONTEXT_TO_BUFFER(RLC_Context_Info_t* context,
+                                        uint8_t*            buffer,
+                                        unsigned int        length,
+                                        unsigned int        pdu_length);
+
 /* Write an individual MAC PDU (PCAP packet header + mac-context + mac-pdu) */
 int LTE_PCAP_MAC_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned char* PDU, unsigned int length);
 int LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned char* PDU, unsigned int length);
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PCAP_CAPTURE_RING_H
+#define SRSRAN_PCAP_CAPTURE_RING_H
+
+#include "srsran/adt/detail/cache_line.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Pre-allocated ring of fixed-size slots that holds the PDUs captured by the PCAP writers until they are written out.
+ * - any number of threads may call try_push concurrently. The PDU is copied straight into the slot memory, so no
+ *   buffers are taken from the data-plane buffer pool. Payloads larger than the slot are truncated, as with the
+ *   snapshot length of a PCAP capture.
+ * - the consumer (a single writer thread) peeks at batches of consecutive published records in place, and releases
+ *   them once they have been written.
+ * - each slot carries a sequence number, like in dyn_mpsc_queue, that tells producers whether the slot is free and
+ *   the consumer whether the slot has been written.
+ */
+class pcap_capture_ring
+{
+  struct slot_t {
+    std::atomic<size_t> seq{0};
+    uint64_t            timestamp_ns = 0;
+    uint32_t            if_id        = 0;
+    uint32_t            orig_len     = 0;
+    uint32_t            len          = 0;
+  };
+
+public:
+  /// View of a published record. The data remains valid until the record is released
+  struct record_t {
+    uint64_t       timestamp_ns;
+    uint32_t       if_id;
+    uint32_t       orig_len;
+    uint32_t       len;
+    const uint8_t* data;
+  };
+
+  pcap_capture_ring() = default;
+  pcap_capture_ring(const pcap_capture_ring&) = delete;
+  pcap_capture_ring& operator=(const pcap_capture_ring&) = delete;
+
+  /// Allocates the ring memory. Must not be called concurrently with any other method
+  void resize(uint32_t nof_slots, uint32_t slot_size_)
+  {
+    std::vector<slot_t>(nof_slots).swap(slots);
+    std::vector<uint8_t>(size_t(nof_slots) * slot_size_).swap(storage);
+    slot_size = slot_size_;
+    for (size_t i = 0; i < slots.size(); ++i) {
+      slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+    enqueue_idx.value.store(0, std::memory_order_relaxed);
+    dequeue_idx.value.store(0, std::memory_order_relaxed);
+  }
+
+  /// Producer: copies a record made of a context header and a payload into a free slot. Returns false if the ring is
+  /// full
+  bool try_push(uint32_t if_id, const uint8_t* hdr, uint32_t hdr_len, const uint8_t* payload, uint32_t payload_len)
+  {
+    if (slots.empty() or hdr_len > slot_size) {
+      return false;
+    }
+    size_t  pos  = enqueue_idx.value.load(std::memory_order_relaxed);
+    slot_t* slot = nullptr;
+    while (true) {
+      slot        = &slots[pos % slots.size()];
+      size_t seq  = slot->seq.load(std::memory_order_acquire);
+      auto   diff = static_cast<std::ptrdiff_t>(seq - pos);
+      if (diff == 0) {
+        if (enqueue_idx.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // The writer has not released the slot yet
+        return false;
+      } else {
+        pos = enqueue_idx.value.load(std::memory_order_relaxed);
+      }
+    }
+
+    uint32_t copy_len  = std::min(payload_len, slot_size - hdr_len);
+    uint8_t* data      = &storage[(pos % slots.size()) * slot_size];
+    slot->timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+    slot->if_id    = if_id;
+    slot->orig_len = hdr_len + payload_len;
+    slot->len      = hdr_len + copy_len;
+    if (hdr_len > 0) {
+      memcpy(data, hdr, hdr_len);
+    }
+    memcpy(data + hdr_len, payload, copy_len);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer: fills "records" with up to "max_records" of the oldest published records, without releasing them.
+  /// Returns the number of records
+  size_t peek(record_t* records, size_t max_records) const
+  {
+    size_t pos = dequeue_idx.value.load(std::memory_order_relaxed);
+    size_t n   = 0;
+    for (; n < max_records and n < slots.size(); ++n) {
+      const slot_t& slot = slots[(pos + n) % slots.size()];
+      if (slot.seq.load(std::memory_order_acquire) != pos + n + 1) {
+        break;
+      }
+      records[n] = {
+          slot.timestamp_ns, slot.if_id, slot.orig_len, slot.len, &storage[((pos + n) % slots.size()) * slot_size]};
+    }
+    return n;
+  }
+
+  /// Consumer: hands the "n" oldest records, previously returned by peek(), back to the producers
+  void release(size_t n)
+  {
+    size_t pos = dequeue_idx.value.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < n; ++i) {
+      slots[(pos + i) % slots.size()].seq.store(pos + i + slots.size(), std::memory_order_release);
+    }
+    dequeue_idx.value.store(pos + n, std::memory_order_release);
+  }
+
+  /// Number of records in the ring, including the ones being pushed
+  size_t size() const
+  {
+    size_t r = dequeue_idx.value.load(std::memory_order_acquire);
+    size_t w = enqueue_idx.value.load(std::memory_order_acquire);
+    return w >= r ? w - r : 0;
+  }
+  bool     empty() const { return size() == 0; }
+  size_t   capacity() const { return slots.size(); }
+  uint32_t get_slot_size() const { return slot_size; }
+
+private:
+  std::vector<slot_t>  slots;
+  std::vector<uint8_t> storage;
+  uint32_t             slot_size = 0;
+
+  // Shared by the producers
+  detail::padded_atomic_index enqueue_idx;
+
+  // Consumer state
+  detail::padded_atomic_index dequeue_idx;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PCAP_CAPTURE_RING_H
@@ -0,0 +1,114 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PCAP_WRITER_H
+#define SRSRAN_PCAP_WRITER_H
+
+#include "srsran/common/pcap_capture_ring.h"
+#include "srsran/common/threads.h"
+#include "srsran/srslog/srslog.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <sys/uio.h>
+#include <vector>
+
+namespace srsran {
+
+enum class pcap_format_t { pcap, pcapng };
+
+/// File options shared by all the PCAP writers
+struct pcap_writer_args_t {
+  pcap_format_t format              = pcap_format_t::pcap;
+  uint64_t      max_file_size       = 0; ///< Rotate to a new file beyond this size, in bytes. 0 disables rotation
+  uint32_t      max_file_duration_s = 0; ///< Rotate to a new file after this time, in seconds. 0 disables rotation
+  uint32_t      ring_size           = 0; ///< Number of PDUs of the capture ring. 0 selects the default of each layer
+};
+
+/// Link layer of the PDUs written by a layer. pcapng files define one interface per layer, while classic PCAP files
+/// only support layers that share the same DLT
+struct pcap_interface_t {
+  uint32_t    dlt;
+  std::string name;
+};
+
+/**
+ * File writer shared by the MAC, RLC, NAS and S1AP captures.
+ * The layers copy each PDU and its packed context header into a pre-allocated capture ring, without locking or taking
+ * buffers from the pool. A dedicated thread drains the ring in batches, and writes each batch with a single vectored
+ * write, either as classic PCAP records or as pcapng Enhanced Packet Blocks tagged with the interface ID of the layer.
+ * Files are rotated once they exceed the configured size or duration, and every new file starts with its own headers.
+ */
+class pcap_writer : protected srsran::thread
+{
+public:
+  explicit pcap_writer(const std::string& thread_name);
+  pcap_writer(const pcap_writer&) = delete;
+  pcap_writer& operator=(const pcap_writer&) = delete;
+  ~pcap_writer();
+
+  /// Opens the first file and starts the writer thread. "slot_size" is the largest record kept in the ring, which
+  /// includes the context header
+  int  open(const std::string&                   filename,
+            const std::vector<pcap_interface_t>& interfaces,
+            uint32_t                             slot_size,
+            uint32_t                             default_ring_size,
+            const pcap_writer_args_t&            args = {});
+  void close();
+  bool is_open() const { return running; }
+
+  /// Called from any thread. Copies the record into the capture ring. Returns false if the PDU was dropped
+  bool write(uint32_t if_id, const uint8_t* hdr, uint32_t hdr_len, const uint8_t* payload, uint32_t payload_len);
+
+  uint64_t get_nof_dropped() const { return nof_dropped.load(std::memory_order_relaxed); }
+
+private:
+  /// Maximum number of records written in a single call to writev
+  const static size_t max_batch_size = 256;
+
+  void run_thread() override;
+  bool write_batch();
+  void flush(struct iovec* iov, size_t iovcnt, size_t nof_bytes, size_t nof_records);
+  void rotate_file();
+  bool create_file();
+  void close_file();
+  bool write_all(struct iovec* iov, size_t iovcnt, size_t nof_bytes);
+
+  srslog::basic_logger&         logger;
+  pcap_writer_args_t            args;
+  std::vector<pcap_interface_t> interfaces;
+  pcap_capture_ring             ring;
+  std::atomic<bool>             running{false};
+  std::atomic<uint64_t>         nof_dropped{0};
+  std::mutex                    mutex;
+
+  // Writer thread state
+  std::string                           base_filename;
+  int                                   fd               = -1;
+  uint32_t                              file_index       = 0;
+  uint64_t                              file_size        = 0;
+  uint64_t                              file_header_size = 0;
+  std::chrono::steady_clock::time_point file_start;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PCAP_WRITER_H
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PERF_COUNTERS_H
+#define SRSRAN_PERF_COUNTERS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace srsran {
+
+/// Hardware events counted by the performance counters
+enum class perf_event_t { cycles, instructions, llc_misses, branch_misses, nof_events };
+
+const char* to_string(perf_event_t event);
+
+using perf_sample_t = std::array<uint64_t, (size_t)perf_event_t::nof_events>;
+
+/**
+ * Hardware performance counters of the calling thread, opened with perf_event_open as a single group, so that the
+ * events are scheduled together and read with one system call. Only the user-space events are counted, which is
+ * allowed for unprivileged processes with the default perf_event_paranoid. The counters are only available when built
+ * with ENABLE_PERF_COUNTERS on Linux, otherwise open() fails.
+ */
+class perf_counter_group
+{
+public:
+  perf_counter_group() { fds.fill(-1); }
+  perf_counter_group(const perf_counter_group&) = delete;
+  perf_counter_group& operator=(const perf_counter_group&) = delete;
+  ~perf_counter_group() { close(); }
+
+  bool open();
+  void close();
+  bool is_open() const { return fds[0] >= 0; }
+
+  /// Reads the current value of the counters. Returns false if the group is not open or the read failed
+  bool read(perf_sample_t& sample) const;
+
+private:
+  std::array<int, (size_t)perf_event_t::nof_events> fds;
+};
+
+/// Enables the per-thread counters of perf_counters_this_thread(). Returns false if the counters cannot be opened on
+/// this system, in which case they are left disabled
+bool perf_counters_enable();
+bool perf_counters_enabled();
+
+/// Counters of the calling thread, opened on first use. Returns nullptr if the counters are disabled or could not be
+/// opened for this thread
+perf_counter_group* perf_counters_this_thread();
+
+/**
+ * Accumulates the counters spent in a code region, which may be run by several threads concurrently. The totals are
+ * read and reset periodically by a single reader.
+ */
+class perf_counter_accumulator
+{
+public:
+  struct summary_t {
+    uint64_t      nof_samples;
+    perf_sample_t totals;
+
+    /// Ratios of the summary, or 0 if no cycle or instruction was counted
+    float ipc() const;
+    float misses_per_kinstr(perf_event_t event) const;
+  };
+
+  perf_counter_accumulator();
+
+  void      add(const perf_sample_t& start, const perf_sample_t& end);
+  summary_t read_and_reset();
+
+private:
+  std::atomic<uint64_t>                                               nof_samples{0};
+  std::array<std::atomic<uint64_t>, (size_t)perf_event_t::nof_events> totals;
+};
+
+/// Samples the counters of the calling thread from construction to destruction into an accumulator, if the counters
+/// are enabled and the accumulator is not null
+class perf_counter_scope
+{
+public:
+  explicit perf_counter_scope(perf_counter_accumulator* acc_) :
+    acc(acc_), group(acc_ != nullptr ? perf_counters_this_thread() : nullptr)
+  {
+    if (group != nullptr and not group->read(start)) {
+      group = nullptr;
+    }
+  }
+  perf_counter_scope(const perf_counter_scope&) = delete;
+  perf_counter_scope& operator=(const perf_counter_scope&) = delete;
+  ~perf_counter_scope()
+  {
+    perf_sample_t end;
+    if (group != nullptr and group->read(end)) {
+      acc->add(start, end);
+    }
+  }
+
+private:
+  perf_counter_accumulator* acc;
+  perf_counter_group*       group;
+  perf_sample_t             start;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PERF_COUNTERS_H
@@ -23,6 +23,7 @@
 #define RLCPCAP_H
 
 #include "srsran/common/pcap.h"
+#include "srsran/common/pcap_writer.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 #include <stdint.h>
 
@@ -31,9 +32,9 @@ namespace srsran {
 class rlc_pcap
 {
 public:
-  rlc_pcap() {}
+  rlc_pcap() : writer("PCAP_WRITER_RLC") {}
   void enable(bool en);
-  void open(const char* filename, const rlc_config_t& config);
+  void open(const char* filename, const rlc_config_t& config, const pcap_writer_args_t& args = {});
   void close();
 
   void set_ue_id(uint16_t ue_id);
@@ -42,9 +43,13 @@ public:
   void write_ul_ccch(uint8_t* pdu, uint32_t pdu_len_bytes);
 
 private:
-  bool     enable_write = false;
-  FILE*    pcap_file    = nullptr;
-  uint32_t ue_id        = 0;
+  /// Size of the capture ring slots and default number of PDUs in the ring
+  const static uint32_t ring_slot_size    = 16384;
+  const static uint32_t default_ring_size = 1024;
+
+  bool        enable_write = false;
+  pcap_writer writer;
+  uint32_t    ue_id        = 0;
   uint8_t  mode         = 0;
   uint8_t  sn_length    = 0;
   void     pack_and_write(uint8_t* pdu,
@@ -23,6 +23,7 @@
 #define SRSRAN_S1AP_PCAP_H
 
 #include "srsran/common/pcap.h"
+#include "srsran/common/pcap_writer.h"
 #include <string>
 
 namespace srsran {
@@ -37,14 +38,18 @@ public:
   s1ap_pcap& operator=(s1ap_pcap&& other) = delete;
 
   void enable();
-  void open(const char* filename_);
+  void open(const char* filename_, const pcap_writer_args_t& args = {});
   void close();
   void write_s1ap(uint8_t* pdu, uint32_t pdu_len_bytes);
 
 private:
+  /// Size of the capture ring slots and default number of PDUs in the ring
+  const static uint32_t ring_slot_size    = 16384;
+  const static uint32_t default_ring_size = 256;
+
   bool        enable_write = false;
   std::string filename;
-  FILE*       pcap_file = nullptr;
+  pcap_writer writer;
 };
 
 } // namespace srsran
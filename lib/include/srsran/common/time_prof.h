@@ -23,6 +23,8 @@
 #define SRSRAN_TIME_PROF_H
 
 #include "srsran/srslog/srslog.h"
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <mutex>
 
@@ -162,6 +164,66 @@ public:
 };
 using sliding_window_stats_ms = sliding_window_stats<std::chrono::milliseconds>;
 
+/**
+ * Lock-free latency histogram, with log-linear buckets in the style of HDR histograms. Each power-of-two range of
+ * nanoseconds is split into 2^sub_bucket_bits linear buckets, which bounds the relative error of the percentiles to
+ * 2^-sub_bucket_bits. Samples can be recorded concurrently from any thread, and the durations above a deadline are
+ * counted as misses. It can be used as the Prof of a tprof.
+ */
+class latency_histogram
+{
+public:
+  struct summary_t {
+    uint64_t                 count = 0;
+    std::chrono::nanoseconds p50{0};
+    std::chrono::nanoseconds p99{0};
+    std::chrono::nanoseconds max{0};
+    uint64_t                 nof_deadline_misses = 0;
+  };
+
+  explicit latency_histogram(std::chrono::nanoseconds deadline_ = std::chrono::nanoseconds::max()) :
+    deadline(deadline_.count())
+  {
+    for (auto& b : buckets) {
+      b.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void operator()(std::chrono::nanoseconds duration)
+  {
+    int64_t ns = std::max<int64_t>(duration.count(), 0);
+    buckets[bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+    if (ns > deadline) {
+      nof_deadline_misses.fetch_add(1, std::memory_order_relaxed);
+    }
+    int64_t prev_max = max_ns.load(std::memory_order_relaxed);
+    while (ns > prev_max and not max_ns.compare_exchange_weak(prev_max, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  /// Computes the summary of the samples recorded since the previous call, and resets the histogram
+  summary_t read_and_reset();
+
+  /// Sets the deadline, before any sample is recorded
+  void                     set_deadline(std::chrono::nanoseconds deadline_) { deadline = deadline_.count(); }
+  std::chrono::nanoseconds get_deadline() const { return std::chrono::nanoseconds{deadline}; }
+
+  /// Bucket where a duration in nanoseconds is counted
+  static size_t bucket_index(int64_t ns);
+  /// Highest duration in nanoseconds counted in a bucket
+  static int64_t bucket_upper_bound(size_t idx);
+
+  const static uint32_t sub_bucket_bits = 4;
+  const static uint32_t max_value_bits  = 36;
+  const static size_t   nof_buckets     = (max_value_bits - sub_bucket_bits + 1) << sub_bucket_bits;
+
+private:
+  int64_t                                        deadline;
+  std::array<std::atomic<uint64_t>, nof_buckets> buckets;
+  std::atomic<int64_t>                           max_ns{0};
+  std::atomic<uint64_t>                          nof_deadline_misses{0};
+};
+
 } // namespace srsran
 
 #endif // SRSRAN_TIME_PROF_H
@@ -55,12 +55,13 @@ struct stack_metrics_t {
 };
 
 struct enb_metrics_t {
-  srsran::rf_metrics_t       rf;
-  std::vector<phy_metrics_t> phy;
-  stack_metrics_t            stack;
-  stack_metrics_t            nr_stack;
-  srsran::sys_metrics_t      sys;
-  bool                       running;
+  srsran::rf_metrics_t             rf;
+  std::vector<phy_metrics_t>       phy; ///< With an LTE stack, phy[i] is the PHY row of stack.mac.ues[i]
+  std::vector<tti_stage_metrics_t> tti_stages;
+  stack_metrics_t                  stack;
+  stack_metrics_t                  nr_stack;
+  srsran::sys_metrics_t            sys;
+  bool                             running;
 };
 
 // ENB interface
@@ -42,7 +42,7 @@ class pdcp_interface_rrc
 public:
   virtual void set_enabled(uint16_t rnti, uint32_t lcid, bool enable)                                      = 0;
   virtual void reset(uint16_t rnti)                                                                        = 0;
-  virtual void add_user(uint16_t rnti)                                                                     = 0;
+  virtual int  add_user(uint16_t rnti)                                                                     = 0;
   virtual void rem_user(uint16_t rnti)                                                                     = 0;
   virtual void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn = -1) = 0;
   virtual void add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cnfg)                 = 0;
@@ -58,7 +58,7 @@ class rlc_interface_rrc
 {
 public:
   virtual void clear_buffer(uint16_t rnti)                                               = 0;
-  virtual void add_user(uint16_t rnti)                                                   = 0;
+  virtual int  add_user(uint16_t rnti)                                                   = 0;
   virtual void rem_user(uint16_t rnti)                                                   = 0;
   virtual void add_bearer(uint16_t rnti, uint32_t lcid, srsran::rlc_config_t cnfg)       = 0;
   virtual void add_bearer_mrb(uint16_t rnti, uint32_t lcid)                              = 0;
@@ -58,6 +58,9 @@ struct phy_args_t {
   int worker_cpu_mask   = -1;
   int sync_cpu_affinity = -1;
 
+  std::string arena_mode      = "none"; // Memory arena for the worker sample buffers: none, thp, 2M or 1G
+  int         arena_numa_node = -1;     // NUMA node of the arenas. -1 uses the node of the first worker CPU, if pinned
+
   uint32_t    nof_lte_carriers             = 1;
   uint32_t    nof_nr_carriers              = 0;
   uint32_t    nr_max_nof_prb               = 106;
@@ -94,6 +97,7 @@ struct phy_args_t {
   uint32_t    intra_freq_meas_period_ms    = 200;
   float       force_ul_amplitude           = 0.0f;
   bool        detect_cp                    = false;
+  bool        cell_search_joint            = false;
 
   bool nr_store_pdsch_ko = false;
 
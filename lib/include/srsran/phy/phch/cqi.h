@@ -187,6 +187,9 @@ SRSRAN_API uint32_t srsran_cqi_get_sb_idx(uint32_t                       tti,
 
 SRSRAN_API uint8_t srsran_cqi_from_snr(float snr);
 
+/// Returns the minimum SNR in dB for which srsran_cqi_from_snr returns the given CQI (CQI 0 maps to -inf)
+SRSRAN_API float srsran_cqi_to_snr(uint32_t cqi);
+
 SRSRAN_API float srsran_cqi_to_coderate(uint32_t cqi, bool use_alt_table);
 
 #endif // SRSRAN_CQI_H
@@ -90,9 +90,10 @@ typedef struct SRSRAN_API {
   // Containers
   cf_t*  ifft_in;
   cf_t*  ifft_out;
-  cf_t*  prach_bins;
+  cf_t*  prach_bins; // PRACH bins of every receive antenna, SRSRAN_PRACH_N_ZC_LONG apart
   cf_t*  corr_spec;
-  float* corr;
+  float* corr;     // Correlation energy, combined across the receive antennas
+  float* corr_ant; // Correlation energy of a single receive antenna
 
   // PRACH IFFT
   srsran_dft_plan_t fft;
@@ -109,6 +110,7 @@ typedef struct SRSRAN_API {
   float                       peak_values[65];
   uint32_t                    peak_offsets[65];
   uint32_t                    num_ra_preambles;
+  uint32_t                    nof_rx_ant; // Number of receive antennas combined in the last detection
   bool                        successive_cancellation;
   bool                        freq_domain_offset_calc;
   srsran_tdd_config_t         tdd_config;
@@ -234,6 +236,35 @@ SRSRAN_API int srsran_prach_detect_offset(srsran_prach_t* p,
                                           float*          peak_to_avg,
                                           uint32_t*       ind_len);
 
+/**
+ * @brief Detects PRACH preambles received on one or more antennas.
+ *
+ * The correlation against every root sequence is computed once per antenna, and the preambles derived from that root
+ * by cyclic shift are read from their windows of the correlation output. The correlation energy is combined
+ * non-coherently across the antennas before the peak search. Successive cancellation and the frequency domain time
+ * offset estimation only use the first antenna.
+ *
+ * @param p PRACH object
+ * @param freq_offset PRACH frequency offset in PRB
+ * @param signal Received signal of each antenna, aligned to the start of the preamble sequence
+ * @param nof_rx_ant Number of receive antennas, up to SRSRAN_MAX_PORTS
+ * @param sig_len Number of samples of each antenna
+ * @param indices Detected preamble indices
+ * @param t_offsets Time offset of each detected preamble in seconds, NULL if not required
+ * @param peak_to_avg Peak to average ratio of each detected preamble, NULL if not required
+ * @param ind_len Number of detected preambles
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_prach_detect_offset_multi(srsran_prach_t* p,
+                                                uint32_t        freq_offset,
+                                                cf_t*           signal[SRSRAN_MAX_PORTS],
+                                                uint32_t        nof_rx_ant,
+                                                uint32_t        sig_len,
+                                                uint32_t*       indices,
+                                                float*          t_offsets,
+                                                float*          peak_to_avg,
+                                                uint32_t*       ind_len);
+
 SRSRAN_API void srsran_prach_set_detect_factor(srsran_prach_t* p, float factor);
 
 SRSRAN_API int srsran_prach_free(srsran_prach_t* p);
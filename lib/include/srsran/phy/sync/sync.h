@@ -149,6 +149,33 @@ SRSRAN_API srsran_sync_find_ret_t srsran_sync_find(srsran_sync_t* q,
                                                    uint32_t       find_offset,
                                                    uint32_t*      peak_position);
 
+/* Result and averaging state of one N_id_2 in the joint PSS search */
+typedef struct SRSRAN_API {
+  srsran_sync_find_ret_t ret;
+  uint32_t               peak_pos;
+  float                  peak_value; // As returned by srsran_sync_get_peak_value()
+  float                  pss_peak;   // Absolute value of the PSS correlation peak
+  bool                   sss_detected;
+  int                    cell_id;
+  uint32_t               sf_idx;
+  srsran_cp_t            cp;
+  srsran_frame_type_t    frame_type;
+  float                  cfo; // As returned by srsran_sync_get_cfo()
+
+  // State averaged across calls
+  float cfo_pss_mean;
+  bool  cfo_pss_is_set;
+  float M_norm_avg;
+  float M_ext_avg;
+} srsran_sync_joint_t;
+
+/* Resets the per-N_id_2 state and PSS correlation averages of the joint search, allocating them the first time */
+SRSRAN_API int srsran_sync_joint_reset(srsran_sync_t* q, srsran_sync_joint_t joint[3]);
+
+/* Finds the PSS of all the N_id_2 in the input signal after find_offset samples of history, using one input FFT */
+SRSRAN_API int
+srsran_sync_find_joint(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, srsran_sync_joint_t joint[3]);
+
 /* Estimates the CP length */
 SRSRAN_API srsran_cp_t srsran_sync_detect_cp(srsran_sync_t* q, const cf_t* input, uint32_t peak_pos);
 
@@ -73,7 +73,10 @@ typedef struct SRSRAN_API {
   uint32_t *mode_ntimes;
   uint8_t*  mode_counted;
 
-  srsran_ue_cellsearch_result_t* candidates;
+  srsran_ue_cellsearch_result_t* candidates; // max_frames candidates for each N_id_2
+
+  bool                joint_search; // Capture once and correlate all N_id_2 together
+  srsran_sync_joint_t joint[3];
 } srsran_ue_cellsearch_t;
 
 SRSRAN_API int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
@@ -97,8 +100,14 @@ SRSRAN_API int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
                                          srsran_ue_cellsearch_result_t found_cells[3],
                                          uint32_t*                     max_N_id_2);
 
+SRSRAN_API int srsran_ue_cellsearch_scan_joint(srsran_ue_cellsearch_t*       q,
+                                               srsran_ue_cellsearch_result_t found_cells[3],
+                                               uint32_t*                     max_N_id_2);
+
 SRSRAN_API int srsran_ue_cellsearch_set_nof_valid_frames(srsran_ue_cellsearch_t* q, uint32_t nof_frames);
 
+SRSRAN_API void srsran_ue_cellsearch_set_joint_search(srsran_ue_cellsearch_t* q, bool enable);
+
 SRSRAN_API void srsran_set_detect_cp(srsran_ue_cellsearch_t* q, bool enable);
 
 #endif // SRSRAN_UE_CELL_SEARCH_H
@@ -72,6 +72,12 @@ SRSRAN_API uint32_t srsran_conv_fft_cc_run_opt(srsran_conv_fft_cc_t* q,
                                                const cf_t*           filter_freq,
                                                cf_t*                 output);
 
+/* Split version of srsran_conv_fft_cc_run_opt(): the input is transformed once by srsran_conv_fft_cc_run_input() and
+ * then convolved with as many frequency-domain filters as needed by srsran_conv_fft_cc_run_filter() */
+SRSRAN_API void srsran_conv_fft_cc_run_input(srsran_conv_fft_cc_t* q, const cf_t* input);
+
+SRSRAN_API uint32_t srsran_conv_fft_cc_run_filter(srsran_conv_fft_cc_t* q, const cf_t* filter_freq, cf_t* output);
+
 SRSRAN_API uint32_t
 srsran_conv_cc(const cf_t* input, const cf_t* filter, cf_t* output, uint32_t input_len, uint32_t filter_len);
 
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         vec_arena.h
+ *
+ *  Description:  Bump allocator for long-lived PHY sample buffers. The arena is
+ *                reserved at once, optionally backed by 2 MB or 1 GB hugepages
+ *                and bound to a NUMA node, and pre-faulted so that no page
+ *                faults occur while processing. Memory is only returned to the
+ *                system when the whole arena is freed, hence buffers allocated
+ *                from it must never be released with free().
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_VEC_ARENA_H
+#define SRSRAN_VEC_ARENA_H
+
+#include "srsran/config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum SRSRAN_API {
+  SRSRAN_VEC_ARENA_DISABLED = 0, ///< No arena, buffers are allocated with srsran_vec_malloc
+  SRSRAN_VEC_ARENA_THP,          ///< Regular pages, transparent hugepages requested with madvise
+  SRSRAN_VEC_ARENA_HUGEPAGE_2M,  ///< Explicit 2 MB hugepages, falls back to THP if none are available
+  SRSRAN_VEC_ARENA_HUGEPAGE_1G,  ///< Explicit 1 GB hugepages, falls back to 2 MB hugepages if none are available
+} srsran_vec_arena_mode_t;
+
+typedef struct SRSRAN_API {
+  uint8_t*                base;
+  size_t                  size;      ///< Reserved size in bytes, multiple of the page size
+  size_t                  used;      ///< Bytes already handed out
+  size_t                  page_size; ///< Size of the pages backing the arena
+  srsran_vec_arena_mode_t mode;      ///< Mode actually obtained, after fallbacks
+  int                     numa_node; ///< NUMA node the arena is bound to, -1 if not bound
+} srsran_vec_arena_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Reserves and pre-faults an arena of at least size bytes.
+ * @param numa_node node the memory is bound to, or -1 to follow the default memory policy of the calling thread
+ * @return SRSRAN_SUCCESS, or SRSRAN_ERROR if no memory could be reserved or mode is SRSRAN_VEC_ARENA_DISABLED
+ */
+SRSRAN_API int srsran_vec_arena_init(srsran_vec_arena_t* q, size_t size, srsran_vec_arena_mode_t mode, int numa_node);
+
+SRSRAN_API void srsran_vec_arena_free(srsran_vec_arena_t* q);
+
+/// Returns true if the arena has been successfully initialised
+SRSRAN_API bool srsran_vec_arena_is_active(const srsran_vec_arena_t* q);
+
+/// Returns a buffer of size bytes with the same alignment as srsran_vec_malloc, or NULL if the arena is exhausted
+SRSRAN_API void* srsran_vec_arena_alloc(srsran_vec_arena_t* q, size_t size);
+
+SRSRAN_API cf_t* srsran_vec_arena_cf_alloc(srsran_vec_arena_t* q, uint32_t nsamples);
+
+/// Number of arena bytes consumed by an allocation of size bytes, used to dimension the arena
+SRSRAN_API size_t srsran_vec_arena_alloc_size(size_t size);
+
+/// Parses "none", "thp", "2M" or "1G". Returns SRSRAN_ERROR if the string is not recognised
+SRSRAN_API int srsran_vec_arena_mode_parse(const char* str, srsran_vec_arena_mode_t* mode);
+
+SRSRAN_API const char* srsran_vec_arena_mode_string(srsran_vec_arena_mode_t mode);
+
+/// Returns the NUMA node of a CPU, or -1 if it cannot be determined
+SRSRAN_API int srsran_vec_arena_cpu_node(uint32_t cpu);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_VEC_ARENA_H
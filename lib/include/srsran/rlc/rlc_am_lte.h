@@ -26,6 +26,7 @@
 #include "srsran/adt/circular_array.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/intrusive_list.h"
+#include "srsran/adt/spsc_queue.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/task_scheduler.h"
@@ -99,7 +100,55 @@ struct rlc_amd_rx_pdu {
 };
 
 struct rlc_amd_rx_pdu_segments_t {
-  std::list<rlc_amd_rx_pdu> segments;
+  using list_type = std::list<rlc_amd_rx_pdu>;
+
+  uint32_t  rlc_sn = std::numeric_limits<uint32_t>::max();
+  list_type segments;
+
+  rlc_amd_rx_pdu_segments_t() = default;
+  explicit rlc_amd_rx_pdu_segments_t(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
+};
+
+/// Cache of RLC AM Rx segment list nodes shared by all the SNs of the Rx window.
+/// Nodes are allocated on demand and spliced in and out of the per-SN segment lists, so that, once the cache is warm,
+/// the reception of PDU segments does not require any heap allocation. The cache is not thread-safe.
+class rlc_amd_rx_segment_pool
+{
+public:
+  using list_type = rlc_amd_rx_pdu_segments_t::list_type;
+  using iterator  = list_type::iterator;
+
+  /// Inserts segment in the provided list before position "pos", reusing a cached node if available
+  iterator insert(list_type& list, iterator pos, rlc_amd_rx_pdu&& segment)
+  {
+    if (free_list.empty()) {
+      free_list.emplace_back();
+    }
+    list.splice(pos, free_list, free_list.begin());
+    iterator it = std::prev(pos);
+    *it         = std::move(segment);
+    return it;
+  }
+  /// Returns node pointed by "it" to the cache. Returns the iterator following the removed node
+  iterator release(list_type& list, iterator it)
+  {
+    iterator next = std::next(it);
+    it->buf.reset();
+    free_list.splice(free_list.begin(), list, it);
+    return next;
+  }
+  /// Returns all the nodes of the list to the cache
+  void release_all(list_type& list)
+  {
+    for (rlc_amd_rx_pdu& s : list) {
+      s.buf.reset();
+    }
+    free_list.splice(free_list.begin(), list);
+  }
+  size_t nof_cached_segments() const { return free_list.size(); }
+
+private:
+  list_type free_list;
 };
 
 /// Class that contains the parameters and state (e.g. segments) of a RLC PDU
@@ -284,18 +333,28 @@ private:
   uint32_t                   count = 0;
 };
 
+/// Queue of pending RLC AM retransmissions. The number of queued entries per SN is tracked in a SN-indexed table, so
+/// that checking whether a SN is already scheduled for retransmission is O(1)
 class pdu_retx_queue
 {
 public:
-  rlc_amd_retx_t& push()
+  pdu_retx_queue() { sn_count.fill(0); }
+
+  rlc_amd_retx_t& push(uint32_t sn)
   {
     assert(not full());
     rlc_amd_retx_t& p = buffer[wpos];
     wpos              = (wpos + 1) % RLC_AM_WINDOW_SIZE;
+    p.sn              = sn;
+    sn_count[sn % sn_count.size()]++;
     return p;
   }
 
-  void pop() { rpos = (rpos + 1) % RLC_AM_WINDOW_SIZE; }
+  void pop()
+  {
+    sn_count[buffer[rpos].sn % sn_count.size()]--;
+    rpos = (rpos + 1) % RLC_AM_WINDOW_SIZE;
+  }
 
   rlc_amd_retx_t& front()
   {
@@ -307,17 +366,10 @@ public:
   {
     wpos = 0;
     rpos = 0;
+    sn_count.fill(0);
   }
 
-  bool has_sn(uint32_t sn) const
-  {
-    for (size_t i = rpos; i != wpos; i = (i + 1) % RLC_AM_WINDOW_SIZE) {
-      if (buffer[i].sn == sn) {
-        return true;
-      }
-    }
-    return false;
-  }
+  bool has_sn(uint32_t sn) const { return sn_count[sn % sn_count.size()] > 0; }
 
   size_t size() const { return (wpos >= rpos) ? wpos - rpos : RLC_AM_WINDOW_SIZE + wpos - rpos; }
   bool   empty() const { return wpos == rpos; }
@@ -325,8 +377,10 @@ public:
 
 private:
   std::array<rlc_amd_retx_t, RLC_AM_WINDOW_SIZE> buffer;
-  size_t                                         wpos = 0;
-  size_t                                         rpos = 0;
+  // Number of queued entries per SN. Sized to the LTE AM SN space (10 bits), so that SNs never alias
+  std::array<uint16_t, 2 * RLC_AM_WINDOW_SIZE> sn_count;
+  size_t                                       wpos = 0;
+  size_t                                       rpos = 0;
 };
 
 class rlc_am_lte : public rlc_common
@@ -406,11 +460,13 @@ private:
 
     void debug_state();
     void empty_queue_nolock();
+    bool block_sdu_writers();
 
     int  required_buffer_size(const rlc_amd_retx_t& retx);
     void retransmit_pdu(uint32_t sn);
 
     void get_buffer_state_nolock(uint32_t& new_tx, uint32_t& prio_tx);
+    void handle_pending_discards();
 
     // Helpers
     bool poll_required();
@@ -429,11 +485,15 @@ private:
 
     rlc_am_config_t cfg = {};
 
-    // TX SDU buffers
-    byte_buffer_queue    tx_sdu_queue;
-    unique_byte_buffer_t tx_sdu;
+    // TX SDU buffers. The PDCP is the single producer of the SDU and discard queues, while their consumer is whoever
+    // holds the Tx mutex (i.e. MAC reading PDUs or the scheduler querying the buffer state)
+    byte_buffer_spsc_queue   tx_sdu_queue;
+    dyn_spsc_queue<uint32_t> discard_queue;
+    unique_byte_buffer_t     tx_sdu;
 
-    bool tx_enabled = false;
+    std::atomic<bool> tx_enabled = {false};
+    // PDCP calls inside write_sdu()/discard_sdu(). The queues are only reset once tx is disabled and none is left
+    std::atomic<uint32_t> nof_sdu_writers = {0};
 
     /****************************************************************************
      * State variables and counters
@@ -471,6 +531,9 @@ private:
     pdu_retx_queue                   retx_queue;
     pdcp_sn_vector_t                 notify_info_vec;
 
+    // NACK indexes of the last received Status PDU, sorted by their position in the Tx window
+    std::vector<uint32_t> nack_order;
+
     // Mutexes
     std::mutex mutex;
 
@@ -510,6 +573,7 @@ private:
     void debug_state();
     void print_rx_segments();
     bool add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_amd_rx_pdu* segment);
+    void erase_rx_segments(uint32_t sn);
     void reset_status();
 
     rlc_am_lte*           parent = nullptr;
@@ -541,8 +605,9 @@ private:
     std::mutex mutex;
 
     // Rx windows
-    rlc_ringbuffer_t<rlc_amd_rx_pdu>              rx_window;
-    std::map<uint32_t, rlc_amd_rx_pdu_segments_t> rx_segments;
+    rlc_ringbuffer_t<rlc_amd_rx_pdu>            rx_window;
+    rlc_ringbuffer_t<rlc_amd_rx_pdu_segments_t> rx_segments;
+    rlc_amd_rx_segment_pool                     segment_pool;
 
     bool              poll_received = false;
     std::atomic<bool> do_status     = {false}; // light-weight access from Tx entity
@@ -574,6 +639,12 @@ private:
 
   std::mutex           metrics_mutex;
   rlc_bearer_metrics_t metrics = {};
+
+  // Metrics updated in the PDCP write_sdu and MAC read_pdu paths, kept outside of the metrics mutex
+  std::atomic<uint32_t> num_tx_sdus      = {0};
+  std::atomic<uint32_t> num_lost_sdus    = {0};
+  std::atomic<uint32_t> num_tx_pdus      = {0};
+  std::atomic<uint64_t> num_tx_pdu_bytes = {0};
 };
 
 /****************************************************************************
@@ -24,6 +24,12 @@
 
 #include "srsran/srslog/bundled/fmt/printf.h"
 #include "srsran/srslog/detail/support/backend_capacity.h"
+#include "srsran/srslog/detail/support/thread_utils.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <unordered_set>
+#include <vector>
 
 namespace srslog {
 
@@ -32,52 +38,202 @@ namespace detail {
 /// Keeps a pool of dynamic_format_arg_store objects. The main reason for this class is that the arg store objects are
 /// implemented with std::vectors, so we want to avoid allocating memory each time we create a new object. Instead,
 /// reserve memory for each vector during initialization and recycle the objects.
+/// Free objects are kept in a lock-free stack of batches and each thread caches up to two batches, so that threads
+/// only touch the shared stack once every batch_size allocations or deallocations.
+/// NOTE: Thread safe class.
 class dyn_arg_store_pool
 {
+  using store_type = fmt::dynamic_format_arg_store<fmt::printf_context>;
+
+  static constexpr uint32_t batch_size = 16;
+  static constexpr uint32_t null_idx   = std::numeric_limits<uint32_t>::max();
+
+  /// Objects cached by a thread for a single pool.
+  struct thread_cache {
+    dyn_arg_store_pool* pool      = nullptr;
+    uint64_t            pool_id   = 0;
+    uint32_t            nof_items = 0;
+    uint32_t            items[2 * batch_size];
+
+    thread_cache() = default;
+    thread_cache(const thread_cache&) = delete;
+    thread_cache& operator=(const thread_cache&) = delete;
+
+    /// Hands the cached objects back to their pool when the thread exits.
+    ~thread_cache() { return_to_pool(); }
+
+    void return_to_pool()
+    {
+      if (pool == nullptr) {
+        return;
+      }
+      scoped_lock lock(registry_mutex());
+      if (alive_pools().count(pool_id) > 0) {
+        pool->push_batch(items, nof_items);
+      }
+      pool      = nullptr;
+      nof_items = 0;
+    }
+  };
+
 public:
-  dyn_arg_store_pool()
+  dyn_arg_store_pool() :
+    pool(SRSLOG_QUEUE_CAPACITY), next(SRSLOG_QUEUE_CAPACITY), next_batch(SRSLOG_QUEUE_CAPACITY), id(new_pool_id())
   {
-    pool.resize(SRSLOG_QUEUE_CAPACITY);
     for (auto& elem : pool) {
       // Reserve for 10 normal and 2 named arguments.
       elem.reserve(10, 2);
     }
-    free_list.reserve(SRSLOG_QUEUE_CAPACITY);
-    for (auto& elem : pool) {
-      free_list.push_back(&elem);
+    uint32_t batch[batch_size];
+    for (uint32_t i = 0; i < pool.size(); i += batch_size) {
+      uint32_t n = 0;
+      for (; n < batch_size and i + n < pool.size(); ++n) {
+        batch[n] = i + n;
+      }
+      push_batch(batch, n);
     }
+    scoped_lock lock(registry_mutex());
+    alive_pools().insert(id);
+  }
+
+  dyn_arg_store_pool(const dyn_arg_store_pool&) = delete;
+  dyn_arg_store_pool& operator=(const dyn_arg_store_pool&) = delete;
+
+  ~dyn_arg_store_pool()
+  {
+    // From now on, exiting threads will not hand back their cached objects.
+    scoped_lock lock(registry_mutex());
+    alive_pools().erase(id);
   }
 
   /// Returns a pointer to a free dyn arg store object, otherwise returns nullptr.
-  fmt::dynamic_format_arg_store<fmt::printf_context>* alloc()
+  store_type* alloc()
   {
-    scoped_lock lock(m);
-    if (free_list.empty()) {
-      return nullptr;
+    thread_cache& cache = get_thread_cache();
+    if (cache.nof_items == 0) {
+      cache.nof_items = pop_batch(cache.items);
+      if (cache.nof_items == 0) {
+        nof_failed_allocs.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+      }
     }
-
-    auto* p = free_list.back();
-    free_list.pop_back();
-
-    return p;
+    return &pool[cache.items[--cache.nof_items]];
   }
 
   /// Deallocate the given dyn arg store object returning it to the pool.
-  void dealloc(fmt::dynamic_format_arg_store<fmt::printf_context>* p)
+  void dealloc(store_type* p)
   {
     if (!p) {
       return;
     }
 
     p->clear();
-    scoped_lock lock(m);
-    free_list.push_back(p);
+    thread_cache& cache = get_thread_cache();
+    if (cache.nof_items == 2 * batch_size) {
+      // Keep the most recently used half in the cache.
+      push_batch(cache.items, batch_size);
+      std::copy(cache.items + batch_size, cache.items + 2 * batch_size, cache.items);
+      cache.nof_items = batch_size;
+    }
+    cache.items[cache.nof_items++] = static_cast<uint32_t>(p - pool.data());
+  }
+
+  /// Returns all the objects cached by the calling thread to the shared stack. Meant to be called by threads that
+  /// deallocate objects, but never allocate them, when they go idle.
+  void flush_thread_cache()
+  {
+    thread_cache& cache = get_thread_cache();
+    uint32_t      i     = 0;
+    for (; i + batch_size <= cache.nof_items; i += batch_size) {
+      push_batch(cache.items + i, batch_size);
+    }
+    push_batch(cache.items + i, cache.nof_items - i);
+    cache.nof_items = 0;
+  }
+
+  /// Number of allocations that failed because the pool was exhausted.
+  uint64_t get_nof_failed_allocs() const { return nof_failed_allocs.load(std::memory_order_relaxed); }
+
+private:
+  /// Returns the cache of the calling thread, after binding it to this pool.
+  thread_cache& get_thread_cache()
+  {
+    static thread_local thread_cache cache;
+    if (cache.pool_id != id) {
+      // The thread was previously used with another pool.
+      cache.return_to_pool();
+      cache.pool    = this;
+      cache.pool_id = id;
+    }
+    return cache;
+  }
+
+  /// Pushes the given objects as a new batch onto the shared stack.
+  void push_batch(const uint32_t* items, uint32_t nof_items)
+  {
+    if (nof_items == 0) {
+      return;
+    }
+    for (uint32_t i = 0; i + 1 < nof_items; ++i) {
+      next[items[i]].store(items[i + 1], std::memory_order_relaxed);
+    }
+    next[items[nof_items - 1]].store(null_idx, std::memory_order_relaxed);
+
+    uint64_t old_head = head.load(std::memory_order_relaxed);
+    uint64_t new_head;
+    do {
+      next_batch[items[0]].store(static_cast<uint32_t>(old_head), std::memory_order_relaxed);
+      // The upper half is a counter that protects the CAS against ABA.
+      new_head = ((old_head >> 32U) + 1) << 32U | items[0];
+    } while (!head.compare_exchange_weak(old_head, new_head, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  /// Pops a batch from the shared stack into items. Returns the number of objects obtained.
+  uint32_t pop_batch(uint32_t* items)
+  {
+    uint64_t old_head = head.load(std::memory_order_acquire);
+    uint64_t new_head;
+    uint32_t first;
+    do {
+      first = static_cast<uint32_t>(old_head);
+      if (first == null_idx) {
+        return 0;
+      }
+      new_head = ((old_head >> 32U) + 1) << 32U | next_batch[first].load(std::memory_order_relaxed);
+    } while (!head.compare_exchange_weak(old_head, new_head, std::memory_order_acquire, std::memory_order_acquire));
+
+    uint32_t n = 0;
+    for (uint32_t i = first; i != null_idx; i = next[i].load(std::memory_order_relaxed)) {
+      items[n++] = i;
+    }
+    return n;
+  }
+
+  static uint64_t new_pool_id()
+  {
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  /// Pools that are alive, so that exiting threads know whether they can hand back their cached objects.
+  static std::unordered_set<uint64_t>& alive_pools()
+  {
+    static std::unordered_set<uint64_t> pools;
+    return pools;
+  }
+  static mutex& registry_mutex()
+  {
+    static mutex m;
+    return m;
   }
 
 private:
-  std::vector<fmt::dynamic_format_arg_store<fmt::printf_context> > pool;
-  std::vector<fmt::dynamic_format_arg_store<fmt::printf_context>*> free_list;
-  mutable mutex                                                    m;
+  std::vector<store_type>             pool;
+  std::vector<std::atomic<uint32_t> > next;
+  std::vector<std::atomic<uint32_t> > next_batch;
+  std::atomic<uint64_t>               head{null_idx};
+  std::atomic<uint64_t>               nof_failed_allocs{0};
+  const uint64_t                      id;
 };
 
 } // namespace detail
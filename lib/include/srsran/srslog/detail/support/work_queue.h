@@ -22,23 +22,20 @@
 #ifndef SRSLOG_DETAIL_SUPPORT_WORK_QUEUE_H
 #define SRSLOG_DETAIL_SUPPORT_WORK_QUEUE_H
 
-#include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/mpsc_queue.h"
 #include "srsran/srslog/detail/support/backend_capacity.h"
-#include "srsran/srslog/detail/support/thread_utils.h"
 
 namespace srslog {
 
 namespace detail {
 
-//: TODO: this is a temp work queue.
-
-/// Thread safe generic data type work queue.
+/// Thread safe generic data type work queue. Any number of threads may push concurrently without taking locks, while
+/// only a single thread at a time may pop. Elements that do not fit in the queue are discarded.
 template <typename T, size_t capacity = SRSLOG_QUEUE_CAPACITY>
 class work_queue
 {
-  srsran::dyn_circular_buffer<T> queue;
-  mutable mutex                  m;
-  static constexpr size_t        threshold = capacity * 0.98;
+  srsran::dyn_mpsc_queue<T> queue;
+  static constexpr size_t   threshold = capacity * 0.98;
 
 public:
   work_queue() : queue(capacity) {}
@@ -50,64 +47,33 @@ public:
   /// queue is full, otherwise true.
   bool push(const T& value)
   {
-    m.lock();
     // Discard the new element if we reach the maximum capacity.
-    if (queue.full()) {
-      m.unlock();
-      return false;
-    }
-    queue.push(value);
-    m.unlock();
-
-    return true;
+    return queue.try_push(value);
   }
 
   /// Inserts a new element into the back of the queue. Returns false when the
-  /// queue is full, otherwise true.
+  /// queue is full, otherwise true. On failure, value is left untouched.
   bool push(T&& value)
   {
-    m.lock();
     // Discard the new element if we reach the maximum capacity.
-    if (queue.full()) {
-      m.unlock();
-      return false;
-    }
-    queue.push(std::move(value));
-    m.unlock();
-
-    return true;
+    return queue.try_push(std::move(value));
   }
 
   /// Extracts the top most element from the queue if it exists.
   /// Returns a pair with a bool indicating if the pop has been successful.
+  /// NOTE: Must not be called concurrently from more than one thread.
   std::pair<bool, T> try_pop()
   {
-    m.lock();
-
-    if (queue.empty()) {
-      m.unlock();
-      return {false, T()};
-    }
-
-    // Here we have been woken up normally.
-    T Item = std::move(queue.top());
-    queue.pop();
-
-    m.unlock();
-
-    return {true, std::move(Item)};
+    std::pair<bool, T> item{false, T()};
+    item.first = queue.try_pop(item.second);
+    return item;
   }
 
   /// Capacity of the queue.
   size_t get_capacity() const { return capacity; }
 
   /// Returns true when the queue is almost full, otherwise returns false.
-  bool is_almost_full() const
-  {
-    scoped_lock lock(m);
-
-    return queue.size() > threshold;
-  }
+  bool is_almost_full() const { return queue.size() > threshold; }
 };
 
 } // namespace detail
@@ -23,6 +23,7 @@
 #define SRSLOG_EVENT_TRACE_H
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 
 namespace srslog {
@@ -51,6 +52,35 @@ void event_trace_init(log_channel& c);
 /// Returns true on success, otherwise false.
 bool event_trace_init(const std::string& filename, std::size_t capacity = 1024 * 1024);
 
+/// File formats of the ring buffer event tracer.
+enum class event_trace_format {
+  /// Chrome trace event JSON format, for chrome://tracing.
+  chrome_json,
+  /// Perfetto protobuf trace format, for ui.perfetto.dev.
+  perfetto
+};
+
+/// Initializes the event trace framework in ring buffer mode, intended for
+/// tracing hot paths with low overhead.
+/// Each thread stores its events as fixed size records, timestamped with the
+/// CPU timestamp counter, in its own lock-free ring buffer of capacity bytes.
+/// A background thread drains the ring buffers into the specified file, and
+/// events are dropped while a ring buffer is full.
+/// Only the addresses of the category and name strings are recorded in this
+/// mode, hence events must be traced with string literals and the std::string
+/// overloads are ignored.
+/// Returns true on success, otherwise false.
+bool event_trace_init_ring(const std::string& filename,
+                           event_trace_format format,
+                           std::size_t        capacity = 1024 * 1024);
+
+/// Stops the ring buffer event tracer, writing the pending events and closing
+/// its file. Automatically called at program exit.
+void event_trace_stop();
+
+/// Returns the number of events dropped by the ring buffer event tracer.
+uint64_t event_trace_get_nof_dropped();
+
 #ifdef ENABLE_SRSLOG_EVENT_TRACE
 
 /// Generates the begin phase of a duration event.
@@ -59,6 +89,17 @@ void trace_duration_begin(const std::string& category, const std::string& name);
 /// Generates the end phase of a duration event.
 void trace_duration_end(const std::string& category, const std::string& name);
 
+/// Overloads of the duration events that are also recorded in ring buffer
+/// mode.
+void trace_duration_begin(const char* category, const char* name);
+void trace_duration_end(const char* category, const char* name);
+
+/// Generates an instant event.
+void trace_instant_event(const char* category, const char* name);
+
+/// Generates a counter event, which tracks the evolution of a value.
+void trace_counter_event(const char* category, const char* name, int64_t value);
+
 #define SRSLOG_TRACE_COMBINE1(X, Y) X##Y
 #define SRSLOG_TRACE_COMBINE(X, Y) SRSLOG_TRACE_COMBINE1(X, Y)
 
@@ -75,6 +116,8 @@ void trace_duration_end(const std::string& category, const std::string& name);
 /// No-ops.
 #define trace_duration_begin(C, N)
 #define trace_duration_end(C, N)
+#define trace_instant_event(C, N)
+#define trace_counter_event(C, N, V)
 #define trace_complete_event(C, N)
 #define trace_threshold_complete_event(C, N, T)
 
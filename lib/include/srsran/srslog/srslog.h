@@ -195,6 +195,12 @@ sink& fetch_file_sink(const std::string&             path,
                       bool                           force_flush = false,
                       std::unique_ptr<log_formatter> f           = get_default_log_formatter());
 
+/// Returns an instance of a sink that writes into a binary file in the
+/// specified path. Log entries are not formatted, their raw arguments are
+/// stored instead, and the file is rendered to text or JSON offline with the
+/// srslog_decode tool. The max_size argument behaves as in fetch_file_sink.
+sink& fetch_binary_file_sink(const std::string& path, size_t max_size = 0);
+
 /// Returns an instance of a sink that writes into syslog
 /// preamble: The string  prepended to every message, If ident is "", the program name is used.
 /// log_local: custom unused facilities that syslog provides which can be used by the user
@@ -254,6 +260,10 @@ void flush();
 /// NOTE: This function should be called before init() and is NOT thread safe.
 void set_error_handler(error_handler handler);
 
+/// Returns the number of log entries that have been discarded so far because
+/// the backend could not keep up with the producers.
+uint64_t get_nof_dropped_entries();
+
 } // namespace srslog
 
 #endif // SRSLOG_SRSLOG_H
@@ -31,6 +31,7 @@
 #define SRSRAN_BYTE_BUFFERQUEUE_H
 
 #include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/spsc_queue.h"
 #include "srsran/common/block_queue.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
@@ -125,6 +126,101 @@ public:
   dyn_blocking_queue<unique_byte_buffer_t, push_callback, pop_callback> queue;
 };
 
+/**
+ * Wait-free single-producer/single-consumer queue of byte buffers, with byte accounting.
+ * The producer (e.g. PDCP) pushes SDUs with try_write() without ever blocking, while the consumer (e.g. MAC reading
+ * RLC PDUs) pops them and may discard queued SDUs in-place. The byte and SDU counters can be read from any thread.
+ * Note: The number of bytes is incremented before the SDU becomes visible to the consumer, so that the counters may
+ * transiently overestimate the queue occupancy, but never underflow.
+ */
+class byte_buffer_spsc_queue
+{
+public:
+  explicit byte_buffer_spsc_queue(uint32_t capacity = 128) : queue(capacity) {}
+
+  // Producer interface
+  srsran::error_type<unique_byte_buffer_t> try_write(unique_byte_buffer_t&& msg)
+  {
+    uint32_t nof_bytes = msg->N_bytes;
+    unread_bytes.fetch_add(nof_bytes, std::memory_order_relaxed);
+    n_sdus.fetch_add(1, std::memory_order_relaxed);
+    if (not queue.try_push(std::move(msg))) {
+      unread_bytes.fetch_sub(nof_bytes, std::memory_order_relaxed);
+      n_sdus.fetch_sub(1, std::memory_order_relaxed);
+      return std::move(msg);
+    }
+    return {};
+  }
+
+  // Consumer interface
+  bool try_read(unique_byte_buffer_t* msg)
+  {
+    unique_byte_buffer_t* front = queue.front();
+    if (front == nullptr) {
+      return false;
+    }
+    *msg = std::move(*front);
+    queue.pop();
+    if (*msg != nullptr) {
+      unread_bytes.fetch_sub((*msg)->N_bytes, std::memory_order_relaxed);
+      n_sdus.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  /// Consumer: discards the first SDU for which "pred" returns true. The SDU slot is kept in the queue as a nullptr
+  template <typename Pred>
+  bool discard_first_if(const Pred& pred)
+  {
+    bool discarded = false;
+    queue.for_each([this, &pred, &discarded](unique_byte_buffer_t& sdu) {
+      if (not discarded and sdu != nullptr and pred(sdu)) {
+        unread_bytes.fetch_sub(sdu->N_bytes, std::memory_order_relaxed);
+        n_sdus.fetch_sub(1, std::memory_order_relaxed);
+        sdu.reset();
+        discarded = true;
+      }
+    });
+    return discarded;
+  }
+
+  /// Consumer: returns the size of the first non-discarded SDU in the queue
+  uint32_t size_tail_bytes()
+  {
+    unique_byte_buffer_t* front = queue.front();
+    return (front != nullptr and *front != nullptr) ? (*front)->N_bytes : 0;
+  }
+
+  /// Consumer: drops all SDUs in the queue
+  void clear()
+  {
+    unique_byte_buffer_t msg;
+    while (try_read(&msg)) {
+    }
+  }
+
+  /// Must not be called concurrently with the producer or consumer
+  void resize(uint32_t capacity)
+  {
+    clear();
+    queue.set_size(capacity);
+    unread_bytes.store(0, std::memory_order_relaxed);
+    n_sdus.store(0, std::memory_order_relaxed);
+  }
+
+  // Thread-safe getters
+  uint32_t size() const { return queue.size(); }
+  uint32_t get_n_sdus() const { return n_sdus.load(std::memory_order_relaxed); }
+  uint32_t size_bytes() const { return unread_bytes.load(std::memory_order_relaxed); }
+  bool     is_empty() const { return queue.empty(); }
+  bool     is_full() const { return queue.full(); }
+
+private:
+  dyn_spsc_queue<unique_byte_buffer_t> queue;
+  std::atomic<uint32_t>                unread_bytes = {0};
+  std::atomic<uint32_t>                n_sdus       = {0};
+};
+
 } // namespace srsran
 
 #endif // SRSRAN_BYTE_BUFFERQUEUE_H
@@ -0,0 +1,134 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PDCP_DISCARD_TIMER_QUEUE_H
+#define SRSRAN_PDCP_DISCARD_TIMER_QUEUE_H
+
+#include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/move_callback.h"
+#include "srsran/common/task_scheduler.h"
+#include <algorithm>
+
+namespace srsran {
+
+/**
+ * discardTimer of a PDCP bearer (TS 36.323/38.323, section 5.3).
+ * All SDUs of a bearer share the same discard timeout, so their expiries follow the order in which they were pushed.
+ * Instead of arming one timer per SDU, the pending SDUs are kept in an expiry-ordered ring and a single timer is
+ * armed for the oldest one. When it fires, all the expired SDUs are swept and the timer is re-armed for the new oldest
+ * SDU. SDUs that get delivered before expiring are not removed from the ring; the owner is expected to ignore their
+ * expiry notification (e.g. by comparing the expiry tic returned by push() with the one notified).
+ */
+class pdcp_discard_timer_queue
+{
+public:
+  /// Called for every expired SDU, with its COUNT/SN and the tic at which it expired
+  using expiry_callback_t = srsran::move_callback<void(uint32_t, uint32_t)>;
+
+  pdcp_discard_timer_queue(task_sched_handle task_sched, expiry_callback_t callback_, size_t initial_capacity) :
+    timer(task_sched.get_unique_timer()), callback(std::move(callback_)), pending(initial_capacity)
+  {
+    timer.set(1, [this](uint32_t tid) { handle_expiry(); });
+  }
+  pdcp_discard_timer_queue(const pdcp_discard_timer_queue&) = delete;
+  pdcp_discard_timer_queue(pdcp_discard_timer_queue&&)      = delete;
+  pdcp_discard_timer_queue& operator=(const pdcp_discard_timer_queue&) = delete;
+  pdcp_discard_timer_queue& operator=(pdcp_discard_timer_queue&&) = delete;
+
+  /// Starts the discard timeout of an SDU. Returns the tic at which the SDU will expire.
+  uint32_t push(uint32_t count, uint32_t timeout)
+  {
+    if (pending.full()) {
+      grow();
+    }
+    uint32_t cur_tic = now();
+    uint32_t expiry  = cur_tic + timeout;
+    pending.push(pending_sdu{count, expiry});
+    if (not timer.is_running()) {
+      clock = cur_tic;
+      arm(timeout, false);
+    }
+    return expiry;
+  }
+
+  /// Stops the timer and forgets all the pending SDUs
+  void clear()
+  {
+    timer.stop();
+    pending.clear();
+  }
+
+  /// Number of SDUs whose discard timeout has not elapsed yet
+  size_t size() const { return pending.size(); }
+  bool   empty() const { return pending.empty(); }
+
+  /// Bearer-local clock, in tics. Only advances while there are pending SDUs
+  uint32_t now() const { return timer.is_running() ? armed_expiry - (timer.duration() - timer.time_elapsed()) : clock; }
+
+private:
+  struct pending_sdu {
+    uint32_t count;
+    uint32_t expiry;
+  };
+
+  /// Arms the timer to fire in "duration" tics. The timer wheel only advances its clock after calling the expiry
+  /// callbacks of a tic, so a timer re-armed from its own callback needs one extra tic.
+  void arm(uint32_t duration, bool from_expiry)
+  {
+    armed_expiry = clock + duration;
+    timer.set(from_expiry ? duration + 1 : duration);
+    timer.run();
+  }
+
+  void handle_expiry()
+  {
+    clock = armed_expiry;
+    while (not pending.empty() and static_cast<int32_t>(pending.top().expiry - clock) <= 0) {
+      pending_sdu sdu = pending.top();
+      pending.pop();
+      callback(sdu.count, sdu.expiry);
+    }
+    if (not pending.empty()) {
+      arm(pending.top().expiry - clock, true);
+    }
+  }
+
+  /// Doubles the ring capacity. Only happens when the number of pending SDUs exceeds the previous maximum
+  void grow()
+  {
+    dyn_circular_buffer<pending_sdu> tmp(std::max(pending.max_size() * 2, static_cast<size_t>(1)));
+    while (not pending.empty()) {
+      tmp.push(pending.top());
+      pending.pop();
+    }
+    pending = std::move(tmp);
+  }
+
+  unique_timer                     timer;
+  expiry_callback_t                callback;
+  dyn_circular_buffer<pending_sdu> pending;
+  uint32_t                         clock        = 0; ///< Bearer-local tic at which the timer was last armed/expired
+  uint32_t                         armed_expiry = 0; ///< Bearer-local tic at which the running timer expires
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PDCP_DISCARD_TIMER_QUEUE_H
@@ -28,6 +28,7 @@
 #include "srsran/common/security.h"
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/upper/pdcp_discard_timer_queue.h"
 #include "srsran/upper/pdcp_entity_base.h"
 
 namespace srsue {
@@ -42,7 +43,7 @@ namespace srsran {
 class undelivered_sdus_queue
 {
 public:
-  explicit undelivered_sdus_queue(srsran::task_sched_handle task_sched);
+  undelivered_sdus_queue(srsran::task_sched_handle task_sched, srsran::move_callback<void(uint32_t)> discard_callback);
 
   bool            empty() const { return count == 0; }
   bool            is_full() const { return count >= capacity; }
@@ -56,10 +57,7 @@ public:
   // Getter for the number of discard timers. Used for debugging.
   size_t nof_discard_timers() const;
 
-  bool add_sdu(uint32_t                              sn,
-               const srsran::unique_byte_buffer_t&   sdu,
-               uint32_t                              discard_timeout,
-               srsran::move_callback<void(uint32_t)> callback);
+  bool add_sdu(uint32_t sn, const srsran::unique_byte_buffer_t& sdu, uint32_t discard_timeout);
 
   unique_byte_buffer_t& operator[](uint32_t sn)
   {
@@ -85,9 +83,12 @@ private:
 
   static uint32_t increment_sn(uint32_t sn) { return (sn + 1) % capacity; }
 
+  void handle_discard_timeout(uint32_t sn, uint32_t expiry);
+
   struct sdu_data {
     srsran::unique_byte_buffer_t sdu;
-    srsran::unique_timer         discard_timer;
+    bool                         discard_armed  = false;
+    uint32_t                     discard_expiry = 0; ///< Tic of the discard timer at which the SDU expires
   };
 
   uint32_t                                   count = 0;
@@ -95,6 +96,10 @@ private:
   uint32_t                                   fms   = 0; // SN of the first missing PDCP SDU
   uint32_t                                   lms   = 0;
   srsran::circular_array<sdu_data, capacity> sdus;
+
+  // discardTimer shared by all SDUs of the bearer
+  srsran::move_callback<void(uint32_t)> discard_fnc;
+  srsran::pdcp_discard_timer_queue      discard_timers;
 };
 
 /****************************************************************************
@@ -205,16 +210,11 @@ private:
 class pdcp_entity_lte::discard_callback
 {
 public:
-  discard_callback(pdcp_entity_lte* parent_, uint32_t sn_)
-  {
-    parent     = parent_;
-    discard_sn = sn_;
-  };
-  void operator()(uint32_t timer_id);
+  discard_callback(pdcp_entity_lte* parent_) { parent = parent_; };
+  void operator()(uint32_t discard_sn);
 
 private:
   pdcp_entity_lte* parent;
-  uint32_t         discard_sn;
 };
 
 } // namespace srsran
@@ -32,6 +32,7 @@
 #include "srsran/interfaces/ue_gw_interfaces.h"
 #include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/interfaces/ue_rlc_interfaces.h"
+#include "srsran/upper/pdcp_discard_timer_queue.h"
 #include <map>
 
 namespace srsran {
@@ -78,7 +79,7 @@ public:
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus() override { return {}; }
 
   // State variable getters (useful for testing)
-  uint32_t nof_discard_timers() { return discard_timers_map.size(); }
+  uint32_t nof_discard_timers() { return discard_timers != nullptr ? discard_timers->size() : 0; }
 
 private:
   srsue::rlc_interface_pdcp* rlc = nullptr;
@@ -95,8 +96,23 @@ private:
   uint32_t window_size = 0;
 
   // Reordering Queue / Timers
-  std::map<uint32_t, unique_byte_buffer_t> reorder_queue;
-  timer_handler::unique_timer              reordering_timer;
+  // The reception window only spans window_size COUNTs starting from RX_DELIV, so the PDUs waiting for reordering
+  // are stored in a ring indexed by COUNT. The ring starts small and doubles, up to window_size, whenever a PDU falls
+  // beyond the COUNTs it can hold.
+  struct reorder_pdu {
+    uint32_t             count = 0;
+    unique_byte_buffer_t pdu;
+  };
+  std::vector<reorder_pdu>    reorder_queue;
+  timer_handler::unique_timer reordering_timer;
+
+  void         grow_reorder_queue(uint32_t count);
+  reorder_pdu& reorder_slot(uint32_t count) { return reorder_queue[count % reorder_queue.size()]; }
+  bool         has_reorder_pdu(uint32_t count)
+  {
+    const reorder_pdu& slot = reorder_slot(count);
+    return slot.pdu != nullptr and slot.count == count;
+  }
 
   // Pass to Upper Layers Helper function
   void deliver_all_consecutive_counts();
@@ -108,7 +124,7 @@ private:
 
   // Discard callback (discardTimer)
   class discard_callback;
-  std::map<uint32_t, timer_handler::unique_timer> discard_timers_map;
+  std::unique_ptr<pdcp_discard_timer_queue> discard_timers;
 
   // COUNT overflow protection
   bool tx_overflow = false;
@@ -133,16 +149,11 @@ private:
 class pdcp_entity_nr::discard_callback
 {
 public:
-  discard_callback(pdcp_entity_nr* parent_, uint32_t sn_)
-  {
-    parent     = parent_;
-    discard_sn = sn_;
-  };
-  void operator()(uint32_t timer_id);
+  discard_callback(pdcp_entity_nr* parent_) { parent = parent_; };
+  void operator()(uint32_t discard_sn, uint32_t expiry);
 
 private:
   pdcp_entity_nr* parent;
-  uint32_t        discard_sn;
 };
 
 /*
@@ -0,0 +1,432 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/kpi_stream.h"
+#include <cstring>
+
+namespace srsran {
+namespace kpi_stream {
+
+namespace {
+
+const char     magic[]            = {'S', 'R', 'S', 'K', 'P', 'I'};
+const size_t   file_header_len    = sizeof(magic) + 2;
+const size_t   record_header_len  = 5;
+const uint8_t  record_type_schema = 1;
+const uint8_t  record_type_block  = 2;
+const uint32_t max_record_len     = 64 * 1024 * 1024;
+
+uint64_t zigzag_encode(int64_t v)
+{
+  return ((uint64_t)v << 1U) ^ (uint64_t)(v >> 63);
+}
+
+int64_t zigzag_decode(uint64_t v)
+{
+  return (int64_t)(v >> 1U) ^ -(int64_t)(v & 1U);
+}
+
+void put_varint(std::vector<uint8_t>& buf, uint64_t v)
+{
+  while (v >= 0x80) {
+    buf.push_back((uint8_t)(v | 0x80U));
+    v >>= 7U;
+  }
+  buf.push_back((uint8_t)v);
+}
+
+void put_string(std::vector<uint8_t>& buf, const std::string& s)
+{
+  put_varint(buf, s.size());
+  buf.insert(buf.end(), s.begin(), s.end());
+}
+
+void put_float(std::vector<uint8_t>& buf, float f)
+{
+  uint32_t v;
+  memcpy(&v, &f, sizeof(v));
+  for (uint32_t i = 0; i < 4; ++i) {
+    buf.push_back((uint8_t)(v >> (8 * i)));
+  }
+}
+
+/// Bounds-checked decoding of a record payload
+class record_parser
+{
+public:
+  record_parser(const uint8_t* data_, size_t len_) : data(data_), len(len_) {}
+
+  bool varint(uint64_t& v)
+  {
+    v = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+      if (pos >= len) {
+        return false;
+      }
+      uint8_t b = data[pos++];
+      v |= (uint64_t)(b & 0x7fU) << shift;
+      if ((b & 0x80U) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+  bool svarint(int64_t& v)
+  {
+    uint64_t u;
+    if (not varint(u)) {
+      return false;
+    }
+    v = zigzag_decode(u);
+    return true;
+  }
+  bool u8(uint8_t& v)
+  {
+    if (pos >= len) {
+      return false;
+    }
+    v = data[pos++];
+    return true;
+  }
+  bool f32(float& f)
+  {
+    if (len - pos < 4) {
+      return false;
+    }
+    uint32_t v = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+      v |= (uint32_t)data[pos++] << (8 * i);
+    }
+    memcpy(&f, &v, sizeof(f));
+    return true;
+  }
+  bool string(std::string& s)
+  {
+    uint64_t n;
+    if (not varint(n) or n > len - pos) {
+      return false;
+    }
+    s.assign((const char*)data + pos, n);
+    pos += n;
+    return true;
+  }
+
+private:
+  const uint8_t* data;
+  size_t         len;
+  size_t         pos = 0;
+};
+
+} // namespace
+
+/******************
+ *     Writer
+ *****************/
+
+bool writer::open(const std::string& filename)
+{
+  close();
+  file = fopen(filename.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  // Blocks are written in a single call, and the file buffer only batches the small ones
+  setvbuf(file, nullptr, _IOFBF, 256 * 1024);
+  uint8_t hdr[file_header_len] = {};
+  memcpy(hdr, magic, sizeof(magic));
+  hdr[sizeof(magic)] = kpi_stream_version;
+  fwrite(hdr, 1, sizeof(hdr), file);
+  nof_bytes = sizeof(hdr);
+  groups.clear();
+  return true;
+}
+
+void writer::close()
+{
+  if (file != nullptr) {
+    fclose(file);
+    file = nullptr;
+  }
+}
+
+void writer::flush()
+{
+  if (file != nullptr) {
+    fflush(file);
+  }
+}
+
+void writer::write_record(uint8_t type)
+{
+  uint8_t  hdr[record_header_len];
+  uint32_t len = buffer.size();
+  hdr[0]       = type;
+  for (uint32_t i = 0; i < 4; ++i) {
+    hdr[1 + i] = (uint8_t)(len >> (8 * i));
+  }
+  if (file != nullptr) {
+    fwrite(hdr, 1, sizeof(hdr), file);
+    fwrite(buffer.data(), 1, buffer.size(), file);
+  }
+  nof_bytes += sizeof(hdr) + buffer.size();
+}
+
+uint32_t writer::add_group(const group_schema_t& schema)
+{
+  uint32_t group_id = groups.size();
+  groups.emplace_back();
+  groups.back().schema = schema;
+
+  buffer.clear();
+  put_varint(buffer, group_id);
+  put_string(buffer, schema.name);
+  put_string(buffer, schema.key_name);
+  put_varint(buffer, schema.columns.size());
+  for (const column_t& col : schema.columns) {
+    buffer.push_back((uint8_t)col.kind);
+    put_string(buffer, col.name);
+  }
+  write_record(record_type_schema);
+  return group_id;
+}
+
+void writer::begin_block(uint32_t group_id, uint64_t timestamp_us)
+{
+  cur_group        = group_id;
+  cur_timestamp_us = timestamp_us;
+  cur_keys.clear();
+  cur_counters.clear();
+  cur_gauges.clear();
+}
+
+void writer::add_row(uint32_t key)
+{
+  size_t nof_columns = groups[cur_group].schema.columns.size();
+  cur_keys.push_back(key);
+  cur_counters.resize(cur_counters.size() + nof_columns, 0);
+  cur_gauges.resize(cur_gauges.size() + nof_columns, 0);
+}
+
+void writer::set_counter(uint32_t column, int64_t value)
+{
+  size_t nof_columns = groups[cur_group].schema.columns.size();
+  cur_counters[(cur_keys.size() - 1) * nof_columns + column] = value;
+}
+
+void writer::set_gauge(uint32_t column, float value)
+{
+  size_t nof_columns = groups[cur_group].schema.columns.size();
+  cur_gauges[(cur_keys.size() - 1) * nof_columns + column] = value;
+}
+
+void writer::end_block()
+{
+  group_ctxt_t&                group       = groups[cur_group];
+  const std::vector<column_t>& columns     = group.schema.columns;
+  size_t                       nof_columns = columns.size();
+
+  buffer.clear();
+  put_varint(buffer, cur_group);
+  put_varint(buffer, zigzag_encode((int64_t)(cur_timestamp_us - group.last_timestamp_us)));
+  put_varint(buffer, cur_keys.size());
+  uint32_t prev_key = 0;
+  for (uint32_t key : cur_keys) {
+    put_varint(buffer, zigzag_encode((int64_t)key - (int64_t)prev_key));
+    prev_key = key;
+  }
+
+  // Counter state of the keys of this block
+  std::vector<std::vector<int64_t>*> last(cur_keys.size());
+  for (size_t row = 0; row < cur_keys.size(); ++row) {
+    std::vector<int64_t>& v = group.last_counters[cur_keys[row]];
+    v.resize(nof_columns, 0);
+    last[row] = &v;
+  }
+
+  for (size_t col = 0; col < nof_columns; ++col) {
+    if (columns[col].kind == column_kind_t::counter) {
+      for (size_t row = 0; row < cur_keys.size(); ++row) {
+        int64_t value = cur_counters[row * nof_columns + col];
+        put_varint(buffer, zigzag_encode(value - (*last[row])[col]));
+        (*last[row])[col] = value;
+      }
+    } else {
+      for (size_t row = 0; row < cur_keys.size(); ++row) {
+        put_float(buffer, cur_gauges[row * nof_columns + col]);
+      }
+    }
+  }
+  group.last_timestamp_us = cur_timestamp_us;
+  write_record(record_type_block);
+}
+
+/******************
+ *     Reader
+ *****************/
+
+bool reader::open(const std::string& filename)
+{
+  close();
+  error = false;
+  groups.clear();
+  file = fopen(filename.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  uint8_t hdr[file_header_len];
+  if (fread(hdr, 1, sizeof(hdr), file) != sizeof(hdr) or memcmp(hdr, magic, sizeof(magic)) != 0 or
+      hdr[sizeof(magic)] != kpi_stream_version) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void reader::close()
+{
+  if (file != nullptr) {
+    fclose(file);
+    file = nullptr;
+  }
+}
+
+bool reader::read_block(block_t& block)
+{
+  while (file != nullptr and not error) {
+    uint8_t hdr[record_header_len];
+    size_t  n = fread(hdr, 1, sizeof(hdr), file);
+    if (n == 0) {
+      return false;
+    }
+    uint32_t len = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+      len |= (uint32_t)hdr[1 + i] << (8 * i);
+    }
+    if (n != sizeof(hdr) or len > max_record_len) {
+      error = true;
+      return false;
+    }
+    buffer.resize(len);
+    if (fread(buffer.data(), 1, len, file) != len) {
+      // Truncated record, e.g. the stream is still being written
+      error = true;
+      return false;
+    }
+    switch (hdr[0]) {
+      case record_type_schema:
+        error = not parse_schema(buffer.data(), len);
+        break;
+      case record_type_block:
+        if (parse_block(buffer.data(), len, block)) {
+          return true;
+        }
+        error = true;
+        break;
+      default:
+        // Unknown records are skipped, for forward compatibility
+        break;
+    }
+  }
+  return false;
+}
+
+bool reader::parse_schema(const uint8_t* data, size_t len)
+{
+  record_parser  p(data, len);
+  uint64_t       group_id, nof_columns;
+  group_schema_t schema;
+  if (not p.varint(group_id) or group_id != groups.size() or not p.string(schema.name) or
+      not p.string(schema.key_name) or not p.varint(nof_columns) or nof_columns > len) {
+    return false;
+  }
+  schema.columns.resize(nof_columns);
+  for (column_t& col : schema.columns) {
+    uint8_t kind;
+    if (not p.u8(kind) or kind > (uint8_t)column_kind_t::gauge or not p.string(col.name)) {
+      return false;
+    }
+    col.kind = (column_kind_t)kind;
+  }
+  groups.emplace_back();
+  groups.back().schema = std::move(schema);
+  return true;
+}
+
+bool reader::parse_block(const uint8_t* data, size_t len, block_t& block)
+{
+  record_parser p(data, len);
+  uint64_t      group_id, nof_rows;
+  int64_t       ts_delta;
+  if (not p.varint(group_id) or group_id >= groups.size() or not p.svarint(ts_delta) or not p.varint(nof_rows) or
+      nof_rows > len) {
+    return false;
+  }
+  group_ctxt_t&                group       = groups[group_id];
+  const std::vector<column_t>& columns     = group.schema.columns;
+  size_t                       nof_columns = columns.size();
+
+  block.group_id          = group_id;
+  group.last_timestamp_us = group.last_timestamp_us + ts_delta;
+  block.timestamp_us      = group.last_timestamp_us;
+  block.keys.resize(nof_rows);
+  int64_t prev_key = 0;
+  for (uint32_t& key : block.keys) {
+    int64_t delta;
+    if (not p.svarint(delta)) {
+      return false;
+    }
+    prev_key += delta;
+    key = (uint32_t)prev_key;
+  }
+
+  std::vector<std::vector<int64_t>*> last(nof_rows);
+  for (size_t row = 0; row < nof_rows; ++row) {
+    std::vector<int64_t>& v = group.last_counters[block.keys[row]];
+    v.resize(nof_columns, 0);
+    last[row] = &v;
+  }
+
+  block.values.resize(nof_columns);
+  for (size_t col = 0; col < nof_columns; ++col) {
+    std::vector<double>& values = block.values[col];
+    values.resize(nof_rows);
+    for (size_t row = 0; row < nof_rows; ++row) {
+      if (columns[col].kind == column_kind_t::counter) {
+        int64_t delta;
+        if (not p.svarint(delta)) {
+          return false;
+        }
+        (*last[row])[col] += delta;
+        values[row] = (double)(*last[row])[col];
+      } else {
+        float f;
+        if (not p.f32(f)) {
+          return false;
+        }
+        values[row] = f;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace kpi_stream
+} // namespace srsran
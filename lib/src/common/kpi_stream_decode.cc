@@ -0,0 +1,97 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/// Converts the KPI streams written by srsran::kpi_stream::writer to CSV, with one line per row and report.
+
+#include "srsran/common/kpi_stream.h"
+#include <cstring>
+#include <inttypes.h>
+
+using namespace srsran::kpi_stream;
+
+static void usage(const char* prog)
+{
+  fprintf(stderr,
+          "Usage: %s [-g group] file\n"
+          "\t-g Only print the rows of the given group. Otherwise, the header of each group is printed before its "
+          "first row\n",
+          prog);
+}
+
+int main(int argc, char** argv)
+{
+  const char* group_filter = nullptr;
+  const char* path         = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-g") == 0 and i + 1 < argc) {
+      group_filter = argv[++i];
+    } else if (argv[i][0] != '-' and path == nullptr) {
+      path = argv[i];
+    } else {
+      usage(argv[0]);
+      return -1;
+    }
+  }
+  if (path == nullptr) {
+    usage(argv[0]);
+    return -1;
+  }
+
+  reader r;
+  if (not r.open(path)) {
+    fprintf(stderr, "Unable to open \"%s\", or it is not a KPI stream\n", path);
+    return -1;
+  }
+
+  std::vector<bool> header_printed;
+  block_t           block;
+  while (r.read_block(block)) {
+    const group_schema_t& schema = r.get_schema(block.group_id);
+    if (group_filter != nullptr and schema.name != group_filter) {
+      continue;
+    }
+    header_printed.resize(r.nof_groups(), false);
+    if (not header_printed[block.group_id]) {
+      printf("group;timestamp_us;%s", schema.key_name.c_str());
+      for (const column_t& col : schema.columns) {
+        printf(";%s", col.name.c_str());
+      }
+      printf("\n");
+      header_printed[block.group_id] = true;
+    }
+    for (size_t row = 0; row < block.keys.size(); ++row) {
+      printf("%s;%" PRIu64 ";%u", schema.name.c_str(), block.timestamp_us, block.keys[row]);
+      for (size_t col = 0; col < schema.columns.size(); ++col) {
+        if (schema.columns[col].kind == column_kind_t::counter) {
+          printf(";%" PRId64, (int64_t)block.values[col][row]);
+        } else {
+          printf(";%g", block.values[col][row]);
+        }
+      }
+      printf("\n");
+    }
+  }
+  if (r.has_error()) {
+    fprintf(stderr, "Error decoding \"%s\": malformed or truncated record\n", path);
+    return -1;
+  }
+  return 0;
+}
@@ -24,25 +24,25 @@
 #include "srsran/common/threads.h"
 
 namespace srsran {
-mac_pcap::mac_pcap() : mac_pcap_base() {}
+mac_pcap::mac_pcap() : mac_pcap_base(), writer("PCAP_WRITER_MAC") {}
 
 mac_pcap::~mac_pcap()
 {
   close();
 }
 
-uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_)
+uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_, const pcap_writer_args_t& args)
 {
   std::lock_guard<std::mutex> lock(mutex);
-  if (pcap_file != nullptr) {
+  if (writer.is_open()) {
     logger.error("PCAP writer for %s already running. Close first.", filename_.c_str());
     return SRSRAN_ERROR;
   }
 
   // set UDP DLT
-  dlt       = UDP_DLT;
-  pcap_file = DLT_PCAP_Open(dlt, filename_.c_str());
-  if (pcap_file == nullptr) {
+  dlt = UDP_DLT;
+  if (writer.open(filename_, {{dlt, "mac-lte"}, {dlt, "mac-nr"}}, ring_slot_size, default_ring_size, args) !=
+      SRSRAN_SUCCESS) {
     logger.error("Couldn't open %s to write PCAP", filename_.c_str());
     return SRSRAN_ERROR;
   }
@@ -51,53 +51,46 @@ uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_)
   ue_id    = ue_id_;
   running  = true;
 
-  // start writer thread
-  start();
-
   return SRSRAN_SUCCESS;
 }
 
 uint32_t mac_pcap::close()
 {
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    if (running == false || pcap_file == nullptr) {
-      return SRSRAN_ERROR;
-    }
-
-    // tell writer thread to stop
-    running        = false;
-    pcap_pdu_t pdu = {};
-    queue.push_blocking(std::move(pdu));
+  std::lock_guard<std::mutex> lock(mutex);
+  if (running == false || not writer.is_open()) {
+    return SRSRAN_ERROR;
   }
 
-  wait_thread_finish();
-
-  // close file handle
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    srsran::console("Saving MAC PCAP (DLT=%d) to %s\n", dlt, filename.c_str());
-    DLT_PCAP_Close(pcap_file);
-    pcap_file = nullptr;
-  }
+  // stop the writer thread and close the file once the capture ring is flushed
+  running = false;
+  writer.close();
+  srsran::console("Saving MAC PCAP (DLT=%d) to %s\n", dlt, filename.c_str());
 
   return SRSRAN_SUCCESS;
 }
 
-void mac_pcap::write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu)
+bool mac_pcap::queue_pdu(pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len)
 {
-  if (pdu.pdu != nullptr) {
-    switch (pdu.rat) {
-      case srsran_rat_t::lte:
-        LTE_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context, pdu.pdu->msg, pdu.pdu->N_bytes);
-        break;
-      case srsran_rat_t::nr:
-        NR_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context_nr, pdu.pdu->msg, pdu.pdu->N_bytes);
-        break;
-      default:
-        logger.error("Error writing PDU to PCAP. Unsupported RAT selected.");
-    }
+  uint8_t context_header[PCAP_CONTEXT_HEADER_MAX] = {};
+  switch (pdu.rat) {
+    case srsran_rat_t::lte:
+      return writer.write(lte_if_id,
+                          context_header,
+                          LTE_PCAP_PACK_MAC_UDP_CONTEXT_TO_BUFFER(
+                              &pdu.context, context_header, PCAP_CONTEXT_HEADER_MAX, payload_len),
+                          payload,
+                          payload_len);
+    case srsran_rat_t::nr:
+      return writer.write(nr_if_id,
+                          context_header,
+                          NR_PCAP_PACK_MAC_UDP_CONTEXT_TO_BUFFER(
+                              &pdu.context_nr, context_header, PCAP_CONTEXT_HEADER_MAX, payload_len),
+                          payload,
+                          payload_len);
+    default:
+      logger.error("Error writing PDU to PCAP. Unsupported RAT selected.");
   }
+  return true;
 }
 
-} // namespace srsran
\ No newline at end of file
+} // namespace srsran
@@ -20,10 +20,11 @@
  */
 
 #include "srsran/common/mac_pcap_net.h"
+#include <thread>
 
 namespace srsran {
 
-mac_pcap_net::mac_pcap_net() : mac_pcap_base() {}
+mac_pcap_net::mac_pcap_net() : mac_pcap_base(), thread("PCAP_WRITER_NET") {}
 
 mac_pcap_net::~mac_pcap_net()
 {
@@ -63,8 +64,9 @@ uint32_t mac_pcap_net::open(std::string client_ip_addr_,
     logger.error("Invalid client_ip_addr: %s", client_ip_addr_.c_str());
     return SRSRAN_ERROR;
   }
-  running                     = true;
-  ue_id                       = ue_id_;
+  ring.resize(default_ring_size, ring_slot_size);
+  running = true;
+  ue_id   = ue_id_;
   // start writer thread
   start();
 
@@ -80,9 +82,7 @@ uint32_t mac_pcap_net::close()
     }
 
     // tell writer thread to stop
-    running        = false;
-    pcap_pdu_t pdu = {};
-    queue.push_blocking(std::move(pdu));
+    running = false;
   }
 
   wait_thread_finish();
@@ -95,25 +95,9 @@ uint32_t mac_pcap_net::close()
   return SRSRAN_SUCCESS;
 }
 
-void mac_pcap_net::write_pdu(pcap_pdu_t& pdu)
+// Function called from PHY worker context, locking not needed as the capture ring is thread-safe
+bool mac_pcap_net::queue_pdu(pcap_pdu_t& pdu, const uint8_t* payload, uint32_t payload_len)
 {
-  if (pdu.pdu != nullptr && socket.is_open()) {
-    switch (pdu.rat) {
-      case srsran_rat_t::lte:
-        write_mac_lte_pdu_to_net(pdu);
-        break;
-      case srsran_rat_t::nr:
-        write_mac_nr_pdu_to_net(pdu);
-        break;
-      default:
-        logger.error("Error writing PDU to PCAP socket. Unsupported RAT selected.");
-    }
-  }
-}
-
-void mac_pcap_net::write_mac_lte_pdu_to_net(pcap_pdu_t& pdu)
-{
-  int      bytes_sent;
   uint32_t offset = 0;
   uint8_t  buffer[PCAP_CONTEXT_HEADER_MAX];
 
@@ -121,61 +105,62 @@ void mac_pcap_net::write_mac_lte_pdu_to_net(pcap_pdu_t& pdu)
   memcpy(buffer + offset, MAC_LTE_START_STRING, strlen(MAC_LTE_START_STRING));
   offset += strlen(MAC_LTE_START_STRING);
 
-  offset += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
-
-  if (pdu.pdu.get()->get_headroom() < offset) {
-    logger.error("PDU headroom is to small for adding context buffer");
-    return;
+  switch (pdu.rat) {
+    case srsran_rat_t::lte:
+      offset += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
+      break;
+    case srsran_rat_t::nr:
+      offset += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context_nr, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
+      break;
+    default:
+      logger.error("Error writing PDU to PCAP socket. Unsupported RAT selected.");
+      return true;
   }
+  return ring.try_push(0, buffer, offset, payload, payload_len);
+}
 
-  pdu.pdu.get()->msg -= offset;
-  memcpy(pdu.pdu.get()->msg, buffer, offset);
-  pdu.pdu.get()->N_bytes += offset;
-
-  bytes_sent = sendto(socket.get_socket(),
-                      pdu.pdu.get()->msg,
-                      pdu.pdu.get()->N_bytes,
-                      0,
-                      (const struct sockaddr*)&client_addr,
-                      sizeof(client_addr));
+void mac_pcap_net::run_thread()
+{
+  while (running) {
+    if (not send_batch()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
 
-  if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
-    logger.error(
-        "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
+  // send remainder of the ring
+  while (send_batch()) {
   }
 }
 
-void mac_pcap_net::write_mac_nr_pdu_to_net(pcap_pdu_t& pdu)
+bool mac_pcap_net::send_batch()
 {
-  int      bytes_sent;
-  uint32_t offset = 0;
-  uint8_t  buffer[PCAP_CONTEXT_HEADER_MAX];
-
-  // MAC_LTE_START_STRING for UDP heuristics
-  memcpy(buffer + offset, MAC_LTE_START_STRING, strlen(MAC_LTE_START_STRING));
-  offset += strlen(MAC_LTE_START_STRING);
-
-  offset += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context_nr, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
-
-  if (pdu.pdu.get()->get_headroom() < offset) {
-    logger.error("PDU headroom is to small for adding context buffer");
-    return;
+  pcap_capture_ring::record_t records[max_batch_size];
+  size_t                      nof_records = ring.peek(records, max_batch_size);
+  if (nof_records == 0) {
+    return false;
   }
 
-  pdu.pdu.get()->msg -= offset;
-  memcpy(pdu.pdu.get()->msg, buffer, offset);
-  pdu.pdu.get()->N_bytes += offset;
-
-  bytes_sent = sendto(socket.get_socket(),
-                      pdu.pdu.get()->msg,
-                      pdu.pdu.get()->N_bytes,
-                      0,
-                      (const struct sockaddr*)&client_addr,
-                      sizeof(client_addr));
+  struct iovec   iov[max_batch_size];
+  struct mmsghdr msgs[max_batch_size] = {};
+  for (size_t i = 0; i < nof_records; ++i) {
+    iov[i]                      = {const_cast<uint8_t*>(records[i].data), records[i].len};
+    msgs[i].msg_hdr.msg_iov     = &iov[i];
+    msgs[i].msg_hdr.msg_iovlen  = 1;
+    msgs[i].msg_hdr.msg_name    = &client_addr;
+    msgs[i].msg_hdr.msg_namelen = sizeof(client_addr);
+  }
 
-  if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
-    logger.error(
-        "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
+  // A failed datagram is reported and skipped, so that the ring keeps draining
+  for (size_t sent = 0; sent < nof_records;) {
+    int n = sendmmsg(socket.get_socket(), &msgs[sent], nof_records - sent, 0);
+    if (n <= 0) {
+      logger.error("Sending UDP packet of %d B failed (err %s)", records[sent].len, strerror(errno));
+      n = 1;
+    }
+    sent += n;
   }
+  ring.release(nof_records);
+  return true;
 }
-} // namespace srsran
\ No newline at end of file
+
+} // namespace srsran
@@ -31,15 +31,17 @@ void nas_pcap::enable()
   enable_write = true;
 }
 
-uint32_t nas_pcap::open(std::string filename_, uint32_t ue_id_, srsran_rat_t rat_type)
+uint32_t nas_pcap::open(std::string filename_, uint32_t ue_id_, srsran_rat_t rat_type, const pcap_writer_args_t& args)
 {
   filename = filename_;
+  pcap_interface_t iface;
   if (rat_type == srsran_rat_t::nr) {
-    pcap_file = DLT_PCAP_Open(NAS_5G_DLT, filename.c_str());
+    iface = {NAS_5G_DLT, "nas-5gs"};
   } else {
-    pcap_file = DLT_PCAP_Open(NAS_LTE_DLT, filename.c_str());
+    iface = {NAS_LTE_DLT, "nas-eps"};
   }
-  if (pcap_file == nullptr) {
+  dlt = iface.dlt;
+  if (writer.open(filename, {iface}, ring_slot_size, default_ring_size, args) != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   ue_id        = ue_id_;
@@ -49,16 +51,18 @@ uint32_t nas_pcap::open(std::string filename_, uint32_t ue_id_, srsran_rat_t rat
 
 void nas_pcap::close()
 {
-  fprintf(stdout, "Saving NAS PCAP file (DLT=%d) to %s \n", NAS_LTE_DLT, filename.c_str());
-  DLT_PCAP_Close(pcap_file);
+  if (not writer.is_open()) {
+    return;
+  }
+  writer.close();
+  fprintf(stdout, "Saving NAS PCAP file (DLT=%d) to %s \n", dlt, filename.c_str());
 }
 
 void nas_pcap::write_nas(uint8_t* pdu, uint32_t pdu_len_bytes)
 {
   if (enable_write) {
-    NAS_Context_Info_t context;
     if (pdu) {
-      LTE_PCAP_NAS_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
+      writer.write(0, nullptr, 0, pdu, pdu_len_bytes);
     }
   }
 }
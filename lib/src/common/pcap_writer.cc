@@ -0,0 +1,367 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pcap_writer.h"
+#include "srsran/common/pcap.h"
+#include "srsran/config.h"
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <string.h>
+#include <thread>
+#include <unistd.h>
+
+namespace srsran {
+
+namespace {
+
+// pcapng block types and options
+const uint32_t pcapng_shb_type       = 0x0A0D0D0A;
+const uint32_t pcapng_idb_type       = 0x00000001;
+const uint32_t pcapng_epb_type       = 0x00000006;
+const uint32_t pcapng_byte_order     = 0x1A2B3C4D;
+const uint16_t pcapng_opt_end        = 0;
+const uint16_t pcapng_opt_if_name    = 2;
+const uint16_t pcapng_opt_if_tsresol = 9;
+
+/// Size of the fixed part of an Enhanced Packet Block, including the trailing block length
+const uint32_t pcapng_epb_overhead = 32;
+
+/// Time the writer thread waits for new records when the ring is empty
+const std::chrono::milliseconds pcap_idle_period{1};
+
+uint32_t pad4(uint32_t len)
+{
+  return (4 - (len % 4)) % 4;
+}
+
+template <typename T>
+void put(std::vector<uint8_t>& buffer, T value)
+{
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(&value);
+  buffer.insert(buffer.end(), ptr, ptr + sizeof(T));
+}
+
+void put_option(std::vector<uint8_t>& buffer, uint16_t code, const void* value, uint16_t len)
+{
+  put(buffer, code);
+  put(buffer, len);
+  const uint8_t* ptr = static_cast<const uint8_t*>(value);
+  buffer.insert(buffer.end(), ptr, ptr + len);
+  buffer.insert(buffer.end(), pad4(len), 0);
+}
+
+/// Closes a block, whose first 8 bytes are the block type and the block total length
+void end_block(std::vector<uint8_t>& buffer, size_t block_start)
+{
+  uint32_t block_len = buffer.size() - block_start + sizeof(uint32_t);
+  memcpy(&buffer[block_start + sizeof(uint32_t)], &block_len, sizeof(block_len));
+  put(buffer, block_len);
+}
+
+/// Builds the name of the file with the given index, as in "enb_mac.1.pcap" for "enb_mac.pcap"
+std::string build_filename_with_index(const std::string& filename, uint32_t index)
+{
+  if (index == 0) {
+    return filename;
+  }
+  size_t dot_pos       = filename.find_last_of('.');
+  size_t separator_pos = filename.find_last_of('/');
+  if (dot_pos == std::string::npos or dot_pos == 0 or dot_pos == filename.size() - 1 or
+      (separator_pos != std::string::npos and separator_pos >= dot_pos - 1)) {
+    return filename + "." + std::to_string(index);
+  }
+  return filename.substr(0, dot_pos) + "." + std::to_string(index) + filename.substr(dot_pos);
+}
+
+} // namespace
+
+pcap_writer::pcap_writer(const std::string& thread_name) :
+  thread(thread_name), logger(srslog::fetch_basic_logger("PCAP", false))
+{}
+
+pcap_writer::~pcap_writer()
+{
+  close();
+}
+
+int pcap_writer::open(const std::string&                   filename,
+                      const std::vector<pcap_interface_t>& interfaces_,
+                      uint32_t                             slot_size,
+                      uint32_t                             default_ring_size,
+                      const pcap_writer_args_t&            args_)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (running) {
+    logger.error("PCAP writer for %s already running. Close first.", filename.c_str());
+    return SRSRAN_ERROR;
+  }
+  if (interfaces_.empty()) {
+    logger.error("No interfaces defined for %s", filename.c_str());
+    return SRSRAN_ERROR;
+  }
+  if (args_.format == pcap_format_t::pcap) {
+    for (const pcap_interface_t& iface : interfaces_) {
+      if (iface.dlt != interfaces_[0].dlt) {
+        logger.error("PCAP file %s can not hold DLTs %d and %d. Use the pcapng format",
+                     filename.c_str(),
+                     interfaces_[0].dlt,
+                     iface.dlt);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  args          = args_;
+  interfaces    = interfaces_;
+  base_filename = filename;
+  file_index    = 0;
+  ring.resize(args.ring_size > 0 ? args.ring_size : default_ring_size, slot_size);
+  nof_dropped.store(0, std::memory_order_relaxed);
+  if (not create_file()) {
+    return SRSRAN_ERROR;
+  }
+
+  running = true;
+  start();
+  return SRSRAN_SUCCESS;
+}
+
+void pcap_writer::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not running) {
+      return;
+    }
+    running = false;
+  }
+  wait_thread_finish();
+  close_file();
+
+  if (nof_dropped > 0) {
+    logger.warning("%" PRIu64 " PDUs were dropped from %s", nof_dropped.load(), base_filename.c_str());
+  }
+}
+
+bool pcap_writer::write(uint32_t if_id, const uint8_t* hdr, uint32_t hdr_len, const uint8_t* payload, uint32_t len)
+{
+  if (not running) {
+    return false;
+  }
+  if (not ring.try_push(if_id, hdr, hdr_len, payload, len)) {
+    nof_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+void pcap_writer::run_thread()
+{
+  while (running) {
+    if (not write_batch()) {
+      std::this_thread::sleep_for(pcap_idle_period);
+    }
+  }
+
+  // write remainder of the ring
+  while (write_batch()) {
+  }
+}
+
+bool pcap_writer::write_batch()
+{
+  pcap_capture_ring::record_t records[max_batch_size];
+  size_t                      nof_records = ring.peek(records, max_batch_size);
+  if (nof_records == 0) {
+    return false;
+  }
+
+  if (args.max_file_duration_s > 0 and
+      std::chrono::steady_clock::now() - file_start >= std::chrono::seconds(args.max_file_duration_s)) {
+    rotate_file();
+  }
+
+  // Each record is written as a header, the data and, in pcapng, the padding plus the trailing block length
+  uint8_t      headers[max_batch_size][28];
+  uint8_t      trailers[max_batch_size][8] = {};
+  struct iovec iov[max_batch_size * 3];
+  size_t       iovcnt = 0, nof_bytes = 0, nof_pending = 0;
+  for (size_t i = 0; i < nof_records; ++i) {
+    const pcap_capture_ring::record_t& rec = records[i];
+    uint32_t                           hdr_len, trailer_len = 0;
+    if (args.format == pcap_format_t::pcapng) {
+      uint32_t block_len = pcapng_epb_overhead + rec.len + pad4(rec.len);
+      uint32_t fields[7] = {pcapng_epb_type,
+                            block_len,
+                            rec.if_id,
+                            uint32_t(rec.timestamp_ns >> 32U),
+                            uint32_t(rec.timestamp_ns),
+                            rec.len,
+                            rec.orig_len};
+      hdr_len            = sizeof(fields);
+      memcpy(headers[i], fields, hdr_len);
+      trailer_len = pad4(rec.len) + sizeof(uint32_t);
+      memcpy(&trailers[i][pad4(rec.len)], &block_len, sizeof(uint32_t));
+    } else {
+      pcaprec_hdr_t rec_hdr;
+      rec_hdr.ts_sec   = rec.timestamp_ns / 1000000000;
+      rec_hdr.ts_usec  = (rec.timestamp_ns % 1000000000) / 1000;
+      rec_hdr.incl_len = rec.len;
+      rec_hdr.orig_len = rec.orig_len;
+      hdr_len          = sizeof(rec_hdr);
+      memcpy(headers[i], &rec_hdr, hdr_len);
+    }
+
+    // Rotate the file before the record that would exceed its maximum size, unless it is the first one of the file
+    uint32_t rec_bytes = hdr_len + rec.len + trailer_len;
+    if (args.max_file_size > 0 and file_size + nof_bytes + rec_bytes > args.max_file_size and
+        file_size + nof_bytes > file_header_size) {
+      flush(iov, iovcnt, nof_bytes, nof_pending);
+      iovcnt = nof_bytes = nof_pending = 0;
+      rotate_file();
+    }
+
+    iov[iovcnt++] = {headers[i], hdr_len};
+    iov[iovcnt++] = {const_cast<uint8_t*>(rec.data), rec.len};
+    if (trailer_len > 0) {
+      iov[iovcnt++] = {trailers[i], trailer_len};
+    }
+    nof_bytes += rec_bytes;
+    nof_pending++;
+  }
+  flush(iov, iovcnt, nof_bytes, nof_pending);
+
+  ring.release(nof_records);
+  return true;
+}
+
+void pcap_writer::flush(struct iovec* iov, size_t iovcnt, size_t nof_bytes, size_t nof_records)
+{
+  if (nof_records == 0) {
+    return;
+  }
+  if (fd >= 0 and write_all(iov, iovcnt, nof_bytes)) {
+    file_size += nof_bytes;
+  } else {
+    nof_dropped.fetch_add(nof_records, std::memory_order_relaxed);
+  }
+}
+
+void pcap_writer::rotate_file()
+{
+  if (fd >= 0) {
+    close_file();
+    create_file();
+  }
+}
+
+bool pcap_writer::write_all(struct iovec* iov, size_t iovcnt, size_t nof_bytes)
+{
+  while (nof_bytes > 0) {
+    ssize_t n = ::writev(fd, iov, std::min<size_t>(iovcnt, IOV_MAX));
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      logger.error("Error writing to PCAP file: %s", strerror(errno));
+      close_file();
+      return false;
+    }
+    nof_bytes -= n;
+
+    // Skip the buffers that were fully written
+    while (iovcnt > 0 and size_t(n) >= iov->iov_len) {
+      n -= iov->iov_len;
+      ++iov;
+      --iovcnt;
+    }
+    if (n > 0) {
+      iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + n;
+      iov->iov_len -= n;
+    }
+  }
+  return true;
+}
+
+bool pcap_writer::create_file()
+{
+  std::string filename = build_filename_with_index(base_filename, file_index++);
+  fd                   = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    logger.error("Couldn't open %s to write PCAP: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+
+  std::vector<uint8_t> header;
+  uint32_t             snaplen = std::max<uint32_t>(65535, ring.get_slot_size());
+  if (args.format == pcap_format_t::pcapng) {
+    // Section Header Block, with unknown section length
+    size_t block_start = header.size();
+    put(header, pcapng_shb_type);
+    put(header, uint32_t(0));
+    put(header, pcapng_byte_order);
+    put(header, uint16_t(1));
+    put(header, uint16_t(0));
+    put(header, int64_t(-1));
+    end_block(header, block_start);
+
+    // One Interface Description Block per layer, with nanosecond timestamps
+    for (const pcap_interface_t& iface : interfaces) {
+      uint8_t tsresol = 9;
+      block_start     = header.size();
+      put(header, pcapng_idb_type);
+      put(header, uint32_t(0));
+      put(header, uint16_t(iface.dlt));
+      put(header, uint16_t(0));
+      put(header, snaplen);
+      put_option(header, pcapng_opt_if_name, iface.name.data(), iface.name.size());
+      put_option(header, pcapng_opt_if_tsresol, &tsresol, sizeof(tsresol));
+      put_option(header, pcapng_opt_end, nullptr, 0);
+      end_block(header, block_start);
+    }
+  } else {
+    pcap_hdr_t file_header = {0xa1b2c3d4, 2, 4, 0, 0, snaplen, interfaces[0].dlt};
+    header.resize(sizeof(file_header));
+    memcpy(header.data(), &file_header, sizeof(file_header));
+  }
+
+  struct iovec iov = {header.data(), header.size()};
+  if (not write_all(&iov, 1, header.size())) {
+    return false;
+  }
+  file_size        = header.size();
+  file_header_size = header.size();
+  file_start       = std::chrono::steady_clock::now();
+  return true;
+}
+
+void pcap_writer::close_file()
+{
+  if (fd >= 0) {
+    ::close(fd);
+    fd = -1;
+  }
+}
+
+} // namespace srsran
@@ -0,0 +1,207 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/perf_counters.h"
+#include <memory>
+
+#if defined(ENABLE_PERF_COUNTERS) && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define PERF_COUNTERS_AVAILABLE
+#endif
+
+namespace srsran {
+
+const char* to_string(perf_event_t event)
+{
+  switch (event) {
+    case perf_event_t::cycles:
+      return "cycles";
+    case perf_event_t::instructions:
+      return "instructions";
+    case perf_event_t::llc_misses:
+      return "llc_misses";
+    case perf_event_t::branch_misses:
+      return "branch_misses";
+    default:
+      break;
+  }
+  return "unknown";
+}
+
+#ifdef PERF_COUNTERS_AVAILABLE
+
+static int perf_event_open(perf_event_t event, int group_fd)
+{
+  static const uint64_t configs[] = {PERF_COUNT_HW_CPU_CYCLES,
+                                     PERF_COUNT_HW_INSTRUCTIONS,
+                                     PERF_COUNT_HW_CACHE_MISSES,
+                                     PERF_COUNT_HW_BRANCH_MISSES};
+
+  struct perf_event_attr attr = {};
+  attr.size                   = sizeof(attr);
+  attr.type                   = PERF_TYPE_HARDWARE;
+  attr.config                 = configs[(size_t)event];
+  attr.read_format            = PERF_FORMAT_GROUP;
+  attr.exclude_kernel         = 1;
+  attr.exclude_hv             = 1;
+  // The group is created disabled, and enabled through its leader once all the events are added
+  attr.disabled = group_fd < 0 ? 1 : 0;
+  // Current thread, on any CPU
+  return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+}
+
+bool perf_counter_group::open()
+{
+  close();
+  for (size_t i = 0; i < fds.size(); ++i) {
+    fds[i] = perf_event_open((perf_event_t)i, fds[0]);
+    if (fds[i] < 0) {
+      close();
+      return false;
+    }
+  }
+  if (ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) < 0) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+void perf_counter_group::close()
+{
+  // The events are closed before the leader of the group
+  for (size_t i = fds.size(); i > 0; --i) {
+    if (fds[i - 1] >= 0) {
+      ::close(fds[i - 1]);
+      fds[i - 1] = -1;
+    }
+  }
+}
+
+bool perf_counter_group::read(perf_sample_t& sample) const
+{
+  if (not is_open()) {
+    return false;
+  }
+  // Layout of PERF_FORMAT_GROUP: the number of events, followed by their values in the order they were added
+  uint64_t buf[1 + (size_t)perf_event_t::nof_events];
+  if (::read(fds[0], buf, sizeof(buf)) != (ssize_t)sizeof(buf) or buf[0] != sample.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < sample.size(); ++i) {
+    sample[i] = buf[1 + i];
+  }
+  return true;
+}
+
+#else // PERF_COUNTERS_AVAILABLE
+
+bool perf_counter_group::open()
+{
+  return false;
+}
+
+void perf_counter_group::close() {}
+
+bool perf_counter_group::read(perf_sample_t& sample) const
+{
+  return false;
+}
+
+#endif // PERF_COUNTERS_AVAILABLE
+
+static std::atomic<bool> perf_counters_on{false};
+
+bool perf_counters_enable()
+{
+  // Probe the counters on this thread before enabling them for all
+  perf_counter_group probe;
+  if (not probe.open()) {
+    return false;
+  }
+  perf_counters_on.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+bool perf_counters_enabled()
+{
+  return perf_counters_on.load(std::memory_order_relaxed);
+}
+
+perf_counter_group* perf_counters_this_thread()
+{
+  if (not perf_counters_enabled()) {
+    return nullptr;
+  }
+  // Opened once per thread, even if it fails, so that the failure does not cost a system call per sample
+  thread_local std::unique_ptr<perf_counter_group> group;
+  thread_local bool                                tried = false;
+  if (not tried) {
+    tried = true;
+    std::unique_ptr<perf_counter_group> g(new perf_counter_group);
+    if (g->open()) {
+      group = std::move(g);
+    }
+  }
+  return group.get();
+}
+
+perf_counter_accumulator::perf_counter_accumulator()
+{
+  for (auto& t : totals) {
+    t.store(0, std::memory_order_relaxed);
+  }
+}
+
+void perf_counter_accumulator::add(const perf_sample_t& start, const perf_sample_t& end)
+{
+  for (size_t i = 0; i < totals.size(); ++i) {
+    totals[i].fetch_add(end[i] - start[i], std::memory_order_relaxed);
+  }
+  nof_samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+perf_counter_accumulator::summary_t perf_counter_accumulator::read_and_reset()
+{
+  summary_t summary;
+  summary.nof_samples = nof_samples.exchange(0, std::memory_order_relaxed);
+  for (size_t i = 0; i < totals.size(); ++i) {
+    summary.totals[i] = totals[i].exchange(0, std::memory_order_relaxed);
+  }
+  return summary;
+}
+
+float perf_counter_accumulator::summary_t::ipc() const
+{
+  uint64_t cycles = totals[(size_t)perf_event_t::cycles];
+  return cycles == 0 ? 0 : (float)totals[(size_t)perf_event_t::instructions] / cycles;
+}
+
+float perf_counter_accumulator::summary_t::misses_per_kinstr(perf_event_t event) const
+{
+  uint64_t instructions = totals[(size_t)perf_event_t::instructions];
+  return instructions == 0 ? 0 : 1000.0f * totals[(size_t)event] / instructions;
+}
+
+} // namespace srsran
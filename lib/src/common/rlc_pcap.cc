@@ -31,11 +31,11 @@ void rlc_pcap::enable(bool en)
   enable_write = true;
 }
 
-void rlc_pcap::open(const char* filename, const rlc_config_t& config)
+void rlc_pcap::open(const char* filename, const rlc_config_t& config, const pcap_writer_args_t& args)
 {
   fprintf(stdout, "Opening RLC PCAP with DLT=%d\n", UDP_DLT);
-  pcap_file    = DLT_PCAP_Open(UDP_DLT, filename);
-  enable_write = true;
+  enable_write =
+      writer.open(filename, {{UDP_DLT, "rlc-lte"}}, ring_slot_size, default_ring_size, args) == SRSRAN_SUCCESS;
 
   if (config.rlc_mode == rlc_mode_t::am) {
     mode      = RLC_AM_MODE;
@@ -54,7 +54,7 @@ void rlc_pcap::open(const char* filename, const rlc_config_t& config)
 void rlc_pcap::close()
 {
   fprintf(stdout, "Saving RLC PCAP file\n");
-  DLT_PCAP_Close(pcap_file);
+  writer.close();
 }
 
 void rlc_pcap::set_ue_id(uint16_t ue_id_)
@@ -83,7 +83,10 @@ void rlc_pcap::pack_and_write(uint8_t* pdu,
     context.channelId            = channel_id;
     context.pduLength            = pdu_len_bytes;
     if (pdu) {
-      LTE_PCAP_RLC_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
+      uint8_t context_header[PCAP_CONTEXT_HEADER_MAX] = {};
+      int     offset =
+          LTE_PCAP_PACK_RLC_CONTEXT_TO_BUFFER(&context, context_header, PCAP_CONTEXT_HEADER_MAX, pdu_len_bytes);
+      writer.write(0, context_header, offset, pdu, pdu_len_bytes);
     }
   }
 }
@@ -33,7 +33,7 @@ static void emergency_cleanup_handler(void* data)
   reinterpret_cast<s1ap_pcap*>(data)->close();
 }
 
-s1ap_pcap::s1ap_pcap()
+s1ap_pcap::s1ap_pcap() : writer("PCAP_WRITER_S1AP")
 {
   add_emergency_cleanup_handler(emergency_cleanup_handler, this);
 }
@@ -42,27 +42,27 @@ void s1ap_pcap::enable()
 {
   enable_write = true;
 }
-void s1ap_pcap::open(const char* filename_)
+void s1ap_pcap::open(const char* filename_, const pcap_writer_args_t& args)
 {
   filename     = filename_;
-  pcap_file    = DLT_PCAP_Open(S1AP_LTE_DLT, filename.c_str());
-  enable_write = true;
+  enable_write = writer.open(filename, {{S1AP_LTE_DLT, "s1ap"}}, ring_slot_size, default_ring_size, args) ==
+                 SRSRAN_SUCCESS;
 }
 void s1ap_pcap::close()
 {
   if (!enable_write) {
     return;
   }
+  writer.close();
   fprintf(stdout, "Saving S1AP PCAP file (DLT=%d) to %s\n", S1AP_LTE_DLT, filename.c_str());
-  DLT_PCAP_Close(pcap_file);
+  enable_write = false;
 }
 
 void s1ap_pcap::write_s1ap(uint8_t* pdu, uint32_t pdu_len_bytes)
 {
   if (enable_write) {
-    S1AP_Context_Info_t context;
     if (pdu) {
-      LTE_PCAP_S1AP_WritePDU(pcap_file, &context, pdu, pdu_len_bytes);
+      writer.write(0, nullptr, 0, pdu, pdu_len_bytes);
     }
   }
 }
@@ -115,3 +115,62 @@ void sliding_window_stats<TUnit>::operator()(nanoseconds duration)
 
 template class srsran::sliding_window_stats<std::chrono::microseconds>;
 template class srsran::sliding_window_stats<std::chrono::milliseconds>;
+
+// latency histogram
+
+size_t latency_histogram::bucket_index(int64_t ns)
+{
+  const uint64_t sub_buckets = 1U << sub_bucket_bits;
+  auto           val         = static_cast<uint64_t>(ns);
+  if (val < sub_buckets) {
+    return val;
+  }
+  uint32_t msb = 63 - __builtin_clzll(val);
+  if (msb >= max_value_bits) {
+    return nof_buckets - 1;
+  }
+  uint32_t shift = msb - sub_bucket_bits;
+  return ((shift + 1) << sub_bucket_bits) + ((val >> shift) & (sub_buckets - 1));
+}
+
+int64_t latency_histogram::bucket_upper_bound(size_t idx)
+{
+  const uint64_t sub_buckets = 1U << sub_bucket_bits;
+  if (idx < sub_buckets) {
+    return idx;
+  }
+  uint32_t shift = (idx >> sub_bucket_bits) - 1;
+  uint64_t lower = (sub_buckets + (idx & (sub_buckets - 1))) << shift;
+  return lower + (1ULL << shift) - 1;
+}
+
+latency_histogram::summary_t latency_histogram::read_and_reset()
+{
+  std::array<uint64_t, nof_buckets> counts;
+  summary_t                         summary;
+  for (size_t i = 0; i < nof_buckets; ++i) {
+    counts[i] = buckets[i].exchange(0, std::memory_order_relaxed);
+    summary.count += counts[i];
+  }
+  summary.max                 = nanoseconds{max_ns.exchange(0, std::memory_order_relaxed)};
+  summary.nof_deadline_misses = nof_deadline_misses.exchange(0, std::memory_order_relaxed);
+  if (summary.count == 0) {
+    return summary;
+  }
+
+  // Percentiles are reported as the upper bound of their bucket, without exceeding the maximum
+  uint64_t p50_rank = (summary.count + 1) / 2, p99_rank = (summary.count * 99 + 99) / 100, acc = 0;
+  bool     p50_found = false;
+  for (size_t i = 0; i < nof_buckets; ++i) {
+    acc += counts[i];
+    if (not p50_found and acc >= p50_rank) {
+      summary.p50 = std::min(nanoseconds{bucket_upper_bound(i)}, summary.max);
+      p50_found   = true;
+    }
+    if (acc >= p99_rank) {
+      summary.p99 = std::min(nanoseconds{bucket_upper_bound(i)}, summary.max);
+      break;
+    }
+  }
+  return summary;
+}
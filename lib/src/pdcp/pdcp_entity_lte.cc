@@ -100,7 +100,8 @@ bool pdcp_entity_lte::configure(const pdcp_config_t& cnfg_)
   logger.info("Status Report Required: %s", cfg.status_report_required ? "True" : "False");
 
   if (is_drb() and not rlc->rb_is_um(lcid)) {
-    undelivered_sdus = std::unique_ptr<undelivered_sdus_queue>(new undelivered_sdus_queue(task_sched));
+    undelivered_sdus =
+        std::unique_ptr<undelivered_sdus_queue>(new undelivered_sdus_queue(task_sched, discard_callback(this)));
     rx_counts_info.reserve(reordering_window);
   }
 
@@ -712,9 +713,8 @@ bool pdcp_entity_lte::store_sdu(uint32_t sn, const unique_byte_buffer_t& sdu)
   }
 
   // Copy PDU contents into queue and start discard timer
-  uint32_t         discard_timeout = static_cast<uint32_t>(cfg.discard_timer);
-  discard_callback discard_fnc(this, sn);
-  bool             ret = undelivered_sdus->add_sdu(sn, sdu, discard_timeout, discard_fnc);
+  uint32_t discard_timeout = static_cast<uint32_t>(cfg.discard_timer);
+  bool     ret             = undelivered_sdus->add_sdu(sn, sdu, discard_timeout);
   if (ret and discard_timeout > 0) {
     logger.debug("Discard Timer set for SN %u. Timeout: %ums", sn, discard_timeout);
   }
@@ -725,7 +725,7 @@ bool pdcp_entity_lte::store_sdu(uint32_t sn, const unique_byte_buffer_t& sdu)
  * Discard functionality
  ***************************************************************************/
 // Discard Timer Callback (discardTimer)
-void pdcp_entity_lte::discard_callback::operator()(uint32_t timer_id)
+void pdcp_entity_lte::discard_callback::operator()(uint32_t discard_sn)
 {
   parent->logger.info("Discard timer for SN=%d expired", discard_sn);
 
@@ -871,17 +871,16 @@ void pdcp_entity_lte::reset_metrics()
 /****************************************************************************
  * Undelivered SDUs queue helpers
  ***************************************************************************/
-undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle task_sched)
-{
-  for (auto& e : sdus) {
-    e.discard_timer = task_sched.get_unique_timer();
-  }
-}
-
-bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
-                                     const srsran::unique_byte_buffer_t&   sdu,
-                                     uint32_t                              discard_timeout,
-                                     srsran::move_callback<void(uint32_t)> callback)
+undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle            task_sched,
+                                               srsran::move_callback<void(uint32_t)> discard_callback) :
+  discard_fnc(std::move(discard_callback)),
+  discard_timers(
+      task_sched,
+      [this](uint32_t sn, uint32_t expiry) { handle_discard_timeout(sn, expiry); },
+      capacity)
+{}
+
+bool undelivered_sdus_queue::add_sdu(uint32_t sn, const srsran::unique_byte_buffer_t& sdu, uint32_t discard_timeout)
 {
   assert(not has_sdu(sn) && "Cannot add repeated SNs");
 
@@ -920,8 +919,8 @@ bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
   sdus[sn].sdu->N_bytes    = sdu->N_bytes;
   memcpy(sdus[sn].sdu->msg, sdu->msg, sdu->N_bytes);
   if (discard_timeout > 0) {
-    sdus[sn].discard_timer.set(discard_timeout, std::move(callback));
-    sdus[sn].discard_timer.run();
+    sdus[sn].discard_armed  = true;
+    sdus[sn].discard_expiry = discard_timers.push(sn, discard_timeout);
   }
   sdus[sn].sdu->set_timestamp(); // Metrics
   bytes += sdu->N_bytes;
@@ -935,7 +934,7 @@ bool undelivered_sdus_queue::clear_sdu(uint32_t sn)
   }
   count--;
   bytes -= sdus[sn].sdu->N_bytes;
-  sdus[sn].discard_timer.stop();
+  sdus[sn].discard_armed = false;
   sdus[sn].sdu.reset();
   // Find next FMS, if necessary
   if (sn == fms) {
@@ -949,17 +948,27 @@ void undelivered_sdus_queue::clear()
   count = 0;
   bytes = 0;
   fms   = 0;
+  discard_timers.clear();
   for (uint32_t sn = 0; sn < capacity; sn++) {
-    sdus[sn].discard_timer.stop();
+    sdus[sn].discard_armed = false;
     sdus[sn].sdu.reset();
   }
 }
 
 size_t undelivered_sdus_queue::nof_discard_timers() const
 {
-  return std::count_if(sdus.begin(), sdus.end(), [](const sdu_data& s) {
-    return s.sdu != nullptr and s.discard_timer.is_valid() and s.discard_timer.is_running();
-  });
+  return std::count_if(
+      sdus.begin(), sdus.end(), [](const sdu_data& s) { return s.sdu != nullptr and s.discard_armed; });
+}
+
+void undelivered_sdus_queue::handle_discard_timeout(uint32_t sn, uint32_t expiry)
+{
+  // SDUs delivered (or replaced by a newer SDU with the same SN) before their expiry are lazily skipped
+  if (not has_sdu(sn) or not sdus[sn].discard_armed or sdus[sn].discard_expiry != expiry) {
+    return;
+  }
+  sdus[sn].discard_armed = false;
+  discard_fnc(sn);
 }
 
 void undelivered_sdus_queue::update_fms()
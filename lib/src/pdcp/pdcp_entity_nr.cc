@@ -21,9 +21,14 @@
 
 #include "srsran/upper/pdcp_entity_nr.h"
 #include "srsran/common/security.h"
+#include <algorithm>
 
 namespace srsran {
 
+// Initial capacity of the reordering ring and of the discard timer queue. Both grow on demand
+static const uint32_t reorder_queue_initial_size      = 64;
+static const uint32_t discard_timers_initial_capacity = 16;
+
 pdcp_entity_nr::pdcp_entity_nr(srsue::rlc_interface_pdcp* rlc_,
                                srsue::rrc_interface_pdcp* rrc_,
                                srsue::gw_interface_pdcp*  gw_,
@@ -65,8 +70,16 @@ bool pdcp_entity_nr::configure(const pdcp_config_t& cnfg_)
   rb_name     = cfg.get_rb_name();
   window_size = 1 << (cfg.sn_len - 1);
 
+  // Reordering window
+  reorder_queue.clear();
+  reorder_queue.resize(std::min(reorder_queue_initial_size, window_size));
+
   // Timers
   reordering_timer = task_sched.get_unique_timer();
+  if (cfg.discard_timer != pdcp_discard_timer_t::infinity) {
+    discard_timers = std::unique_ptr<pdcp_discard_timer_queue>(
+        new pdcp_discard_timer_queue(task_sched, discard_callback(this), discard_timers_initial_capacity));
+  }
 
   // configure timer
   if (static_cast<uint32_t>(cfg.t_reordering) > 0) {
@@ -104,12 +117,8 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
   }
 
   // Start discard timer
-  if (cfg.discard_timer != pdcp_discard_timer_t::infinity) {
-    timer_handler::unique_timer discard_timer = task_sched.get_unique_timer();
-    discard_callback            discard_fnc(this, tx_next);
-    discard_timer.set(static_cast<uint32_t>(cfg.discard_timer), discard_fnc);
-    discard_timer.run();
-    discard_timers_map.insert(std::make_pair(tx_next, std::move(discard_timer)));
+  if (discard_timers != nullptr) {
+    discard_timers->push(tx_next, static_cast<uint32_t>(cfg.discard_timer));
     logger.debug("Discard Timer set for SN %u. Timeout: %ums", tx_next, static_cast<uint32_t>(cfg.discard_timer));
   }
 
@@ -194,12 +203,18 @@ void pdcp_entity_nr::write_pdu(unique_byte_buffer_t pdu)
   }
 
   // Check if PDU has been received
-  if (reorder_queue.find(rcvd_count) != reorder_queue.end()) {
+  grow_reorder_queue(rcvd_count);
+  reorder_pdu& slot = reorder_slot(rcvd_count);
+  if (slot.pdu != nullptr) {
+    if (slot.count != rcvd_count) {
+      logger.warning("RCVD_COUNT %u is outside of the reception window (RX_DELIV %u)", rcvd_count, rx_deliv);
+    }
     return; // PDU already present, drop.
   }
 
   // Store PDU in reception buffer
-  reorder_queue[rcvd_count] = std::move(pdu);
+  slot.count = rcvd_count;
+  slot.pdu   = std::move(pdu);
 
   // Update RX_NEXT
   if (rcvd_count >= rx_next) {
@@ -239,14 +254,33 @@ void pdcp_entity_nr::notify_failure(const pdcp_sn_vector_t& pdcp_sns)
  * Packing / Unpacking Helpers
  */
 
+// Doubles the reordering ring until it holds all the COUNTs from RX_DELIV to the received one. The received COUNT is
+// always inside the reception window, so the ring never grows beyond window_size
+void pdcp_entity_nr::grow_reorder_queue(uint32_t count)
+{
+  size_t new_size = reorder_queue.size();
+  while (count - rx_deliv >= new_size and new_size < window_size) {
+    new_size *= 2;
+  }
+  if (new_size == reorder_queue.size()) {
+    return;
+  }
+  // The stored PDUs have distinct COUNTs from RX_DELIV onwards, so they do not collide in the larger ring
+  std::vector<reorder_pdu> new_queue(new_size);
+  for (reorder_pdu& slot : reorder_queue) {
+    if (slot.pdu != nullptr) {
+      new_queue[slot.count % new_size] = std::move(slot);
+    }
+  }
+  reorder_queue.swap(new_queue);
+}
+
 // Deliver all consecutivly associated COUNTs.
 // Update RX_NEXT after submitting to higher layers
 void pdcp_entity_nr::deliver_all_consecutive_counts()
 {
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = reorder_queue.begin();
-       it != reorder_queue.end() && it->first == rx_deliv;
-       reorder_queue.erase(it++)) {
-    logger.debug("Delivering SDU with RCVD_COUNT %u", it->first);
+  while (has_reorder_pdu(rx_deliv)) {
+    logger.debug("Delivering SDU with RCVD_COUNT %u", rx_deliv);
 
     // Check RX_DELIV overflow
     if (rx_overflow) {
@@ -258,7 +292,7 @@ void pdcp_entity_nr::deliver_all_consecutive_counts()
     }
 
     // Pass PDCP SDU to the next layers
-    pass_to_upper_layers(std::move(it->second));
+    pass_to_upper_layers(std::move(reorder_slot(rx_deliv).pdu));
 
     // Update RX_DELIV
     rx_deliv = rx_deliv + 1;
@@ -274,14 +308,15 @@ void pdcp_entity_nr::reordering_callback::operator()(uint32_t timer_id)
   parent->logger.debug("Reordering timer expired");
 
   // Deliver all PDCP SDU(s) with associeted COUNT value(s) < RX_REORD
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = parent->reorder_queue.begin();
-       it != parent->reorder_queue.end() && it->first < parent->rx_reord;
-       parent->reorder_queue.erase(it++)) {
-    // Deliver to upper layers
-    parent->pass_to_upper_layers(std::move(it->second));
+  for (uint32_t count = parent->rx_deliv; count < parent->rx_reord; ++count) {
+    if (parent->has_reorder_pdu(count)) {
+      // Deliver to upper layers
+      parent->pass_to_upper_layers(std::move(parent->reorder_slot(count).pdu));
+    }
   }
 
   // Deliver all PDCP SDU(s) consecutivly associeted COUNT value(s) starting from RX_REORD
+  parent->rx_deliv = std::max(parent->rx_deliv, parent->rx_reord);
   parent->deliver_all_consecutive_counts();
 
   if (parent->rx_deliv < parent->rx_next) {
@@ -291,16 +326,12 @@ void pdcp_entity_nr::reordering_callback::operator()(uint32_t timer_id)
 }
 
 // Discard Timer Callback (discardTimer)
-void pdcp_entity_nr::discard_callback::operator()(uint32_t timer_id)
+void pdcp_entity_nr::discard_callback::operator()(uint32_t discard_sn, uint32_t expiry)
 {
   parent->logger.debug("Discard timer expired for PDU with SN = %d", discard_sn);
 
   // Notify the RLC of the discard. It's the RLC to actually discard, if no segment was transmitted yet.
   parent->rlc->discard_sdu(parent->lcid, discard_sn);
-
-  // Remove timer from map
-  // NOTE: this will delete the callback. It *must* be the last instruction.
-  parent->discard_timers_map.erase(discard_sn);
 }
 
 void pdcp_entity_nr::get_bearer_state(pdcp_lte_state_t* state)
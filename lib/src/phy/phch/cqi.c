@@ -747,6 +747,14 @@ uint8_t srsran_cqi_from_snr(float snr)
   return 0;
 }
 
+float srsran_cqi_to_snr(uint32_t cqi)
+{
+  if (cqi == 0) {
+    return -INFINITY;
+  }
+  return cqi_to_snr_table[SRSRAN_MIN(cqi, 15) - 1];
+}
+
 /* Returns the number of subbands to be reported in CQI measurements as
  * defined in clause 7.2 in TS 36.213, i.e., the N parameter
  */
@@ -564,9 +564,10 @@ int srsran_prach_init(srsran_prach_t* p, uint32_t max_N_ifft_ul)
     p->max_N_ifft_ul = max_N_ifft_ul;
 
     // Set up containers
-    p->prach_bins = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
+    p->prach_bins = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG * SRSRAN_MAX_PORTS);
     p->corr_spec  = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
     p->corr       = srsran_vec_f_malloc(SRSRAN_PRACH_N_ZC_LONG);
+    p->corr_ant   = srsran_vec_f_malloc(SRSRAN_PRACH_N_ZC_LONG);
     p->cross      = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
     p->corr_freq  = srsran_vec_cf_malloc(SRSRAN_PRACH_N_ZC_LONG);
 
@@ -882,18 +883,29 @@ int srsran_prach_process(srsran_prach_t* p,
   int max_idx         = 0;
   srsran_vec_cf_zero(p->cross, p->N_zc);
   srsran_vec_cf_zero(p->corr_freq, p->N_zc);
+  // num_ra_preambles is limited to N_roots, so every iteration correlates against a different root sequence
   for (int i = 0; i < p->num_ra_preambles; i++) {
     cf_t* root_spec = get_precoded_dft(p, p->root_seqs_idx[i]);
 
-    srsran_vec_prod_conj_ccc(p->prach_bins, root_spec, p->corr_spec, p->N_zc);
+    for (uint32_t ant = 0; ant < p->nof_rx_ant; ant++) {
+      srsran_vec_prod_conj_ccc(&p->prach_bins[ant * SRSRAN_PRACH_N_ZC_LONG], root_spec, p->corr_spec, p->N_zc);
 
-    srsran_vec_prod_conj_ccc(p->corr_spec, &p->corr_spec[1], p->cross, p->N_zc - 1);
-    if (p->successive_cancellation) {
-      srsran_vec_cf_copy(p->corr_freq, p->corr_spec, p->N_zc);
-    }
-    srsran_dft_run(&p->zc_ifft, p->corr_spec, p->corr_spec);
+      if (ant == 0) {
+        srsran_vec_prod_conj_ccc(p->corr_spec, &p->corr_spec[1], p->cross, p->N_zc - 1);
+        if (p->successive_cancellation) {
+          srsran_vec_cf_copy(p->corr_freq, p->corr_spec, p->N_zc);
+        }
+      }
+      srsran_dft_run(&p->zc_ifft, p->corr_spec, p->corr_spec);
 
-    srsran_vec_abs_square_cf(p->corr_spec, p->corr, p->N_zc);
+      // Combine the correlation energy of all antennas non-coherently
+      if (ant == 0) {
+        srsran_vec_abs_square_cf(p->corr_spec, p->corr, p->N_zc);
+      } else {
+        srsran_vec_abs_square_cf(p->corr_spec, p->corr_ant, p->N_zc);
+        srsran_vec_sum_fff(p->corr, p->corr_ant, p->corr, p->N_zc);
+      }
+    }
 
     float corr_ave = srsran_vec_acc_ff(p->corr, p->N_zc) / p->N_zc;
 
@@ -905,6 +917,10 @@ int srsran_prach_process(srsran_prach_t* p,
     }
     uint32_t n_wins = p->N_zc / winsize;
 
+    // Only the windows of the preambles generated from this root are searched
+    uint32_t root_end = (i + 1 < p->N_roots) ? p->root_seqs_idx[i + 1] : N_SEQS;
+    n_wins            = SRSRAN_MIN(n_wins, root_end - p->root_seqs_idx[i]);
+
     float max_peak = 0;
     for (int j = 0; j < n_wins; j++) {
       uint32_t start = (p->N_zc - (j * p->N_cs)) % p->N_zc;
@@ -928,20 +944,22 @@ int srsran_prach_process(srsran_prach_t* p,
     if (max_peak > (p->detect_factor * corr_ave)) {
       for (int j = 0; j < n_wins; j++) {
         if (p->peak_values[j] > p->detect_factor * corr_ave) {
+          // The preamble with cyclic shift j of this root
+          uint32_t preamble_idx = p->root_seqs_idx[i] + j;
           if (indices) {
             if (p->successive_cancellation) {
               if (max_peak > max_to_cancel) {
-                cancellation_idx       = (i * n_wins) + j;
+                cancellation_idx       = preamble_idx;
                 max_to_cancel          = max_peak;
-                p->prach_cancel.idx    = cancellation_idx;
+                p->prach_cancel.idx    = i;
                 p->prach_cancel.factor = (sqrt(max_peak / (p->N_zc * p->N_zc)));
                 srsran_prach_calculate_correction_array(p, p->corr_freq);
               }
-              if (srsran_prach_have_stored(((i * n_wins) + j), indices, *n_indices)) {
+              if (srsran_prach_have_stored(preamble_idx, indices, *n_indices)) {
                 break;
               }
             }
-            indices[*n_indices] = (i * n_wins) + j;
+            indices[*n_indices] = preamble_idx;
           }
           if (peak_to_avg) {
             peak_to_avg[*n_indices] = p->peak_values[j] / corr_ave;
@@ -974,9 +992,25 @@ int srsran_prach_detect_offset(srsran_prach_t* p,
                                float*          t_offsets,
                                float*          peak_to_avg,
                                uint32_t*       n_indices)
+{
+  cf_t* signal_ant[SRSRAN_MAX_PORTS] = {signal};
+  return srsran_prach_detect_offset_multi(
+      p, freq_offset, signal_ant, 1, sig_len, indices, t_offsets, peak_to_avg, n_indices);
+}
+
+int srsran_prach_detect_offset_multi(srsran_prach_t* p,
+                                     uint32_t        freq_offset,
+                                     cf_t*           signal[SRSRAN_MAX_PORTS],
+                                     uint32_t        nof_rx_ant,
+                                     uint32_t        sig_len,
+                                     uint32_t*       indices,
+                                     float*          t_offsets,
+                                     float*          peak_to_avg,
+                                     uint32_t*       n_indices)
 {
   int ret = SRSRAN_ERROR;
-  if (p != NULL && signal != NULL && sig_len > 0 && indices != NULL) {
+  if (p != NULL && signal != NULL && nof_rx_ant > 0 && nof_rx_ant <= SRSRAN_MAX_PORTS && sig_len > 0 &&
+      indices != NULL) {
     if (sig_len < p->N_ifft_prach) {
       ERROR("srsran_prach_detect: Signal length is %d and should be %d", sig_len, p->N_ifft_prach);
       return SRSRAN_ERROR_INVALID_INPUTS;
@@ -984,9 +1018,6 @@ int srsran_prach_detect_offset(srsran_prach_t* p,
     int cancellation_idx = -2;
     bzero(&p->prach_cancel, sizeof(srsran_prach_cancellation_t));
 
-    // FFT incoming signal
-    srsran_dft_run(&p->fft, signal, p->signal_fft);
-
     *n_indices = 0;
 
     // Extract bins of interest
@@ -995,13 +1026,26 @@ int srsran_prach_detect_offset(srsran_prach_t* p,
     uint32_t K       = DELTA_F / DELTA_F_RA;
     uint32_t begin   = PHI + (K * k_0) + (p->is_nr ? 0 : (K / 2));
 
-    memcpy(p->prach_bins, &p->signal_fft[begin], p->N_zc * sizeof(cf_t));
-    int loops = (p->successive_cancellation) ? SUCCESSIVE_CANCELLATION_ITS : 1;
+    for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+      if (signal[ant] == NULL) {
+        return SRSRAN_ERROR_INVALID_INPUTS;
+      }
+
+      // FFT incoming signal
+      srsran_dft_run(&p->fft, signal[ant], p->signal_fft);
+
+      srsran_vec_cf_copy(&p->prach_bins[ant * SRSRAN_PRACH_N_ZC_LONG], &p->signal_fft[begin], p->N_zc);
+    }
+    p->nof_rx_ant = nof_rx_ant;
+
+    // The cancelled preamble is only estimated from the first antenna, hence successive cancellation is not applied
+    // when several antennas are combined
+    int loops = (p->successive_cancellation && nof_rx_ant == 1) ? SUCCESSIVE_CANCELLATION_ITS : 1;
     // if successive cancellation is enabled, we perform the entire search process p->num_ra_preambles times, removing
     // the highest power PRACH preamble each time.
     for (int l = 0; l < loops; l++) {
       if (srsran_prach_process(
-              p, signal, indices, t_offsets, peak_to_avg, n_indices, cancellation_idx, begin, sig_len)) {
+              p, signal[0], indices, t_offsets, peak_to_avg, n_indices, cancellation_idx, begin, sig_len)) {
         break;
       }
     }
@@ -1016,6 +1060,7 @@ int srsran_prach_free(srsran_prach_t* p)
   free(p->prach_bins);
   free(p->corr_spec);
   free(p->corr);
+  free(p->corr_ant);
   srsran_dft_plan_free(&p->ifft);
   free(p->ifft_in);
   free(p->ifft_out);
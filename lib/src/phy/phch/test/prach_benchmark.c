@@ -0,0 +1,258 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/phch/prach.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/support/srsran_test.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+/*
+ * PRACH detector benchmark. Every trial transmits a random set of preambles, each one with a random delay and an
+ * independent Rayleigh flat fading gain per receive antenna, and adds white noise at the configured SNR. Trials
+ * without any preamble are interleaved to measure the false-alarm rate. The detection and false-alarm rates and the
+ * number of PRACH occasions processed per second are reported.
+ */
+
+static uint32_t nof_prb         = 25;
+static uint32_t preamble_format = 0;
+static uint32_t root_seq_idx    = 0;
+static uint32_t zero_corr_zone  = 1;
+static uint32_t nof_rx_ant      = 1;
+static uint32_t nof_preambles   = 1;
+static uint32_t nof_trials      = 100;
+static float    snr_dB          = -10.0f;
+static float    detect_factor   = 60.0f;
+static float    min_pd          = 0.0f; // Minimum detection rate for the test to pass
+static float    max_pfa         = 1.0f; // Maximum false-alarm rate for the test to pass
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [NfrzantsDpF]\n", prog);
+  printf("\t-N Uplink number of PRB [Default %d]\n", nof_prb);
+  printf("\t-f Preamble format [Default %d]\n", preamble_format);
+  printf("\t-r Root sequence index [Default %d]\n", root_seq_idx);
+  printf("\t-z Zero correlation zone config [Default %d]\n", zero_corr_zone);
+  printf("\t-a Number of receive antennas [Default %d]\n", nof_rx_ant);
+  printf("\t-n Number of preambles transmitted in each trial [Default %d]\n", nof_preambles);
+  printf("\t-t Number of trials with and without preambles [Default %d]\n", nof_trials);
+  printf("\t-s SNR per antenna in dB [Default %.1f]\n", snr_dB);
+  printf("\t-D Detection factor [Default %.1f]\n", detect_factor);
+  printf("\t-p Minimum detection rate [Default %.2f]\n", min_pd);
+  printf("\t-F Maximum false-alarm rate [Default %.2f]\n", max_pfa);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "NfrzantsDpF")) != -1) {
+    switch (opt) {
+      case 'N':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'f':
+        preamble_format = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        root_seq_idx = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'z':
+        zero_corr_zone = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'a':
+        nof_rx_ant = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_preambles = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        nof_trials = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        // Skip the value, which may be negative and would otherwise be parsed as an option
+        snr_dB = strtof(argv[optind++], NULL);
+        break;
+      case 'D':
+        detect_factor = strtof(argv[optind], NULL);
+        break;
+      case 'p':
+        min_pd = strtof(argv[optind], NULL);
+        break;
+      case 'F':
+        max_pfa = strtof(argv[optind], NULL);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  TESTASSERT(nof_rx_ant > 0 && nof_rx_ant <= SRSRAN_MAX_PORTS);
+  TESTASSERT(nof_preambles <= 64);
+
+  srsran_prach_t     prach     = {};
+  srsran_prach_cfg_t prach_cfg = {};
+  prach_cfg.config_idx         = preamble_format;
+  prach_cfg.root_seq_idx       = root_seq_idx;
+  prach_cfg.zero_corr_zone     = zero_corr_zone;
+  TESTASSERT(srsran_prach_init(&prach, srsran_symbol_sz(nof_prb)) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_prach_set_cfg(&prach, &prach_cfg, nof_prb) == SRSRAN_SUCCESS);
+  srsran_prach_set_detect_factor(&prach, detect_factor);
+
+  // Delays up to half of the cyclic shift, so that every preamble stays within its correlation window
+  uint32_t max_delay = prach.N_cp;
+  if (prach.N_cs != 0) {
+    max_delay = SRSRAN_MIN(max_delay, (prach.N_cs * prach.N_seq) / (2 * prach.N_zc));
+  }
+  uint32_t sf_len = prach.N_cp + prach.N_seq + max_delay;
+
+  cf_t* preamble = srsran_vec_cf_malloc(sf_len);
+  cf_t* rx[SRSRAN_MAX_PORTS];
+  for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+    rx[ant] = srsran_vec_cf_malloc(sf_len);
+    TESTASSERT(rx[ant] != NULL);
+  }
+  TESTASSERT(preamble != NULL);
+
+  srsran_random_t       random_gen = srsran_random_init(0x1234);
+  srsran_channel_awgn_t awgn       = {};
+  TESTASSERT(srsran_channel_awgn_init(&awgn, 0x1234) == SRSRAN_SUCCESS);
+  // Every preamble is normalised to unit power
+  TESTASSERT(srsran_channel_awgn_set_n0(&awgn, -snr_dB) == SRSRAN_SUCCESS);
+
+  uint32_t indices[64]     = {};
+  uint32_t n_indices       = 0;
+  uint32_t nof_tx          = 0;
+  uint32_t nof_detected    = 0;
+  uint32_t nof_false       = 0;
+  uint32_t nof_false_trial = 0;
+  uint64_t elapsed_us      = 0;
+
+  for (uint32_t trial = 0; trial < 2 * nof_trials; trial++) {
+    bool with_preambles = (trial % 2) == 0;
+    bool tx[64]         = {};
+
+    for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+      srsran_vec_cf_zero(rx[ant], sf_len);
+    }
+    for (uint32_t n = 0; with_preambles && n < nof_preambles; n++) {
+      uint32_t idx = 0;
+      do {
+        idx = (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, 63);
+      } while (tx[idx]);
+      tx[idx] = true;
+      nof_tx++;
+
+      TESTASSERT(srsran_prach_gen(&prach, idx, prach_cfg.freq_offset, preamble) == SRSRAN_SUCCESS);
+      float    scale = 1.0f / sqrtf(srsran_vec_avg_power_cf(preamble, prach.N_cp + prach.N_seq));
+      uint32_t delay = (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, (int)max_delay);
+      for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+        cf_t h = (srsran_random_gauss_dist(random_gen, M_SQRT1_2) +
+                  _Complex_I * srsran_random_gauss_dist(random_gen, M_SQRT1_2)) *
+                 scale;
+        for (uint32_t i = 0; i < prach.N_cp + prach.N_seq; i++) {
+          rx[ant][delay + i] += h * preamble[i];
+        }
+      }
+    }
+    for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+      srsran_channel_awgn_run_c(&awgn, rx[ant], rx[ant], sf_len);
+    }
+
+    cf_t* signal[SRSRAN_MAX_PORTS] = {};
+    for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+      signal[ant] = &rx[ant][prach.N_cp];
+    }
+
+    struct timeval t[3];
+    gettimeofday(&t[1], NULL);
+    TESTASSERT(srsran_prach_detect_offset_multi(&prach,
+                                                prach_cfg.freq_offset,
+                                                signal,
+                                                nof_rx_ant,
+                                                prach.N_seq,
+                                                indices,
+                                                NULL,
+                                                NULL,
+                                                &n_indices) == SRSRAN_SUCCESS);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_us += t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+    uint32_t nof_false_now = 0;
+    for (uint32_t i = 0; i < n_indices; i++) {
+      TESTASSERT(indices[i] < 64);
+      if (tx[indices[i]]) {
+        nof_detected++;
+        tx[indices[i]] = false;
+      } else {
+        nof_false_now++;
+      }
+    }
+    nof_false += nof_false_now;
+    if (!with_preambles && nof_false_now > 0) {
+      nof_false_trial++;
+    }
+  }
+
+  float pd  = nof_tx ? (float)nof_detected / nof_tx : 1.0f;
+  float pfa = (float)nof_false_trial / nof_trials;
+  printf("PRACH format=%d, nof_prb=%d, N_cs=%d, N_roots=%d, nof_rx_ant=%d, SNR=%+.1f dB\n",
+         preamble_format,
+         nof_prb,
+         prach.N_cs,
+         prach.N_roots,
+         nof_rx_ant,
+         snr_dB);
+  printf("  detection rate:   %.3f (%d/%d preambles)\n", pd, nof_detected, nof_tx);
+  printf("  false-alarm rate: %.3f (%d/%d empty occasions, %d false preambles in total)\n",
+         pfa,
+         nof_false_trial,
+         nof_trials,
+         nof_false);
+  printf("  throughput:       %.1f detections/s (%.1f us per occasion)\n",
+         elapsed_us ? 2e6 * nof_trials / elapsed_us : 0.0,
+         (double)elapsed_us / (2 * nof_trials));
+
+  TESTASSERT(pd >= min_pd);
+  TESTASSERT(pfa <= max_pfa);
+
+  srsran_channel_awgn_free(&awgn);
+  srsran_random_free(random_gen);
+  for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+    free(rx[ant]);
+  }
+  free(preamble);
+  srsran_prach_free(&prach);
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
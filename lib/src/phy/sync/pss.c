@@ -314,6 +314,11 @@ void srsran_pss_free(srsran_pss_t* q)
     if (q->conv_output_avg) {
       free(q->conv_output_avg);
     }
+    for (i = 0; i < 3; i++) {
+      if (q->conv_output_avg_joint[i]) {
+        free(q->conv_output_avg_joint[i]);
+      }
+    }
 
     srsran_dft_plan_free(&q->dftp_input);
     srsran_dft_plan_free(&q->idftp_input);
@@ -332,6 +337,33 @@ void srsran_pss_reset(srsran_pss_t* q)
 {
   uint32_t buffer_size = q->fft_size + q->frame_size + 1;
   srsran_vec_f_zero(q->conv_output_avg, buffer_size);
+  for (uint32_t i = 0; i < 3; i++) {
+    if (q->conv_output_avg_joint[i]) {
+      srsran_vec_f_zero(q->conv_output_avg_joint[i], buffer_size);
+    }
+  }
+}
+
+/* Allocates the correlation averages used by srsran_pss_find_pss_joint(), one for each N_id_2. They are sized for the
+ * maximum frame and FFT sizes, so the object can still be resized afterwards.
+ */
+int srsran_pss_joint_init(srsran_pss_t* q)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  uint32_t buffer_size = (q->max_fft_size + q->max_frame_size) / q->decimate + 1;
+  for (uint32_t i = 0; i < 3; i++) {
+    if (q->conv_output_avg_joint[i] == NULL) {
+      q->conv_output_avg_joint[i] = srsran_vec_f_malloc(buffer_size);
+      if (!q->conv_output_avg_joint[i]) {
+        ERROR("Error allocating memory");
+        return SRSRAN_ERROR;
+      }
+      srsran_vec_f_zero(q->conv_output_avg_joint[i], buffer_size);
+    }
+  }
+  return SRSRAN_SUCCESS;
 }
 
 /**
@@ -405,18 +437,18 @@ void srsran_pss_set_ema_alpha(srsran_pss_t* q, float alpha)
   q->ema_alpha = alpha;
 }
 
-float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t conv_output_len)
+static float compute_peak_sidelobe(const float* conv_output_avg, uint32_t corr_peak_pos, uint32_t conv_output_len)
 {
   // Find end of peak lobe to the right
   int pl_ub = corr_peak_pos + 1;
-  while (q->conv_output_avg[pl_ub + 1] <= q->conv_output_avg[pl_ub] && pl_ub < conv_output_len) {
+  while (conv_output_avg[pl_ub + 1] <= conv_output_avg[pl_ub] && pl_ub < conv_output_len) {
     pl_ub++;
   }
   // Find end of peak lobe to the left
   int pl_lb;
   if (corr_peak_pos > 2) {
     pl_lb = corr_peak_pos - 1;
-    while (q->conv_output_avg[pl_lb - 1] <= q->conv_output_avg[pl_lb] && pl_lb > 1) {
+    while (conv_output_avg[pl_lb - 1] <= conv_output_avg[pl_lb] && pl_lb > 1) {
       pl_lb--;
     }
   } else {
@@ -429,11 +461,64 @@ float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t co
   }
   int sl_distance_left = pl_lb;
 
-  int   sl_right        = pl_ub + srsran_vec_max_fi(&q->conv_output_avg[pl_ub], sl_distance_right);
-  int   sl_left         = srsran_vec_max_fi(q->conv_output_avg, sl_distance_left);
-  float side_lobe_value = SRSRAN_MAX(q->conv_output_avg[sl_right], q->conv_output_avg[sl_left]);
+  int   sl_right        = pl_ub + srsran_vec_max_fi(&conv_output_avg[pl_ub], sl_distance_right);
+  int   sl_left         = srsran_vec_max_fi(conv_output_avg, sl_distance_left);
+  float side_lobe_value = SRSRAN_MAX(conv_output_avg[sl_right], conv_output_avg[sl_left]);
 
-  return q->conv_output_avg[corr_peak_pos] / side_lobe_value;
+  return conv_output_avg[corr_peak_pos] / side_lobe_value;
+}
+
+/* Finds the peak of the correlation in q->conv_output, after averaging its modulus square into conv_output_avg.
+ * Returns the peak position in the same units as srsran_pss_find_pss()
+ */
+static int pss_find_peak(srsran_pss_t* q,
+                         uint32_t      conv_output_len,
+                         float*        conv_output_avg,
+                         float*        corr_peak_value,
+                         float*        peak_value)
+{
+  uint32_t corr_peak_pos;
+
+  // Compute modulus square
+  srsran_vec_abs_square_cf(q->conv_output, q->conv_output_abs, conv_output_len - 1);
+
+  // If enabled, average the absolute value from previous calls
+  if (q->ema_alpha < 1.0 && q->ema_alpha > 0.0) {
+    srsran_vec_sc_prod_fff(q->conv_output_abs, q->ema_alpha, q->conv_output_abs, conv_output_len - 1);
+    srsran_vec_sc_prod_fff(conv_output_avg, 1 - q->ema_alpha, conv_output_avg, conv_output_len - 1);
+
+    srsran_vec_sum_fff(q->conv_output_abs, conv_output_avg, conv_output_avg, conv_output_len - 1);
+  } else {
+    memcpy(conv_output_avg, q->conv_output_abs, sizeof(float) * (conv_output_len - 1));
+  }
+
+  /* Find maximum of the absolute value of the correlation */
+  corr_peak_pos = srsran_vec_max_fi(conv_output_avg, conv_output_len - 1);
+
+  // save absolute value
+  *peak_value = conv_output_avg[corr_peak_pos];
+
+#ifdef SRSRAN_PSS_RETURN_PSR
+  if (corr_peak_value) {
+    *corr_peak_value = compute_peak_sidelobe(conv_output_avg, corr_peak_pos, conv_output_len);
+  }
+#else
+  if (corr_peak_value) {
+    *corr_peak_value = conv_output_avg[corr_peak_pos];
+  }
+#endif
+
+  if (q->decimate > 1) {
+    int decimation_correction = (q->filter.num_taps - 2);
+    corr_peak_pos             = corr_peak_pos - decimation_correction;
+    corr_peak_pos             = corr_peak_pos * q->decimate;
+  }
+
+  if (q->frame_size >= q->fft_size) {
+    return (int)corr_peak_pos;
+  } else {
+    return (int)corr_peak_pos + q->fft_size;
+  }
 }
 
 /** Performs time-domain PSS correlation.
@@ -448,7 +533,6 @@ int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_val
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
 
   if (q != NULL && input != NULL) {
-    uint32_t corr_peak_pos;
     uint32_t conv_output_len;
 
     if (!srsran_N_id_2_isvalid(q->N_id_2)) {
@@ -489,48 +573,59 @@ int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_val
       conv_output_len = q->frame_size;
     }
 
-    // Compute modulus square
-    srsran_vec_abs_square_cf(q->conv_output, q->conv_output_abs, conv_output_len - 1);
-
-    // If enabled, average the absolute value from previous calls
-    if (q->ema_alpha < 1.0 && q->ema_alpha > 0.0) {
-      srsran_vec_sc_prod_fff(q->conv_output_abs, q->ema_alpha, q->conv_output_abs, conv_output_len - 1);
-      srsran_vec_sc_prod_fff(q->conv_output_avg, 1 - q->ema_alpha, q->conv_output_avg, conv_output_len - 1);
-
-      srsran_vec_sum_fff(q->conv_output_abs, q->conv_output_avg, q->conv_output_avg, conv_output_len - 1);
-    } else {
-      memcpy(q->conv_output_avg, q->conv_output_abs, sizeof(float) * (conv_output_len - 1));
-    }
+    ret = pss_find_peak(q, conv_output_len, q->conv_output_avg, corr_peak_value, &q->peak_value);
+  }
+  return ret;
+}
 
-    /* Find maximum of the absolute value of the correlation */
-    corr_peak_pos = srsran_vec_max_fi(q->conv_output_avg, conv_output_len - 1);
+/** Correlates the input with the PSS sequences of the three N_id_2 at once. The input is transformed to the
+ * frequency domain only once and multiplied by each of the PSS replicas. Each N_id_2 keeps its own correlation
+ * average, hence srsran_pss_joint_init() must be called first.
+ *
+ * The peak position, the value returned by srsran_pss_find_pss() in corr_peak_value and the absolute peak value of
+ * each N_id_2 are stored in the arrays indexed by N_id_2. Input buffer must be frame_size long.
+ */
+int srsran_pss_find_pss_joint(srsran_pss_t* q,
+                              const cf_t*   input,
+                              int           peak_pos[3],
+                              float         corr_peak_value[3],
+                              float         peak_value[3])
+{
+#ifdef CONVOLUTION_FFT
+  if (q == NULL || input == NULL || peak_pos == NULL || peak_value == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (q->conv_output_avg_joint[0] == NULL || q->frame_size < q->fft_size) {
+    ERROR("Error finding joint PSS peak, joint search not initiated or frame too short");
+    return SRSRAN_ERROR;
+  }
 
-    // save absolute value
-    q->peak_value = q->conv_output_avg[corr_peak_pos];
+  memcpy(q->tmp_input, input, (q->frame_size * q->decimate) * sizeof(cf_t));
+  if (q->decimate > 1) {
+    srsran_filt_decim_cc_execute(&(q->filter),
+                                 q->tmp_input,
+                                 q->filter.downsampled_input,
+                                 q->filter.filter_output,
+                                 (q->frame_size * q->decimate));
+    srsran_conv_fft_cc_run_input(&q->conv_fft, q->filter.filter_output);
+  } else {
+    srsran_conv_fft_cc_run_input(&q->conv_fft, q->tmp_input);
+  }
 
-#ifdef SRSRAN_PSS_RETURN_PSR
-    if (corr_peak_value) {
-      *corr_peak_value = compute_peak_sidelobe(q, corr_peak_pos, conv_output_len);
-    }
+  for (uint32_t N_id_2 = 0; N_id_2 < 3; N_id_2++) {
+    uint32_t conv_output_len =
+        srsran_conv_fft_cc_run_filter(&q->conv_fft, q->pss_signal_freq_full[N_id_2], q->conv_output);
+    peak_pos[N_id_2] = pss_find_peak(q,
+                                     conv_output_len,
+                                     q->conv_output_avg_joint[N_id_2],
+                                     corr_peak_value ? &corr_peak_value[N_id_2] : NULL,
+                                     &peak_value[N_id_2]);
+  }
+  return SRSRAN_SUCCESS;
 #else
-    if (corr_peak_value) {
-      *corr_peak_value = q->conv_output_avg[corr_peak_pos];
-    }
+  ERROR("Joint PSS search requires CONVOLUTION_FFT");
+  return SRSRAN_ERROR;
 #endif
-
-    if (q->decimate > 1) {
-      int decimation_correction = (q->filter.num_taps - 2);
-      corr_peak_pos             = corr_peak_pos - decimation_correction;
-      corr_peak_pos             = corr_peak_pos * q->decimate;
-    }
-
-    if (q->frame_size >= q->fft_size) {
-      ret = (int)corr_peak_pos;
-    } else {
-      ret = (int)corr_peak_pos + q->fft_size;
-    }
-  }
-  return ret;
 }
 
 /* Computes frequency-domain channel estimation of the PSS symbol
@@ -616,6 +616,141 @@ static int cfo_i_estimate(srsran_sync_t* q, const cf_t* input, int find_offset,
   return 0;
 }
 
+/* Runs the stages that follow the PSS correlation, given the PSS peak position relative to find_offset: PSS-based CFO
+ * estimation, SSS correlation and CP detection.
+ */
+static srsran_sync_find_ret_t
+sync_find_post_pss(srsran_sync_t* q, const cf_t* input_ptr, uint32_t find_offset, int peak_pos)
+{
+  srsran_sync_find_ret_t ret = SRSRAN_SYNC_ERROR;
+
+  // In case of decimation, this compensates for the constant time shift caused by the low pass filter
+  if (q->decimate && peak_pos < 0) {
+    peak_pos = 0; // peak_pos + q->decimate*(2);// replace 2 with q->filter_size -2;
+  }
+
+  /* If peak is over threshold, compute CFO and SSS */
+  if (q->peak_value >= q->threshold || q->threshold == 0) {
+    if (q->cfo_pss_enable && peak_pos >= q->fft_size) {
+      // Filter central bands before PSS-based CFO estimation
+      const cf_t* pss_ptr = &input_ptr[find_offset + peak_pos - q->fft_size];
+      if (q->pss_filtering_enabled) {
+        srsran_pss_filter(&q->pss, pss_ptr, q->pss_filt);
+        pss_ptr = q->pss_filt;
+      }
+
+      // PSS-based CFO estimation
+      q->cfo_pss = srsran_pss_cfo_compute(&q->pss, pss_ptr);
+      if (!q->cfo_pss_is_set) {
+        q->cfo_pss_mean   = q->cfo_pss;
+        q->cfo_pss_is_set = true;
+      } else if (15000 * fabsf(q->cfo_pss) < MAX_CFO_PSS_OFFSET) {
+        q->cfo_pss_mean = SRSRAN_VEC_EMA(q->cfo_pss, q->cfo_pss_mean, q->cfo_ema_alpha);
+      }
+
+      DEBUG("PSS-CFO: filter=%s, estimated=%f, mean=%f",
+            q->pss_filtering_enabled ? "yes" : "no",
+            q->cfo_pss,
+            q->cfo_pss_mean);
+    }
+
+    // If there is enough space for CP and SSS estimation
+    if (peak_pos + find_offset >= 2 * (q->fft_size + SRSRAN_CP_LEN_EXT(q->fft_size))) {
+      // If SSS search is enabled, correlate SSS sequence
+      if (q->sss_en) {
+        int                 sss_idx;
+        uint32_t            nof_frame_type_trials;
+        srsran_frame_type_t frame_type_trials[2];
+        float               sss_corr[2] = {};
+        uint32_t            sf_idx[2], N_id_1[2];
+
+        if (q->detect_frame_type) {
+          nof_frame_type_trials = 2;
+          frame_type_trials[0]  = SRSRAN_FDD;
+          frame_type_trials[1]  = SRSRAN_TDD;
+        } else {
+          frame_type_trials[0]  = q->frame_type;
+          nof_frame_type_trials = 1;
+        }
+
+        q->sss_available = true;
+        q->sss_detected  = false;
+        for (uint32_t f = 0; f < nof_frame_type_trials; f++) {
+          if (frame_type_trials[f] == SRSRAN_FDD) {
+            sss_idx = (int)find_offset + peak_pos - 2 * SRSRAN_SYMBOL_SZ(q->fft_size, q->cp) +
+                      SRSRAN_CP_SZ(q->fft_size, q->cp);
+          } else {
+            sss_idx = (int)find_offset + peak_pos - 4 * SRSRAN_SYMBOL_SZ(q->fft_size, q->cp) +
+                      SRSRAN_CP_SZ(q->fft_size, q->cp);
+            ;
+          }
+
+          if (sss_idx >= 0) {
+            const cf_t* sss_ptr = &input_ptr[sss_idx];
+
+            // Correct CFO if detected in PSS
+            if (q->cfo_pss_enable) {
+              srsran_cfo_correct(&q->cfo_corr_symbol, sss_ptr, q->sss_filt, -q->cfo_pss_mean / q->fft_size);
+              // Equalize channel if estimated in PSS
+              if (q->sss_channel_equalize && q->pss.chest_on_filter && q->pss_filtering_enabled) {
+                srsran_vec_prod_ccc(&q->sss_filt[q->fft_size / 2 - SRSRAN_PSS_LEN / 2],
+                                    q->pss.tmp_ce,
+                                    &q->sss_filt[q->fft_size / 2 - SRSRAN_PSS_LEN / 2],
+                                    SRSRAN_PSS_LEN);
+              }
+              sss_ptr = q->sss_filt;
+            }
+
+            // Consider SSS detected if at least one trial found the SSS
+            q->sss_detected |= sync_sss_symbol(q, sss_ptr, &sf_idx[f], &N_id_1[f], &sss_corr[f]);
+          } else {
+            q->sss_available = false;
+          }
+        }
+
+        if (q->detect_frame_type) {
+          if (sss_corr[0] > sss_corr[1]) {
+            q->frame_type = SRSRAN_FDD;
+            q->sf_idx     = sf_idx[0];
+            q->N_id_1     = N_id_1[0];
+            q->sss_corr   = sss_corr[0];
+          } else {
+            q->frame_type = SRSRAN_TDD;
+            q->sf_idx     = sf_idx[1] + 1;
+            q->N_id_1     = N_id_1[1];
+            q->sss_corr   = sss_corr[1];
+          }
+          DEBUG("SYNC: Detected SSS %s, corr=%.2f/%.2f",
+                q->frame_type == SRSRAN_FDD ? "FDD" : "TDD",
+                sss_corr[0],
+                sss_corr[1]);
+        } else if (q->sss_detected) {
+          if (q->frame_type == SRSRAN_FDD) {
+            q->sf_idx = sf_idx[0];
+          } else {
+            q->sf_idx = sf_idx[0] + 1;
+          }
+          q->N_id_1   = N_id_1[0];
+          q->sss_corr = sss_corr[0];
+        }
+      }
+
+      // Detect CP length
+      if (q->detect_cp) {
+        srsran_sync_set_cp(q, srsran_sync_detect_cp(q, input_ptr, peak_pos + find_offset));
+      }
+
+      ret = SRSRAN_SYNC_FOUND;
+    } else {
+      ret = SRSRAN_SYNC_FOUND_NOSPACE;
+    }
+  } else {
+    ret = SRSRAN_SYNC_NOFOUND;
+  }
+
+  return ret;
+}
+
 /** Finds the PSS sequence previously defined by a call to srsran_sync_set_N_id_2()
  * around the position find_offset in the buffer input.
  *
@@ -701,145 +836,149 @@ srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint
       *peak_position = (uint32_t)peak_pos;
     }
 
-    // In case of decimation, this compensates for the constant time shift caused by the low pass filter
-    if (q->decimate && peak_pos < 0) {
-      peak_pos = 0; // peak_pos + q->decimate*(2);// replace 2 with q->filter_size -2;
-    }
+    ret = sync_find_post_pss(q, input_ptr, find_offset, peak_pos);
 
-    /* If peak is over threshold, compute CFO and SSS */
-    if (q->peak_value >= q->threshold || q->threshold == 0) {
-      if (q->cfo_pss_enable && peak_pos >= q->fft_size) {
-        // Filter central bands before PSS-based CFO estimation
-        const cf_t* pss_ptr = &input_ptr[find_offset + peak_pos - q->fft_size];
-        if (q->pss_filtering_enabled) {
-          srsran_pss_filter(&q->pss, pss_ptr, q->pss_filt);
-          pss_ptr = q->pss_filt;
-        }
+    DEBUG("SYNC ret=%d N_id_2=%d find_offset=%d frame_len=%d, pos=%d peak=%.2f threshold=%.2f CFO=%.3f kHz",
+          ret,
+          q->N_id_2,
+          find_offset,
+          q->frame_size,
+          peak_pos,
+          q->peak_value,
+          q->threshold,
+          15 * (srsran_sync_get_cfo(q)));
 
-        // PSS-based CFO estimation
-        q->cfo_pss = srsran_pss_cfo_compute(&q->pss, pss_ptr);
-        if (!q->cfo_pss_is_set) {
-          q->cfo_pss_mean   = q->cfo_pss;
-          q->cfo_pss_is_set = true;
-        } else if (15000 * fabsf(q->cfo_pss) < MAX_CFO_PSS_OFFSET) {
-          q->cfo_pss_mean = SRSRAN_VEC_EMA(q->cfo_pss, q->cfo_pss_mean, q->cfo_ema_alpha);
-        }
+  } else if (!srsran_N_id_2_isvalid(q->N_id_2)) {
+    ERROR("Must call srsran_sync_set_N_id_2() first!");
+  }
 
-        DEBUG("PSS-CFO: filter=%s, estimated=%f, mean=%f",
-              q->pss_filtering_enabled ? "yes" : "no",
-              q->cfo_pss,
-              q->cfo_pss_mean);
-      }
+  return ret;
+}
 
-      // If there is enough space for CP and SSS estimation
-      if (peak_pos + find_offset >= 2 * (q->fft_size + SRSRAN_CP_LEN_EXT(q->fft_size))) {
-        // If SSS search is enabled, correlate SSS sequence
-        if (q->sss_en) {
-          int                 sss_idx;
-          uint32_t            nof_frame_type_trials;
-          srsran_frame_type_t frame_type_trials[2];
-          float               sss_corr[2] = {};
-          uint32_t            sf_idx[2], N_id_1[2];
-
-          if (q->detect_frame_type) {
-            nof_frame_type_trials = 2;
-            frame_type_trials[0]  = SRSRAN_FDD;
-            frame_type_trials[1]  = SRSRAN_TDD;
-          } else {
-            frame_type_trials[0]  = q->frame_type;
-            nof_frame_type_trials = 1;
-          }
+int srsran_sync_joint_reset(srsran_sync_t* q, srsran_sync_joint_t joint[3])
+{
+  if (q == NULL || joint == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-          q->sss_available = true;
-          q->sss_detected  = false;
-          for (uint32_t f = 0; f < nof_frame_type_trials; f++) {
-            if (frame_type_trials[f] == SRSRAN_FDD) {
-              sss_idx = (int)find_offset + peak_pos - 2 * SRSRAN_SYMBOL_SZ(q->fft_size, q->cp) +
-                        SRSRAN_CP_SZ(q->fft_size, q->cp);
-            } else {
-              sss_idx = (int)find_offset + peak_pos - 4 * SRSRAN_SYMBOL_SZ(q->fft_size, q->cp) +
-                        SRSRAN_CP_SZ(q->fft_size, q->cp);
-              ;
-            }
+  // The per-N_id_2 correlation averages are only allocated the first time
+  if (srsran_pss_joint_init(&q->pss)) {
+    ERROR("Error initiating joint PSS search");
+    return SRSRAN_ERROR;
+  }
+  srsran_pss_reset(&q->pss);
 
-            if (sss_idx >= 0) {
-              const cf_t* sss_ptr = &input_ptr[sss_idx];
-
-              // Correct CFO if detected in PSS
-              if (q->cfo_pss_enable) {
-                srsran_cfo_correct(&q->cfo_corr_symbol, sss_ptr, q->sss_filt, -q->cfo_pss_mean / q->fft_size);
-                // Equalize channel if estimated in PSS
-                if (q->sss_channel_equalize && q->pss.chest_on_filter && q->pss_filtering_enabled) {
-                  srsran_vec_prod_ccc(&q->sss_filt[q->fft_size / 2 - SRSRAN_PSS_LEN / 2],
-                                      q->pss.tmp_ce,
-                                      &q->sss_filt[q->fft_size / 2 - SRSRAN_PSS_LEN / 2],
-                                      SRSRAN_PSS_LEN);
-                }
-                sss_ptr = q->sss_filt;
-              }
+  for (uint32_t N_id_2 = 0; N_id_2 < 3; N_id_2++) {
+    bzero(&joint[N_id_2], sizeof(srsran_sync_joint_t));
+    joint[N_id_2].cp         = q->cp;
+    joint[N_id_2].frame_type = q->frame_type;
+  }
+  return SRSRAN_SUCCESS;
+}
 
-              // Consider SSS detected if at least one trial found the SSS
-              q->sss_detected |= sync_sss_symbol(q, sss_ptr, &sf_idx[f], &N_id_1[f], &sss_corr[f]);
-            } else {
-              q->sss_available = false;
-            }
-          }
+/** Finds the PSS of the three N_id_2 in the same input signal, correlating it with the three PSS sequences using a
+ * single FFT of the input. For each N_id_2 whose peak exceeds the threshold, the SSS, CP and PSS-based CFO are then
+ * estimated as srsran_sync_find() does. The state that is averaged across calls is kept separately for each N_id_2 in
+ * joint, which must be initialized with srsran_sync_joint_reset().
+ *
+ * The input buffer must contain find_offset samples of history followed by frame_size new samples, so that the SSS
+ * and CP of a PSS found at the start of the new samples can still be detected. CP-based CFO is common to all cells
+ * and integer CFO estimation is not supported.
+ *
+ * Returns SRSRAN_SUCCESS and the result of each N_id_2 in joint, or a negative number on error.
+ */
+int srsran_sync_find_joint(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, srsran_sync_joint_t joint[3])
+{
+  int   peak_pos[3];
+  float peak_value[3];
+  float pss_peak[3];
 
-          if (q->detect_frame_type) {
-            if (sss_corr[0] > sss_corr[1]) {
-              q->frame_type = SRSRAN_FDD;
-              q->sf_idx     = sf_idx[0];
-              q->N_id_1     = N_id_1[0];
-              q->sss_corr   = sss_corr[0];
-            } else {
-              q->frame_type = SRSRAN_TDD;
-              q->sf_idx     = sf_idx[1] + 1;
-              q->N_id_1     = N_id_1[1];
-              q->sss_corr   = sss_corr[1];
-            }
-            DEBUG("SYNC: Detected SSS %s, corr=%.2f/%.2f",
-                  q->frame_type == SRSRAN_FDD ? "FDD" : "TDD",
-                  sss_corr[0],
-                  sss_corr[1]);
-          } else if (q->sss_detected) {
-            if (q->frame_type == SRSRAN_FDD) {
-              q->sf_idx = sf_idx[0];
-            } else {
-              q->sf_idx = sf_idx[0] + 1;
-            }
-            q->N_id_1   = N_id_1[0];
-            q->sss_corr = sss_corr[0];
-          }
-        }
+  if (q == NULL || input == NULL || joint == NULL || !fft_size_isvalid(q->fft_size)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (q->cfo_i_enable) {
+    ERROR("Joint PSS search does not support integer CFO estimation");
+    return SRSRAN_ERROR;
+  }
+  if (find_offset > q->frame_size) {
+    ERROR("Joint PSS search history (%d) can not exceed the frame size (%d)", find_offset, q->frame_size);
+    return SRSRAN_ERROR;
+  }
 
-        // Detect CP length
-        if (q->detect_cp) {
-          srsran_sync_set_cp(q, srsran_sync_detect_cp(q, input_ptr, peak_pos + find_offset));
-        }
+  const cf_t* input_ptr = input;
 
-        ret = SRSRAN_SYNC_FOUND;
-      } else {
-        ret = SRSRAN_SYNC_FOUND_NOSPACE;
-      }
+  // The CP-based CFO is estimated on the new samples and corrects the history too, which the SSS may fall into
+  if (q->cfo_cp_enable) {
+    float cfo_cp = cfo_cp_estimate(q, &input[find_offset]);
+
+    if (!q->cfo_cp_is_set) {
+      q->cfo_cp_mean   = cfo_cp;
+      q->cfo_cp_is_set = true;
     } else {
-      ret = SRSRAN_SYNC_NOFOUND;
+      q->cfo_cp_mean = SRSRAN_VEC_EMA(cfo_cp, q->cfo_cp_mean, q->cfo_ema_alpha);
     }
 
-    DEBUG("SYNC ret=%d N_id_2=%d find_offset=%d frame_len=%d, pos=%d peak=%.2f threshold=%.2f CFO=%.3f kHz",
-          ret,
-          q->N_id_2,
-          find_offset,
-          q->frame_size,
-          peak_pos,
-          q->peak_value,
+    DEBUG("CP-CFO: estimated=%f, mean=%f", cfo_cp, q->cfo_cp_mean);
+
+    srsran_vec_apply_cfo(input, -q->cfo_cp_mean / q->fft_size, q->temp, find_offset + q->frame_size);
+    input_ptr = q->temp;
+  }
+
+  if (srsran_pss_find_pss_joint(&q->pss, &input_ptr[find_offset], peak_pos, peak_value, pss_peak) < 0) {
+    ERROR("Error calling finding joint PSS sequence");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t N_id_2 = 0; N_id_2 < 3; N_id_2++) {
+    srsran_sync_joint_t* j = &joint[N_id_2];
+
+    // Restore the state of this N_id_2
+    q->N_id_2         = N_id_2;
+    q->peak_value     = peak_value[N_id_2];
+    q->pss.peak_value = pss_peak[N_id_2];
+    q->cfo_pss_mean   = j->cfo_pss_mean;
+    q->cfo_pss_is_set = j->cfo_pss_is_set;
+    q->M_norm_avg     = j->M_norm_avg;
+    q->M_ext_avg      = j->M_ext_avg;
+    q->sss_detected   = false;
+    q->sss_available  = false;
+    srsran_pss_set_N_id_2(&q->pss, N_id_2);
+    srsran_sync_set_cp(q, j->cp);
+    if (q->detect_frame_type) {
+      q->frame_type = j->frame_type;
+    }
+
+    j->ret = sync_find_post_pss(q, input_ptr, find_offset, peak_pos[N_id_2]);
+
+    // Save the state and the results of this N_id_2
+    j->cfo_pss_mean   = q->cfo_pss_mean;
+    j->cfo_pss_is_set = q->cfo_pss_is_set;
+    j->M_norm_avg     = q->M_norm_avg;
+    j->M_ext_avg      = q->M_ext_avg;
+    j->cp             = q->cp;
+    j->frame_type     = q->frame_type;
+    j->peak_pos       = (uint32_t)SRSRAN_MAX(peak_pos[N_id_2], 0);
+    j->peak_value     = q->peak_value;
+    j->pss_peak       = pss_peak[N_id_2];
+    j->sss_detected   = q->sss_detected;
+    j->sf_idx         = q->sf_idx;
+    j->cell_id        = srsran_sync_get_cell_id(q);
+    j->cfo            = srsran_sync_get_cfo(q);
+
+    DEBUG("SYNC joint ret=%d N_id_2=%d pos=%d peak=%.2f threshold=%.2f CFO=%.3f kHz",
+          j->ret,
+          N_id_2,
+          peak_pos[N_id_2],
+          j->peak_value,
           q->threshold,
-          15 * (srsran_sync_get_cfo(q)));
+          15 * j->cfo);
 
-  } else if (!srsran_N_id_2_isvalid(q->N_id_2)) {
-    ERROR("Must call srsran_sync_set_N_id_2() first!");
+    if (j->ret == SRSRAN_SYNC_ERROR) {
+      return SRSRAN_ERROR;
+    }
   }
 
-  return ret;
+  return SRSRAN_SUCCESS;
 }
 
 void srsran_sync_reset(srsran_sync_t* q)
@@ -0,0 +1,223 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/dft/ofdm.h"
+#include "srsran/phy/sync/pss.h"
+#include "srsran/phy/sync/sss.h"
+#include "srsran/phy/ue/ue_cell_search.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <getopt.h>
+#include <stdlib.h>
+
+// One cell per N_id_2, each with a different timing and power
+static uint32_t cell_id[3]    = {150, 301, 44};
+static uint32_t cell_delay[3] = {0, 2700, 6100}; // In samples at 1.92 MHz
+static float    cell_gain[3]  = {1.0f, 0.8f, 0.6f};
+
+// Test and channel parameters
+static float    n0_dB      = -25.0f; // Noise floor in dB relative to full-scale
+static uint32_t max_frames = 8;      // Maximum number of 5 ms frames per search
+
+// Test context
+static uint32_t              sf_len    = 0;    // Subframe length
+static uint32_t              frame_len = 0;    // Radio frame length
+static cf_t*                 frame     = NULL; // Periodic radio frame of the three cells
+static uint32_t              frame_pos = 0;    // Current position in the radio frame
+static uint64_t              nof_rx    = 0;    // Number of received samples
+static srsran_channel_awgn_t awgn;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nv]\n", prog);
+  printf("\t-n noise floor in dBfs [Default %.1f]\n", n0_dB);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nv")) != -1) {
+    switch (opt) {
+      case 'n':
+        n0_dB = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static int recv_callback(void* h, cf_t* data[SRSRAN_MAX_CHANNELS], uint32_t nsamples, srsran_timestamp_t* t)
+{
+  for (uint32_t i = 0; i < nsamples; i++) {
+    data[0][i] = frame[frame_pos];
+    frame_pos  = (frame_pos + 1) % frame_len;
+  }
+  srsran_channel_awgn_run_c(&awgn, data[0], data[0], nsamples);
+  nof_rx += nsamples;
+  return (int)nsamples;
+}
+
+/* Adds to the radio frame the PSS, SSS and random QPSK data of a cell */
+static int add_cell(uint32_t id, uint32_t delay, float gain)
+{
+  int           ret        = SRSRAN_ERROR;
+  uint32_t      nof_re     = SRSRAN_SF_LEN_RE(SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+  cf_t*         sf_symbols = srsran_vec_cf_malloc(nof_re);
+  cf_t*         sf_buffer  = srsran_vec_cf_malloc(sf_len);
+  cf_t          pss_signal[SRSRAN_PSS_LEN];
+  float         sss_signal[2][SRSRAN_SSS_LEN];
+  srsran_ofdm_t ifft = {};
+
+  if (!sf_symbols || !sf_buffer) {
+    goto clean_exit;
+  }
+  if (srsran_ofdm_tx_init(&ifft, SRSRAN_CP_NORM, sf_symbols, sf_buffer, SRSRAN_CS_NOF_PRB)) {
+    ERROR("Error creating iFFT object");
+    goto clean_exit;
+  }
+
+  srsran_pss_generate(pss_signal, id % 3);
+  srsran_sss_generate(sss_signal[0], sss_signal[1], id);
+
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    // Random data so that the CP-based CFO estimation sees a loaded cell
+    for (uint32_t i = 0; i < nof_re; i++) {
+      sf_symbols[i] = 0.1f * ((rand() % 2 ? 1.0f : -1.0f) + _Complex_I * (rand() % 2 ? 1.0f : -1.0f)) / sqrtf(2.0f);
+    }
+    if (sf_idx == 0 || sf_idx == 5) {
+      srsran_pss_put_slot(pss_signal, sf_symbols, SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+      srsran_sss_put_slot(sss_signal[sf_idx / 5], sf_symbols, SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+    }
+    srsran_ofdm_tx_sf(&ifft);
+
+    for (uint32_t i = 0; i < sf_len; i++) {
+      frame[(delay + sf_idx * sf_len + i) % frame_len] += gain * sf_buffer[i];
+    }
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_ofdm_tx_free(&ifft);
+  if (sf_symbols) {
+    free(sf_symbols);
+  }
+  if (sf_buffer) {
+    free(sf_buffer);
+  }
+  return ret;
+}
+
+/* Searches the cells with or without joint search, and saves the number of received samples */
+static int test_search(bool joint, uint64_t* nof_samples)
+{
+  srsran_ue_cellsearch_t        cs = {};
+  srsran_ue_cellsearch_result_t found_cells[3];
+  uint32_t                      max_N_id_2 = 3;
+  int                           dummy      = 0;
+
+  bzero(found_cells, sizeof(found_cells));
+  TESTASSERT(srsran_ue_cellsearch_init_multi(&cs, max_frames, recv_callback, 1, &dummy) == SRSRAN_SUCCESS);
+  srsran_ue_cellsearch_set_nof_valid_frames(&cs, 4);
+  srsran_ue_cellsearch_set_joint_search(&cs, joint);
+
+  nof_rx    = 0;
+  frame_pos = 0;
+  TESTASSERT(srsran_ue_cellsearch_scan(&cs, found_cells, &max_N_id_2) == 3);
+
+  // TEST: all the cells are found, and the strongest one is selected
+  for (uint32_t N_id_2 = 0; N_id_2 < 3; N_id_2++) {
+    printf("%s search: N_id_2=%d, cell_id=%d, CP=%s, %s, PSR=%.2f, CFO=%+.1f Hz\n",
+           joint ? "Joint" : "Serial",
+           N_id_2,
+           found_cells[N_id_2].cell_id,
+           srsran_cp_string(found_cells[N_id_2].cp),
+           found_cells[N_id_2].frame_type == SRSRAN_FDD ? "FDD" : "TDD",
+           found_cells[N_id_2].psr,
+           found_cells[N_id_2].cfo);
+    TESTASSERT(found_cells[N_id_2].cell_id == cell_id[N_id_2]);
+    TESTASSERT(found_cells[N_id_2].cp == SRSRAN_CP_NORM);
+    TESTASSERT(found_cells[N_id_2].frame_type == SRSRAN_FDD);
+  }
+  TESTASSERT(max_N_id_2 == 0);
+
+  srsran_ue_cellsearch_free(&cs);
+
+  *nof_samples = nof_rx;
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+  srand(0);
+
+  sf_len    = SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB);
+  frame_len = SRSRAN_NOF_SF_X_FRAME * sf_len;
+  frame     = srsran_vec_cf_malloc(frame_len);
+  if (!frame) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+  srsran_vec_cf_zero(frame, frame_len);
+
+  if (srsran_channel_awgn_init(&awgn, 0x1234)) {
+    ERROR("Error initiating AWGN");
+    goto clean_exit;
+  }
+  srsran_channel_awgn_set_n0(&awgn, n0_dB);
+
+  for (uint32_t i = 0; i < 3; i++) {
+    if (add_cell(cell_id[i], cell_delay[i], cell_gain[i])) {
+      goto clean_exit;
+    }
+  }
+
+  uint64_t nof_rx_serial = 0;
+  uint64_t nof_rx_joint  = 0;
+  if (test_search(false, &nof_rx_serial) || test_search(true, &nof_rx_joint)) {
+    goto clean_exit;
+  }
+  printf("Received samples: serial=%" PRIu64 ", joint=%" PRIu64 "\n", nof_rx_serial, nof_rx_joint);
+
+  // TEST: the joint search captures the frames once for the three N_id_2
+  if (nof_rx_joint < nof_rx_serial) {
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  if (frame) {
+    free(frame);
+  }
+  srsran_channel_awgn_free(&awgn);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
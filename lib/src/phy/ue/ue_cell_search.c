@@ -33,6 +33,9 @@
 
 #define CELL_SEARCH_BUFFER_MAX_SAMPLES (3 * SRSRAN_SF_LEN_MAX)
 
+// Samples kept from the previous capture in joint search, enough for the TDD SSS and the CP detection
+#define CELL_SEARCH_JOINT_HISTORY(fft_size) (5 * ((fft_size) + SRSRAN_CP_LEN_EXT(fft_size)))
+
 int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
                               uint32_t                max_frames,
                               int(recv_callback)(void*, void*, uint32_t, srsran_timestamp_t*),
@@ -66,7 +69,7 @@ int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
     q->sf_buffer[0]    = srsran_vec_cf_malloc(CELL_SEARCH_BUFFER_MAX_SAMPLES);
     q->nof_rx_antennas = 1;
 
-    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), max_frames);
+    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), 3 * max_frames);
     if (!q->candidates) {
       perror("malloc");
       goto clean_exit;
@@ -128,7 +131,7 @@ int srsran_ue_cellsearch_init_multi(
     }
     q->nof_rx_antennas = nof_rx_antennas;
 
-    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), max_frames);
+    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), 3 * max_frames);
     if (!q->candidates) {
       perror("malloc");
       goto clean_exit;
@@ -193,8 +196,16 @@ void srsran_set_detect_cp(srsran_ue_cellsearch_t* q, bool enable)
   srsran_ue_sync_cp_en(&q->ue_sync, enable);
 }
 
+void srsran_ue_cellsearch_set_joint_search(srsran_ue_cellsearch_t* q, bool enable)
+{
+  q->joint_search = enable;
+}
+
 /* Decide the most likely cell based on the mode */
-static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, srsran_ue_cellsearch_result_t* found_cell)
+static void get_cell(srsran_ue_cellsearch_t*        q,
+                     srsran_ue_cellsearch_result_t* candidates,
+                     uint32_t                       nof_detected_frames,
+                     srsran_ue_cellsearch_result_t* found_cell)
 {
   uint32_t i, j;
 
@@ -205,7 +216,7 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
   for (i = 0; i < nof_detected_frames; i++) {
     uint32_t cnt = 1;
     for (j = i + 1; j < nof_detected_frames; j++) {
-      if (q->candidates[j].cell_id == q->candidates[i].cell_id && !q->mode_counted[j]) {
+      if (candidates[j].cell_id == candidates[i].cell_id && !q->mode_counted[j]) {
         q->mode_counted[j] = 1;
         cnt++;
       }
@@ -219,22 +230,22 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
       mode_pos  = i;
     }
   }
-  found_cell->cell_id = q->candidates[mode_pos].cell_id;
+  found_cell->cell_id = candidates[mode_pos].cell_id;
   /* Now in all these cell IDs, find most frequent CP and duplex mode */
   uint32_t nof_normal = 0;
   uint32_t nof_fdd    = 0;
   found_cell->peak    = 0;
   for (i = 0; i < nof_detected_frames; i++) {
-    if (q->candidates[i].cell_id == found_cell->cell_id) {
-      if (SRSRAN_CP_ISNORM(q->candidates[i].cp)) {
+    if (candidates[i].cell_id == found_cell->cell_id) {
+      if (SRSRAN_CP_ISNORM(candidates[i].cp)) {
         nof_normal++;
       }
-      if (q->candidates[i].frame_type == SRSRAN_FDD) {
+      if (candidates[i].frame_type == SRSRAN_FDD) {
         nof_fdd++;
       }
     }
     // average absolute peak value
-    found_cell->peak += q->candidates[i].peak;
+    found_cell->peak += candidates[i].peak;
   }
   found_cell->peak /= nof_detected_frames;
 
@@ -251,15 +262,16 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
   found_cell->mode = (float)q->mode_ntimes[mode_pos] / nof_detected_frames;
 
   // PSR is already averaged so take the last value
-  found_cell->psr = q->candidates[nof_detected_frames - 1].psr;
+  found_cell->psr = candidates[nof_detected_frames - 1].psr;
 
   // CFO is also already averaged
-  found_cell->cfo = q->candidates[nof_detected_frames - 1].cfo;
+  found_cell->cfo = candidates[nof_detected_frames - 1].cfo;
 }
 
 /** Finds up to 3 cells, one per each N_id_2=0,1,2 and stores ID and CP in the structure pointed by found_cell.
  * Each position in found_cell corresponds to a different N_id_2.
  * Saves in the pointer max_N_id_2 the N_id_2 index of the cell with the highest PSR
+ * If joint search is enabled, the three N_id_2 are searched in the same frames by srsran_ue_cellsearch_scan_joint()
  * Returns the number of found cells or a negative number if error
  */
 int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
@@ -270,6 +282,11 @@ int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
   float    max_peak_value     = -1.0;
   uint32_t nof_detected_cells = 0;
 
+  // Integer CFO estimation is only supported when searching one N_id_2 at a time
+  if (q->joint_search && !q->ue_sync.sfind.cfo_i_enable) {
+    return srsran_ue_cellsearch_scan_joint(q, found_cells, max_N_id_2);
+  }
+
   for (uint32_t N_id_2 = 0; N_id_2 < 3; N_id_2++) {
     INFO("CELL SEARCH: Starting scan for N_id_2=%d", N_id_2);
     ret = srsran_ue_cellsearch_scan_N_id_2(q, N_id_2, &found_cells[N_id_2]);
@@ -288,6 +305,127 @@ int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
   return nof_detected_cells;
 }
 
+/** Same as srsran_ue_cellsearch_scan() but each 5 ms frame is received only once and correlated with the PSS of the
+ * three N_id_2 together, instead of scanning max_frames frames for each N_id_2. Some samples of the previous frame are
+ * kept in front of the new ones, so that no realignment is needed to detect the SSS of a PSS close to the frame start.
+ * Returns the number of found cells or a negative number if error
+ */
+int srsran_ue_cellsearch_scan_joint(srsran_ue_cellsearch_t*       q,
+                                    srsran_ue_cellsearch_result_t found_cells[3],
+                                    uint32_t*                     max_N_id_2)
+{
+  if (q == NULL || found_cells == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  srsran_ue_sync_t* ue_sync                  = &q->ue_sync;
+  uint32_t          frame_len                = ue_sync->frame_len;
+  uint32_t          history                  = CELL_SEARCH_JOINT_HISTORY(ue_sync->fft_size);
+  uint32_t          nof_detected[3]          = {};
+  uint32_t          nof_scanned_frames       = 0;
+  uint32_t          nof_detected_cells       = 0;
+  bool              pending                  = true;
+  float             max_peak_value           = -1.0;
+  cf_t*             ptr[SRSRAN_MAX_CHANNELS] = {NULL};
+
+  if (history + frame_len > CELL_SEARCH_BUFFER_MAX_SAMPLES) {
+    ERROR("Cell search buffer too small for joint search (%d < %d)",
+          CELL_SEARCH_BUFFER_MAX_SAMPLES,
+          history + frame_len);
+    return SRSRAN_ERROR;
+  }
+
+  bzero(q->candidates, sizeof(srsran_ue_cellsearch_result_t) * 3 * q->max_frames);
+
+  srsran_ue_sync_reset(ue_sync);
+  srsran_ue_sync_cfo_reset(ue_sync, 0.0f);
+  if (srsran_sync_joint_reset(&ue_sync->sfind, q->joint)) {
+    return SRSRAN_ERROR;
+  }
+  for (int i = 0; i < q->nof_rx_antennas; i++) {
+    srsran_vec_cf_zero(q->sf_buffer[i], history);
+    ptr[i] = &q->sf_buffer[i][history];
+  }
+
+  INFO("CELL SEARCH: Starting joint scan for all N_id_2");
+
+  do {
+    if (ue_sync->recv_callback(ue_sync->stream, ptr, frame_len, &ue_sync->last_timestamp) < 0) {
+      ERROR("Error receiving samples");
+      return SRSRAN_ERROR;
+    }
+
+    // Correct CFO before PSS/SSS find, as srsran_ue_sync_zerocopy() does
+    if (ue_sync->cfo_correct_enable_find) {
+      srsran_cfo_correct(
+          &ue_sync->strack.cfo_corr_frame, ptr[0], ptr[0], -ue_sync->cfo_current_value / ue_sync->fft_size);
+    }
+
+    if (srsran_sync_find_joint(&ue_sync->sfind, q->sf_buffer[0], history, q->joint) < 0) {
+      ERROR("Error finding correlation peak");
+      return SRSRAN_ERROR;
+    }
+
+    if (ue_sync->do_agc) {
+      srsran_agc_process(&ue_sync->agc, ptr[0], ue_sync->sf_len);
+    }
+
+    pending = false;
+    for (uint32_t N_id_2 = 0; N_id_2 < 3; N_id_2++) {
+      srsran_sync_joint_t* j = &q->joint[N_id_2];
+      if (nof_detected[N_id_2] >= q->nof_valid_frames) {
+        continue;
+      }
+      if (j->ret == SRSRAN_SYNC_FOUND && j->sss_detected && j->cell_id >= 0) {
+        /* Save cell id, cp and peak */
+        srsran_ue_cellsearch_result_t* c = &q->candidates[N_id_2 * q->max_frames + nof_detected[N_id_2]];
+        c->cell_id                       = (uint32_t)j->cell_id;
+        c->cp                            = j->cp;
+        c->peak                          = j->pss_peak;
+        c->psr                           = j->peak_value;
+        c->cfo                           = 15000 * j->cfo;
+        c->frame_type                    = j->frame_type;
+        INFO("CELL SEARCH: [%d/%d/%d]: Found peak PSR=%.3f, Cell_id: %d CP: %s, CFO=%.1f KHz",
+             nof_detected[N_id_2],
+             nof_scanned_frames,
+             q->nof_valid_frames,
+             c->psr,
+             c->cell_id,
+             srsran_cp_string(c->cp),
+             c->cfo / 1000);
+
+        nof_detected[N_id_2]++;
+      }
+      pending |= nof_detected[N_id_2] < q->nof_valid_frames;
+    }
+
+    // Keep the end of this frame in front of the next one
+    for (int i = 0; i < q->nof_rx_antennas; i++) {
+      memmove(q->sf_buffer[i], &q->sf_buffer[i][frame_len], sizeof(cf_t) * history);
+    }
+
+    nof_scanned_frames++;
+
+  } while (nof_scanned_frames < q->max_frames && pending);
+
+  for (uint32_t N_id_2 = 0; N_id_2 < 3; N_id_2++) {
+    if (nof_detected[N_id_2] > 0) {
+      get_cell(q, &q->candidates[N_id_2 * q->max_frames], nof_detected[N_id_2], &found_cells[N_id_2]);
+      nof_detected_cells++;
+    }
+    if (max_N_id_2) {
+      if (found_cells[N_id_2].peak > max_peak_value) {
+        max_peak_value = found_cells[N_id_2].peak;
+        *max_N_id_2    = N_id_2;
+      }
+    }
+  }
+
+  INFO("CELL SEARCH: Joint scan found %d cells in %d frames", nof_detected_cells, nof_scanned_frames);
+
+  return nof_detected_cells;
+}
+
 /** Finds a cell for a given N_id_2 and stores ID and CP in the structure pointed by found_cell.
  * Returns 1 if the cell is found, 0 if not or -1 on error
  */
@@ -352,7 +490,7 @@ int srsran_ue_cellsearch_scan_N_id_2(srsran_ue_cellsearch_t*        q,
     if (nof_detected_frames > 0) {
       ret = 1; // A cell has been found.
       if (found_cell) {
-        get_cell(q, nof_detected_frames, found_cell);
+        get_cell(q, q->candidates, nof_detected_frames, found_cell);
       }
     } else {
       ret = 0; // A cell was not found.
@@ -0,0 +1,203 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/support/srsran_test.h"
+#include <linux/perf_event.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vec_arena.h"
+#include "srsran/phy/utils/vector.h"
+
+/*
+ * Compares the data TLB misses and the processing time of a PHY-like access pattern (subframe-sized sample buffers,
+ * visited in random order) when the buffers come from srsran_vec_malloc and from a vector arena. The TLB misses are
+ * read from the dTLB-load-misses perf counter, which may not be accessible (e.g. in containers). In that case only
+ * the processing time is reported.
+ */
+
+static uint32_t nof_buffers = 64;
+static uint32_t buffer_len  = 2 * 30720; // Two subframes of 20 MHz, as the eNB RX/TX sample buffers
+static uint32_t nof_rounds  = 20;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nlr]\n", prog);
+  printf("\t-n number of buffers [Default %d]\n", nof_buffers);
+  printf("\t-l buffer length in samples [Default %d]\n", buffer_len);
+  printf("\t-r number of rounds [Default %d]\n", nof_rounds);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nlr")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_buffers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'l':
+        buffer_len = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_rounds = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static int tlb_counter_open(void)
+{
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size           = sizeof(attr);
+  attr.type           = PERF_TYPE_HW_CACHE;
+  attr.config         = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  attr.disabled       = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+  return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/// Visits the samples of all buffers, one cache line at a time, in a random buffer order for every round
+static float run_rounds(cf_t** buffers, const uint32_t* order)
+{
+  float acc = 0.0f;
+  for (uint32_t r = 0; r < nof_rounds; r++) {
+    for (uint32_t b = 0; b < nof_buffers; b++) {
+      const cf_t* buf = buffers[order[r * nof_buffers + b]];
+      for (uint32_t i = 0; i < buffer_len; i += 8) {
+        acc += __real__ buf[i];
+      }
+    }
+  }
+  return acc;
+}
+
+static int run_benchmark(const char* name, cf_t** buffers, const uint32_t* order, int perf_fd)
+{
+  for (uint32_t b = 0; b < nof_buffers; b++) {
+    TESTASSERT(buffers[b] != NULL);
+    TESTASSERT(((uintptr_t)buffers[b] % SRSRAN_SIMD_BIT_ALIGN) == 0);
+    for (uint32_t i = 0; i < buffer_len; i++) {
+      buffers[b][i] = 1.0f;
+    }
+  }
+
+  struct timeval t[3];
+  uint64_t       tlb_misses = 0;
+  if (perf_fd >= 0) {
+    ioctl(perf_fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+  gettimeofday(&t[1], NULL);
+  float acc = run_rounds(buffers, order);
+  gettimeofday(&t[2], NULL);
+  if (perf_fd >= 0) {
+    ioctl(perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(perf_fd, &tlb_misses, sizeof(tlb_misses)) != sizeof(tlb_misses)) {
+      tlb_misses = 0;
+    }
+  }
+  get_time_interval(t);
+
+  TESTASSERT(acc == (float)nof_rounds * nof_buffers * ((buffer_len + 7) / 8));
+
+  uint64_t elapsed_us = t[0].tv_sec * 1000000UL + t[0].tv_usec;
+  if (perf_fd >= 0) {
+    printf("%-16s %8ld us, %12lu dTLB load misses\n", name, elapsed_us, tlb_misses);
+  } else {
+    printf("%-16s %8ld us, dTLB load misses n/a\n", name, elapsed_us);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  cf_t**          buffers = calloc(nof_buffers, sizeof(cf_t*));
+  uint32_t*       order   = calloc((size_t)nof_rounds * nof_buffers, sizeof(uint32_t));
+  srsran_random_t rand_h  = srsran_random_init(0);
+  TESTASSERT(buffers != NULL && order != NULL);
+  for (uint32_t r = 0; r < nof_rounds; r++) {
+    for (uint32_t b = 0; b < nof_buffers; b++) {
+      order[r * nof_buffers + b] = (uint32_t)srsran_random_uniform_int_dist(rand_h, 0, (int)nof_buffers - 1);
+    }
+  }
+
+  int perf_fd = tlb_counter_open();
+  if (perf_fd < 0) {
+    printf("dTLB load miss counter not available, reporting processing time only\n");
+  }
+
+  // Baseline: one srsran_vec_malloc per buffer
+  for (uint32_t b = 0; b < nof_buffers; b++) {
+    buffers[b] = srsran_vec_cf_malloc(buffer_len);
+  }
+  TESTASSERT(run_benchmark("srsran_vec_malloc", buffers, order, perf_fd) == SRSRAN_SUCCESS);
+  for (uint32_t b = 0; b < nof_buffers; b++) {
+    free(buffers[b]);
+  }
+
+  // Arena with every page size. Modes that cannot be obtained fall back to smaller pages and are reported as such
+  size_t                  arena_size = nof_buffers * srsran_vec_arena_alloc_size(buffer_len * sizeof(cf_t));
+  srsran_vec_arena_mode_t modes[]    = {SRSRAN_VEC_ARENA_THP, SRSRAN_VEC_ARENA_HUGEPAGE_2M, SRSRAN_VEC_ARENA_HUGEPAGE_1G};
+  for (uint32_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+    srsran_vec_arena_t arena;
+    TESTASSERT(srsran_vec_arena_init(&arena, arena_size, modes[m], -1) == SRSRAN_SUCCESS);
+    TESTASSERT(arena.size >= arena_size && arena.size % arena.page_size == 0);
+    for (uint32_t b = 0; b < nof_buffers; b++) {
+      buffers[b] = srsran_vec_arena_cf_alloc(&arena, buffer_len);
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "arena (%s)", srsran_vec_arena_mode_string(arena.mode));
+    TESTASSERT(run_benchmark(name, buffers, order, perf_fd) == SRSRAN_SUCCESS);
+
+    // The arena was dimensioned for exactly this set of buffers
+    if (arena.size == arena_size) {
+      TESTASSERT(srsran_vec_arena_cf_alloc(&arena, buffer_len) == NULL);
+    }
+    srsran_vec_arena_free(&arena);
+    TESTASSERT(!srsran_vec_arena_is_active(&arena));
+  }
+
+  if (perf_fd >= 0) {
+    close(perf_fd);
+  }
+  srsran_random_free(rand_h);
+  free(order);
+  free(buffers);
+  return SRSRAN_SUCCESS;
+}
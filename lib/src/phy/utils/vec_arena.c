@@ -0,0 +1,238 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <dirent.h>
+#include <linux/mempolicy.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vec_arena.h"
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+#define VEC_ARENA_PAGE_4K (4096UL)
+#define VEC_ARENA_PAGE_2M (2UL * 1024UL * 1024UL)
+#define VEC_ARENA_PAGE_1G (1024UL * 1024UL * 1024UL)
+
+static size_t vec_arena_round_up(size_t size, size_t align)
+{
+  return ((size + align - 1) / align) * align;
+}
+
+static size_t vec_arena_mode_page_size(srsran_vec_arena_mode_t mode)
+{
+  switch (mode) {
+    case SRSRAN_VEC_ARENA_HUGEPAGE_2M:
+      return VEC_ARENA_PAGE_2M;
+    case SRSRAN_VEC_ARENA_HUGEPAGE_1G:
+      return VEC_ARENA_PAGE_1G;
+    default:
+      break;
+  }
+  return VEC_ARENA_PAGE_4K;
+}
+
+static void* vec_arena_map(size_t size, srsran_vec_arena_mode_t mode)
+{
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_HUGETLB
+  if (mode == SRSRAN_VEC_ARENA_HUGEPAGE_2M) {
+    flags |= MAP_HUGETLB | (21 << MAP_HUGE_SHIFT);
+  } else if (mode == SRSRAN_VEC_ARENA_HUGEPAGE_1G) {
+    flags |= MAP_HUGETLB | (30 << MAP_HUGE_SHIFT);
+  }
+#else
+  if (mode == SRSRAN_VEC_ARENA_HUGEPAGE_2M || mode == SRSRAN_VEC_ARENA_HUGEPAGE_1G) {
+    return NULL;
+  }
+#endif
+  void* ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (ptr == MAP_FAILED) {
+    return NULL;
+  }
+#ifdef MADV_HUGEPAGE
+  if (mode == SRSRAN_VEC_ARENA_THP) {
+    // Best effort, transparent hugepages may be disabled in the system
+    madvise(ptr, size, MADV_HUGEPAGE);
+  }
+#endif
+  return ptr;
+}
+
+static int vec_arena_bind(void* ptr, size_t size, int numa_node)
+{
+  unsigned long nodemask[4] = {0};
+  if (numa_node < 0 || numa_node >= (int)(8 * sizeof(nodemask))) {
+    return SRSRAN_ERROR;
+  }
+  nodemask[numa_node / (8 * sizeof(unsigned long))] = 1UL << (numa_node % (8 * sizeof(unsigned long)));
+  if (syscall(SYS_mbind, ptr, size, MPOL_BIND, nodemask, 8 * sizeof(nodemask), 0) != 0) {
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_vec_arena_init(srsran_vec_arena_t* q, size_t size, srsran_vec_arena_mode_t mode, int numa_node)
+{
+  if (q == NULL || size == 0 || mode == SRSRAN_VEC_ARENA_DISABLED) {
+    return SRSRAN_ERROR;
+  }
+  memset(q, 0, sizeof(srsran_vec_arena_t));
+  q->numa_node = -1;
+
+  // Try the requested page size first and fall back to smaller pages if the system has none reserved
+  for (srsran_vec_arena_mode_t m = mode; m >= SRSRAN_VEC_ARENA_THP; m--) {
+    size_t page_size = vec_arena_mode_page_size(m);
+    size_t map_size  = vec_arena_round_up(size, page_size);
+    void*  ptr       = vec_arena_map(map_size, m);
+    if (ptr != NULL) {
+      q->base      = ptr;
+      q->size      = map_size;
+      q->page_size = page_size;
+      q->mode      = m;
+      break;
+    }
+    INFO("Could not reserve %zd bytes of %s pages for vector arena", map_size, srsran_vec_arena_mode_string(m));
+  }
+  if (q->base == NULL) {
+    ERROR("Error reserving %zd bytes for vector arena", size);
+    return SRSRAN_ERROR;
+  }
+
+  // The pages are not allocated until touched, so the memory policy must be set before pre-faulting them
+  if (numa_node >= 0) {
+    if (vec_arena_bind(q->base, q->size, numa_node) == SRSRAN_SUCCESS) {
+      q->numa_node = numa_node;
+    } else {
+      INFO("Could not bind vector arena to NUMA node %d", numa_node);
+    }
+  }
+  memset(q->base, 0, q->size);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_vec_arena_free(srsran_vec_arena_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+  if (q->base != NULL) {
+    munmap(q->base, q->size);
+  }
+  memset(q, 0, sizeof(srsran_vec_arena_t));
+  q->numa_node = -1;
+}
+
+bool srsran_vec_arena_is_active(const srsran_vec_arena_t* q)
+{
+  return q != NULL && q->base != NULL;
+}
+
+size_t srsran_vec_arena_alloc_size(size_t size)
+{
+  return vec_arena_round_up(size, SRSRAN_SIMD_BIT_ALIGN);
+}
+
+void* srsran_vec_arena_alloc(srsran_vec_arena_t* q, size_t size)
+{
+  if (!srsran_vec_arena_is_active(q)) {
+    return NULL;
+  }
+  size_t nbytes = srsran_vec_arena_alloc_size(size);
+  if (q->used + nbytes > q->size) {
+    return NULL;
+  }
+  void* ptr = q->base + q->used;
+  q->used += nbytes;
+  return ptr;
+}
+
+cf_t* srsran_vec_arena_cf_alloc(srsran_vec_arena_t* q, uint32_t nsamples)
+{
+  return (cf_t*)srsran_vec_arena_alloc(q, (size_t)nsamples * sizeof(cf_t));
+}
+
+int srsran_vec_arena_mode_parse(const char* str, srsran_vec_arena_mode_t* mode)
+{
+  if (str == NULL || mode == NULL) {
+    return SRSRAN_ERROR;
+  }
+  if (strcmp(str, "none") == 0) {
+    *mode = SRSRAN_VEC_ARENA_DISABLED;
+  } else if (strcmp(str, "thp") == 0) {
+    *mode = SRSRAN_VEC_ARENA_THP;
+  } else if (strcmp(str, "2M") == 0) {
+    *mode = SRSRAN_VEC_ARENA_HUGEPAGE_2M;
+  } else if (strcmp(str, "1G") == 0) {
+    *mode = SRSRAN_VEC_ARENA_HUGEPAGE_1G;
+  } else {
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+const char* srsran_vec_arena_mode_string(srsran_vec_arena_mode_t mode)
+{
+  switch (mode) {
+    case SRSRAN_VEC_ARENA_DISABLED:
+      return "none";
+    case SRSRAN_VEC_ARENA_THP:
+      return "thp";
+    case SRSRAN_VEC_ARENA_HUGEPAGE_2M:
+      return "2M";
+    case SRSRAN_VEC_ARENA_HUGEPAGE_1G:
+      return "1G";
+    default:
+      break;
+  }
+  return "invalid";
+}
+
+int srsran_vec_arena_cpu_node(uint32_t cpu)
+{
+  char path[64];
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u", cpu);
+
+  // The CPU directory contains a "nodeN" link to the node it belongs to
+  DIR* dir = opendir(path);
+  if (dir == NULL) {
+    return -1;
+  }
+  int            node  = -1;
+  struct dirent* entry = NULL;
+  while ((entry = readdir(dir)) != NULL) {
+    if (strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+      node = atoi(&entry->d_name[4]);
+      break;
+    }
+  }
+  closedir(dir);
+  return node;
+}
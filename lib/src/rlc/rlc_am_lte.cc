@@ -20,11 +20,14 @@
  */
 
 #include "srsran/rlc/rlc_am_lte.h"
+#include "srsran/adt/scope_exit.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/interfaces/ue_pdcp_interfaces.h"
 #include "srsran/interfaces/ue_rrc_interfaces.h"
 #include "srsran/srslog/event_trace.h"
+#include <algorithm>
 #include <iostream>
+#include <thread>
 
 #define MOD 1024
 #define RX_MOD_BASE(x) (((x)-vr_r) % 1024)
@@ -218,6 +221,10 @@ rlc_bearer_metrics_t rlc_am_lte::get_metrics()
   std::lock_guard<std::mutex> lock(metrics_mutex);
   metrics.rx_latency_ms     = latency;
   metrics.rx_buffered_bytes = buffered_bytes;
+  metrics.num_tx_sdus       = num_tx_sdus.load(std::memory_order_relaxed);
+  metrics.num_lost_sdus     = num_lost_sdus.load(std::memory_order_relaxed);
+  metrics.num_tx_pdus       = num_tx_pdus.load(std::memory_order_relaxed);
+  metrics.num_tx_pdu_bytes  = num_tx_pdu_bytes.load(std::memory_order_relaxed);
 
   return metrics;
 }
@@ -226,6 +233,10 @@ void rlc_am_lte::reset_metrics()
 {
   std::lock_guard<std::mutex> lock(metrics_mutex);
   metrics = {};
+  num_tx_sdus.store(0, std::memory_order_relaxed);
+  num_lost_sdus.store(0, std::memory_order_relaxed);
+  num_tx_pdus.store(0, std::memory_order_relaxed);
+  num_tx_pdu_bytes.store(0, std::memory_order_relaxed);
 }
 
 /****************************************************************************
@@ -235,17 +246,14 @@ void rlc_am_lte::reset_metrics()
 void rlc_am_lte::write_sdu(unique_byte_buffer_t sdu)
 {
   if (tx.write_sdu(std::move(sdu)) == SRSRAN_SUCCESS) {
-    std::lock_guard<std::mutex> lock(metrics_mutex);
-    metrics.num_tx_sdus++;
+    num_tx_sdus.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
 void rlc_am_lte::discard_sdu(uint32_t discard_sn)
 {
   tx.discard_sdu(discard_sn);
-
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  metrics.num_lost_sdus++;
+  num_lost_sdus.fetch_add(1, std::memory_order_relaxed);
 }
 
 bool rlc_am_lte::sdu_queue_is_full()
@@ -276,9 +284,8 @@ uint32_t rlc_am_lte::read_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   uint32_t read_bytes = tx.read_pdu(payload, nof_bytes);
 
-  std::lock_guard<std::mutex> lock(metrics_mutex);
-  metrics.num_tx_pdus++;
-  metrics.num_tx_pdu_bytes += read_bytes;
+  num_tx_pdus.fetch_add(1, std::memory_order_relaxed);
+  num_tx_pdu_bytes.fetch_add(read_bytes, std::memory_order_relaxed);
 
   return read_bytes;
 }
@@ -302,7 +309,9 @@ rlc_am_lte::rlc_am_lte_tx::rlc_am_lte_tx(rlc_am_lte* parent_) :
   pool(byte_buffer_pool::get_instance()),
   poll_retx_timer(parent_->timers->get_unique_timer()),
   status_prohibit_timer(parent_->timers->get_unique_timer())
-{}
+{
+  nack_order.reserve(RLC_AM_WINDOW_SIZE);
+}
 
 rlc_am_lte::rlc_am_lte_tx::~rlc_am_lte_tx() {}
 
@@ -340,9 +349,11 @@ bool rlc_am_lte::rlc_am_lte_tx::configure(const rlc_config_t& cfg_)
     poll_retx_timer.set(static_cast<uint32_t>(cfg.t_poll_retx), [this](uint32_t timerid) { timer_expired(timerid); });
   }
 
-  // make sure Tx queue is empty before attempting to resize
+  // make sure Tx queue is empty and no PDCP writer is left before attempting to resize
+  block_sdu_writers();
   empty_queue_nolock();
   tx_sdu_queue.resize(cfg_.tx_queue_length);
+  discard_queue.set_size(cfg_.tx_queue_length);
 
   tx_enabled = true;
 
@@ -357,10 +368,9 @@ void rlc_am_lte::rlc_am_lte_tx::stop()
 
 void rlc_am_lte::rlc_am_lte_tx::stop_nolock()
 {
+  block_sdu_writers();
   empty_queue_nolock();
 
-  tx_enabled = false;
-
   if (parent->timers != nullptr && poll_retx_timer.is_valid()) {
     poll_retx_timer.stop();
   }
@@ -390,15 +400,27 @@ void rlc_am_lte::rlc_am_lte_tx::stop_nolock()
 void rlc_am_lte::rlc_am_lte_tx::empty_queue()
 {
   std::lock_guard<std::mutex> lock(mutex);
+  bool                        enabled = block_sdu_writers();
   empty_queue_nolock();
+  tx_enabled = enabled;
+}
+
+// Disables tx and waits for the PDCP writers still inside write_sdu()/discard_sdu(), so that the Tx SDU and discard
+// queues can be reset. Returns whether tx was enabled
+bool rlc_am_lte::rlc_am_lte_tx::block_sdu_writers()
+{
+  bool enabled = tx_enabled.exchange(false);
+  while (nof_sdu_writers.load() > 0) {
+    std::this_thread::yield();
+  }
+  return enabled;
 }
 
 void rlc_am_lte::rlc_am_lte_tx::empty_queue_nolock()
 {
   // deallocate all SDUs in transmit queue
-  while (tx_sdu_queue.size() > 0) {
-    unique_byte_buffer_t buf = tx_sdu_queue.read();
-  }
+  tx_sdu_queue.clear();
+  discard_queue.clear();
 
   // deallocate SDU that is currently processed
   if (tx_sdu != nullptr) {
@@ -422,6 +444,11 @@ bool rlc_am_lte::rlc_am_lte_tx::do_status()
 // Function is supposed to return as fast as possible
 bool rlc_am_lte::rlc_am_lte_tx::has_data()
 {
+  // Discarded SDUs must not be reported. The lock is only taken if there are discards pending
+  if (not discard_queue.empty()) {
+    std::lock_guard<std::mutex> lock(mutex);
+    handle_pending_discards();
+  }
   return (((do_status() && not status_prohibit_timer.is_running())) || // if we have a status PDU to transmit
           (not retx_queue.empty()) ||                                  // if we have a retransmission
           (tx_sdu != nullptr) ||                                       // if we are currently transmitting a SDU
@@ -472,6 +499,8 @@ void rlc_am_lte::rlc_am_lte_tx::get_buffer_state_nolock(uint32_t& n_bytes_newtx,
   n_bytes_prio    = 0;
   uint32_t n_sdus = 0;
 
+  handle_pending_discards();
+
   logger.debug("%s Buffer state - do_status=%s, status_prohibit_running=%s (%d/%d)",
                RB_NAME,
                do_status() ? "yes" : "no",
@@ -532,10 +561,12 @@ void rlc_am_lte::rlc_am_lte_tx::get_buffer_state_nolock(uint32_t& n_bytes_newtx,
   }
 }
 
+// Called from the PDCP. It does not take the Tx mutex, as it is the single producer of the Tx SDU queue
 int rlc_am_lte::rlc_am_lte_tx::write_sdu(unique_byte_buffer_t sdu)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
+  // Registered before checking tx_enabled, so that the queues are not reset while the SDU is pushed
+  nof_sdu_writers++;
+  auto writer_exit = srsran::make_scope_exit([this]() { nof_sdu_writers--; });
   if (!tx_enabled) {
     return SRSRAN_ERROR;
   }
@@ -548,13 +579,13 @@ int rlc_am_lte::rlc_am_lte_tx::write_sdu(unique_byte_buffer_t sdu)
   // Get SDU info
   uint32_t sdu_pdcp_sn = sdu->md.pdcp_sn;
 
+  // Log before storing the SDU, as the MAC may send it and return it to the pool as soon as it is in the queue
+  logger.info(
+      sdu->msg, sdu->N_bytes, "%s Tx SDU (%d B, tx_sdu_queue_len=%d)", RB_NAME, sdu->N_bytes, tx_sdu_queue.size());
+
   // Store SDU
-  uint8_t*                                 msg_ptr   = sdu->msg;
-  uint32_t                                 nof_bytes = sdu->N_bytes;
-  srsran::error_type<unique_byte_buffer_t> ret       = tx_sdu_queue.try_write(std::move(sdu));
-  if (ret) {
-    logger.info(msg_ptr, nof_bytes, "%s Tx SDU (%d B, tx_sdu_queue_len=%d)", RB_NAME, nof_bytes, tx_sdu_queue.size());
-  } else {
+  srsran::error_type<unique_byte_buffer_t> ret = tx_sdu_queue.try_write(std::move(sdu));
+  if (not ret) {
     // in case of fail, the try_write returns back the sdu
     logger.warning(ret.error()->msg,
                    ret.error()->N_bytes,
@@ -570,20 +601,28 @@ int rlc_am_lte::rlc_am_lte_tx::write_sdu(unique_byte_buffer_t sdu)
 
 void rlc_am_lte::rlc_am_lte_tx::discard_sdu(uint32_t discard_sn)
 {
+  nof_sdu_writers++;
+  auto writer_exit = srsran::make_scope_exit([this]() { nof_sdu_writers--; });
   if (!tx_enabled) {
     return;
   }
 
-  bool discarded = tx_sdu_queue.apply_first([&discard_sn, this](unique_byte_buffer_t& sdu) {
-    if (sdu != nullptr && sdu->md.pdcp_sn == discard_sn) {
-      tx_sdu_queue.queue.pop_func(sdu);
-      sdu = nullptr;
-    }
-    return false;
-  });
+  // The discard is applied by the consumer of the Tx SDU queue, to avoid locking the Tx entity in the PDCP thread
+  if (not discard_queue.try_push(discard_sn)) {
+    logger.warning("Couldn't discard PDU with PDCP_SN=%d. Discard queue is full.", discard_sn);
+  }
+}
+
+void rlc_am_lte::rlc_am_lte_tx::handle_pending_discards()
+{
+  uint32_t discard_sn = 0;
+  while (discard_queue.try_pop(discard_sn)) {
+    bool discarded = tx_sdu_queue.discard_first_if(
+        [discard_sn](const unique_byte_buffer_t& sdu) { return sdu->md.pdcp_sn == discard_sn; });
 
-  // Discard fails when the PDCP PDU is already in Tx window.
-  logger.info("%s PDU with PDCP_SN=%d", discarded ? "Discarding" : "Couldn't discard", discard_sn);
+    // Discard fails when the PDCP PDU is already in Tx window.
+    logger.info("%s PDU with PDCP_SN=%d", discarded ? "Discarding" : "Couldn't discard", discard_sn);
+  }
 }
 
 bool rlc_am_lte::rlc_am_lte_tx::sdu_queue_is_full()
@@ -599,6 +638,8 @@ uint32_t rlc_am_lte::rlc_am_lte_tx::read_pdu(uint8_t* payload, uint32_t nof_byte
     return 0;
   }
 
+  handle_pending_discards();
+
   logger.debug("MAC opportunity - %d bytes", nof_bytes);
   logger.debug("tx_window size - %zu PDUs", tx_window.size());
 
@@ -670,11 +711,10 @@ void rlc_am_lte::rlc_am_lte_tx::retransmit_pdu(uint32_t sn)
   check_sn_reached_max_retx(sn);
 
   logger.info("%s Schedule SN=%d for reTx", RB_NAME, pdu.rlc_sn);
-  rlc_amd_retx_t& retx = retx_queue.push();
+  rlc_amd_retx_t& retx = retx_queue.push(pdu.rlc_sn);
   retx.is_segment      = false;
   retx.so_start        = 0;
   retx.so_end          = pdu.buf->N_bytes;
-  retx.sn              = pdu.rlc_sn;
 }
 
 /****************************************************************************
@@ -1124,9 +1164,10 @@ int rlc_am_lte::rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_byt
       break;
     }
 
-    do {
-      tx_sdu = tx_sdu_queue.read();
-    } while (tx_sdu == nullptr && tx_sdu_queue.size() != 0);
+    // skip discarded SDUs
+    tx_sdu.reset();
+    while (tx_sdu == nullptr && tx_sdu_queue.try_read(&tx_sdu)) {
+    }
     if (tx_sdu == nullptr) {
       if (header.N_li > 0) {
         header.N_li--;
@@ -1265,64 +1306,72 @@ void rlc_am_lte::rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t no
     vt_s_local = vt_s;
   }
 
+  // Sort NACKs by their position in the Tx window, so that the window is traversed only once
+  nack_order.clear();
+  for (uint32_t j = 0; j < status.N_nack; j++) {
+    nack_order.push_back(j);
+  }
+  std::stable_sort(nack_order.begin(), nack_order.end(), [i, &status](uint32_t lhs, uint32_t rhs) {
+    return (MOD + status.nacks[lhs].nack_sn - i) % MOD < (MOD + status.nacks[rhs].nack_sn - i) % MOD;
+  });
+  auto nack_it = nack_order.begin();
+
   bool update_vt_a = true;
   while (TX_MOD_BASE(i) < TX_MOD_BASE(status.ack_sn) && TX_MOD_BASE(i) < TX_MOD_BASE(vt_s_local)) {
     bool nack = false;
-    for (uint32_t j = 0; j < status.N_nack; j++) {
-      if (status.nacks[j].nack_sn == i) {
-        nack        = true;
-        update_vt_a = false;
-        std::lock_guard<std::mutex> lock(mutex);
-        if (tx_window.has_sn(i)) {
-          auto& pdu = tx_window[i];
-
-          // add to retx queue if it's not already there
-          if (not retx_queue.has_sn(i)) {
-            // increment Retx counter and inform upper layers if needed
-            pdu.retx_count++;
-            check_sn_reached_max_retx(i);
-
-            rlc_amd_retx_t& retx = retx_queue.push();
-            srsran_expect(tx_window[i].rlc_sn == i, "Incorrect RLC SN=%d!=%d being accessed", tx_window[i].rlc_sn, i);
-            retx.sn         = i;
-            retx.is_segment = false;
-            retx.so_start   = 0;
-            retx.so_end     = pdu.buf->N_bytes;
-
-            if (status.nacks[j].has_so) {
-              // sanity check
-              if (status.nacks[j].so_start >= pdu.buf->N_bytes) {
-                // print error but try to send original PDU again
-                logger.info(
-                    "SO_start is larger than original PDU (%d >= %d)", status.nacks[j].so_start, pdu.buf->N_bytes);
-                status.nacks[j].so_start = 0;
-              }
-
-              // check for special SO_end value
-              if (status.nacks[j].so_end == 0x7FFF) {
-                status.nacks[j].so_end = pdu.buf->N_bytes;
-              } else {
-                retx.so_end = status.nacks[j].so_end + 1;
-              }
-
-              if (status.nacks[j].so_start < pdu.buf->N_bytes && status.nacks[j].so_end <= pdu.buf->N_bytes) {
-                retx.is_segment = true;
-                retx.so_start   = status.nacks[j].so_start;
-              } else {
-                logger.warning("%s invalid segment NACK received for SN %d. so_start: %d, so_end: %d, N_bytes: %d",
-                               RB_NAME,
-                               i,
-                               status.nacks[j].so_start,
-                               status.nacks[j].so_end,
-                               pdu.buf->N_bytes);
-              }
+    for (; nack_it != nack_order.end() and status.nacks[*nack_it].nack_sn == i; ++nack_it) {
+      uint32_t j  = *nack_it;
+      nack        = true;
+      update_vt_a = false;
+      std::lock_guard<std::mutex> lock(mutex);
+      if (tx_window.has_sn(i)) {
+        auto& pdu = tx_window[i];
+
+        // add to retx queue if it's not already there
+        if (not retx_queue.has_sn(i)) {
+          // increment Retx counter and inform upper layers if needed
+          pdu.retx_count++;
+          check_sn_reached_max_retx(i);
+
+          rlc_amd_retx_t& retx = retx_queue.push(i);
+          srsran_expect(tx_window[i].rlc_sn == i, "Incorrect RLC SN=%d!=%d being accessed", tx_window[i].rlc_sn, i);
+          retx.is_segment = false;
+          retx.so_start   = 0;
+          retx.so_end     = pdu.buf->N_bytes;
+
+          if (status.nacks[j].has_so) {
+            // sanity check
+            if (status.nacks[j].so_start >= pdu.buf->N_bytes) {
+              // print error but try to send original PDU again
+              logger.info(
+                  "SO_start is larger than original PDU (%d >= %d)", status.nacks[j].so_start, pdu.buf->N_bytes);
+              status.nacks[j].so_start = 0;
+            }
+
+            // check for special SO_end value
+            if (status.nacks[j].so_end == 0x7FFF) {
+              status.nacks[j].so_end = pdu.buf->N_bytes;
+            } else {
+              retx.so_end = status.nacks[j].so_end + 1;
+            }
+
+            if (status.nacks[j].so_start < pdu.buf->N_bytes && status.nacks[j].so_end <= pdu.buf->N_bytes) {
+              retx.is_segment = true;
+              retx.so_start   = status.nacks[j].so_start;
+            } else {
+              logger.warning("%s invalid segment NACK received for SN %d. so_start: %d, so_end: %d, N_bytes: %d",
+                             RB_NAME,
+                             i,
+                             status.nacks[j].so_start,
+                             status.nacks[j].so_end,
+                             pdu.buf->N_bytes);
             }
-          } else {
-            logger.info("%s NACKed SN=%d already considered for retransmission", RB_NAME, i);
           }
         } else {
-          logger.error("%s NACKed SN=%d already removed from Tx window", RB_NAME, i);
+          logger.info("%s NACKed SN=%d already considered for retransmission", RB_NAME, i);
         }
+      } else {
+        logger.error("%s NACKed SN=%d already removed from Tx window", RB_NAME, i);
       }
     }
 
@@ -1671,8 +1720,6 @@ void rlc_am_lte::rlc_am_lte_rx::handle_data_pdu_segment(uint8_t*              pa
                                                         uint32_t              nof_bytes,
                                                         rlc_amd_pdu_header_t& header)
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-
   logger.info(payload,
               nof_bytes,
               "%s Rx data PDU segment of SN=%d (%d B), SO=%d, N_li=%d",
@@ -1715,8 +1762,7 @@ void rlc_am_lte::rlc_am_lte_rx::handle_data_pdu_segment(uint8_t*              pa
   segment.header       = header;
 
   // Check if we already have a segment from the same PDU
-  it = rx_segments.find(header.sn);
-  if (rx_segments.end() != it) {
+  if (rx_segments.has_sn(header.sn)) {
     if (header.p) {
       logger.info("%s Status packet requested through polling bit", RB_NAME);
       do_status = true;
@@ -1724,15 +1770,15 @@ void rlc_am_lte::rlc_am_lte_rx::handle_data_pdu_segment(uint8_t*              pa
 
     // Add segment to PDU list and check for complete
     // NOTE: MAY MOVE. Preference would be to capture by value, and then move; but header is stack allocated
-    if (add_segment_and_check(&it->second, &segment)) {
-      rx_segments.erase(it);
+    // NOTE: the reassembled PDU may have already advanced vr_r past this SN and erased its segments
+    if (add_segment_and_check(&rx_segments[header.sn], &segment) and rx_segments.has_sn(header.sn)) {
+      erase_rx_segments(header.sn);
     }
 
   } else {
     // Create new PDU segment list and write to rx_segments
-    rlc_amd_rx_pdu_segments_t pdu;
-    pdu.segments.push_back(std::move(segment));
-    rx_segments[header.sn] = std::move(pdu);
+    rlc_amd_rx_pdu_segments_t& pdu = rx_segments.add_pdu(header.sn);
+    segment_pool.insert(pdu.segments, pdu.segments.end(), std::move(segment));
 
     // Update vr_h
     if (RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_h)) {
@@ -1888,19 +1934,16 @@ void rlc_am_lte::rlc_am_lte_rx::reassemble_rx_sdus()
     // Move the rx_window
     logger.debug("Erasing SN=%d.", vr_r);
     // also erase any segments of this SN
-    std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-    it = rx_segments.find(vr_r);
-    if (rx_segments.end() != it) {
+    if (rx_segments.has_sn(vr_r)) {
       logger.debug("Erasing segments of SN=%d", vr_r);
-      std::list<rlc_amd_rx_pdu>::iterator segit;
-      for (segit = it->second.segments.begin(); segit != it->second.segments.end(); ++segit) {
+      for (const rlc_amd_rx_pdu& segment : rx_segments[vr_r].segments) {
         logger.debug(" Erasing segment of SN=%d SO=%d Len=%d N_li=%d",
-                     segit->header.sn,
-                     segit->header.so,
-                     segit->buf->N_bytes,
-                     segit->header.N_li);
+                     segment.header.sn,
+                     segment.header.so,
+                     segment.buf->N_bytes,
+                     segment.header.N_li);
       }
-      it->second.segments.clear();
+      erase_rx_segments(vr_r);
     }
     rx_window.remove_pdu(vr_r);
     vr_r  = (vr_r + 1) % MOD;
@@ -2061,19 +2104,26 @@ int rlc_am_lte::rlc_am_lte_rx::get_status_pdu_length()
 
 void rlc_am_lte::rlc_am_lte_rx::print_rx_segments()
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-  std::stringstream                                       ss;
+  std::stringstream ss;
   ss << "rx_segments:" << std::endl;
-  for (it = rx_segments.begin(); it != rx_segments.end(); it++) {
-    std::list<rlc_amd_rx_pdu>::iterator segit;
-    for (segit = it->second.segments.begin(); segit != it->second.segments.end(); segit++) {
-      ss << "    SN=" << segit->header.sn << " SO:" << segit->header.so << " N:" << segit->buf->N_bytes
-         << " N_li: " << segit->header.N_li << std::endl;
+  for (uint32_t i = vr_r; RX_MOD_BASE(i) < RX_MOD_BASE(vr_mr); i = (i + 1) % MOD) {
+    if (not rx_segments.has_sn(i)) {
+      continue;
+    }
+    for (const rlc_amd_rx_pdu& segment : rx_segments[i].segments) {
+      ss << "    SN=" << segment.header.sn << " SO:" << segment.header.so << " N:" << segment.buf->N_bytes
+         << " N_li: " << segment.header.N_li << std::endl;
     }
   }
   logger.debug("%s", ss.str().c_str());
 }
 
+void rlc_am_lte::rlc_am_lte_rx::erase_rx_segments(uint32_t sn)
+{
+  segment_pool.release_all(rx_segments[sn].segments);
+  rx_segments.remove_pdu(sn);
+}
+
 // NOTE: Preference would be to capture by value, and then move; but header is stack allocated
 bool rlc_am_lte::rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_amd_rx_pdu* segment)
 {
@@ -2097,16 +2147,16 @@ bool rlc_am_lte::rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t*
         // Ignore otherwise
       }
     } else if (s.header.so > segment->header.so) {
-      pdu->segments.insert(it1, std::move(*segment));
+      segment_pool.insert(pdu->segments, it1, std::move(*segment));
     }
   } else {
     // Either the new segment is the latest or the only one, push back
-    pdu->segments.push_back(std::move(*segment));
+    segment_pool.insert(pdu->segments, pdu->segments.end(), std::move(*segment));
   }
 
   // Check for complete
-  uint32_t                            so = 0;
-  std::list<rlc_amd_rx_pdu>::iterator it, tmpit;
+  uint32_t                                     so = 0;
+  rlc_amd_rx_pdu_segments_t::list_type::iterator it, tmpit;
   for (it = pdu->segments.begin(); it != pdu->segments.end(); /* Do not increment */) {
     // Check that there is no gap between last segment and current; overlap allowed
     if (so < it->header.so) {
@@ -2117,7 +2167,7 @@ bool rlc_am_lte::rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t*
     // Check if segment is overlapped
     if (it->header.so + it->buf->N_bytes <= so) {
       // completely overlapped with previous segments, erase
-      it = pdu->segments.erase(it); // Returns next iterator
+      it = segment_pool.release(pdu->segments, it); // Returns next iterator
     } else {
       // Update segment offset it shall not go backwards
       so = SRSRAN_MAX(so, it->header.so + it->buf->N_bytes);
@@ -103,6 +103,8 @@ void backend_worker::do_work()
 
     // Spin while there are no new entries to process.
     if (!item.first) {
+      // Hand back the arg stores released by this thread, so that producers can reuse them.
+      arg_pool.flush_thread_cache();
       std::this_thread::sleep_for(sleep_period);
       continue;
     }
@@ -165,4 +167,6 @@ void backend_worker::process_outstanding_entries()
 
     process_log_entry(std::move(item.second));
   }
+
+  arg_pool.flush_thread_cache();
 }
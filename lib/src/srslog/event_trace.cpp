@@ -20,12 +20,17 @@
  */
 
 #include "srsran/srslog/event_trace.h"
+#include "event_trace_ring.h"
 #include "sinks/buffered_file_sink.h"
 #include "srsran/srslog/srslog.h"
+#include <algorithm>
+#include <cstdlib>
 #include <ctime>
 
 #undef trace_duration_begin
 #undef trace_duration_end
+#undef trace_instant_event
+#undef trace_counter_event
 #undef trace_complete_event
 
 using namespace srslog;
@@ -33,6 +38,9 @@ using namespace srslog;
 /// Log channel where event traces will get sent.
 static log_channel* tracer = nullptr;
 
+/// Ring buffer tracer where event traces will get recorded, when installed.
+static std::atomic<detail::trace_ring_tracer*> ring_tracer{nullptr};
+
 /// Tracer sink name.
 static constexpr char sink_name[] = "srslog_trace_sink";
 
@@ -67,7 +75,7 @@ bool srslog::event_trace_init(const std::string& filename, std::size_t capacity)
 {
   // Nothing to do if the user previously set a custom channel or this is not
   // the first time this function is called.
-  if (tracer) {
+  if (tracer || ring_tracer) {
     return false;
   }
 
@@ -85,6 +93,52 @@ bool srslog::event_trace_init(const std::string& filename, std::size_t capacity)
   return false;
 }
 
+/// Owns the ring buffer tracers. Stopped tracers are kept alive until program
+/// exit, since threads may still be accessing them.
+static std::vector<std::unique_ptr<detail::trace_ring_tracer>>& get_ring_tracers()
+{
+  static std::vector<std::unique_ptr<detail::trace_ring_tracer>> tracers;
+  return tracers;
+}
+
+bool srslog::event_trace_init_ring(const std::string& filename, event_trace_format format, std::size_t capacity)
+{
+  // Nothing to do if a tracer is already running.
+  if (tracer || ring_tracer) {
+    return false;
+  }
+
+  std::size_t nof_records = std::max<std::size_t>(capacity / sizeof(detail::trace_record), 1);
+  auto        t = std::unique_ptr<detail::trace_ring_tracer>(
+      new detail::trace_ring_tracer(nof_records, detail::create_trace_exporter(format)));
+  if (!t->start(filename)) {
+    return false;
+  }
+
+  // Make sure the pending events get written to the file at program exit.
+  auto& tracers = get_ring_tracers();
+  if (tracers.empty()) {
+    std::atexit(event_trace_stop);
+  }
+  ring_tracer = t.get();
+  tracers.push_back(std::move(t));
+
+  return true;
+}
+
+void srslog::event_trace_stop()
+{
+  if (detail::trace_ring_tracer* t = ring_tracer.exchange(nullptr)) {
+    t->stop();
+  }
+}
+
+uint64_t srslog::event_trace_get_nof_dropped()
+{
+  auto& tracers = get_ring_tracers();
+  return tracers.empty() ? 0 : tracers.back()->get_nof_dropped();
+}
+
 /// Fills in the input buffer with the current time.
 static void format_time(char* buffer, size_t len)
 {
@@ -118,12 +172,66 @@ void trace_duration_end(const std::string& category, const std::string& name)
   (*tracer)("[%s] [TID:%0u] Leaving \"%s\": %s", fmt_time, (unsigned)::pthread_self(), category, name);
 }
 
+void trace_duration_begin(const char* category, const char* name)
+{
+  if (detail::trace_ring_tracer* t = ring_tracer.load(std::memory_order_acquire)) {
+    t->push(detail::trace_record_type::begin, category, name, 0);
+    return;
+  }
+  trace_duration_begin(std::string(category), std::string(name));
+}
+
+void trace_duration_end(const char* category, const char* name)
+{
+  if (detail::trace_ring_tracer* t = ring_tracer.load(std::memory_order_acquire)) {
+    t->push(detail::trace_record_type::end, category, name, 0);
+    return;
+  }
+  trace_duration_end(std::string(category), std::string(name));
+}
+
+void trace_instant_event(const char* category, const char* name)
+{
+  if (detail::trace_ring_tracer* t = ring_tracer.load(std::memory_order_acquire)) {
+    t->push(detail::trace_record_type::instant, category, name, 0);
+    return;
+  }
+  if (!tracer) {
+    return;
+  }
+
+  char fmt_time[24];
+  format_time(fmt_time, sizeof(fmt_time));
+  (*tracer)("[%s] [TID:%0u] Instant \"%s\": %s", fmt_time, (unsigned)::pthread_self(), category, name);
+}
+
+void trace_counter_event(const char* category, const char* name, int64_t value)
+{
+  if (detail::trace_ring_tracer* t = ring_tracer.load(std::memory_order_acquire)) {
+    t->push(detail::trace_record_type::counter, category, name, value);
+    return;
+  }
+  if (!tracer) {
+    return;
+  }
+
+  char fmt_time[24];
+  format_time(fmt_time, sizeof(fmt_time));
+  (*tracer)("[%s] [TID:%0u] Counter \"%s\": %s = %lld",
+            fmt_time,
+            (unsigned)::pthread_self(),
+            category,
+            name,
+            (long long)value);
+}
+
 } // namespace srslog
 
 /// Private implementation of the complete event destructor.
 srslog::detail::scoped_complete_event::~scoped_complete_event()
 {
-  if (!tracer) {
+  trace_ring_tracer* t = ring_tracer.load(std::memory_order_acquire);
+  if (!tracer && !t) {
     return;
   }
 
@@ -134,5 +242,13 @@ srslog::detail::scoped_complete_event::~scoped_complete_event()
     return;
   }
 
+  if (t) {
+    t->push(trace_record_type::complete,
+            category,
+            name,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    return;
+  }
+
   (*tracer)("%s %s, %u", category, name, (unsigned)diff.count());
 }
@@ -0,0 +1,548 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "event_trace_ring.h"
+#include <algorithm>
+#include <cstring>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace srslog;
+using namespace srslog::detail;
+
+/// Period of the drainer thread.
+static constexpr std::chrono::milliseconds drain_period(10);
+
+/// Time spent measuring the initial frequency of the timestamp counter.
+static constexpr std::chrono::milliseconds calibration_period(10);
+
+/// Maximum number of records popped from a ring at once.
+static constexpr std::size_t pop_batch_size = 1024;
+
+static uint64_t steady_now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+trace_thread_ring::trace_thread_ring(std::size_t capacity, uint32_t tid, std::string name) :
+  mask([capacity]() {
+    // Round up to a power of two to wrap the indexes with a mask.
+    uint64_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    return size - 1;
+  }()),
+  tid(tid),
+  name(std::move(name))
+{
+  buffer.resize(mask + 1);
+}
+
+std::size_t trace_thread_ring::pop(trace_record* out, std::size_t max_records)
+{
+  uint64_t    r = read_idx.load(std::memory_order_relaxed);
+  uint64_t    w = write_idx.load(std::memory_order_acquire);
+  std::size_t n = std::min<uint64_t>(w - r, max_records);
+  for (std::size_t i = 0; i != n; ++i) {
+    out[i] = buffer[(r + i) & mask];
+  }
+  read_idx.store(r + n, std::memory_order_release);
+  return n;
+}
+
+namespace {
+
+/// Ring buffer of the calling thread, cached to avoid looking it up on every
+/// event.
+struct thread_ring_cache {
+  uint64_t                           instance_id = 0;
+  std::shared_ptr<trace_thread_ring> ring;
+
+  ~thread_ring_cache()
+  {
+    if (ring) {
+      ring->mark_exited();
+    }
+  }
+};
+
+thread_local thread_ring_cache ring_cache;
+
+std::atomic<uint64_t> next_instance_id{1};
+
+} // namespace
+
+trace_ring_tracer::trace_ring_tracer(std::size_t records_per_thread, std::unique_ptr<trace_exporter> exporter) :
+  records_per_thread(records_per_thread),
+  exporter(std::move(exporter)),
+  instance_id(next_instance_id.fetch_add(1, std::memory_order_relaxed)),
+  pop_buffer(pop_batch_size)
+{}
+
+bool trace_ring_tracer::start(const std::string& filename)
+{
+  if (running || file) {
+    return false;
+  }
+
+  file = std::fopen(filename.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+  exporter->begin(file);
+
+  // Take a first measurement of the frequency of the timestamp counter, which
+  // gets refined by the drainer over time.
+  start_ticks = read_trace_ticks();
+  start_ns    = steady_now_ns();
+  std::this_thread::sleep_for(calibration_period);
+  calibrate();
+
+  running = true;
+  drainer = std::thread([this]() {
+    ::pthread_setname_np(::pthread_self(), "TRACE_DRAINER");
+    drain_loop();
+  });
+
+  return true;
+}
+
+void trace_ring_tracer::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(drainer_mutex);
+    if (!running) {
+      return;
+    }
+    running = false;
+  }
+  drainer_cvar.notify_one();
+  drainer.join();
+
+  // Write the events recorded until now.
+  calibrate();
+  drain();
+  exporter->end(file);
+  std::fclose(file);
+  file = nullptr;
+}
+
+uint64_t trace_ring_tracer::get_nof_dropped() const
+{
+  std::lock_guard<std::mutex> lock(rings_mutex);
+  uint64_t                    count = nof_dropped_released;
+  for (const auto& ring : rings) {
+    count += ring->get_nof_dropped();
+  }
+  return count;
+}
+
+trace_thread_ring* trace_ring_tracer::get_thread_ring()
+{
+  if (ring_cache.instance_id == instance_id) {
+    return ring_cache.ring.get();
+  }
+  return register_thread();
+}
+
+trace_thread_ring* trace_ring_tracer::register_thread()
+{
+  // Release the ring of a previous tracer instance.
+  if (ring_cache.ring) {
+    ring_cache.ring->mark_exited();
+  }
+
+  char thread_name[32] = {};
+  if (::pthread_getname_np(::pthread_self(), thread_name, sizeof(thread_name)) != 0) {
+    thread_name[0] = '\0';
+  }
+  auto tid = (uint32_t)::syscall(SYS_gettid);
+
+  ring_cache.instance_id = instance_id;
+  ring_cache.ring        = std::make_shared<trace_thread_ring>(records_per_thread, tid, thread_name);
+
+  std::lock_guard<std::mutex> lock(rings_mutex);
+  rings.push_back(ring_cache.ring);
+  return ring_cache.ring.get();
+}
+
+uint64_t trace_ring_tracer::ticks_to_ns(uint64_t ticks) const
+{
+  if (ticks < start_ticks) {
+    return 0;
+  }
+  return (uint64_t)((ticks - start_ticks) * ns_per_tick);
+}
+
+void trace_ring_tracer::calibrate()
+{
+  // The timestamp counter is assumed to be invariant and synchronized across
+  // cores, which is the case in any recent x86 CPU.
+  uint64_t ticks = read_trace_ticks();
+  uint64_t ns    = steady_now_ns();
+  if (ticks > start_ticks && ns > start_ns) {
+    ns_per_tick = (double)(ns - start_ns) / (ticks - start_ticks);
+  }
+}
+
+void trace_ring_tracer::drain_loop()
+{
+  std::unique_lock<std::mutex> lock(drainer_mutex);
+  while (running) {
+    drainer_cvar.wait_for(lock, drain_period);
+    lock.unlock();
+    calibrate();
+    drain();
+    lock.lock();
+  }
+}
+
+void trace_ring_tracer::drain()
+{
+  // Work on a copy of the ring list, so that new threads are not blocked while
+  // writing to the file.
+  std::vector<std::shared_ptr<trace_thread_ring>> current;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    current = rings;
+  }
+
+  for (const auto& ring : current) {
+    if (declared_threads.insert(ring->get_tid()).second) {
+      exporter->add_thread(file, ring->get_tid(), ring->get_name());
+    }
+    std::size_t n;
+    while ((n = ring->pop(pop_buffer.data(), pop_buffer.size())) > 0) {
+      for (std::size_t i = 0; i != n; ++i) {
+        exporter->add_event(file, ring->get_tid(), pop_buffer[i], ticks_to_ns(pop_buffer[i].ticks));
+      }
+    }
+  }
+  std::fflush(file);
+
+  // Release the rings of exited threads once they have been fully drained.
+  std::lock_guard<std::mutex> lock(rings_mutex);
+  auto it = std::remove_if(rings.begin(), rings.end(), [this](const std::shared_ptr<trace_thread_ring>& ring) {
+    if (ring->has_exited() && ring->empty()) {
+      nof_dropped_released += ring->get_nof_dropped();
+      return true;
+    }
+    return false;
+  });
+  rings.erase(it, rings.end());
+}
+
+namespace {
+
+/// Writes the input string escaping the characters that are not allowed in
+/// JSON strings.
+void write_json_string(std::FILE* f, const char* str)
+{
+  std::fputc('"', f);
+  for (; *str; ++str) {
+    auto c = (unsigned char)*str;
+    if (c == '"' || c == '\\') {
+      std::fputc('\\', f);
+      std::fputc(c, f);
+    } else if (c < 0x20) {
+      std::fprintf(f, "\\u%04x", c);
+    } else {
+      std::fputc(c, f);
+    }
+  }
+  std::fputc('"', f);
+}
+
+/// Exporter of the Chrome trace event JSON format, which can be loaded in
+/// chrome://tracing and in the Perfetto UI.
+class chrome_json_exporter : public trace_exporter
+{
+public:
+  void begin(std::FILE* f) override
+  {
+    pid = (unsigned)::getpid();
+    std::fputs("{\"traceEvents\":[", f);
+  }
+
+  void add_thread(std::FILE* f, uint32_t tid, const std::string& name) override
+  {
+    next_event(f);
+    std::fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":", pid, tid);
+    write_json_string(f, name.c_str());
+    std::fputs("}}", f);
+  }
+
+  void add_event(std::FILE* f, uint32_t tid, const trace_record& r, uint64_t timestamp_ns) override
+  {
+    next_event(f);
+    std::fputs("{\"name\":", f);
+    write_json_string(f, r.name);
+    std::fputs(",\"cat\":", f);
+    write_json_string(f, r.category);
+
+    // Timestamps are expressed in microseconds.
+    switch (r.type) {
+      case trace_record_type::begin:
+        std::fprintf(f, ",\"ph\":\"B\",\"ts\":%.3f", timestamp_ns / 1e3);
+        break;
+      case trace_record_type::end:
+        std::fprintf(f, ",\"ph\":\"E\",\"ts\":%.3f", timestamp_ns / 1e3);
+        break;
+      case trace_record_type::instant:
+        std::fprintf(f, ",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f", timestamp_ns / 1e3);
+        break;
+      case trace_record_type::counter:
+        std::fprintf(
+            f, ",\"ph\":\"C\",\"ts\":%.3f,\"args\":{\"value\":%lld}", timestamp_ns / 1e3, (long long)r.value);
+        break;
+      case trace_record_type::complete: {
+        uint64_t duration_ns = std::min<uint64_t>(r.value, timestamp_ns);
+        std::fprintf(f,
+                     ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f",
+                     (timestamp_ns - duration_ns) / 1e3,
+                     duration_ns / 1e3);
+        break;
+      }
+    }
+    std::fprintf(f, ",\"pid\":%u,\"tid\":%u}", pid, tid);
+  }
+
+  void end(std::FILE* f) override { std::fputs("\n]}\n", f); }
+
+private:
+  void next_event(std::FILE* f)
+  {
+    std::fputs(first ? "\n" : ",\n", f);
+    first = false;
+  }
+
+  unsigned pid   = 0;
+  bool     first = true;
+};
+
+/// Minimal encoder of the protobuf wire format.
+class proto_encoder
+{
+public:
+  void clear() { buffer.clear(); }
+
+  const std::string& data() const { return buffer; }
+
+  void add_varint(uint32_t field, uint64_t value)
+  {
+    put_varint((uint64_t)field << 3);
+    put_varint(value);
+  }
+
+  void add_bytes(uint32_t field, const char* data, std::size_t len)
+  {
+    put_varint(((uint64_t)field << 3) | 2);
+    put_varint(len);
+    buffer.append(data, len);
+  }
+
+  void add_string(uint32_t field, const char* str) { add_bytes(field, str, std::strlen(str)); }
+
+  void add_message(uint32_t field, const proto_encoder& msg) { add_bytes(field, msg.buffer.data(), msg.buffer.size()); }
+
+private:
+  void put_varint(uint64_t value)
+  {
+    while (value >= 0x80) {
+      buffer.push_back((char)((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    buffer.push_back((char)value);
+  }
+
+  std::string buffer;
+};
+
+/// Exporter of the Perfetto protobuf trace format, which can be loaded in the
+/// Perfetto UI (ui.perfetto.dev) and queried with its trace processor.
+/// Field numbers follow perfetto/trace/trace_packet.proto and track_event.proto.
+class perfetto_exporter : public trace_exporter
+{
+  // Trace message.
+  static constexpr uint32_t trace_packet = 1;
+  // TracePacket message.
+  static constexpr uint32_t packet_timestamp        = 8;
+  static constexpr uint32_t packet_sequence_id      = 10;
+  static constexpr uint32_t packet_track_event      = 11;
+  static constexpr uint32_t packet_sequence_flags   = 13;
+  static constexpr uint32_t packet_track_descriptor = 60;
+  // TrackDescriptor message.
+  static constexpr uint32_t track_uuid        = 1;
+  static constexpr uint32_t track_name        = 2;
+  static constexpr uint32_t track_process     = 3;
+  static constexpr uint32_t track_thread      = 4;
+  static constexpr uint32_t track_parent_uuid = 5;
+  static constexpr uint32_t track_counter     = 8;
+  // ProcessDescriptor and ThreadDescriptor messages.
+  static constexpr uint32_t desc_pid         = 1;
+  static constexpr uint32_t desc_tid         = 2;
+  static constexpr uint32_t desc_thread_name = 5;
+  // TrackEvent message.
+  static constexpr uint32_t event_type          = 9;
+  static constexpr uint32_t event_track_uuid    = 11;
+  static constexpr uint32_t event_categories    = 22;
+  static constexpr uint32_t event_name          = 23;
+  static constexpr uint32_t event_counter_value = 30;
+  // TrackEvent types.
+  static constexpr uint64_t type_slice_begin = 1;
+  static constexpr uint64_t type_slice_end   = 2;
+  static constexpr uint64_t type_instant     = 3;
+  static constexpr uint64_t type_counter     = 4;
+  // Sequence flag SEQ_INCREMENTAL_STATE_CLEARED.
+  static constexpr uint64_t incremental_state_cleared = 1;
+  // All packets are written in a single sequence.
+  static constexpr uint64_t sequence_id = 1;
+
+public:
+  void begin(std::FILE* f) override
+  {
+    pid          = (uint32_t)::getpid();
+    process_uuid = (1ULL << 48) | pid;
+
+    proto_encoder process;
+    process.add_varint(desc_pid, pid);
+    track.clear();
+    track.add_varint(track_uuid, process_uuid);
+    track.add_message(track_process, process);
+    packet.clear();
+    packet.add_varint(packet_sequence_id, sequence_id);
+    packet.add_varint(packet_sequence_flags, incremental_state_cleared);
+    packet.add_message(packet_track_descriptor, track);
+    write_packet(f);
+  }
+
+  void add_thread(std::FILE* f, uint32_t tid, const std::string& name) override
+  {
+    proto_encoder thread;
+    thread.add_varint(desc_pid, pid);
+    thread.add_varint(desc_tid, tid);
+    thread.add_string(desc_thread_name, name.c_str());
+    track.clear();
+    track.add_varint(track_uuid, tid);
+    track.add_varint(track_parent_uuid, process_uuid);
+    track.add_message(track_thread, thread);
+    packet.clear();
+    packet.add_varint(packet_sequence_id, sequence_id);
+    packet.add_message(packet_track_descriptor, track);
+    write_packet(f);
+  }
+
+  void add_event(std::FILE* f, uint32_t tid, const trace_record& r, uint64_t timestamp_ns) override
+  {
+    switch (r.type) {
+      case trace_record_type::begin:
+        write_event(f, timestamp_ns, type_slice_begin, tid, &r);
+        break;
+      case trace_record_type::end:
+        write_event(f, timestamp_ns, type_slice_end, tid, nullptr);
+        break;
+      case trace_record_type::instant:
+        write_event(f, timestamp_ns, type_instant, tid, &r);
+        break;
+      case trace_record_type::counter:
+        write_event(f, timestamp_ns, type_counter, get_counter_track(f, r.name), &r);
+        break;
+      case trace_record_type::complete: {
+        uint64_t duration_ns = std::min<uint64_t>(r.value, timestamp_ns);
+        write_event(f, timestamp_ns - duration_ns, type_slice_begin, tid, &r);
+        write_event(f, timestamp_ns, type_slice_end, tid, nullptr);
+        break;
+      }
+    }
+  }
+
+  void end(std::FILE*) override {}
+
+private:
+  /// Writes a track event, where the category and name are omitted when r is
+  /// null.
+  void write_event(std::FILE* f, uint64_t timestamp_ns, uint64_t type, uint64_t uuid, const trace_record* r)
+  {
+    event.clear();
+    event.add_varint(event_type, type);
+    event.add_varint(event_track_uuid, uuid);
+    if (r && type != type_counter) {
+      event.add_string(event_categories, r->category);
+      event.add_string(event_name, r->name);
+    }
+    if (r && type == type_counter) {
+      event.add_varint(event_counter_value, (uint64_t)r->value);
+    }
+    packet.clear();
+    packet.add_varint(packet_timestamp, timestamp_ns);
+    packet.add_varint(packet_sequence_id, sequence_id);
+    packet.add_message(packet_track_event, event);
+    write_packet(f);
+  }
+
+  /// Returns the uuid of the track of the specified counter, declaring it on
+  /// first use.
+  uint64_t get_counter_track(std::FILE* f, const char* name)
+  {
+    uint64_t uuid = (2ULL << 48) | (std::hash<std::string>{}(name) & ((1ULL << 48) - 1));
+    if (!counter_tracks.insert(uuid).second) {
+      return uuid;
+    }
+    track.clear();
+    track.add_varint(track_uuid, uuid);
+    track.add_string(track_name, name);
+    track.add_varint(track_parent_uuid, process_uuid);
+    track.add_bytes(track_counter, "", 0);
+    packet.clear();
+    packet.add_varint(packet_sequence_id, sequence_id);
+    packet.add_message(packet_track_descriptor, track);
+    write_packet(f);
+    return uuid;
+  }
+
+  void write_packet(std::FILE* f)
+  {
+    trace.clear();
+    trace.add_message(trace_packet, packet);
+    std::fwrite(trace.data().data(), 1, trace.data().size(), f);
+  }
+
+  uint32_t                     pid          = 0;
+  uint64_t                     process_uuid = 0;
+  std::unordered_set<uint64_t> counter_tracks;
+  proto_encoder                trace;
+  proto_encoder                packet;
+  proto_encoder                track;
+  proto_encoder                event;
+};
+
+} // namespace
+
+std::unique_ptr<trace_exporter> srslog::detail::create_trace_exporter(event_trace_format format)
+{
+  if (format == event_trace_format::perfetto) {
+    return std::unique_ptr<trace_exporter>(new perfetto_exporter);
+  }
+  return std::unique_ptr<trace_exporter>(new chrome_json_exporter);
+}
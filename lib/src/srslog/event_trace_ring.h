@@ -0,0 +1,216 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_EVENT_TRACE_RING_H
+#define SRSLOG_EVENT_TRACE_RING_H
+
+#include "srsran/srslog/event_trace.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace srslog {
+
+namespace detail {
+
+/// Types of the trace records.
+enum class trace_record_type : uint8_t { begin, end, instant, counter, complete };
+
+/// Fixed size trace record. Only the addresses of the category and name
+/// strings are stored, so they must outlive the tracer.
+struct trace_record {
+  uint64_t          ticks;
+  const char*       category;
+  const char*       name;
+  /// Counter value, or duration in nanoseconds of complete events.
+  int64_t           value;
+  trace_record_type type;
+};
+
+/// Reads the timestamp counter of the CPU, falling back to the steady clock
+/// on other architectures.
+inline uint64_t read_trace_ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  uint32_t lo, hi;
+  __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+  return ((uint64_t)hi << 32) | lo;
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+/// Single producer, single consumer ring buffer of trace records owned by one
+/// thread. The owner thread pushes records and the drainer thread pops them.
+class trace_thread_ring
+{
+public:
+  trace_thread_ring(std::size_t capacity, uint32_t tid, std::string name);
+
+  trace_thread_ring(const trace_thread_ring&) = delete;
+  trace_thread_ring& operator=(const trace_thread_ring&) = delete;
+
+  /// Pushes a new record into the ring. Returns false when the ring is full,
+  /// in which case the record is dropped.
+  bool try_push(const trace_record& r)
+  {
+    uint64_t w = write_idx.load(std::memory_order_relaxed);
+    if (w - read_idx.load(std::memory_order_acquire) >= buffer.size()) {
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    buffer[w & mask] = r;
+    write_idx.store(w + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Pops at most max_records records into the output buffer, returning the
+  /// number of popped records.
+  std::size_t pop(trace_record* out, std::size_t max_records);
+
+  bool empty() const
+  {
+    return read_idx.load(std::memory_order_relaxed) == write_idx.load(std::memory_order_acquire);
+  }
+
+  uint32_t           get_tid() const { return tid; }
+  const std::string& get_name() const { return name; }
+  uint64_t           get_nof_dropped() const { return nof_dropped.load(std::memory_order_relaxed); }
+
+  /// Flags that the owner thread has exited, so that the ring can be released
+  /// once drained.
+  void               mark_exited() { exited.store(true, std::memory_order_release); }
+  bool               has_exited() const { return exited.load(std::memory_order_acquire); }
+
+private:
+  std::vector<trace_record> buffer;
+  const uint64_t            mask;
+  const uint32_t            tid;
+  const std::string         name;
+  alignas(64) std::atomic<uint64_t> write_idx{0};
+  alignas(64) std::atomic<uint64_t> read_idx{0};
+  std::atomic<uint64_t>             nof_dropped{0};
+  std::atomic<bool>                 exited{false};
+};
+
+/// Writes the drained trace records in one of the supported file formats.
+class trace_exporter
+{
+public:
+  virtual ~trace_exporter() = default;
+
+  /// Writes the file header.
+  virtual void begin(std::FILE* f) = 0;
+
+  /// Declares a new thread, before any of its events is written.
+  virtual void add_thread(std::FILE* f, uint32_t tid, const std::string& name) = 0;
+
+  /// Writes one event, where timestamp_ns is the end of complete events.
+  virtual void add_event(std::FILE* f, uint32_t tid, const trace_record& r, uint64_t timestamp_ns) = 0;
+
+  /// Writes the file trailer.
+  virtual void end(std::FILE* f) = 0;
+};
+
+/// Event tracer that records trace events into per thread lock-free ring
+/// buffers, and drains them into a trace file from a background thread.
+class trace_ring_tracer
+{
+public:
+  trace_ring_tracer(std::size_t records_per_thread, std::unique_ptr<trace_exporter> exporter);
+  ~trace_ring_tracer() { stop(); }
+
+  trace_ring_tracer(const trace_ring_tracer&) = delete;
+  trace_ring_tracer& operator=(const trace_ring_tracer&) = delete;
+
+  /// Opens the output file and starts the drainer thread.
+  bool start(const std::string& filename);
+
+  /// Drains all the pending records, stops the drainer thread and closes the
+  /// output file. Calling this function more than once has no effect.
+  void stop();
+
+  /// Records a new event in the ring buffer of the calling thread.
+  void push(trace_record_type type, const char* category, const char* name, int64_t value)
+  {
+    trace_thread_ring* ring = get_thread_ring();
+    if (ring) {
+      ring->try_push({read_trace_ticks(), category, name, value, type});
+    }
+  }
+
+  /// Returns the number of records dropped because of full ring buffers.
+  uint64_t get_nof_dropped() const;
+
+private:
+  trace_thread_ring* get_thread_ring();
+  trace_thread_ring* register_thread();
+
+  /// Converts a tick count of the CPU counter to nanoseconds since start.
+  uint64_t ticks_to_ns(uint64_t ticks) const;
+
+  /// Updates the ticks to nanoseconds conversion with a new anchor point.
+  void calibrate();
+
+  void drain_loop();
+
+  /// Writes the pending records of every ring into the output file.
+  void drain();
+
+  const std::size_t                               records_per_thread;
+  const std::unique_ptr<trace_exporter>           exporter;
+  /// Identifies this tracer instance in the thread local ring caches.
+  const uint64_t                                  instance_id;
+  std::FILE*                                      file = nullptr;
+  mutable std::mutex                              rings_mutex;
+  std::vector<std::shared_ptr<trace_thread_ring>> rings;
+  std::unordered_set<uint32_t>                    declared_threads;
+  uint64_t                                        nof_dropped_released = 0;
+  std::vector<trace_record>                       pop_buffer;
+  std::thread                                     drainer;
+  std::mutex                                      drainer_mutex;
+  std::condition_variable                         drainer_cvar;
+  bool                                            running = false;
+
+  // Conversion from ticks to nanoseconds.
+  uint64_t start_ticks = 0;
+  uint64_t start_ns    = 0;
+  double   ns_per_tick = 1.0;
+};
+
+/// Creates the exporter of the specified trace file format.
+std::unique_ptr<trace_exporter> create_trace_exporter(event_trace_format format);
+
+} // namespace detail
+
+} // namespace srslog
+
+#endif // SRSLOG_EVENT_TRACE_RING_H
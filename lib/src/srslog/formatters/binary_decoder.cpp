@@ -0,0 +1,259 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "binary_decoder.h"
+#include "binary_format.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+
+using namespace srslog;
+using namespace srslog::binary_format;
+
+/// Output is written into the file in chunks of this size.
+static constexpr size_t output_chunk_size = 1U << 16U;
+
+detail::error_string binary_decoder::decode(const uint8_t* data, size_t size, std::FILE* out)
+{
+  reader   file(data, size);
+  char     magic[sizeof(file_magic)];
+  uint16_t version = 0, bom = 0;
+  if (!file.get(magic) || !file.get(version) || !file.get(bom) || std::memcmp(magic, file_magic, sizeof(magic)) != 0) {
+    return "Not a binary log file";
+  }
+  if (version > file_version) {
+    return fmt::format("Unsupported binary log file version {}", version);
+  }
+  if (bom != byte_order_mark) {
+    return "Binary log file written by a host with a different byte order";
+  }
+
+  // Every file holds the definitions of the strings it uses.
+  strings.clear();
+
+  detail::error_string err;
+  while (!err && file.remaining() != 0) {
+    uint8_t          type         = 0;
+    uint32_t         payload_size = 0;
+    fmt::string_view payload;
+    if (!file.get(type) || !file.get(payload_size) || !file.get_view(payload, payload_size)) {
+      err = "Truncated record at the end of the file";
+      break;
+    }
+
+    auto* p = reinterpret_cast<const uint8_t*>(payload.data());
+    switch (static_cast<record_type>(type)) {
+      case record_type::string_def:
+        err = decode_string_def(p, payload.size());
+        break;
+      case record_type::log_entry:
+        err = decode_log_entry(p, payload.size());
+        break;
+      case record_type::text_entry:
+        err = decode_text_entry(p, payload.size());
+        break;
+      default:
+        // Records added by newer versions are skipped.
+        break;
+    }
+
+    if (output.size() >= output_chunk_size) {
+      if (auto write_err = write_output(out)) {
+        return write_err;
+      }
+    }
+  }
+
+  if (auto write_err = write_output(out)) {
+    return write_err;
+  }
+  return err;
+}
+
+detail::error_string binary_decoder::write_output(std::FILE* out)
+{
+  if (output.size() != 0 && std::fwrite(output.data(), sizeof(char), output.size(), out) != output.size()) {
+    return "Unable to write the decoded entries";
+  }
+  output.clear();
+  return {};
+}
+
+detail::error_string binary_decoder::decode_string_def(const uint8_t* payload, size_t size)
+{
+  reader           r(payload, size);
+  uint32_t         id = 0;
+  fmt::string_view str;
+  // Identifiers are assigned sequentially.
+  if (!r.get(id) || !r.get_view(str, r.remaining()) || id > strings.size()) {
+    return "Malformed string definition record";
+  }
+  if (id == strings.size()) {
+    strings.emplace_back();
+  }
+  strings[id].assign(str.data(), str.size());
+  return {};
+}
+
+/// Reads the prefix common to all entry records into the metadata.
+static bool decode_entry_prefix(reader& r, const std::vector<std::string>& strings, detail::log_entry_metadata& md)
+{
+  int64_t  tp_ns       = 0;
+  uint32_t name_id     = 0;
+  uint32_t ctx_value   = 0;
+  uint8_t  ctx_enabled = 0;
+  if (!r.get(tp_ns) || !r.get(name_id) || !r.get(ctx_value) || !r.get(ctx_enabled) || !r.get(md.log_tag)) {
+    return false;
+  }
+  if (name_id != invalid_string_id && name_id >= strings.size()) {
+    return false;
+  }
+
+  using clock_type = std::chrono::high_resolution_clock;
+  md.tp = clock_type::time_point(std::chrono::duration_cast<clock_type::duration>(std::chrono::nanoseconds(tp_ns)));
+  md.context = {ctx_value, ctx_enabled != 0};
+  if (name_id != invalid_string_id) {
+    md.log_name = strings[name_id];
+  }
+  return true;
+}
+
+/// Reads the hex dump at the end of entry records into the metadata.
+static bool decode_hex_dump(reader& r, detail::log_entry_metadata& md)
+{
+  uint32_t         hex_size = 0;
+  fmt::string_view hex;
+  if (!r.get(hex_size) || !r.get_view(hex, hex_size)) {
+    return false;
+  }
+  md.hex_dump.assign(hex.data(), hex.data() + hex.size());
+  return true;
+}
+
+/// Reads an argument value of type T and pushes it into the store.
+template <typename T, typename Stored = T>
+static bool decode_arg(reader& r, fmt::dynamic_format_arg_store<fmt::printf_context>& store)
+{
+  T value;
+  if (!r.get(value)) {
+    return false;
+  }
+  store.push_back(static_cast<Stored>(value));
+  return true;
+}
+
+/// Reads a serialized argument and pushes it into the store.
+static bool decode_arg(reader& r, fmt::dynamic_format_arg_store<fmt::printf_context>& store)
+{
+  arg_type type;
+  if (!r.get(type)) {
+    return false;
+  }
+
+  switch (type) {
+    case arg_type::int32:
+      return decode_arg<int32_t, int>(r, store);
+    case arg_type::uint32:
+      return decode_arg<uint32_t, unsigned>(r, store);
+    case arg_type::int64:
+      return decode_arg<int64_t, long long>(r, store);
+    case arg_type::uint64:
+      return decode_arg<uint64_t, unsigned long long>(r, store);
+    case arg_type::boolean:
+      return decode_arg<uint8_t, bool>(r, store);
+    case arg_type::character:
+      return decode_arg<char>(r, store);
+    case arg_type::float32:
+      return decode_arg<float>(r, store);
+    case arg_type::float64:
+      return decode_arg<double>(r, store);
+    case arg_type::long_float64:
+      return decode_arg<double, long double>(r, store);
+    case arg_type::pointer: {
+      uint64_t value = 0;
+      if (!r.get(value)) {
+        return false;
+      }
+      store.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(value)));
+      return true;
+    }
+    case arg_type::string: {
+      fmt::string_view str;
+      if (!r.get_string(str)) {
+        return false;
+      }
+      store.push_back(std::string(str.data(), str.size()));
+      return true;
+    }
+  }
+  return false;
+}
+
+detail::error_string binary_decoder::decode_log_entry(const uint8_t* payload, size_t size)
+{
+  reader                     r(payload, size);
+  detail::log_entry_metadata md{};
+  uint32_t                   fmt_id   = 0;
+  uint8_t                    nof_args = 0;
+  if (!decode_entry_prefix(r, strings, md) || !r.get(fmt_id) || !r.get(nof_args)) {
+    return "Malformed log entry record";
+  }
+  if (fmt_id != invalid_string_id) {
+    if (fmt_id >= strings.size()) {
+      return "Log entry references an undefined format string";
+    }
+    md.fmtstring = strings[fmt_id].c_str();
+  }
+
+  store.clear();
+  if (nof_args != no_arg_store) {
+    for (unsigned i = 0; i != nof_args; ++i) {
+      if (!decode_arg(r, store)) {
+        return "Malformed log entry argument";
+      }
+    }
+    md.store = &store;
+  }
+  if (!decode_hex_dump(r, md)) {
+    return "Malformed log entry record";
+  }
+
+  formatter->format(std::move(md), output);
+  ++nof_entries;
+  return {};
+}
+
+detail::error_string binary_decoder::decode_text_entry(const uint8_t* payload, size_t size)
+{
+  reader                     r(payload, size);
+  detail::log_entry_metadata md{};
+  fmt::string_view           text;
+  if (!decode_entry_prefix(r, strings, md) || !r.get_string(text) || !decode_hex_dump(r, md)) {
+    return "Malformed text entry record";
+  }
+
+  // Text entries are printed verbatim, without an argument store.
+  std::string text_str(text.data(), text.size());
+  md.fmtstring = text_str.c_str();
+
+  formatter->format(std::move(md), output);
+  ++nof_entries;
+  return {};
+}
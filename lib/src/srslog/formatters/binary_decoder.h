@@ -0,0 +1,69 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSLOG_BINARY_DECODER_H
+#define SRSLOG_BINARY_DECODER_H
+
+#include "srsran/srslog/bundled/fmt/printf.h"
+#include "srsran/srslog/detail/support/error_string.h"
+#include "srsran/srslog/formatter.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace srslog {
+
+/// Renders the binary log files written by the binary formatter using another formatter, e.g. a text or JSON one.
+class binary_decoder
+{
+public:
+  explicit binary_decoder(std::unique_ptr<log_formatter> f) : formatter(std::move(f)) { output.reserve(1U << 16U); }
+
+  binary_decoder(const binary_decoder&) = delete;
+  binary_decoder& operator=(const binary_decoder&) = delete;
+
+  /// Decodes the contents of a whole binary log file and writes the rendered entries into out. The entries preceding
+  /// a malformed or truncated record are written before returning the error.
+  detail::error_string decode(const uint8_t* data, size_t size, std::FILE* out);
+
+  /// Number of entries that have been rendered so far.
+  uint64_t get_nof_entries() const { return nof_entries; }
+
+private:
+  detail::error_string decode_string_def(const uint8_t* payload, size_t size);
+  detail::error_string decode_log_entry(const uint8_t* payload, size_t size);
+  detail::error_string decode_text_entry(const uint8_t* payload, size_t size);
+
+  /// Writes the pending output into the file.
+  detail::error_string write_output(std::FILE* out);
+
+private:
+  std::unique_ptr<log_formatter>                     formatter;
+  std::vector<std::string>                           strings;
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+  fmt::memory_buffer                                 output;
+  uint64_t                                           nof_entries = 0;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_DECODER_H
@@ -0,0 +1,169 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSLOG_BINARY_FORMAT_H
+#define SRSLOG_BINARY_FORMAT_H
+
+#include "srsran/srslog/bundled/fmt/format.h"
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace srslog {
+
+/// Layout of the binary log files written by the binary formatter.
+///
+/// A file starts with a header followed by a sequence of records. Every record starts with a 1 byte type and a 4 byte
+/// payload size, so that readers can skip records they do not understand. All integers are stored in the byte order
+/// of the host that wrote the file, which is recorded in the header.
+///
+/// Format strings and logger names are not repeated in every entry: the first time a string is seen, a string
+/// definition record assigns it an identifier, which is then referenced by the log entries.
+namespace binary_format {
+
+/// Magic bytes at the beginning of every file.
+constexpr char     file_magic[8] = {'S', 'R', 'S', 'L', 'O', 'G', 'B', '\0'};
+constexpr uint16_t file_version  = 1;
+/// Written in host byte order, allows readers to detect files created in hosts with a different endianness.
+constexpr uint16_t byte_order_mark = 0x0102;
+/// Size of the file header: magic, version and byte order mark.
+constexpr size_t file_header_size = sizeof(file_magic) + 2 * sizeof(uint16_t);
+/// Size of the record header: type and payload size.
+constexpr size_t record_header_size = sizeof(uint8_t) + sizeof(uint32_t);
+
+/// Identifier of a missing string, e.g. the logger name of an unnamed channel.
+constexpr uint32_t invalid_string_id = std::numeric_limits<uint32_t>::max();
+/// Number of arguments of entries whose format string is printed verbatim, i.e. entries without an argument store.
+constexpr uint8_t no_arg_store = std::numeric_limits<uint8_t>::max();
+
+enum class record_type : uint8_t {
+  /// Payload: uint32 id, followed by the string characters.
+  string_def = 1,
+  /// Payload: entry prefix, uint32 format string id, uint8 number of arguments, the arguments, uint32 hex dump size
+  /// and the hex dump bytes.
+  log_entry = 2,
+  /// Payload: entry prefix, uint32 text size, the text, uint32 hex dump size and the hex dump bytes. Used for entries
+  /// that are rendered to text upfront, like context dumps.
+  text_entry = 3
+};
+
+/// Common prefix of log_entry and text_entry records: int64 nanoseconds since epoch, uint32 logger name id, uint32
+/// context value, uint8 context enabled flag and the 1 byte log tag.
+constexpr size_t entry_prefix_size = sizeof(int64_t) + 2 * sizeof(uint32_t) + 2 * sizeof(uint8_t);
+
+/// Type tag of each argument, followed by its value. Strings are stored as an uint32 size and the characters.
+enum class arg_type : uint8_t {
+  int32,
+  uint32,
+  int64,
+  uint64,
+  boolean,
+  character,
+  float32,
+  float64,
+  long_float64,
+  string,
+  pointer
+};
+
+/// Appends the raw bytes of the given value to the buffer.
+template <typename T>
+inline void put(fmt::memory_buffer& buffer, const T& value)
+{
+  static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types are supported");
+  const char* p = reinterpret_cast<const char*>(&value);
+  buffer.append(p, p + sizeof(T));
+}
+
+/// Appends a string as its size followed by its characters.
+inline void put_string(fmt::memory_buffer& buffer, fmt::string_view str)
+{
+  put(buffer, static_cast<uint32_t>(str.size()));
+  buffer.append(str.data(), str.data() + str.size());
+}
+
+/// Appends a record header and returns its position, so that the payload size can be set once the payload is written.
+inline size_t begin_record(fmt::memory_buffer& buffer, record_type type)
+{
+  size_t pos = buffer.size();
+  put(buffer, static_cast<uint8_t>(type));
+  put(buffer, uint32_t(0));
+  return pos;
+}
+
+/// Sets the payload size of the record that starts at the given position.
+inline void end_record(fmt::memory_buffer& buffer, size_t record_pos)
+{
+  auto payload_size = static_cast<uint32_t>(buffer.size() - record_pos - record_header_size);
+  std::memcpy(buffer.data() + record_pos + sizeof(uint8_t), &payload_size, sizeof(payload_size));
+}
+
+/// Bounds checked sequential reader of record payloads.
+class reader
+{
+public:
+  reader(const uint8_t* data, size_t size) : it(data), end(data + size) {}
+
+  /// Number of bytes left to read.
+  size_t remaining() const { return end - it; }
+
+  /// Reads a value, returns false if there are not enough bytes left.
+  template <typename T>
+  bool get(T& value)
+  {
+    if (remaining() < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, it, sizeof(T));
+    it += sizeof(T);
+    return true;
+  }
+
+  /// Reads a string of the given size without copying it, returns false if there are not enough bytes left.
+  bool get_view(fmt::string_view& str, size_t size)
+  {
+    if (remaining() < size) {
+      return false;
+    }
+    str = fmt::string_view(reinterpret_cast<const char*>(it), size);
+    it += size;
+    return true;
+  }
+
+  /// Reads a string stored as its size followed by its characters.
+  bool get_string(fmt::string_view& str)
+  {
+    uint32_t size = 0;
+    return get(size) && get_view(str, size);
+  }
+
+private:
+  const uint8_t* it;
+  const uint8_t* end;
+};
+
+} // namespace binary_format
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_FORMAT_H
@@ -0,0 +1,279 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "binary_formatter.h"
+#include "binary_format.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include <cstring>
+
+using namespace srslog;
+using namespace srslog::binary_format;
+
+std::unique_ptr<log_formatter> binary_formatter::clone() const
+{
+  return std::unique_ptr<log_formatter>(new binary_formatter);
+}
+
+namespace {
+
+/// Visitor that serializes format arguments, prefixing each value with its type.
+class arg_serializer
+{
+public:
+  explicit arg_serializer(fmt::memory_buffer& buffer) : buffer(buffer) {}
+
+  /// Number of arguments that have been serialized.
+  uint8_t get_nof_args() const { return nof_args; }
+
+  void operator()(int v) { put_arg(arg_type::int32, static_cast<int32_t>(v)); }
+  void operator()(unsigned v) { put_arg(arg_type::uint32, static_cast<uint32_t>(v)); }
+  void operator()(long long v) { put_arg(arg_type::int64, static_cast<int64_t>(v)); }
+  void operator()(unsigned long long v) { put_arg(arg_type::uint64, static_cast<uint64_t>(v)); }
+  void operator()(bool v) { put_arg(arg_type::boolean, static_cast<uint8_t>(v)); }
+  void operator()(char v) { put_arg(arg_type::character, v); }
+  void operator()(float v) { put_arg(arg_type::float32, v); }
+  void operator()(double v) { put_arg(arg_type::float64, v); }
+  void operator()(long double v) { put_arg(arg_type::long_float64, static_cast<double>(v)); }
+  void operator()(const char* v) { (*this)(fmt::string_view(v)); }
+  void operator()(fmt::string_view v)
+  {
+    put(buffer, arg_type::string);
+    put_string(buffer, v);
+    ++nof_args;
+  }
+  void operator()(const void* v) { put_arg(arg_type::pointer, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(v))); }
+
+  /// User defined types are rendered to a string, since they cannot be formatted offline.
+  void operator()(fmt::basic_format_arg<fmt::printf_context>::handle h)
+  {
+    fmt::memory_buffer  str;
+    fmt::printf_context ctx(std::back_inserter(static_cast<fmt::detail::buffer<char>&>(str)), "", {});
+    h.format(ctx.parse_context(), ctx);
+    (*this)(fmt::string_view(str.data(), str.size()));
+  }
+
+  /// Empty and unsupported arguments are skipped.
+  template <typename T>
+  void operator()(T)
+  {}
+
+private:
+  template <typename T>
+  void put_arg(arg_type type, T value)
+  {
+    put(buffer, type);
+    put(buffer, value);
+    ++nof_args;
+  }
+
+  fmt::memory_buffer& buffer;
+  uint8_t             nof_args = 0;
+};
+
+} // namespace
+
+/// Renders the log message of an entry to text.
+static void format_message(const detail::log_entry_metadata& md, fmt::memory_buffer& buffer)
+{
+  if (!md.store) {
+    fmt::format_to(buffer, "{}", md.fmtstring);
+    return;
+  }
+  fmt::basic_format_args<fmt::basic_printf_context_t<char> > args(*md.store);
+  try {
+    fmt::vprintf(buffer, fmt::to_string_view(md.fmtstring), args);
+  } catch (...) {
+    fmt::print(stderr, "srsLog error - Invalid format string: \"{}\"\n", md.fmtstring);
+    fmt::format_to(buffer, " -> srsLog error - Invalid format string: \"{}\"", md.fmtstring);
+#ifdef STOP_ON_WARNING
+    std::abort();
+#endif
+  }
+}
+
+void binary_formatter::format(detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer)
+{
+  uint32_t fmt_id = invalid_string_id;
+  if (metadata.fmtstring) {
+    fmt_id = get_format_string_id(metadata.fmtstring, buffer);
+    if (fmt_id == invalid_string_id) {
+      // No room left in the dictionary, fall back to text.
+      ctx_text.clear();
+      format_message(metadata, ctx_text);
+      format_text_entry(metadata, fmt::string_view(ctx_text.data(), ctx_text.size()), buffer);
+      return;
+    }
+  }
+  uint32_t name_id = get_name_id(metadata.log_name, buffer);
+
+  size_t record_pos = begin_record(buffer, record_type::log_entry);
+  format_entry_prefix(metadata, name_id, buffer);
+  put(buffer, fmt_id);
+
+  // The number of arguments is known once they have been serialized.
+  size_t nof_args_pos = buffer.size();
+  put(buffer, no_arg_store);
+  if (metadata.store) {
+    fmt::basic_format_args<fmt::printf_context> args(*metadata.store);
+    arg_serializer                              serializer(buffer);
+    for (int i = 0, e = std::min(args.max_size(), no_arg_store - 1); i != e; ++i) {
+      fmt::visit_format_arg(serializer, args.get(i));
+    }
+    buffer.data()[nof_args_pos] = static_cast<char>(serializer.get_nof_args());
+  }
+
+  put(buffer, static_cast<uint32_t>(metadata.hex_dump.size()));
+  buffer.append(metadata.hex_dump.data(), metadata.hex_dump.data() + metadata.hex_dump.size());
+  end_record(buffer, record_pos);
+}
+
+void binary_formatter::format_dictionary(fmt::memory_buffer& buffer) const
+{
+  for (uint32_t id = 0, e = strings.size(); id != e; ++id) {
+    size_t record_pos = begin_record(buffer, record_type::string_def);
+    put(buffer, id);
+    buffer.append(strings[id].data(), strings[id].data() + strings[id].size());
+    end_record(buffer, record_pos);
+  }
+}
+
+uint32_t binary_formatter::get_format_string_id(const char* str, fmt::memory_buffer& buffer)
+{
+  auto it = fmt_ids.find(str);
+  if (it != fmt_ids.end() && strings[it->second] == str) {
+    return it->second;
+  }
+  if (strings.size() == max_dictionary_size) {
+    return invalid_string_id;
+  }
+  uint32_t id  = define_string(str, buffer);
+  fmt_ids[str] = id;
+  return id;
+}
+
+uint32_t binary_formatter::get_name_id(const std::string& name, fmt::memory_buffer& buffer)
+{
+  if (name.empty()) {
+    return invalid_string_id;
+  }
+  auto it = name_ids.find(name);
+  if (it != name_ids.end()) {
+    return it->second;
+  }
+  // Logger names are bounded, so they are always added to the dictionary.
+  uint32_t id = define_string(name, buffer);
+  name_ids.emplace(name, id);
+  return id;
+}
+
+uint32_t binary_formatter::define_string(std::string str, fmt::memory_buffer& buffer)
+{
+  auto id = static_cast<uint32_t>(strings.size());
+  strings.push_back(std::move(str));
+
+  size_t record_pos = begin_record(buffer, record_type::string_def);
+  put(buffer, id);
+  buffer.append(strings.back().data(), strings.back().data() + strings.back().size());
+  end_record(buffer, record_pos);
+
+  return id;
+}
+
+void binary_formatter::format_entry_prefix(const detail::log_entry_metadata& md,
+                                           uint32_t                          name_id,
+                                           fmt::memory_buffer&               buffer)
+{
+  auto tp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(md.tp.time_since_epoch()).count();
+  put(buffer, static_cast<int64_t>(tp_ns));
+  put(buffer, name_id);
+  put(buffer, static_cast<uint32_t>(md.context.value));
+  put(buffer, static_cast<uint8_t>(md.context.enabled));
+  put(buffer, md.log_tag);
+}
+
+void binary_formatter::format_text_entry(const detail::log_entry_metadata& md,
+                                         fmt::string_view                  text,
+                                         fmt::memory_buffer&               buffer)
+{
+  uint32_t name_id = get_name_id(md.log_name, buffer);
+
+  size_t record_pos = begin_record(buffer, record_type::text_entry);
+  format_entry_prefix(md, name_id, buffer);
+  put_string(buffer, text);
+  put(buffer, static_cast<uint32_t>(md.hex_dump.size()));
+  buffer.append(md.hex_dump.data(), md.hex_dump.data() + md.hex_dump.size());
+  end_record(buffer, record_pos);
+}
+
+/// Contexts are rendered to text in the same way as the text formatter dumps them, as they are logged at a low rate.
+void binary_formatter::format_context_begin(const detail::log_entry_metadata& md,
+                                            fmt::string_view                  ctx_name,
+                                            unsigned                          size,
+                                            fmt::memory_buffer&               buffer)
+{
+  ctx_text.clear();
+  fmt::format_to(ctx_text, "Context dump for \"{}\"", ctx_name);
+  if (md.fmtstring) {
+    fmt::format_to(ctx_text, ": ");
+    format_message(md, ctx_text);
+  }
+}
+
+void binary_formatter::format_context_end(const detail::log_entry_metadata& md,
+                                          fmt::string_view                  ctx_name,
+                                          fmt::memory_buffer&               buffer)
+{
+  format_text_entry(md, fmt::string_view(ctx_text.data(), ctx_text.size()), buffer);
+}
+
+void binary_formatter::format_metric_set_begin(fmt::string_view    set_name,
+                                               unsigned            size,
+                                               unsigned            level,
+                                               fmt::memory_buffer& buffer)
+{
+  fmt::format_to(ctx_text, "\n{: <{}}> Set: {}", ' ', level * 2, set_name);
+}
+
+void binary_formatter::format_list_begin(fmt::string_view    list_name,
+                                         unsigned            size,
+                                         unsigned            level,
+                                         fmt::memory_buffer& buffer)
+{
+  fmt::format_to(ctx_text, "\n{: <{}}> List: {}", ' ', level * 2, list_name);
+}
+
+void binary_formatter::format_metric(fmt::string_view    metric_name,
+                                     fmt::string_view    metric_value,
+                                     fmt::string_view    metric_units,
+                                     metric_kind         kind,
+                                     unsigned            level,
+                                     fmt::memory_buffer& buffer)
+{
+  fmt::format_to(ctx_text,
+                 "\n{: <{}}{}: {}{}{}",
+                 ' ',
+                 level * 2,
+                 metric_name,
+                 metric_value,
+                 metric_units.size() == 0 ? "" : " ",
+                 metric_units);
+}
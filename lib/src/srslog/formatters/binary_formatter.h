@@ -0,0 +1,111 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSLOG_BINARY_FORMATTER_H
+#define SRSLOG_BINARY_FORMATTER_H
+
+#include "srsran/srslog/formatter.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace srslog {
+
+/// Binary formatter implementation class. Instead of rendering the log entries, it serializes the format string
+/// identifier, the raw arguments and the metadata of each entry, deferring the formatting to the offline decoder. The
+/// layout of the output is described in binary_format.h.
+class binary_formatter : public log_formatter
+{
+public:
+  binary_formatter() { ctx_text.reserve(1024); }
+
+  /// Returns a copy of the formatter with an empty string dictionary.
+  std::unique_ptr<log_formatter> clone() const override;
+
+  void format(detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer) override;
+
+  /// Writes the definitions of all the strings seen so far into the buffer, so that a file can be decoded on its own
+  /// after a rotation.
+  void format_dictionary(fmt::memory_buffer& buffer) const;
+
+  /// Maximum number of strings in the dictionary. Format strings that do not fit, e.g. strings built at runtime, are
+  /// rendered to text upfront.
+  static constexpr size_t max_dictionary_size = 1U << 16U;
+
+private:
+  void format_context_begin(const detail::log_entry_metadata& md,
+                            fmt::string_view                  ctx_name,
+                            unsigned                          size,
+                            fmt::memory_buffer&               buffer) override;
+
+  void format_context_end(const detail::log_entry_metadata& md,
+                          fmt::string_view                  ctx_name,
+                          fmt::memory_buffer&               buffer) override;
+
+  void format_metric_set_begin(fmt::string_view    set_name,
+                               unsigned            size,
+                               unsigned            level,
+                               fmt::memory_buffer& buffer) override;
+
+  void format_metric_set_end(fmt::string_view set_name, unsigned level, fmt::memory_buffer& buffer) override {}
+
+  void
+  format_list_begin(fmt::string_view list_name, unsigned size, unsigned level, fmt::memory_buffer& buffer) override;
+
+  void format_list_end(fmt::string_view list_name, unsigned level, fmt::memory_buffer& buffer) override {}
+
+  void format_metric(fmt::string_view    metric_name,
+                     fmt::string_view    metric_value,
+                     fmt::string_view    metric_units,
+                     metric_kind         kind,
+                     unsigned            level,
+                     fmt::memory_buffer& buffer) override;
+
+  /// Returns the identifier of the given format string, defining it in the buffer if it has not been seen before.
+  /// Returns binary_format::invalid_string_id when the dictionary is full.
+  uint32_t get_format_string_id(const char* str, fmt::memory_buffer& buffer);
+
+  /// Returns the identifier of the given logger name, defining it in the buffer if it has not been seen before.
+  uint32_t get_name_id(const std::string& name, fmt::memory_buffer& buffer);
+
+  /// Adds a new string to the dictionary and writes its definition into the buffer.
+  uint32_t define_string(std::string str, fmt::memory_buffer& buffer);
+
+  /// Writes the prefix common to all entry records.
+  void format_entry_prefix(const detail::log_entry_metadata& md, uint32_t name_id, fmt::memory_buffer& buffer);
+
+  /// Writes an entry that has been rendered to text.
+  void format_text_entry(const detail::log_entry_metadata& md, fmt::string_view text, fmt::memory_buffer& buffer);
+
+private:
+  /// Format strings are looked up by address, given that they are usually literals, and the contents are compared
+  /// to detect addresses that are reused by different strings.
+  std::unordered_map<const char*, uint32_t> fmt_ids;
+  std::unordered_map<std::string, uint32_t> name_ids;
+  std::vector<std::string>                  strings;
+  /// Text of the context that is being formatted.
+  fmt::memory_buffer ctx_text;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_FORMATTER_H
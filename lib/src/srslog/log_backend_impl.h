@@ -43,8 +43,13 @@ public:
   bool push(detail::log_entry&& entry) override
   {
     auto* arg_store = entry.metadata.store;
+    bool  is_flush  = entry.flush_cmd != nullptr;
     if (!queue.push(std::move(entry))) {
       arg_pool.dealloc(arg_store);
+      // Flush commands are retried by the caller, so they are not accounted as drops.
+      if (!is_flush) {
+        nof_dropped_entries.fetch_add(1, std::memory_order_relaxed);
+      }
       return false;
     }
     return true;
@@ -60,10 +65,18 @@ public:
   /// Stops the backend worker thread.
   void stop() { worker.stop(); }
 
+  /// Returns the number of log entries that have been discarded, either because the queue or the arg store pool was
+  /// full.
+  uint64_t get_nof_dropped_entries() const
+  {
+    return nof_dropped_entries.load(std::memory_order_relaxed) + arg_pool.get_nof_failed_allocs();
+  }
+
 private:
   detail::work_queue<detail::log_entry> queue;
   detail::dyn_arg_store_pool            arg_pool;
   backend_worker                        worker{queue, arg_pool};
+  std::atomic<uint64_t>                 nof_dropped_entries{0};
 };
 
 } // namespace srslog
@@ -0,0 +1,107 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSLOG_BINARY_FILE_SINK_H
+#define SRSLOG_BINARY_FILE_SINK_H
+
+#include "../formatters/binary_format.h"
+#include "../formatters/binary_formatter.h"
+#include "file_utils.h"
+#include "srsran/srslog/sink.h"
+
+namespace srslog {
+
+/// This sink implementation writes binary log files that are decoded offline by the srslog_decode tool. Log entries
+/// are not rendered, the binary formatter serializes their raw arguments instead. Includes the optional feature of
+/// file rotation, where every new file starts with the file header and the string dictionary so that it can be
+/// decoded on its own.
+class binary_file_sink : public sink
+{
+public:
+  binary_file_sink(std::string name, size_t max_size) :
+    sink(std::unique_ptr<log_formatter>(new binary_formatter)),
+    formatter(static_cast<binary_formatter&>(get_formatter())),
+    max_size((max_size == 0) ? 0 : std::max<size_t>(max_size, 4 * 1024)),
+    base_filename(std::move(name))
+  {}
+
+  binary_file_sink(const binary_file_sink& other) = delete;
+  binary_file_sink& operator=(const binary_file_sink& other) = delete;
+
+  detail::error_string write(detail::memory_buffer buffer) override
+  {
+    // Create a new file the first time we hit this method.
+    if (file_index == 0) {
+      if (auto err_str = create_file()) {
+        return err_str;
+      }
+    }
+
+    // Do not bother doing any work when the file was closed on a previous
+    // error.
+    if (!handler) {
+      return {};
+    }
+
+    current_size += buffer.size();
+    if (max_size && current_size >= max_size) {
+      if (auto err_str = create_file()) {
+        return err_str;
+      }
+      current_size += buffer.size();
+    }
+
+    return handler.write(buffer);
+  }
+
+  detail::error_string flush() override { return handler.flush(); }
+
+private:
+  /// Creates a new file, writing the file header and the strings defined so far.
+  detail::error_string create_file()
+  {
+    if (auto err_str = handler.create(file_utils::build_filename_with_index(base_filename, file_index++))) {
+      return err_str;
+    }
+
+    fmt::memory_buffer header;
+    header.append(binary_format::file_magic, binary_format::file_magic + sizeof(binary_format::file_magic));
+    binary_format::put(header, binary_format::file_version);
+    binary_format::put(header, binary_format::byte_order_mark);
+    formatter.format_dictionary(header);
+
+    current_size = header.size();
+    return handler.write({header.data(), header.size()});
+  }
+
+private:
+  binary_formatter& formatter;
+  const size_t      max_size;
+  const std::string base_filename;
+  file_utils::file  handler;
+  size_t            current_size = 0;
+  uint32_t          file_index   = 0;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_FILE_SINK_H
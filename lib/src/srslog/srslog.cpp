@@ -21,6 +21,7 @@
 
 #include "srsran/srslog/srslog.h"
 #include "formatters/json_formatter.h"
+#include "sinks/binary_file_sink.h"
 #include "sinks/file_sink.h"
 #include "sinks/syslog_sink.h"
 #include "srslog_instance.h"
@@ -178,6 +179,21 @@ sink& srslog::fetch_file_sink(const std::string&             path,
   return *s;
 }
 
+sink& srslog::fetch_binary_file_sink(const std::string& path, size_t max_size)
+{
+  assert(!path.empty() && "Empty path string");
+
+  if (auto* s = find_sink(path)) {
+    return *s;
+  }
+
+  auto& s = srslog_instance::get().get_sink_repo().emplace(std::piecewise_construct,
+                                                           std::forward_as_tuple(path),
+                                                           std::forward_as_tuple(new binary_file_sink(path, max_size)));
+
+  return *s;
+}
+
 sink& srslog::fetch_syslog_sink(const std::string&             preamble_,
                                 syslog_local_type              log_local_,
                                 std::unique_ptr<log_formatter> f)
@@ -258,6 +274,11 @@ void srslog::set_error_handler(error_handler handler)
   srslog_instance::get().set_error_handler(std::move(handler));
 }
 
+uint64_t srslog::get_nof_dropped_entries()
+{
+  return srslog_instance::get().get_nof_dropped_entries();
+}
+
 ///
 /// Logger management function implementations.
 ///
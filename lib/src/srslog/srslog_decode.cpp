@@ -0,0 +1,101 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+/// Renders the binary log files written by the binary file sink of srslog as text or JSON.
+
+#include "formatters/binary_decoder.h"
+#include "srsran/srslog/srslog.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace srslog;
+
+static void usage(const char* prog)
+{
+  fmt::print(stderr,
+             "Usage: {} [-j] file [file...]\n"
+             "\t-j Render the entries as JSON instead of plain text\n"
+             "Files are decoded in order, e.g. the files created by the log rotation may be given one after the other\n",
+             prog);
+}
+
+/// Maps the given file into memory and decodes it into stdout.
+static bool decode_file(binary_decoder& decoder, const char* path)
+{
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) {
+    fmt::print(stderr, "Unable to open \"{}\": {}\n", path, std::strerror(errno));
+    return false;
+  }
+  struct stat st = {};
+  if (::fstat(fd, &st) != 0) {
+    fmt::print(stderr, "Unable to read \"{}\": {}\n", path, std::strerror(errno));
+    ::close(fd);
+    return false;
+  }
+
+  size_t size = st.st_size;
+  void*  data = size == 0 ? nullptr : ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    fmt::print(stderr, "Unable to map \"{}\": {}\n", path, std::strerror(errno));
+    return false;
+  }
+
+  detail::error_string err = decoder.decode(static_cast<const uint8_t*>(data), size, stdout);
+  if (data != nullptr) {
+    ::munmap(data, size);
+  }
+  if (err) {
+    fmt::print(stderr, "Error decoding \"{}\": {}\n", path, err.get_error());
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  bool json  = false;
+  int  first = 1;
+  if (argc > 1 && std::strcmp(argv[1], "-j") == 0) {
+    json  = true;
+    first = 2;
+  }
+  if (first >= argc) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  binary_decoder decoder(json ? create_json_formatter() : create_text_formatter());
+  bool           success = true;
+  for (int i = first; i != argc; ++i) {
+    success &= decode_file(decoder, argv[i]);
+  }
+  std::fflush(stdout);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -88,6 +88,9 @@ public:
   /// Installs the specified error handler into the backend.
   void set_error_handler(error_handler callback) { backend.set_error_handler(std::move(callback)); }
 
+  /// Returns the number of log entries discarded by the backend.
+  uint64_t get_nof_dropped_entries() const { return backend.get_nof_dropped_entries(); }
+
   /// Set the specified sink as the default one.
   void set_default_sink(sink& s) { default_sink = &s; }
 
@@ -21,6 +21,8 @@
 
 #include "srsran/adt/bounded_bitset.h"
 #include "srsran/common/test_common.h"
+#include <chrono>
+#include <random>
 
 void test_bit_operations()
 {
@@ -278,6 +280,121 @@ void test_bitset_find()
   }
 }
 
+template <bool reversed>
+void test_bitset_range_operations()
+{
+  std::mt19937                            rgen(0);
+  srsran::bounded_bitset<275, reversed>   bitset(275);
+  std::uniform_int_distribution<uint32_t> pos_dist(0, bitset.size());
+
+  for (uint32_t trial = 0; trial < 1000; ++trial) {
+    bitset.reset();
+    for (uint32_t i = 0; i < bitset.size(); ++i) {
+      bitset.set(i, (rgen() & 1u) != 0);
+    }
+    uint32_t start = pos_dist(rgen), stop = pos_dist(rgen);
+    if (start > stop) {
+      std::swap(start, stop);
+    }
+
+    // count and any over a range must match a bit-by-bit check
+    size_t nof_ones = 0;
+    for (uint32_t i = start; i < stop; ++i) {
+      nof_ones += bitset.test(i) ? 1 : 0;
+    }
+    TESTASSERT(bitset.count(start, stop) == nof_ones);
+    TESTASSERT(bitset.any(start, stop) == (nof_ones > 0));
+
+    // fill only touches the bits within the range
+    srsran::bounded_bitset<275, reversed> filled(bitset);
+    bool                                  value = (trial % 2) == 0;
+    filled.fill(start, stop, value);
+    for (uint32_t i = 0; i < bitset.size(); ++i) {
+      TESTASSERT(filled.test(i) == ((i >= start and i < stop) ? value : bitset.test(i)));
+    }
+    TESTASSERT(filled.count() == (value ? bitset.count() + (stop - start) - nof_ones : bitset.count() - nof_ones));
+
+    // intersects is equivalent to (a & b).any()
+    srsran::bounded_bitset<275, reversed> other(bitset.size());
+    other.fill(start, stop);
+    TESTASSERT(bitset.intersects(other) == (bitset & other).any());
+  }
+
+  // Corner cases at word boundaries
+  bitset.reset();
+  bitset.fill(63, 65);
+  TESTASSERT(bitset.count() == 2 and bitset.test(63) and bitset.test(64));
+  TESTASSERT(bitset.count(0, 64) == 1 and bitset.count(64, 128) == 1 and bitset.count(64, 64) == 0);
+  TESTASSERT(not bitset.any(0, 63) and bitset.any(0, 64) and not bitset.any(65, bitset.size()));
+  bitset.fill(0, bitset.size());
+  TESTASSERT(bitset.all() and bitset.count(0, bitset.size()) == bitset.size());
+}
+
+void bounded_bitset_benchmark()
+{
+  using std::chrono::high_resolution_clock;
+  using std::chrono::nanoseconds;
+
+  const size_t                      N = 1000000;
+  std::mt19937                      rgen(0);
+  srsran::bounded_bitset<275, true> bitset(275), other(275);
+  for (uint32_t i = 0; i < bitset.size(); ++i) {
+    bitset.set(i, (rgen() % 4) == 0);
+  }
+  other.fill(100, 150);
+
+  // The result is accumulated so that the compiler does not discard the loops
+  size_t acc = 0;
+
+  auto tp = high_resolution_clock::now();
+  for (size_t i = 0; i < N; ++i) {
+    acc += bitset.count();
+  }
+  nanoseconds t_count = std::chrono::duration_cast<nanoseconds>(high_resolution_clock::now() - tp);
+
+  tp = high_resolution_clock::now();
+  for (size_t i = 0; i < N; ++i) {
+    acc += bitset.count(i % 100, 275 - (i % 50));
+  }
+  nanoseconds t_count_range = std::chrono::duration_cast<nanoseconds>(high_resolution_clock::now() - tp);
+
+  tp = high_resolution_clock::now();
+  for (size_t i = 0; i < N; ++i) {
+    acc += bitset.find_lowest(i % 200, bitset.size(), (i & 1) == 0);
+  }
+  nanoseconds t_find = std::chrono::duration_cast<nanoseconds>(high_resolution_clock::now() - tp);
+
+  tp = high_resolution_clock::now();
+  for (size_t i = 0; i < N; ++i) {
+    acc += bitset.any(i % 100, 100 + (i % 175)) ? 1 : 0;
+  }
+  nanoseconds t_any_range = std::chrono::duration_cast<nanoseconds>(high_resolution_clock::now() - tp);
+
+  tp = high_resolution_clock::now();
+  for (size_t i = 0; i < N; ++i) {
+    acc += bitset.intersects(other) ? 1 : 0;
+  }
+  nanoseconds t_intersects = std::chrono::duration_cast<nanoseconds>(high_resolution_clock::now() - tp);
+
+  tp = high_resolution_clock::now();
+  for (size_t i = 0; i < N; ++i) {
+    other.fill(i % 100, 100 + (i % 175), (i & 1) == 0);
+  }
+  nanoseconds t_fill = std::chrono::duration_cast<nanoseconds>(high_resolution_clock::now() - tp);
+  acc += other.count();
+
+  auto per_op = [N](nanoseconds t) { return (double)t.count() / N; };
+  fmt::print("bounded_bitset<275> time per operation: count={:.1f} nsec, count(range)={:.1f} nsec, find_lowest={:.1f} "
+             "nsec, any(range)={:.1f} nsec, intersects={:.1f} nsec, fill={:.1f} nsec (acc={})\n",
+             per_op(t_count),
+             per_op(t_count_range),
+             per_op(t_find),
+             per_op(t_any_range),
+             per_op(t_intersects),
+             per_op(t_fill),
+             acc);
+}
+
 int main()
 {
   test_bit_operations();
@@ -289,6 +406,9 @@ int main()
   TESTASSERT(test_bitset_resize() == SRSRAN_SUCCESS);
   test_bitset_find<false>();
   test_bitset_find<true>();
+  test_bitset_range_operations<false>();
+  test_bitset_range_operations<true>();
+  bounded_bitset_benchmark();
   printf("Success\n");
   return 0;
 }
@@ -23,6 +23,7 @@
 #include "srsran/adt/pool/mem_pool.h"
 #include "srsran/adt/pool/obj_pool.h"
 #include "srsran/common/test_common.h"
+#include <thread>
 
 class C
 {
@@ -179,6 +180,45 @@ void test_background_pool()
     objs.push_back(obj_pool.make());
   }
   TESTASSERT(C::dtor_counter == C::default_ctor_counter);
+
+  // Released objects are recycled in the background
+  C::default_ctor_counter = 0;
+  C::dtor_counter         = 0;
+  {
+    std::atomic<int> nof_recycled{0};
+
+    auto init_D_val = [](void* ptr) {
+      new (ptr) D();
+      static_cast<D*>(ptr)->val = 'c';
+    };
+    auto recycle_D_val = [&nof_recycled](D& d) {
+      d.val = 'c';
+      nof_recycled++;
+    };
+    srsran::background_obj_pool<D> obj_pool(16, 4, 16, init_D_val, recycle_D_val, true);
+    std::vector<srsran::unique_pool_ptr<D> > objs;
+    for (size_t i = 0; i < 8; ++i) {
+      objs.push_back(obj_pool.make());
+      objs.back()->val = 'd';
+    }
+    TESTASSERT(obj_pool.cache_size() == 8);
+
+    objs.clear();
+    for (size_t i = 0; i < 1000 and obj_pool.cache_size() < 16; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    TESTASSERT(obj_pool.cache_size() == 16);
+    TESTASSERT(nof_recycled == 8);
+    for (size_t i = 0; i < 16 - 4; ++i) {
+      objs.push_back(obj_pool.make());
+    }
+    TESTASSERT(
+        std::all_of(objs.begin(), objs.end(), [](const srsran::unique_pool_ptr<D>& d) { return d->val == 'c'; }));
+
+    // Objects pending recycling when the pool is destroyed are not leaked
+    objs.clear();
+  }
+  TESTASSERT(C::dtor_counter == C::default_ctor_counter);
 }
 
 int main(int argc, char** argv)
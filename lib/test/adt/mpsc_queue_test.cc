@@ -0,0 +1,140 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/mpsc_queue.h"
+#include "srsran/common/test_common.h"
+#include <memory>
+#include <thread>
+
+namespace srsran {
+
+struct C {
+  C() : val_ptr(new int(5)) { count++; }
+  ~C() { count--; }
+  C(C&& other) noexcept : val_ptr(std::move(other.val_ptr)) { count++; }
+  C& operator=(C&&) = default;
+
+  std::unique_ptr<int> val_ptr;
+
+  static size_t count;
+};
+size_t C::count = 0;
+
+void test_mpsc_queue_api()
+{
+  dyn_mpsc_queue<int> q(4);
+  TESTASSERT(q.capacity() == 4);
+  TESTASSERT(q.empty() and not q.full() and q.size() == 0);
+
+  // push until full
+  for (int i = 0; i < 4; ++i) {
+    TESTASSERT(q.try_push(i));
+    TESTASSERT(q.size() == (size_t)i + 1);
+  }
+  TESTASSERT(q.full() and not q.try_push(5));
+
+  int v = -1;
+  TESTASSERT(q.try_pop(v) and v == 0);
+  TESTASSERT(q.try_push(10));
+  for (int i = 1; i < 4; ++i) {
+    TESTASSERT(q.try_pop(v) and v == i);
+  }
+  TESTASSERT(q.try_pop(v) and v == 10);
+  TESTASSERT(q.empty() and not q.try_pop(v));
+
+  // wrap around several times
+  for (int i = 0; i < 10; ++i) {
+    TESTASSERT(q.try_push(i) and q.try_push(i + 1));
+    int sum = 0;
+    TESTASSERT(q.consume_all([&sum](int& e) { sum += e; }) == 2);
+    TESTASSERT(sum == 2 * i + 1 and q.empty());
+  }
+
+  // resize
+  q.set_size(8);
+  TESTASSERT(q.capacity() == 8 and q.empty());
+  TESTASSERT(q.try_push(1) and q.try_pop(v) and v == 1);
+}
+
+void test_mpsc_queue_dtor()
+{
+  {
+    dyn_mpsc_queue<C> q(8);
+    for (size_t i = 0; i < 5; ++i) {
+      TESTASSERT(q.try_push(C{}));
+    }
+    TESTASSERT(C::count == 5);
+    C c;
+    TESTASSERT(q.try_pop(c));
+    TESTASSERT(C::count == 5);
+  }
+  TESTASSERT(C::count == 0);
+}
+
+void test_mpsc_queue_concurrent()
+{
+  const uint32_t           nof_producers = 4;
+  const uint32_t           nof_elems     = 250000;
+  dyn_mpsc_queue<uint32_t> q(64);
+
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&q, p, nof_elems, nof_producers]() {
+      for (uint32_t i = 0; i < nof_elems; ++i) {
+        while (not q.try_push(i * nof_producers + p)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // Elements of each producer must be received in order
+  std::vector<uint32_t> next(nof_producers, 0);
+  uint32_t              v = 0;
+  for (uint32_t i = 0; i < nof_producers * nof_elems; ++i) {
+    while (not q.try_pop(v)) {
+      std::this_thread::yield();
+    }
+    uint32_t p = v % nof_producers;
+    TESTASSERT(v / nof_producers == next[p]);
+    next[p]++;
+  }
+  for (std::thread& t : producers) {
+    t.join();
+  }
+  TESTASSERT(q.empty());
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_mpsc_queue_api();
+  srsran::test_mpsc_queue_dtor();
+  srsran::test_mpsc_queue_concurrent();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
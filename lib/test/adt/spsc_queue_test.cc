@@ -0,0 +1,126 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/spsc_queue.h"
+#include "srsran/common/test_common.h"
+#include <memory>
+#include <thread>
+
+namespace srsran {
+
+struct C {
+  C() : val_ptr(new int(5)) { count++; }
+  ~C() { count--; }
+  C(C&& other) noexcept : val_ptr(std::move(other.val_ptr)) { count++; }
+  C& operator=(C&&) = default;
+
+  std::unique_ptr<int> val_ptr;
+
+  static size_t count;
+};
+size_t C::count = 0;
+
+void test_spsc_queue_api()
+{
+  dyn_spsc_queue<int> q(4);
+  TESTASSERT(q.capacity() == 4);
+  TESTASSERT(q.empty() and not q.full() and q.size() == 0);
+  TESTASSERT(q.front() == nullptr);
+
+  // push until full
+  for (int i = 0; i < 4; ++i) {
+    TESTASSERT(q.try_push(i));
+    TESTASSERT(q.size() == (size_t)i + 1);
+  }
+  TESTASSERT(q.full() and not q.try_push(5));
+
+  // in-place modification by the consumer
+  q.for_each([](int& v) { v *= 2; });
+
+  int v = -1;
+  TESTASSERT(q.try_pop(v) and v == 0);
+  TESTASSERT(q.try_push(10));
+  for (int i = 1; i < 4; ++i) {
+    TESTASSERT(q.try_pop(v) and v == 2 * i);
+  }
+  TESTASSERT(*q.front() == 10);
+  q.pop();
+  TESTASSERT(q.empty() and not q.try_pop(v));
+
+  // resize
+  q.set_size(8);
+  TESTASSERT(q.capacity() == 8 and q.empty());
+}
+
+void test_spsc_queue_dtor()
+{
+  {
+    dyn_spsc_queue<C> q(8);
+    for (size_t i = 0; i < 5; ++i) {
+      TESTASSERT(q.try_push(C{}));
+    }
+    TESTASSERT(C::count == 5);
+    C c;
+    TESTASSERT(q.try_pop(c));
+    TESTASSERT(C::count == 5);
+  }
+  TESTASSERT(C::count == 0);
+}
+
+void test_spsc_queue_concurrent()
+{
+  const uint32_t           nof_elems = 1000000;
+  dyn_spsc_queue<uint32_t> q(64);
+
+  std::thread producer([&q, nof_elems]() {
+    for (uint32_t i = 0; i < nof_elems; ++i) {
+      while (not q.try_push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint32_t v = 0;
+  for (uint32_t i = 0; i < nof_elems; ++i) {
+    while (not q.try_pop(v)) {
+      std::this_thread::yield();
+    }
+    TESTASSERT(v == i);
+  }
+  producer.join();
+  TESTASSERT(q.empty());
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_spsc_queue_api();
+  srsran::test_spsc_queue_dtor();
+  srsran::test_spsc_queue_concurrent();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/triple_buffer.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace srsran {
+
+void test_triple_buffer_api()
+{
+  triple_buffer<int> buf(-1);
+
+  // Nothing published yet
+  TESTASSERT(not buf.fetch());
+  TESTASSERT(buf.read_buffer() == -1);
+
+  buf.write_buffer() = 1;
+  buf.publish();
+  TESTASSERT(buf.fetch());
+  TESTASSERT(buf.read_buffer() == 1);
+  TESTASSERT(not buf.fetch());
+  TESTASSERT(buf.read_buffer() == 1);
+
+  // Only the latest snapshot is kept
+  buf.write_buffer() = 2;
+  buf.publish();
+  buf.write_buffer() = 3;
+  buf.publish();
+  TESTASSERT(buf.read_buffer() == 1);
+  TESTASSERT(buf.fetch());
+  TESTASSERT(buf.read_buffer() == 3);
+  TESTASSERT(not buf.fetch());
+}
+
+void test_triple_buffer_concurrent()
+{
+  // Each snapshot is a vector whose elements are all equal to the snapshot index, so torn reads are detected
+  const uint32_t                        nof_snapshots = 100000, snapshot_size = 64;
+  triple_buffer<std::vector<uint32_t> > buf(std::vector<uint32_t>(snapshot_size, 0));
+
+  std::thread producer([&buf, nof_snapshots]() {
+    for (uint32_t i = 1; i <= nof_snapshots; ++i) {
+      std::vector<uint32_t>& v = buf.write_buffer();
+      std::fill(v.begin(), v.end(), i);
+      buf.publish();
+    }
+  });
+
+  uint32_t last = 0;
+  while (last < nof_snapshots) {
+    if (not buf.fetch()) {
+      std::this_thread::yield();
+      continue;
+    }
+    const std::vector<uint32_t>& v = buf.read_buffer();
+    // Snapshots are complete and in order
+    TESTASSERT(v.size() == snapshot_size);
+    TESTASSERT(v.front() > last);
+    TESTASSERT(std::all_of(v.begin(), v.end(), [&v](uint32_t e) { return e == v.front(); }));
+    last = v.front();
+  }
+  producer.join();
+  TESTASSERT(not buf.fetch());
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_triple_buffer_api();
+  srsran::test_triple_buffer_concurrent();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
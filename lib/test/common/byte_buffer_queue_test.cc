@@ -80,7 +80,107 @@ int test_concurrent_writeread()
   return result;
 }
 
+int test_spsc_concurrent_writeread()
+{
+  byte_buffer_spsc_queue q;
+  unique_byte_buffer_t   b;
+  int                    result = 0;
+
+  std::thread t([&q]() {
+    unique_byte_buffer_t buf;
+    for (uint32_t i = 0; i < NMSGS; i++) {
+      do {
+        buf = srsran::make_byte_buffer();
+        if (buf == nullptr) {
+          // wait until pool is not depleted
+          std::this_thread::yield();
+        }
+      } while (buf == nullptr);
+      memcpy(buf->msg, &i, 4);
+      buf->N_bytes = 4;
+      // in case of failure, try_write returns back the buffer
+      srsran::error_type<unique_byte_buffer_t> ret = q.try_write(std::move(buf));
+      while (not ret) {
+        std::this_thread::yield();
+        ret = q.try_write(std::move(ret.error()));
+      }
+    }
+  });
+
+  for (uint32_t i = 0; i < NMSGS; i++) {
+    while (not q.try_read(&b)) {
+      std::this_thread::yield();
+    }
+    uint32_t r = 0;
+    memcpy(&r, b->msg, 4);
+    if (r != i) {
+      result = -1;
+      break;
+    }
+  }
+
+  t.join();
+
+  if (q.size() != 0 || q.size_bytes() != 0 || q.get_n_sdus() != 0) {
+    result = -1;
+  }
+
+  printf("%s\n", result == 0 ? "Passed" : "Failed");
+  return result;
+}
+
+int test_spsc_discard()
+{
+  byte_buffer_spsc_queue q(4);
+  for (uint32_t i = 0; i < 4; i++) {
+    unique_byte_buffer_t b = srsran::make_byte_buffer();
+    b->N_bytes             = 10;
+    b->md.pdcp_sn          = i;
+    if (not q.try_write(std::move(b))) {
+      return -1;
+    }
+  }
+  unique_byte_buffer_t b = srsran::make_byte_buffer();
+  b->N_bytes             = 10;
+  // queue is full, the SDU is returned back
+  srsran::error_type<unique_byte_buffer_t> ret = q.try_write(std::move(b));
+  if (ret or ret.error() == nullptr or not q.is_full()) {
+    return -1;
+  }
+
+  // discard SDU in the middle of the queue
+  if (not q.discard_first_if([](const unique_byte_buffer_t& sdu) { return sdu->md.pdcp_sn == 1; })) {
+    return -1;
+  }
+  if (q.size_bytes() != 30 or q.get_n_sdus() != 3) {
+    return -1;
+  }
+
+  // discarded SDU is popped as a nullptr
+  uint32_t expected_sns[] = {0, 2, 3};
+  uint32_t count          = 0;
+  while (q.try_read(&b)) {
+    if (b == nullptr) {
+      continue;
+    }
+    if (b->md.pdcp_sn != expected_sns[count++]) {
+      return -1;
+    }
+  }
+  if (count != 3 or q.size_bytes() != 0 or q.get_n_sdus() != 0 or not q.is_empty()) {
+    return -1;
+  }
+  printf("Passed\n");
+  return 0;
+}
+
 int main()
 {
-  return test_concurrent_writeread();
+  if (test_concurrent_writeread() != 0) {
+    return -1;
+  }
+  if (test_spsc_concurrent_writeread() != 0) {
+    return -1;
+  }
+  return test_spsc_discard();
 }
@@ -0,0 +1,178 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/kpi_stream.h"
+#include "srsran/common/test_common.h"
+#include <fstream>
+#include <iterator>
+
+using namespace srsran;
+using namespace srsran::kpi_stream;
+
+const static char* filename = "kpi_stream_test.kpi";
+
+/// Value of a counter of a UE in a given report, with a slow drift and an occasional reset
+static int64_t counter_value(uint32_t report, uint32_t rnti, uint32_t col)
+{
+  if (col == 1 and report == 50) {
+    return 0;
+  }
+  return (int64_t)rnti * 1000 + report * (col + 1) + (col == 2 ? (int64_t)1 << 40 : 0);
+}
+
+static float gauge_value(uint32_t report, uint32_t rnti)
+{
+  return rnti * 0.5f - report / 3.0f;
+}
+
+/// UEs attached in a report. Some UEs detach and come back later
+static std::vector<uint32_t> get_rntis(uint32_t report)
+{
+  std::vector<uint32_t> rntis;
+  for (uint32_t rnti = 0x46; rnti < 0x46 + 20; ++rnti) {
+    if (rnti % 5 != 0 or report % 10 < 5) {
+      rntis.push_back(rnti);
+    }
+  }
+  return rntis;
+}
+
+int test_roundtrip()
+{
+  const uint32_t nof_reports = 100;
+
+  group_schema_t ue_schema;
+  ue_schema.name     = "ue";
+  ue_schema.key_name = "rnti";
+  ue_schema.columns  = {{"tx_pkts", column_kind_t::counter},
+                        {"dl_cqi", column_kind_t::gauge},
+                        {"rx_pkts", column_kind_t::counter},
+                        {"bytes", column_kind_t::counter}};
+  group_schema_t cell_schema;
+  cell_schema.name     = "cell";
+  cell_schema.key_name = "cc";
+  cell_schema.columns  = {{"nof_ues", column_kind_t::gauge}};
+
+  writer w;
+  TESTASSERT(w.open(filename));
+  uint32_t ue_group   = w.add_group(ue_schema);
+  uint32_t cell_group = w.add_group(cell_schema);
+  TESTASSERT(ue_group == 0 and cell_group == 1);
+  for (uint32_t report = 0; report < nof_reports; ++report) {
+    uint64_t              ts    = 1600000000000000ULL + report * 100000;
+    std::vector<uint32_t> rntis = get_rntis(report);
+    w.begin_block(ue_group, ts);
+    for (uint32_t rnti : rntis) {
+      w.add_row(rnti);
+      w.set_counter(0, counter_value(report, rnti, 0));
+      w.set_gauge(1, gauge_value(report, rnti));
+      w.set_counter(2, counter_value(report, rnti, 1));
+      w.set_counter(3, counter_value(report, rnti, 2));
+    }
+    w.end_block();
+    w.begin_block(cell_group, ts);
+    w.add_row(0);
+    w.set_gauge(0, rntis.size());
+    w.end_block();
+  }
+  uint64_t nof_bytes = w.get_nof_bytes();
+  w.close();
+
+  // TEST: the counters take a few bytes per value, despite their magnitude
+  TESTASSERT(nof_bytes < nof_reports * 20 * 12);
+
+  reader r;
+  TESTASSERT(r.open(filename));
+  block_t block;
+  for (uint32_t report = 0; report < nof_reports; ++report) {
+    uint64_t              ts    = 1600000000000000ULL + report * 100000;
+    std::vector<uint32_t> rntis = get_rntis(report);
+
+    TESTASSERT(r.read_block(block));
+    TESTASSERT(block.group_id == ue_group);
+    TESTASSERT(block.timestamp_us == ts);
+    TESTASSERT(block.keys == rntis);
+    TESTASSERT(block.values.size() == 4);
+    for (uint32_t i = 0; i < rntis.size(); ++i) {
+      TESTASSERT(block.values[0][i] == counter_value(report, rntis[i], 0));
+      TESTASSERT(block.values[1][i] == gauge_value(report, rntis[i]));
+      TESTASSERT(block.values[2][i] == counter_value(report, rntis[i], 1));
+      TESTASSERT(block.values[3][i] == counter_value(report, rntis[i], 2));
+    }
+
+    TESTASSERT(r.read_block(block));
+    TESTASSERT(block.group_id == cell_group);
+    TESTASSERT(block.keys.size() == 1 and block.values[0][0] == rntis.size());
+  }
+  TESTASSERT(not r.read_block(block));
+  TESTASSERT(not r.has_error());
+  TESTASSERT(r.nof_groups() == 2);
+  TESTASSERT(r.get_schema(ue_group).key_name == "rnti");
+  TESTASSERT(r.get_schema(ue_group).columns[3].name == "bytes");
+  TESTASSERT(r.get_schema(ue_group).columns[1].kind == column_kind_t::gauge);
+  return SRSRAN_SUCCESS;
+}
+
+int test_truncated()
+{
+  writer w;
+  TESTASSERT(w.open(filename));
+  uint32_t group = w.add_group(group_schema_t{"g", "key", {{"c", column_kind_t::counter}}});
+  for (uint32_t i = 0; i < 2; ++i) {
+    w.begin_block(group, i);
+    w.add_row(1);
+    w.set_counter(0, 1000 * i);
+    w.end_block();
+  }
+  w.close();
+
+  // Cut the last byte, as seen by a reader of a stream that is still being written
+  std::ifstream        in(filename, std::ios::binary);
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  out.write((const char*)data.data(), data.size() - 1);
+  out.close();
+
+  // TEST: the complete blocks are read, and the truncated one is reported
+  reader  r;
+  block_t block;
+  TESTASSERT(r.open(filename));
+  TESTASSERT(r.read_block(block));
+  TESTASSERT(block.values[0][0] == 0);
+  TESTASSERT(not r.read_block(block));
+  TESTASSERT(r.has_error());
+
+  // TEST: files that are not KPI streams are rejected
+  std::ofstream bad(filename, std::ios::binary | std::ios::trunc);
+  bad << "time;nof_ue;dl_brate\n";
+  bad.close();
+  TESTASSERT(not r.open(filename));
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_roundtrip() == SRSRAN_SUCCESS);
+  TESTASSERT(test_truncated() == SRSRAN_SUCCESS);
+  remove(filename);
+  return SRSRAN_SUCCESS;
+}
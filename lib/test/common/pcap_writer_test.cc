@@ -0,0 +1,232 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/pcap.h"
+#include "srsran/common/pcap_writer.h"
+#include "srsran/common/test_common.h"
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+using namespace srsran;
+
+static std::vector<uint8_t> read_file(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+template <typename T>
+static T get(const std::vector<uint8_t>& data, size_t offset)
+{
+  T value;
+  memcpy(&value, &data[offset], sizeof(T));
+  return value;
+}
+
+const static uint32_t max_nof_threads = 4;
+
+/// Payload of the n-th PDU written by a thread, so that the record contents can be checked
+static std::vector<uint8_t> make_pdu(uint32_t thread_idx, uint32_t n)
+{
+  std::vector<uint8_t> pdu(20 + n % 100);
+  for (uint32_t i = 0; i < pdu.size(); ++i) {
+    pdu[i] = thread_idx + i;
+  }
+  return pdu;
+}
+
+/// Parses a classic PCAP file, returning the number of records or -1 if it is malformed
+static int count_pcap_records(const std::vector<uint8_t>& data, uint32_t dlt, uint32_t hdr_len)
+{
+  if (data.size() < sizeof(pcap_hdr_t) or get<uint32_t>(data, 0) != 0xa1b2c3d4 or get<uint32_t>(data, 20) != dlt) {
+    return -1;
+  }
+  int nof_records = 0;
+  for (size_t offset = sizeof(pcap_hdr_t); offset < data.size(); ++nof_records) {
+    pcaprec_hdr_t rec = get<pcaprec_hdr_t>(data, offset);
+    offset += sizeof(pcaprec_hdr_t);
+    // The first byte of the payload carries the index of the writer thread
+    if (rec.incl_len != rec.orig_len or rec.incl_len < hdr_len + 20 or data[offset] != 0xab or
+        data[offset + hdr_len] >= max_nof_threads) {
+      return -1;
+    }
+    offset += rec.incl_len;
+  }
+  return nof_records;
+}
+
+int test_pcap_multithread()
+{
+  const uint32_t nof_threads = max_nof_threads, nof_pdus = 2000;
+  const uint8_t  hdr[]       = {0xab, 0xcd, 0xef};
+
+  pcap_writer_args_t args;
+  args.ring_size = nof_threads * nof_pdus;
+  pcap_writer writer("PCAP_TEST");
+  TESTASSERT(writer.open("pcap_writer_test.pcap", {{UDP_DLT, "mac-lte"}}, 1024, 16, args) == SRSRAN_SUCCESS);
+  TESTASSERT(writer.open("pcap_writer_test.pcap", {{UDP_DLT, "mac-lte"}}, 1024, 16, args) != SRSRAN_SUCCESS);
+
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < nof_threads; ++t) {
+    threads.emplace_back([&writer, &hdr, t]() {
+      for (uint32_t n = 0; n < nof_pdus; ++n) {
+        std::vector<uint8_t> pdu = make_pdu(t, n);
+        TESTASSERT(writer.write(0, hdr, sizeof(hdr), pdu.data(), pdu.size()));
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  writer.close();
+  TESTASSERT(not writer.is_open());
+  TESTASSERT(writer.get_nof_dropped() == 0);
+
+  // TEST: all the PDUs of all threads are written, each one with its context header
+  TESTASSERT(count_pcap_records(read_file("pcap_writer_test.pcap"), UDP_DLT, sizeof(hdr)) ==
+             (int)(nof_threads * nof_pdus));
+  return SRSRAN_SUCCESS;
+}
+
+int test_pcap_ring_full()
+{
+  const uint8_t hdr[] = {0xab};
+  uint8_t       pdu[100] = {};
+
+  pcap_writer writer("PCAP_TEST");
+  TESTASSERT(writer.open("pcap_writer_full_test.pcap", {{S1AP_LTE_DLT, "s1ap"}}, 64, 4) == SRSRAN_SUCCESS);
+
+  // TEST: PDUs are dropped when the ring is full, and truncated when larger than the ring slots
+  uint32_t nof_written = 0;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    nof_written += writer.write(0, hdr, sizeof(hdr), pdu, sizeof(pdu)) ? 1 : 0;
+  }
+  writer.close();
+  TESTASSERT(nof_written + writer.get_nof_dropped() == 1000);
+  TESTASSERT(writer.get_nof_dropped() > 0);
+
+  std::vector<uint8_t> data = read_file("pcap_writer_full_test.pcap");
+  TESTASSERT(data.size() == sizeof(pcap_hdr_t) + nof_written * (sizeof(pcaprec_hdr_t) + 64));
+  pcaprec_hdr_t rec = get<pcaprec_hdr_t>(data, sizeof(pcap_hdr_t));
+  TESTASSERT(rec.incl_len == 64 and rec.orig_len == sizeof(hdr) + sizeof(pdu));
+
+  // TEST: Writing to a closed writer fails
+  TESTASSERT(not writer.write(0, hdr, sizeof(hdr), pdu, sizeof(pdu)));
+  return SRSRAN_SUCCESS;
+}
+
+int test_pcapng()
+{
+  const uint8_t pdu[] = {1, 2, 3, 4, 5};
+
+  // TEST: Classic PCAP files only support a single DLT
+  pcap_writer writer("PCAP_TEST");
+  TESTASSERT(writer.open("pcap_writer_test.pcapng", {{UDP_DLT, "mac"}, {S1AP_LTE_DLT, "s1ap"}}, 1024, 16) !=
+             SRSRAN_SUCCESS);
+
+  pcap_writer_args_t args;
+  args.format = pcap_format_t::pcapng;
+  TESTASSERT(writer.open("pcap_writer_test.pcapng", {{UDP_DLT, "mac"}, {S1AP_LTE_DLT, "s1ap"}}, 1024, 16, args) ==
+             SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < 10; ++i) {
+    TESTASSERT(writer.write(i % 2, nullptr, 0, pdu, sizeof(pdu)));
+  }
+  writer.close();
+
+  // TEST: The file holds a Section Header Block, an Interface Description Block per layer and a packet block per PDU
+  std::vector<uint8_t>  data = read_file("pcap_writer_test.pcapng");
+  std::vector<uint32_t> block_types, if_ids, linktypes;
+  for (size_t offset = 0; offset < data.size();) {
+    uint32_t type = get<uint32_t>(data, offset), len = get<uint32_t>(data, offset + 4);
+    TESTASSERT(len % 4 == 0 and offset + len <= data.size());
+    TESTASSERT(get<uint32_t>(data, offset + len - 4) == len);
+    if (type == 0x0A0D0D0A) {
+      TESTASSERT(get<uint32_t>(data, offset + 8) == 0x1A2B3C4D);
+    } else if (type == 1) {
+      linktypes.push_back(get<uint16_t>(data, offset + 8));
+    } else if (type == 6) {
+      if_ids.push_back(get<uint32_t>(data, offset + 8));
+      TESTASSERT(get<uint32_t>(data, offset + 20) == sizeof(pdu));
+      TESTASSERT(memcmp(&data[offset + 28], pdu, sizeof(pdu)) == 0);
+    }
+    block_types.push_back(type);
+    offset += len;
+  }
+  TESTASSERT(block_types.size() == 13 and block_types[0] == 0x0A0D0D0A);
+  TESTASSERT(linktypes == (std::vector<uint32_t>{UDP_DLT, S1AP_LTE_DLT}));
+  TESTASSERT(if_ids.size() == 10);
+  for (uint32_t i = 0; i < if_ids.size(); ++i) {
+    TESTASSERT(if_ids[i] == i % 2);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_pcap_rotation()
+{
+  const uint8_t hdr[] = {0xab};
+
+  pcap_writer_args_t args;
+  args.max_file_size = 32768;
+  pcap_writer writer("PCAP_TEST");
+  TESTASSERT(writer.open("pcap_writer_rotation_test.pcap", {{UDP_DLT, "rlc-lte"}}, 1024, 4096, args) ==
+             SRSRAN_SUCCESS);
+  for (uint32_t n = 0; n < 1000; ++n) {
+    std::vector<uint8_t> pdu = make_pdu(0, n);
+    TESTASSERT(writer.write(0, hdr, sizeof(hdr), pdu.data(), pdu.size()));
+    if (n % 100 == 0) {
+      // Give the writer some time, so that the PDUs are written in several batches
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  }
+  writer.close();
+
+  // TEST: Every file starts with its own header, and holds whole records up to the maximum size
+  int nof_records = 0, nof_files = 0;
+  for (std::string filename = "pcap_writer_rotation_test.pcap";;
+       filename = "pcap_writer_rotation_test." + std::to_string(nof_files) + ".pcap") {
+    std::vector<uint8_t> data = read_file(filename);
+    if (data.empty()) {
+      break;
+    }
+    int n = count_pcap_records(data, UDP_DLT, sizeof(hdr));
+    TESTASSERT(n > 0);
+    TESTASSERT(data.size() <= args.max_file_size);
+    nof_records += n;
+    nof_files++;
+  }
+  TESTASSERT(nof_files > 1);
+  TESTASSERT(nof_records == 1000);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_pcap_multithread() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pcap_ring_full() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pcapng() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pcap_rotation() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/perf_counters.h"
+#include "srsran/common/test_common.h"
+
+using namespace srsran;
+
+int test_accumulator()
+{
+  perf_counter_accumulator acc;
+  perf_sample_t            start = {100, 200, 0, 0};
+  perf_sample_t            end   = {1100, 2200, 4, 10};
+  acc.add(start, end);
+  acc.add(start, end);
+
+  // TEST: the deltas of all the samples are summed
+  perf_counter_accumulator::summary_t s = acc.read_and_reset();
+  TESTASSERT(s.nof_samples == 2);
+  TESTASSERT(s.totals[(size_t)perf_event_t::cycles] == 2000);
+  TESTASSERT(s.totals[(size_t)perf_event_t::instructions] == 4000);
+  TESTASSERT(s.ipc() == 2.0f);
+  TESTASSERT(s.misses_per_kinstr(perf_event_t::llc_misses) == 2.0f);
+  TESTASSERT(s.misses_per_kinstr(perf_event_t::branch_misses) == 5.0f);
+
+  // TEST: the accumulator is reset, and the ratios of an empty summary are zero
+  s = acc.read_and_reset();
+  TESTASSERT(s.nof_samples == 0);
+  TESTASSERT(s.ipc() == 0 and s.misses_per_kinstr(perf_event_t::llc_misses) == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int test_scope()
+{
+  perf_counter_accumulator acc;
+
+  // TEST: nothing is sampled while the counters are disabled
+  TESTASSERT(perf_counters_this_thread() == nullptr);
+  {
+    perf_counter_scope scope(&acc);
+  }
+  TESTASSERT(acc.read_and_reset().nof_samples == 0);
+  {
+    perf_counter_scope scope(nullptr);
+  }
+
+  if (not perf_counters_enable()) {
+    // No hardware counters in this system, e.g. in a VM or with a restrictive perf_event_paranoid
+    srslog::fetch_basic_logger("TEST").info("Hardware performance counters not available");
+    return SRSRAN_SUCCESS;
+  }
+
+  // TEST: a loop runs at least as many instructions as iterations
+  TESTASSERT(perf_counters_this_thread() != nullptr);
+  volatile uint32_t sum = 0;
+  {
+    perf_counter_scope scope(&acc);
+    for (uint32_t i = 0; i < 100000; ++i) {
+      sum += i;
+    }
+  }
+  perf_counter_accumulator::summary_t s = acc.read_and_reset();
+  TESTASSERT(s.nof_samples == 1);
+  TESTASSERT(s.totals[(size_t)perf_event_t::instructions] >= 100000);
+  TESTASSERT(s.totals[(size_t)perf_event_t::cycles] > 0);
+  TESTASSERT(s.ipc() > 0);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_accumulator() == SRSRAN_SUCCESS);
+  TESTASSERT(test_scope() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,110 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/time_prof.h"
+#include <thread>
+#include <vector>
+
+using namespace srsran;
+using std::chrono::microseconds;
+using std::chrono::nanoseconds;
+
+int test_latency_histogram_buckets()
+{
+  // Small values are counted exactly
+  for (int64_t ns = 0; ns < 16; ++ns) {
+    TESTASSERT(latency_histogram::bucket_index(ns) == (size_t)ns);
+    TESTASSERT(latency_histogram::bucket_upper_bound(ns) == ns);
+  }
+
+  // Every value falls in a bucket whose range bounds the relative error
+  int64_t prev_upper = 15;
+  for (size_t idx = 16; idx < latency_histogram::nof_buckets; ++idx) {
+    int64_t upper = latency_histogram::bucket_upper_bound(idx);
+    TESTASSERT(upper > prev_upper);
+    TESTASSERT(latency_histogram::bucket_index(prev_upper + 1) == idx);
+    TESTASSERT(latency_histogram::bucket_index(upper) == idx);
+    TESTASSERT((upper - prev_upper) * 16 <= prev_upper + 1);
+    prev_upper = upper;
+  }
+
+  // Values out of range are counted in the last bucket
+  TESTASSERT(latency_histogram::bucket_index(int64_t(1) << 40) == latency_histogram::nof_buckets - 1);
+  return SRSRAN_SUCCESS;
+}
+
+int test_latency_histogram_percentiles()
+{
+  latency_histogram hist(microseconds{900});
+
+  latency_histogram::summary_t summary = hist.read_and_reset();
+  TESTASSERT(summary.count == 0 and summary.max.count() == 0);
+
+  // Samples of 1 to 1000 usec
+  for (int64_t i = 1; i <= 1000; ++i) {
+    hist(microseconds{i});
+  }
+  summary = hist.read_and_reset();
+  TESTASSERT(summary.count == 1000);
+  TESTASSERT(summary.max == microseconds{1000});
+  TESTASSERT(summary.nof_deadline_misses == 100);
+  TESTASSERT(summary.p50 >= microseconds{500} and summary.p50 <= microseconds{500} * 17 / 16);
+  TESTASSERT(summary.p99 >= microseconds{990} and summary.p99 <= microseconds{1000});
+
+  // The histogram is reset after being read
+  summary = hist.read_and_reset();
+  TESTASSERT(summary.count == 0 and summary.nof_deadline_misses == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int test_latency_histogram_multithread()
+{
+  const uint32_t    nof_threads = 4, nof_samples = 10000;
+  latency_histogram hist;
+
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < nof_threads; ++t) {
+    threads.emplace_back([&hist, t]() {
+      for (uint32_t i = 0; i < nof_samples; ++i) {
+        hist(nanoseconds{(t + 1) * 1000});
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  latency_histogram::summary_t summary = hist.read_and_reset();
+  TESTASSERT(summary.count == nof_threads * nof_samples);
+  TESTASSERT(summary.max == nanoseconds{nof_threads * 1000});
+  TESTASSERT(summary.nof_deadline_misses == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_latency_histogram_buckets() == SRSRAN_SUCCESS);
+  TESTASSERT(test_latency_histogram_percentiles() == SRSRAN_SUCCESS);
+  TESTASSERT(test_latency_histogram_multithread() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,148 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "pdcp_nr_test.h"
+#include <chrono>
+
+/*
+ * Benchmark of the PDCP NR bookkeeping (discard timers and reordering window) at high SDU rates.
+ * Security is not enabled, so that the measured time is dominated by the PDCP state handling.
+ */
+
+// RLC that stores the PDUs generated by the TX entity, so that they can be looped back to the RX entity
+class rlc_loopback : public srsue::rlc_interface_pdcp
+{
+public:
+  void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu) override { pdus.push_back(std::move(sdu)); }
+  void discard_sdu(uint32_t lcid, uint32_t discard_sn) override { discard_count++; }
+  bool rb_is_um(uint32_t lcid) override { return false; }
+  bool sdu_queue_is_full(uint32_t lcid) override { return false; }
+  bool is_suspended(const uint32_t lcid) override { return false; }
+
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+  uint64_t                                  discard_count = 0;
+};
+
+struct bench_params {
+  uint8_t  sn_len;
+  uint32_t nof_ttis;
+  uint32_t sdus_per_tti;
+  uint32_t loss_period; ///< One every loss_period PDUs is lost. Zero disables losses
+};
+
+int run_benchmark(const bench_params& params, srslog::basic_logger& logger)
+{
+  srsran::pdcp_config_t cfg_tx = {1,
+                                  srsran::PDCP_RB_IS_DRB,
+                                  srsran::SECURITY_DIRECTION_UPLINK,
+                                  srsran::SECURITY_DIRECTION_DOWNLINK,
+                                  params.sn_len,
+                                  srsran::pdcp_t_reordering_t::ms10,
+                                  srsran::pdcp_discard_timer_t::ms50,
+                                  false,
+                                  srsran::srsran_rat_t::nr};
+  srsran::pdcp_config_t cfg_rx = {1,
+                                  srsran::PDCP_RB_IS_DRB,
+                                  srsran::SECURITY_DIRECTION_DOWNLINK,
+                                  srsran::SECURITY_DIRECTION_UPLINK,
+                                  params.sn_len,
+                                  srsran::pdcp_t_reordering_t::ms10,
+                                  srsran::pdcp_discard_timer_t::ms50,
+                                  false,
+                                  srsran::srsran_rat_t::nr};
+
+  srsue::stack_test_dummy stack;
+  rlc_loopback            rlc;
+  rrc_dummy               rrc(logger);
+  gw_dummy                gw(logger);
+  srsran::pdcp_entity_nr  pdcp_tx(&rlc, &rrc, &gw, &stack.task_sched, logger, 0);
+  srsran::pdcp_entity_nr  pdcp_rx(&rlc, &rrc, &gw, &stack.task_sched, logger, 0);
+  TESTASSERT(pdcp_tx.configure(cfg_tx));
+  TESTASSERT(pdcp_rx.configure(cfg_rx));
+
+  uint64_t nof_sdus = 0, nof_lost = 0;
+  auto     tp_start = std::chrono::high_resolution_clock::now();
+  for (uint32_t tti = 0; tti < params.nof_ttis; ++tti) {
+    for (uint32_t i = 0; i < params.sdus_per_tti; ++i) {
+      srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+      TESTASSERT(sdu != nullptr);
+      sdu->append_bytes(sdu1, sizeof(sdu1));
+      pdcp_tx.write_sdu(std::move(sdu));
+    }
+
+    // Deliver the PDUs of this TTI to the RX entity with adjacent PDUs swapped
+    for (size_t i = 0; i + 1 < rlc.pdus.size(); i += 2) {
+      std::swap(rlc.pdus[i], rlc.pdus[i + 1]);
+    }
+    for (srsran::unique_byte_buffer_t& pdu : rlc.pdus) {
+      if (params.loss_period > 0 and ++nof_sdus % params.loss_period == 0) {
+        nof_lost++;
+        continue;
+      }
+      pdcp_rx.write_pdu(std::move(pdu));
+    }
+    rlc.pdus.clear();
+
+    stack.run_tti();
+  }
+  auto     tp_end     = std::chrono::high_resolution_clock::now();
+  uint64_t elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(tp_end - tp_start).count();
+
+  uint64_t nof_tx_sdus = (uint64_t)params.nof_ttis * params.sdus_per_tti;
+  fmt::print("SN len={:>2}, SDUs/TTI={:>4}, loss period={:>5}: {:>10.0f} SDUs/s (TX+RX), delivered={}, lost={}, "
+             "discard notifications={}\n",
+             params.sn_len,
+             params.sdus_per_tti,
+             params.loss_period,
+             nof_tx_sdus * 1.0e6 / std::max(elapsed_us, (uint64_t)1),
+             gw.rx_count,
+             nof_lost,
+             rlc.discard_count);
+
+  // All the SDUs except the lost ones must have been delivered, and all the discard timers must have expired
+  for (uint32_t i = 0; i < 100; ++i) {
+    stack.run_tti();
+  }
+  TESTASSERT(gw.rx_count == nof_tx_sdus - nof_lost);
+  TESTASSERT(rlc.discard_count == nof_tx_sdus);
+  TESTASSERT(pdcp_tx.nof_discard_timers() == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  auto& logger = srslog::fetch_basic_logger("PDCP NR Bench", false);
+  logger.set_level(srslog::basic_levels::warning);
+
+  uint32_t nof_ttis = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+
+  std::vector<bench_params> runs = {{srsran::PDCP_SN_LEN_12, nof_ttis, 16, 0},
+                                    {srsran::PDCP_SN_LEN_18, nof_ttis, 16, 0},
+                                    {srsran::PDCP_SN_LEN_18, nof_ttis, 256, 0},
+                                    {srsran::PDCP_SN_LEN_18, nof_ttis, 64, 1000}};
+  for (const bench_params& p : runs) {
+    TESTASSERT(run_benchmark(p, logger) == SRSRAN_SUCCESS);
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -19,6 +19,7 @@
  *
  */
 #include "pdcp_nr_test.h"
+#include <algorithm>
 #include <numeric>
 
 /*
@@ -224,6 +225,21 @@ int test_rx_all(srslog::basic_logger& logger)
     test8_pdus.push_back(std::move(event_pdu2));
     TESTASSERT(test_rx(std::move(test8_pdus), test8_init_state, srsran::PDCP_SN_LEN_12, 1, tst_sdu1, logger) == 0);
   }
+
+  /*
+   * RX Test 9: PDCP Entity with SN LEN = 18
+   * Test reception of 300 packets in reverse order, starting at COUNT 0.
+   * This tests that the reordering window grows beyond its initial size without losing the stored PDUs
+   */
+  {
+    std::vector<uint32_t> test9_counts(300);
+    std::iota(test9_counts.begin(), test9_counts.end(), 0);
+    std::reverse(test9_counts.begin(), test9_counts.end());
+    std::vector<pdcp_test_event_t> test9_pdus =
+        gen_expected_pdus_vector(tst_sdu1, test9_counts, srsran::PDCP_SN_LEN_18, sec_cfg, logger);
+    pdcp_initial_state test9_init_state = {};
+    TESTASSERT(test_rx(std::move(test9_pdus), test9_init_state, srsran::PDCP_SN_LEN_18, 300, tst_sdu1, logger) == 0);
+  }
   return 0;
 }
 
@@ -460,6 +460,19 @@ private:
   std::uniform_int_distribution<> int_dist;
 };
 
+void print_pdu_rate(const char* name, const rlc_bearer_metrics_t& metrics, const stress_test_args_t& args)
+{
+  uint32_t nof_pdus = metrics.num_tx_pdus + metrics.num_rx_pdus;
+  printf("%s processed %d PDUs (Tx=%d, Rx=%d) in %ds (%.2f PDUs/s) with PDU drop rate %.2f\n",
+         name,
+         nof_pdus,
+         metrics.num_tx_pdus,
+         metrics.num_rx_pdus,
+         args.test_duration_sec,
+         static_cast<double>(nof_pdus) / args.test_duration_sec,
+         args.pdu_drop_rate);
+}
+
 void stress_test(stress_test_args_t args)
 {
   auto& log1 = srslog::fetch_basic_logger("RLC_1", false);
@@ -578,6 +591,7 @@ void stress_test(stress_test_args_t args)
          metrics.bearer[lcid].num_tx_pdu_bytes,
          metrics.bearer[lcid].num_rx_pdu_bytes);
   rlc_bearer_metrics_print(metrics.bearer[lcid]);
+  print_pdu_rate("RLC1", metrics.bearer[lcid], args);
 
   rlc2.get_metrics(metrics, 1);
   printf("RLC2 received %d SDUs in %ds (%.2f/s), Tx=%" PRIu64 " B, Rx=%" PRIu64 " B\n",
@@ -587,6 +601,7 @@ void stress_test(stress_test_args_t args)
          metrics.bearer[lcid].num_tx_pdu_bytes,
          metrics.bearer[lcid].num_rx_pdu_bytes);
   rlc_bearer_metrics_print(metrics.bearer[lcid]);
+  print_pdu_rate("RLC2", metrics.bearer[lcid], args);
 }
 
 int main(int argc, char** argv)
@@ -21,6 +21,7 @@
 
 #include "srsran/srslog/srslog.h"
 #include <atomic>
+#include <cstdlib>
 #include <sys/resource.h>
 #include <thread>
 
@@ -104,6 +105,7 @@ static void benchmark(unsigned num_threads)
   std::vector<std::thread> workers;
   workers.reserve(num_threads);
 
+  uint64_t              nof_dropped_before = srslog::get_nof_dropped_entries();
   std::atomic<unsigned> ctx_counter(0);
   for (unsigned i = 0; i != num_threads; ++i) {
     workers.emplace_back(run_thread, std::ref(channel), std::ref(thread_results[i]), std::ref(ctx_counter));
@@ -112,6 +114,8 @@ static void benchmark(unsigned num_threads)
     w.join();
   }
 
+  uint64_t nof_dropped = srslog::get_nof_dropped_entries() - nof_dropped_before;
+
   std::vector<uint64_t> results;
   results.reserve(num_threads * num_iterations);
   for (const auto& v : thread_results) {
@@ -123,7 +127,8 @@ static void benchmark(unsigned num_threads)
              "All values in nanoseconds\n"
              "Percentiles: | 50th | 75th | 90th | 99th | 99.9th | Worst |\n"
              "             |{:6}|{:6}|{:6}|{:6}|{:8}|{:7}|\n"
-             "Context switches: {} in {} of generated entries\n\n",
+             "Context switches: {} in {} of generated entries\n"
+             "Dropped entries: {}\n\n",
              num_threads,
              (num_threads > 1) ? "s" : "",
              results[static_cast<size_t>(results.size() * 0.5)],
@@ -133,12 +138,21 @@ static void benchmark(unsigned num_threads)
              results[static_cast<size_t>(results.size() * 0.999)],
              results.back(),
              ctx_counter,
-             num_threads * num_iterations * num_entries_per_iter);
+             num_threads * num_iterations * num_entries_per_iter,
+             nof_dropped);
 }
 
-int main()
+int main(int argc, char** argv)
 {
-  for (auto n : {1, 2, 4}) {
+  // The number of producer threads of each run may be given in the command line, e.g. "srslog_frontend_latency 8 32".
+  if (argc > 1) {
+    for (int i = 1; i != argc; ++i) {
+      benchmark(std::max(1, std::atoi(argv[i])));
+    }
+    return 0;
+  }
+
+  for (auto n : {1, 2, 4, 8, 16, 32}) {
     benchmark(n);
   }
 
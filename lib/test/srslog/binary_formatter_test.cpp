@@ -0,0 +1,291 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "file_test_utils.h"
+#include "src/srslog/formatters/binary_decoder.h"
+#include "src/srslog/formatters/binary_format.h"
+#include "src/srslog/formatters/binary_formatter.h"
+#include "src/srslog/formatters/text_formatter.h"
+#include "src/srslog/sinks/binary_file_sink.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include "testing_helpers.h"
+#include <fstream>
+#include <numeric>
+#include <ostream>
+
+using namespace srslog;
+
+using store_type = fmt::dynamic_format_arg_store<fmt::printf_context>;
+
+/// Type without a fmt formatter, printed through its stream operator.
+struct custom_type {
+  int value;
+};
+static std::ostream& operator<<(std::ostream& os, const custom_type& v)
+{
+  return os << "custom(" << v.value << ")";
+}
+
+namespace {
+DECLARE_METRIC("SNR", snr_t, float, "dB");
+DECLARE_METRIC_SET("ue_container", ue_set, snr_t);
+using ctx_t = srslog::build_context_type<ue_set>;
+} // namespace
+
+/// Helper to build a log entry.
+static detail::log_entry_metadata build_log_entry_metadata(const char* fmtstring, store_type* store)
+{
+  // Create a time point 50000us from epoch.
+  using tp_ty = std::chrono::time_point<std::chrono::high_resolution_clock>;
+  tp_ty tp(std::chrono::microseconds(50000));
+
+  return {tp, {10, true}, fmtstring, store, "ABC", 'Z'};
+}
+
+/// Returns a buffer holding the binary file header.
+static fmt::memory_buffer build_file_header()
+{
+  fmt::memory_buffer buffer;
+  buffer.append(binary_format::file_magic, binary_format::file_magic + sizeof(binary_format::file_magic));
+  binary_format::put(buffer, binary_format::file_version);
+  binary_format::put(buffer, binary_format::byte_order_mark);
+  return buffer;
+}
+
+/// Decodes the binary buffer with a text formatter, storing the rendered entries in result.
+static detail::error_string decode(const fmt::memory_buffer& binary, std::string& result)
+{
+  binary_decoder decoder(std::unique_ptr<log_formatter>(new text_formatter));
+  std::FILE*     f   = std::tmpfile();
+  auto           err = decoder.decode(reinterpret_cast<const uint8_t*>(binary.data()), binary.size(), f);
+
+  result.resize(std::ftell(f));
+  std::rewind(f);
+  result.resize(std::fread(&result[0], 1, result.size(), f));
+  std::fclose(f);
+  return err;
+}
+
+static bool when_log_entries_are_decoded_then_output_matches_text_formatter()
+{
+  fmt::memory_buffer binary = build_file_header();
+  fmt::memory_buffer expected;
+  binary_formatter   bin_fmt;
+  text_formatter     txt_fmt;
+
+  // Formats the same entry with both formatters.
+  auto format_both = [&](const std::function<detail::log_entry_metadata(store_type*)>& build) {
+    store_type store1, store2;
+    bin_fmt.format(build(&store1), binary);
+    txt_fmt.format(build(&store2), expected);
+  };
+
+  format_both([](store_type* s) {
+    s->push_back(-88);
+    s->push_back(7U);
+    s->push_back(1LL << 40U);
+    s->push_back(~0ULL);
+    return build_log_entry_metadata("Integers %d %u %lld %llu", s);
+  });
+  format_both([](store_type* s) {
+    s->push_back(1.5f);
+    s->push_back(-2.25);
+    s->push_back('x');
+    s->push_back(true);
+    return build_log_entry_metadata("Others %.2f %f %c %d", s);
+  });
+  format_both([](store_type* s) {
+    s->push_back("literal");
+    s->push_back(std::string("string"));
+    s->push_back(custom_type{3});
+    return build_log_entry_metadata("Strings %s %s %s", s);
+  });
+  // Repeated format strings are only defined once.
+  size_t size_before_repeat      = binary.size();
+  size_t text_size_before_repeat = expected.size();
+  format_both([](store_type* s) {
+    s->push_back(-88);
+    s->push_back(7U);
+    s->push_back(1LL << 40U);
+    s->push_back(~0ULL);
+    return build_log_entry_metadata("Integers %d %u %lld %llu", s);
+  });
+  size_t repeat_size      = binary.size() - size_before_repeat;
+  size_t text_repeat_size = expected.size() - text_size_before_repeat;
+  // Entries without arguments print the format string verbatim.
+  format_both([](store_type* s) {
+    auto entry     = build_log_entry_metadata("Verbatim 100%%", nullptr);
+    entry.log_name = "";
+    entry.log_tag  = '\0';
+    return entry;
+  });
+  format_both([](store_type* s) {
+    auto entry            = build_log_entry_metadata("Hex dump", s);
+    entry.context.enabled = false;
+    entry.hex_dump.resize(20);
+    std::iota(entry.hex_dump.begin(), entry.hex_dump.end(), 0);
+    return entry;
+  });
+
+  std::string result;
+  ASSERT_EQ(bool(decode(binary, result)), false);
+  ASSERT_EQ(result, fmt::to_string(expected));
+
+  // The repeated entry is smaller than its text form.
+  ASSERT_EQ(repeat_size < text_repeat_size, true);
+
+  return true;
+}
+
+static bool when_format_string_address_is_reused_then_new_string_is_defined()
+{
+  fmt::memory_buffer binary = build_file_header();
+  binary_formatter   bin_fmt;
+
+  char fmtstring[] = "First %d";
+  {
+    store_type store;
+    store.push_back(1);
+    bin_fmt.format(build_log_entry_metadata(fmtstring, &store), binary);
+  }
+  std::strcpy(fmtstring, "Other %d");
+  {
+    store_type store;
+    store.push_back(2);
+    bin_fmt.format(build_log_entry_metadata(fmtstring, &store), binary);
+  }
+
+  std::string result;
+  ASSERT_EQ(bool(decode(binary, result)), false);
+  ASSERT_EQ(result,
+            "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] First 1\n"
+            "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] Other 2\n");
+
+  return true;
+}
+
+static bool when_context_is_formatted_then_it_is_decoded_as_text()
+{
+  ctx_t ctx("Metrics");
+  ctx.get<ue_set>().write<snr_t>(10.5f);
+
+  fmt::memory_buffer binary = build_file_header();
+  binary_formatter{}.format_ctx(ctx, build_log_entry_metadata(nullptr, nullptr), binary);
+
+  std::string result;
+  ASSERT_EQ(bool(decode(binary, result)), false);
+  ASSERT_EQ(result,
+            "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] Context dump for \"Metrics\"\n"
+            "  > Set: ue_container\n"
+            "    SNR: 10.5 dB\n");
+
+  return true;
+}
+
+static bool when_binary_data_is_malformed_then_error_is_reported()
+{
+  std::string result;
+
+  // Missing header.
+  fmt::memory_buffer no_header;
+  fmt::format_to(no_header, "Plain text log entry\n");
+  ASSERT_EQ(bool(decode(no_header, result)), true);
+
+  // Truncated record: the entries before it are still decoded.
+  fmt::memory_buffer binary = build_file_header();
+  binary_formatter   bin_fmt;
+  for (unsigned i = 0; i != 2; ++i) {
+    store_type store;
+    store.push_back(i);
+    bin_fmt.format(build_log_entry_metadata("Entry %u", &store), binary);
+  }
+  binary.resize(binary.size() - 1);
+  ASSERT_EQ(bool(decode(binary, result)), true);
+  ASSERT_EQ(result, "1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] Entry 0\n");
+
+  return true;
+}
+
+/// A Test-Specific Subclass of binary_file_sink that formats the entries it writes.
+class binary_file_sink_subclass : public binary_file_sink
+{
+public:
+  using binary_file_sink::binary_file_sink;
+
+  detail::error_string write_entry(unsigned i)
+  {
+    store_type store;
+    store.push_back(i);
+    fmt::memory_buffer buffer;
+    get_formatter().format(build_log_entry_metadata("Rotated entry %u", &store), buffer);
+    return write({buffer.data(), buffer.size()});
+  }
+};
+
+/// Reads the whole contents of a file.
+static fmt::memory_buffer read_file(const std::string& path)
+{
+  std::ifstream      file(path, std::ios::binary);
+  fmt::memory_buffer buffer;
+  for (char c; file.get(c);) {
+    buffer.push_back(c);
+  }
+  return buffer;
+}
+
+static bool when_binary_file_is_rotated_then_each_file_is_decoded_on_its_own()
+{
+  static constexpr char log_filename[] = "binary_file_sink_test.bin";
+  std::string           filename0      = file_utils::build_filename_with_index(log_filename, 0);
+  std::string           filename1      = file_utils::build_filename_with_index(log_filename, 1);
+  file_test_utils::scoped_file_deleter deleter = {filename0, filename1};
+
+  {
+    binary_file_sink_subclass sink(log_filename, 4 * 1024);
+    unsigned                  i = 0;
+    while (!file_test_utils::file_exists(filename1)) {
+      ASSERT_EQ(bool(sink.write_entry(i++)), false);
+    }
+    sink.flush();
+  }
+
+  std::string result;
+  ASSERT_EQ(bool(decode(read_file(filename0), result)), false);
+  ASSERT_EQ(result.find("Rotated entry 0\n") != std::string::npos, true);
+
+  // The strings defined in the first file are defined again in the second one.
+  ASSERT_EQ(bool(decode(read_file(filename1), result)), false);
+  ASSERT_EQ(result.find("1970-01-01T00:00:00.050000 [ABC    ] [Z] [   10] Rotated entry"), 0);
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_log_entries_are_decoded_then_output_matches_text_formatter);
+  TEST_FUNCTION(when_format_string_address_is_reused_then_new_string_is_defined);
+  TEST_FUNCTION(when_context_is_formatted_then_it_is_decoded_as_text);
+  TEST_FUNCTION(when_binary_data_is_malformed_then_error_is_reported);
+  TEST_FUNCTION(when_binary_file_is_rotated_then_each_file_is_decoded_on_its_own);
+
+  return 0;
+}
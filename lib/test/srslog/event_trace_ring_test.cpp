@@ -0,0 +1,213 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/srslog/event_trace.h"
+#include "testing_helpers.h"
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <thread>
+#include <vector>
+
+using namespace srslog;
+
+static constexpr unsigned nof_threads       = 4;
+static constexpr unsigned events_per_thread = 100;
+
+/// Traces each kind of event events_per_thread times from nof_threads threads.
+static void run_traced_threads()
+{
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i != nof_threads; ++i) {
+    threads.emplace_back([]() {
+      for (unsigned j = 0; j != events_per_thread; ++j) {
+        trace_complete_event("test", "complete");
+        trace_duration_begin("test", "duration");
+        trace_instant_event("test", "instant");
+        trace_counter_event("test", "counter", j);
+        trace_duration_end("test", "duration");
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
+static std::string read_file(const std::string& filename)
+{
+  std::ifstream f(filename, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+static unsigned count_occurrences(const std::string& str, const std::string& pattern)
+{
+  unsigned count = 0;
+  for (auto pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+static bool when_tracing_in_chrome_json_format_then_all_events_are_exported()
+{
+  const std::string filename = "event_trace_ring_test.json";
+  ASSERT_EQ(event_trace_init_ring(filename, event_trace_format::chrome_json), true);
+  // A second initialization is rejected while the tracer is running.
+  ASSERT_EQ(event_trace_init_ring(filename, event_trace_format::chrome_json), false);
+
+  run_traced_threads();
+  event_trace_stop();
+  ASSERT_EQ(event_trace_get_nof_dropped(), 0);
+
+  std::string trace = read_file(filename);
+  ASSERT_EQ(trace.find("{\"traceEvents\":["), 0);
+  ASSERT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+  ASSERT_EQ(count_occurrences(trace, "\"ph\":\"M\""), nof_threads);
+  ASSERT_EQ(count_occurrences(trace, "\"ph\":\"X\""), nof_threads * events_per_thread);
+  ASSERT_EQ(count_occurrences(trace, "\"ph\":\"B\""), nof_threads * events_per_thread);
+  ASSERT_EQ(count_occurrences(trace, "\"ph\":\"E\""), nof_threads * events_per_thread);
+  ASSERT_EQ(count_occurrences(trace, "\"ph\":\"i\""), nof_threads * events_per_thread);
+  ASSERT_EQ(count_occurrences(trace, "\"ph\":\"C\""), nof_threads * events_per_thread);
+  ASSERT_EQ(count_occurrences(trace, "\"name\":\"counter\""), nof_threads * events_per_thread);
+
+  return true;
+}
+
+static bool when_ring_is_full_then_events_are_dropped()
+{
+  const std::string filename   = "event_trace_ring_test_drop.json";
+  const unsigned    nof_events = 100000;
+  // Room for a few records only.
+  ASSERT_EQ(event_trace_init_ring(filename, event_trace_format::chrome_json, 16 * 64), true);
+
+  std::thread t([nof_events]() {
+    for (unsigned i = 0; i != nof_events; ++i) {
+      trace_instant_event("test", "instant");
+    }
+  });
+  t.join();
+  event_trace_stop();
+
+  uint64_t nof_dropped = event_trace_get_nof_dropped();
+  ASSERT_NE(nof_dropped, 0);
+  ASSERT_EQ(count_occurrences(read_file(filename), "\"ph\":\"i\"") + nof_dropped, nof_events);
+
+  return true;
+}
+
+/// Reads a varint from the input buffer, advancing the read position.
+static uint64_t read_varint(const std::string& buffer, std::size_t& pos)
+{
+  uint64_t value = 0;
+  for (unsigned shift = 0; pos < buffer.size(); shift += 7) {
+    auto byte = (uint8_t)buffer[pos++];
+    value |= (uint64_t)(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      break;
+    }
+  }
+  return value;
+}
+
+/// Decodes the fields of a protobuf message, storing the varint values and the
+/// payload of length delimited fields.
+static bool decode_message(const std::string&                    msg,
+                           std::multimap<uint32_t, uint64_t>&    varints,
+                           std::multimap<uint32_t, std::string>& submessages)
+{
+  std::size_t pos = 0;
+  while (pos < msg.size()) {
+    uint64_t tag = read_varint(msg, pos);
+    switch (tag & 7) {
+      case 0:
+        varints.emplace(tag >> 3, read_varint(msg, pos));
+        break;
+      case 2: {
+        uint64_t len = read_varint(msg, pos);
+        if (pos + len > msg.size()) {
+          return false;
+        }
+        submessages.emplace(tag >> 3, msg.substr(pos, len));
+        pos += len;
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+static bool when_tracing_in_perfetto_format_then_all_events_are_exported()
+{
+  const std::string filename = "event_trace_ring_test.perfetto-trace";
+  ASSERT_EQ(event_trace_init_ring(filename, event_trace_format::perfetto), true);
+  run_traced_threads();
+  event_trace_stop();
+
+  std::multimap<uint32_t, uint64_t>    trace_varints;
+  std::multimap<uint32_t, std::string> packets;
+  ASSERT_EQ(decode_message(read_file(filename), trace_varints, packets), true);
+  ASSERT_EQ(trace_varints.empty(), true);
+
+  std::map<uint64_t, unsigned> event_types;
+  unsigned                     nof_descriptors = 0;
+  for (const auto& packet : packets) {
+    ASSERT_EQ(packet.first, 1);
+    std::multimap<uint32_t, uint64_t>    fields;
+    std::multimap<uint32_t, std::string> submessages;
+    ASSERT_EQ(decode_message(packet.second, fields, submessages), true);
+    // Trusted packet sequence id.
+    ASSERT_EQ(fields.count(10), 1);
+    // Track descriptors.
+    nof_descriptors += submessages.count(60);
+    // Track events.
+    auto it = submessages.find(11);
+    if (it != submessages.end()) {
+      std::multimap<uint32_t, uint64_t>    event_fields;
+      std::multimap<uint32_t, std::string> event_strings;
+      ASSERT_EQ(decode_message(it->second, event_fields, event_strings), true);
+      // Timestamp.
+      ASSERT_EQ(fields.count(8), 1);
+      event_types[event_fields.find(9)->second]++;
+    }
+  }
+
+  // One process, one track per thread and one counter track.
+  ASSERT_EQ(nof_descriptors, 1 + nof_threads + 1);
+  // Complete and duration events are exported as slice begin and end events.
+  ASSERT_EQ(event_types[1], 2 * nof_threads * events_per_thread);
+  ASSERT_EQ(event_types[2], 2 * nof_threads * events_per_thread);
+  ASSERT_EQ(event_types[3], nof_threads * events_per_thread);
+  ASSERT_EQ(event_types[4], nof_threads * events_per_thread);
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_tracing_in_chrome_json_format_then_all_events_are_exported);
+  TEST_FUNCTION(when_ring_is_full_then_events_are_dropped);
+  TEST_FUNCTION(when_tracing_in_perfetto_format_then_all_events_are_exported);
+
+  return 0;
+}
@@ -35,7 +35,9 @@ namespace srsenb {
 #define SRSENB_RRC_MAX_N_PLMN_IDENTITIES 6
 
 #define SRSENB_N_SRB 3
+#ifndef SRSENB_MAX_UES
 #define SRSENB_MAX_UES 64
+#endif
 const uint32_t MAX_ERAB_ID   = 15;
 const uint32_t MAX_NOF_ERABS = 16;
 
@@ -84,6 +84,7 @@ struct log_args_t {
   int         all_hex_limit;
   int         file_max_size;
   std::string filename;
+  bool        binary;
 };
 
 struct gui_args_t {
@@ -95,6 +96,8 @@ struct general_args_t {
   float       metrics_period_secs;
   bool        metrics_csv_enable;
   std::string metrics_csv_filename;
+  bool        metrics_kpi_enable;
+  std::string metrics_kpi_filename;
   bool        report_json_enable;
   std::string report_json_filename;
   bool        report_json_asn1_oct;
@@ -104,6 +107,7 @@ struct general_args_t {
   bool        tracing_enable;
   std::size_t tracing_buffcapacity;
   std::string tracing_filename;
+  std::string tracing_format;
   std::string eia_pref_list;
   std::string eea_pref_list;
   uint32_t    max_mac_dl_kos;
@@ -180,6 +184,9 @@ private:
   // System metrics processor.
   srsran::sys_metrics_processor sys_proc;
 
+  // PHY metrics read at the previous metrics call, reported with the LTE stack metrics of that same period
+  std::vector<phy_metrics_t> prev_phy_metrics;
+
   std::string get_build_mode();
   std::string get_build_info();
   std::string get_build_string();
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        metrics_kpi_stream.h
+ * Description: Metrics class writing a binary columnar KPI stream.
+ *****************************************************************************/
+
+#ifndef SRSENB_METRICS_KPI_STREAM_H
+#define SRSENB_METRICS_KPI_STREAM_H
+
+#include "srsran/common/kpi_stream.h"
+#include "srsran/common/metrics_hub.h"
+#include "srsran/interfaces/enb_metrics_interface.h"
+#include <chrono>
+
+namespace srsenb {
+
+/**
+ * Writes the cell, UE, TTI stage and system metrics of every report as blocks of a KPI stream, which can be converted
+ * to CSV with kpi_stream_decode. Each report costs a few bytes per UE and metric, without any text formatting, hence
+ * it is suited to short metrics periods and large numbers of UEs.
+ */
+class metrics_kpi_stream : public srsran::metrics_listener<enb_metrics_t>
+{
+public:
+  explicit metrics_kpi_stream(const std::string& filename);
+
+  void set_metrics(const enb_metrics_t& m, const uint32_t period_usec) override;
+  void stop() override;
+
+private:
+  void write_cells(const enb_metrics_t& m, uint64_t ts);
+  void write_ues(const enb_metrics_t& m, uint64_t ts);
+  void write_tti_stages(const enb_metrics_t& m, uint64_t ts);
+  void write_sys(const enb_metrics_t& m, uint64_t ts);
+
+  srsran::kpi_stream::writer            writer;
+  uint32_t                              cell_group      = 0;
+  uint32_t                              ue_group        = 0;
+  uint32_t                              tti_stage_group = 0;
+  uint32_t                              sys_group       = 0;
+  std::chrono::steady_clock::time_point last_flush;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_METRICS_KPI_STREAM_H
@@ -25,6 +25,8 @@
 #include <string.h>
 
 #include "../phy_common.h"
+#include "srsenb/hdr/phy/lte/ue_metrics_sums.h"
+#include "srsran/adt/triple_buffer.h"
 #include "srsran/srslog/srslog.h"
 
 #define LOG_EXECTIME
@@ -37,9 +39,12 @@ class cc_worker
 public:
   cc_worker(srslog::basic_logger& logger);
   ~cc_worker();
-  void init(phy_common* phy, uint32_t cc_idx);
+  void init(phy_common* phy, uint32_t cc_idx, srsran_vec_arena_t* arena = nullptr);
   void reset();
 
+  /// Arena bytes needed by the sample buffers of a carrier
+  static size_t get_arena_size(phy_common* phy, uint32_t cc_idx);
+
   cf_t* get_buffer_rx(uint32_t antenna_idx);
   cf_t* get_buffer_tx(uint32_t antenna_idx);
   void  set_tti(uint32_t tti);
@@ -61,6 +66,7 @@ public:
                stack_interface_phy_lte::ul_sched_t& ul_grants,
                srsran_mbsfn_cfg_t*                  mbsfn_cfg);
 
+  /// Metrics of the UEs since the previous call. It does not take the worker mutex, and can be called at any rate
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
 
 private:
@@ -77,6 +83,7 @@ private:
   int  encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
   int  encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_grants);
   int  decode_pucch();
+  void publish_metrics();
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -85,6 +92,7 @@ private:
 
   cf_t*    signal_buffer_rx[SRSRAN_MAX_PORTS] = {};
   cf_t*    signal_buffer_tx[SRSRAN_MAX_PORTS] = {};
+  bool     signal_buffers_in_arena            = false; ///< Buffers belong to the sf_worker arena, they are not freed
   uint32_t tti_rx = 0, tti_tx_dl = 0, tti_tx_ul = 0;
 
   srsran_enb_dl_t enb_dl = {};
@@ -99,22 +107,23 @@ private:
   class ue
   {
   public:
-    explicit ue(uint16_t rnti_) : rnti(rnti_)
+    ue(uint16_t rnti_, uint32_t ue_id) : rnti(rnti_)
     {
-      // Do nothing
+      metrics.rnti  = rnti_;
+      metrics.ue_id = ue_id;
     }
 
     srsran_phich_grant_t phich_grant = {};
 
-    void     metrics_read(phy_metrics_t* metrics);
-    void     metrics_dl(uint32_t mcs);
-    void     metrics_ul(uint32_t mcs, float rssi, float sinr, float turbo_iters);
-    void     metrics_ul_pucch(float sinr);
-    uint32_t get_rnti() const { return rnti; }
+    void                     metrics_dl(uint32_t mcs);
+    void                     metrics_ul(uint32_t mcs, float rssi, float sinr, float turbo_iters);
+    void                     metrics_ul_pucch(float sinr);
+    const ue_metrics_sums_t& get_metrics() const { return metrics; }
+    uint32_t                 get_rnti() const { return rnti; }
 
   private:
-    uint32_t      rnti    = 0;
-    phy_metrics_t metrics = {};
+    uint32_t          rnti    = 0;
+    ue_metrics_sums_t metrics = {};
   };
 
   // Component carrier index
@@ -123,6 +132,12 @@ private:
   // Each worker keeps a local copy of the user database. Uses more memory but more efficient to manage concurrency
   std::map<uint16_t, ue*> ue_db;
   std::mutex              mutex;
+  uint32_t                next_ue_id = 0;
+
+  // Metrics of the UEs, published by the worker at the end of every TTI
+  srsran::triple_buffer<std::vector<ue_metrics_sums_t> > metrics_snapshot;
+  // Derives the metrics of the period from the snapshots, only accessed by the reader
+  ue_metrics_reader metrics_reader;
 };
 
 } // namespace lte
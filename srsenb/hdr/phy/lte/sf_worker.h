@@ -73,6 +73,9 @@ private:
   srsran::phy_common_interface::worker_context_t context = {};
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
+
+  // Memory arena the sample buffers of all carriers are allocated from, if enabled
+  srsran_vec_arena_t arena = {};
 };
 
 } // namespace lte
@@ -0,0 +1,64 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSENB_UE_METRICS_SUMS_H
+#define SRSENB_UE_METRICS_SUMS_H
+
+#include "srsenb/hdr/phy/phy_metrics.h"
+#include <map>
+#include <stdint.h>
+#include <vector>
+
+namespace srsenb {
+namespace lte {
+
+/// Cumulative PHY metrics of a UE since it was added to a CC worker. The metrics of a period are derived from the
+/// difference between two snapshots, so that the readers never reset them
+struct ue_metrics_sums_t {
+  uint16_t rnti               = 0;
+  uint32_t ue_id              = 0; ///< Changes every time the UE is added, so that a re-added UE restarts its sums
+  uint64_t dl_n_samples       = 0;
+  double   dl_mcs             = 0;
+  uint64_t ul_n_samples       = 0;
+  double   ul_mcs             = 0;
+  double   ul_pusch_sinr      = 0;
+  double   ul_rssi            = 0;
+  double   ul_turbo_iters     = 0;
+  uint64_t ul_n_samples_pucch = 0;
+  double   ul_pucch_sinr      = 0;
+};
+
+/// Derives the PHY metrics of each UE over the period since the previous read, from the latest snapshot of the sums
+class ue_metrics_reader
+{
+public:
+  /// Fills one metrics row per UE of the snapshot, in the same order. Returns the number of UEs
+  uint32_t read(const std::vector<ue_metrics_sums_t>& snapshot, std::vector<phy_metrics_t>& metrics);
+
+private:
+  std::map<uint16_t, ue_metrics_sums_t> last_read;
+};
+
+} // namespace lte
+} // namespace srsenb
+
+#endif // SRSENB_UE_METRICS_SUMS_H
@@ -22,6 +22,7 @@
 #ifndef SRSENB_NR_SLOT_WORKER_H
 #define SRSENB_NR_SLOT_WORKER_H
 
+#include "../tti_profiler.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/gnb_interfaces.h"
 #include "srsran/interfaces/phy_common_interface.h"
@@ -68,6 +69,7 @@ public:
     uint32_t                    pusch_max_its    = 10;
     float                       pusch_min_snr_dB = -10.0f;
     double                      srate_hz         = 0.0;
+    tti_profiler*               tti_prof         = nullptr; ///< Optional profiler of the processing stages
   };
 
   slot_worker(srsran::phy_common_interface& common_,
@@ -114,6 +116,7 @@ private:
   uint32_t                                       sf_len      = 0;
   uint32_t                                       cell_index  = 0;
   uint32_t                                       rf_port     = 0;
+  tti_profiler*                                  tti_prof    = nullptr;
   srsran_slot_cfg_t                              dl_slot_cfg = {};
   srsran_slot_cfg_t                              ul_slot_cfg = {};
   srsran::phy_common_interface::worker_context_t context     = {};
@@ -108,6 +108,7 @@ public:
     uint32_t               pusch_max_its     = 10;
     float                  pusch_min_snr_dB  = -10;
     srsran::phy_log_args_t log               = {};
+    tti_profiler*          tti_prof          = nullptr; ///< Optional profiler of the processing stages
   };
   slot_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
 
@@ -24,6 +24,7 @@
 
 #include "phy_interfaces.h"
 #include "srsenb/hdr/phy/phy_ue_db.h"
+#include "srsenb/hdr/phy/tti_profiler.h"
 #include "srsran/common/gen_mch_tables.h"
 #include "srsran/common/interfaces_common.h"
 #include "srsran/common/standard_streams.h"
@@ -71,6 +72,9 @@ public:
   // Common objects
   phy_args_t params = {};
 
+  /// Latency of the TTI processing stages, recorded by the txrx thread and the workers
+  tti_profiler tti_prof;
+
   uint32_t get_nof_carriers_lte() { return static_cast<uint32_t>(cell_list_lte.size()); }
   uint32_t get_nof_carriers_nr() { return static_cast<uint32_t>(cell_list_nr.size()); }
   uint32_t get_nof_carriers() { return static_cast<uint32_t>(cell_list_lte.size() + cell_list_nr.size()); }
@@ -77,6 +77,9 @@ struct phy_args_t {
   bool                    pucch_meas_ta       = true;
   uint32_t                nof_prach_threads   = 1;
   bool                    extended_cp         = false;
+  std::string             arena_mode          = "none";
+  int                     arena_numa_node     = -1;
+  bool                    perf_counters       = false;
   srsran::channel::args_t dl_channel_args;
   srsran::channel::args_t ul_channel_args;
 
@@ -22,6 +22,8 @@
 #ifndef SRSENB_PHY_METRICS_H
 #define SRSENB_PHY_METRICS_H
 
+#include <stdint.h>
+
 namespace srsenb {
 
 // PHY metrics per user
@@ -43,10 +45,28 @@ struct dl_metrics_t {
 };
 
 struct phy_metrics_t {
+  uint16_t     rnti;
   dl_metrics_t dl;
   ul_metrics_t ul;
 };
 
+// Latency and hardware counters of a TTI processing stage over a metrics period
+
+struct tti_stage_metrics_t {
+  const char* name;
+  uint64_t    count;
+  float       p50_us;
+  float       p99_us;
+  float       max_us;
+  float       deadline_us;
+  uint64_t    nof_deadline_misses;
+  // Hardware performance counters, only valid if nof_perf_samples > 0
+  uint64_t    nof_perf_samples;
+  float       ipc;         ///< Instructions per cycle
+  float       llc_mpki;    ///< Last level cache misses per thousand instructions
+  float       branch_mpki; ///< Branch mispredictions per thousand instructions
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
@@ -53,8 +53,9 @@ public:
             const srsran_prach_cfg_t& prach_cfg_,
             stack_interface_phy_lte*  mac,
             int                       priority,
-            uint32_t                  nof_workers);
-  int  new_tti(uint32_t tti, cf_t* buffer);
+            uint32_t                  nof_workers,
+            uint32_t                  nof_rx_ant = 1);
+  int  new_tti(uint32_t tti, cf_t* buffer[SRSRAN_MAX_PORTS]);
   void set_max_prach_offset_us(float delay_us);
   void stop();
 
@@ -84,8 +85,8 @@ private:
       nof_samples = 0;
       tti         = 0;
     }
-    cf_t     samples[sf_buffer_sz] = {};
-    uint32_t nof_samples           = 0;
+    cf_t     samples[sf_buffer_sz] = {}; ///< Samples of every antenna, one PRACH occasion after the other
+    uint32_t nof_samples           = 0;  ///< Number of samples of each antenna
     uint32_t tti                   = 0;
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
     char debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN];
@@ -103,6 +104,7 @@ private:
   uint32_t                 nof_sf      = 0;
   uint32_t                 sf_cnt      = 0;
   uint32_t                 nof_workers = 0;
+  uint32_t                 nof_rx_ant  = 1;
 
   void run_thread() final;
   int  run_tti(sf_buffer* b);
@@ -123,14 +125,15 @@ public:
             stack_interface_phy_lte*  mac,
             srslog::basic_logger&     logger,
             int                       priority,
-            uint32_t                  nof_workers_x_cc)
+            uint32_t                  nof_workers_x_cc,
+            uint32_t                  nof_rx_ant = 1)
   {
     // Create PRACH worker if required
     while (cc_idx >= prach_vec.size()) {
       prach_vec.push_back(std::unique_ptr<prach_worker>(new prach_worker(prach_vec.size(), logger)));
     }
 
-    prach_vec[cc_idx]->init(cell_, prach_cfg_, mac, priority, nof_workers_x_cc);
+    prach_vec[cc_idx]->init(cell_, prach_cfg_, mac, priority, nof_workers_x_cc, nof_rx_ant);
   }
 
   void set_max_prach_offset_us(float delay_us)
@@ -147,7 +150,7 @@ public:
     }
   }
 
-  int new_tti(uint32_t cc_idx, uint32_t tti, cf_t* buffer)
+  int new_tti(uint32_t cc_idx, uint32_t tti, cf_t* buffer[SRSRAN_MAX_PORTS])
   {
     int ret = SRSRAN_ERROR;
     if (cc_idx < prach_vec.size()) {
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_TTI_PROFILER_H
+#define SRSENB_TTI_PROFILER_H
+
+#include "phy_metrics.h"
+#include "srsran/common/perf_counters.h"
+#include "srsran/common/time_prof.h"
+#include <vector>
+
+namespace srsenb {
+
+/// Processing stages of a TTI that are profiled
+enum class tti_stage_t {
+  rx,
+  ul_fft,
+  ul_decode,
+  dl_encode,
+  mac_sched,
+  rf_tx,
+  total,
+  nr_ul_sched,
+  nr_ul,
+  nr_dl_sched,
+  nr_dl,
+  nof_stages
+};
+
+const char* to_string(tti_stage_t stage);
+
+/**
+ * Profiler of the latency of each processing stage of a TTI. The stages are measured from the txrx thread and the PHY
+ * workers, and accumulated in lock-free histograms that are summarized and reset on every metrics period.
+ * The total stage spans from the reception of the subframe samples to the submission of the TX subframe to the radio,
+ * and misses its deadline when the TX subframe is late. Any other stage misses its deadline when it exceeds one TTI.
+ * When the hardware performance counters are enabled, the cycles, instructions and misses of the thread running each
+ * stage are accumulated as well, except for the total stage, which spans several threads.
+ */
+class tti_profiler
+{
+public:
+  /// Measures the duration of a stage until it goes out of scope. Nothing is measured if the profiler is null
+  class scoped_measure
+  {
+  public:
+    scoped_measure(tti_profiler& prof_, tti_stage_t stage_) : scoped_measure(&prof_, stage_) {}
+    scoped_measure(tti_profiler* prof_, tti_stage_t stage_) :
+      prof(prof_), stage(stage_), perf(prof_ != nullptr ? &prof_->perf[(size_t)stage_] : nullptr)
+    {
+      meas.start();
+    }
+    ~scoped_measure()
+    {
+      if (prof != nullptr) {
+        prof->record(stage, meas.stop());
+      }
+    }
+
+  private:
+    tti_profiler*              prof;
+    tti_stage_t                stage;
+    srsran::perf_counter_scope perf;
+    srsran::tprof_measure      meas;
+  };
+
+  tti_profiler();
+
+  void record(tti_stage_t stage, std::chrono::nanoseconds duration) { stages[(size_t)stage](duration); }
+
+  /// Marks the reception of the samples of a TTI, the start of the total stage
+  void tti_start(uint32_t tti);
+  /// Marks the submission of the TX subframe of a TTI to the radio, the end of the total stage
+  void tti_end(uint32_t tti);
+
+  /// Summarizes the stages since the previous call
+  void get_metrics(std::vector<tti_stage_metrics_t>& metrics);
+
+private:
+  /// Number of TTIs whose start time is kept, which must exceed the number of TTIs in flight
+  const static uint32_t nof_tti_start = 16;
+
+  std::array<srsran::latency_histogram, (size_t)tti_stage_t::nof_stages>        stages;
+  std::array<srsran::perf_counter_accumulator, (size_t)tti_stage_t::nof_stages> perf;
+  std::array<std::atomic<int64_t>, nof_tti_start>                               tti_start_ns;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_TTI_PROFILER_H
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_ENB_STACK_BASE_H
 #define SRSRAN_ENB_STACK_BASE_H
 
+#include "srsran/common/pcap_writer.h"
 #include "srsran/interfaces/enb_interfaces.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_s1ap_interfaces.h"
@@ -69,15 +70,16 @@ typedef struct {
 } stack_log_args_t;
 
 typedef struct {
-  uint32_t         sync_queue_size; // Max allowed difference between PHY and Stack clocks (in TTI)
-  uint32_t         gtpu_indirect_tunnel_timeout_msec;
-  mac_args_t       mac;
-  s1ap_args_t      s1ap;
-  pcap_args_t      mac_pcap;
-  pcap_net_args_t  mac_pcap_net;
-  pcap_args_t      s1ap_pcap;
-  stack_log_args_t log;
-  embms_args_t     embms;
+  uint32_t                   sync_queue_size; // Max allowed difference between PHY and Stack clocks (in TTI)
+  uint32_t                   gtpu_indirect_tunnel_timeout_msec;
+  mac_args_t                 mac;
+  s1ap_args_t                s1ap;
+  pcap_args_t                mac_pcap;
+  pcap_net_args_t            mac_pcap_net;
+  pcap_args_t                s1ap_pcap;
+  srsran::pcap_writer_args_t pcap_writer;
+  stack_log_args_t           log;
+  embms_args_t               embms;
 } stack_args_t;
 
 struct stack_metrics_t;
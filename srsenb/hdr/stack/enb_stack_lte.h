@@ -30,6 +30,7 @@
 #include "mac/mac.h"
 #include "rrc/rrc.h"
 #include "s1ap/s1ap.h"
+#include "srsran/adt/triple_buffer.h"
 #include "srsran/common/task_scheduler.h"
 #include "upper/gtpu.h"
 #include "upper/pdcp.h"
@@ -194,7 +195,9 @@ private:
   // state
   std::atomic<bool> started{false};
 
-  srsran::dyn_blocking_queue<stack_metrics_t> pending_stack_metrics;
+  // Metrics collected by the stack thread, and the reader side flag of the first collection
+  srsran::triple_buffer<stack_metrics_t> stack_metrics_snapshot;
+  bool                                   stack_metrics_valid = false;
 };
 
 } // namespace srsenb
@@ -54,6 +54,10 @@ struct mac_ue_metrics_t {
   int      dl_mcs_samples;
   float    ul_mcs;
   int      ul_mcs_samples;
+
+  // NR-only link adaptation state
+  float    dl_cqi_offset;
+  float    ul_snr_offset;
 };
 /// MAC misc information for each cc.
 struct mac_cc_info_t {
@@ -61,6 +65,10 @@ struct mac_cc_info_t {
   uint32_t pci;
   /// RACH preamble counter per cc.
   uint32_t cc_rach_counter;
+  /// Average time spent allocating a DCI in the PDCCH, in microseconds.
+  float pdcch_alloc_time_us;
+  /// Fraction of DCI allocation attempts that did not find space in the PDCCH.
+  float pdcch_blocking_rate;
 };
 
 /// Main MAC metrics.
@@ -42,6 +42,7 @@ struct mac_nr_args_t {
   int                              fixed_ul_mcs = -1;
   sched_nr_interface::sched_args_t sched_cfg    = {};
   srsenb::pcap_args_t              pcap;
+  srsran::pcap_writer_args_t       pcap_writer;
 };
 
 class mac_nr final : public mac_interface_phy_nr, public mac_interface_rrc_nr, public mac_interface_rlc_nr
@@ -57,6 +57,8 @@ public:
   void ul_crc_info(uint16_t rnti, uint32_t cc, uint32_t pid, bool crc) override;
   void ul_sr_info(uint16_t rnti) override;
   void ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr) override;
+  void dl_cqi_info(uint16_t rnti, uint32_t cc, uint32_t cqi) override;
+  void ul_sinr_info(uint16_t rnti, uint32_t cc, float sinr) override;
   void dl_buffer_state(uint16_t rnti, uint32_t lcid, uint32_t newtx, uint32_t retx);
 
   int run_slot(slot_point pdsch_tti, uint32_t cc, dl_res_t& result) override;
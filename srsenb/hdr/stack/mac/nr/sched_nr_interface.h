@@ -42,6 +42,7 @@ const static size_t   SCHED_NR_MAX_HARQ         = SRSRAN_DEFAULT_HARQ_PROC_DL_NR
 const static size_t   SCHED_NR_MAX_BWP_PER_CELL = 2;
 const static size_t   SCHED_NR_MAX_LCID         = srsran::MAX_NR_NOF_BEARERS;
 const static size_t   SCHED_NR_MAX_LC_GROUP     = 7;
+const static uint32_t SCHED_NR_MAX_LOOKAHEAD    = 4;
 
 struct sched_nr_ue_cc_cfg_t {
   bool     active = false;
@@ -90,12 +91,21 @@ public:
   };
 
   struct sched_args_t {
-    bool        pdsch_enabled      = true;
-    bool        pusch_enabled      = true;
-    bool        auto_refill_buffer = false;
-    int         fixed_dl_mcs       = 28;
-    int         fixed_ul_mcs       = 28;
-    std::string logger_name        = "MAC-NR";
+    bool        pdsch_enabled             = true;
+    bool        pusch_enabled             = true;
+    bool        auto_refill_buffer        = false;
+    int         fixed_dl_mcs              = 28; ///< -1 to derive the MCS from the CQI reports
+    int         fixed_ul_mcs              = 28; ///< -1 to derive the MCS from the PUSCH SINR
+    float       target_bler               = 0.05; ///< BLER targeted by the outer-loop link adaptation, 0 to disable
+    float       max_delta_dl_cqi          = 5;
+    float       max_delta_ul_snr          = 5;
+    float       adaptive_dl_mcs_step_size = 0.001;
+    float       adaptive_ul_mcs_step_size = 0.001;
+    float       ul_snr_avg_alpha          = 0.05;
+    int         init_ul_snr_value         = 5;
+    int         init_dl_cqi               = 5;
+    uint32_t    lookahead_slots           = 0; ///< Slots generated ahead of the slot being transmitted, 0 to disable
+    std::string logger_name               = "MAC-NR";
   };
 
   using ue_cc_cfg_t = sched_nr_ue_cc_cfg_t;
@@ -144,6 +154,8 @@ public:
   virtual void ul_crc_info(uint16_t rnti, uint32_t cc, uint32_t pid, bool crc)                  = 0;
   virtual void ul_sr_info(uint16_t rnti)                                                        = 0;
   virtual void ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)                             = 0;
+  virtual void dl_cqi_info(uint16_t rnti, uint32_t cc, uint32_t cqi)                            = 0;
+  virtual void ul_sinr_info(uint16_t rnti, uint32_t cc, float sinr)                             = 0;
 };
 
 } // namespace srsenb
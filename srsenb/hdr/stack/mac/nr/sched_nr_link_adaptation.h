@@ -0,0 +1,90 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_NR_LINK_ADAPTATION_H
+#define SRSRAN_SCHED_NR_LINK_ADAPTATION_H
+
+#include "sched_nr_interface.h"
+
+namespace srsenb {
+
+namespace sched_nr_impl {
+
+/// Highest MCS index of the 64QAM MCS table (TS 38.214, Table 5.1.3.1-1)
+const static uint32_t max_mcs_64qam = 28;
+
+/**
+ * Link adaptation of a UE carrier. The DL MCS is derived from the last wideband CQI and the UL MCS from the averaged
+ * PUSCH SINR, via tables precomputed for the 64QAM MCS table. An outer loop offsets the CQI and the SINR on every
+ * HARQ-ACK and CRC, so that the BLER converges to the configured target_bler.
+ */
+class link_adaptation
+{
+public:
+  explicit link_adaptation(const sched_nr_interface::sched_args_t& sched_args);
+
+  void dl_cqi_info(uint32_t cqi);
+  void ul_sinr_info(float sinr);
+
+  /// Outer-loop update, given the MCS of the acknowledged transmission
+  void dl_ack_info(bool ack, uint32_t mcs);
+  void ul_crc_info(bool crc, uint32_t mcs);
+
+  uint32_t get_dl_mcs() const;
+  uint32_t get_ul_mcs() const;
+
+  uint32_t get_dl_cqi() const { return dl_cqi; }
+  float    get_ul_sinr() const { return ul_sinr; }
+  float    get_dl_cqi_offset() const { return dl_cqi_coeff; }
+  float    get_ul_snr_offset() const { return ul_snr_coeff; }
+
+  /// Highest MCS whose spectral efficiency does not exceed the one of a, possibly fractional, CQI
+  static uint32_t cqi_to_mcs(float cqi);
+  /// Highest MCS whose spectral efficiency does not exceed the one of the CQI reported at a given SINR
+  static uint32_t sinr_to_mcs(float sinr_dB);
+
+private:
+  const int   fixed_dl_mcs;
+  const int   fixed_ul_mcs;
+  const float target_bler;
+  const float ul_snr_avg_alpha;
+
+  // Outer-loop steps and limits
+  float dl_delta_inc  = 0;
+  float dl_delta_dec  = 0;
+  float ul_delta_inc  = 0;
+  float ul_delta_dec  = 0;
+  float max_cqi_coeff = 0;
+  float max_snr_coeff = 0;
+
+  // Channel state
+  uint32_t dl_cqi          = 0;
+  float    ul_sinr         = 0;
+  bool     ul_sinr_present = false;
+  float    dl_cqi_coeff    = 0;
+  float    ul_snr_coeff    = 0;
+};
+
+} // namespace sched_nr_impl
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_NR_LINK_ADAPTATION_H
@@ -24,6 +24,8 @@
 
 #include "srsenb/hdr/stack/mac/nr/sched_nr_interface.h"
 #include "srsran/adt/bounded_bitset.h"
+#include "srsran/adt/bounded_vector.h"
+#include "srsran/adt/span.h"
 #include "srsran/phy/common/phy_common_nr.h"
 
 namespace srsenb {
@@ -144,6 +146,7 @@ public:
   {
     prbs_.reset();
     rbgs_.reset();
+    free_intervals_valid = false;
   }
 
   template <typename T>
@@ -156,16 +159,19 @@ public:
   {
     prbs_.fill(prbs.start(), prbs.stop());
     add_prbs_to_rbgs(prbs);
+    free_intervals_valid = false;
   }
   void add(const prb_bitmap& grant)
   {
     prbs_ |= grant;
     add_prbs_to_rbgs(grant);
+    free_intervals_valid = false;
   }
   void add(const rbg_bitmap& grant)
   {
     rbgs_ |= grant;
     add_rbgs_to_prbs(grant);
+    free_intervals_valid = false;
   }
   void add(const prb_grant& grant)
   {
@@ -178,7 +184,7 @@ public:
   bool collides(const prb_grant& grant) const
   {
     if (grant.is_alloc_type0()) {
-      return (rbgs() & grant.rbgs()).any();
+      return rbgs().intersects(grant.rbgs());
     }
     return prbs().any(grant.prbs().start(), grant.prbs().stop());
   }
@@ -187,8 +193,13 @@ public:
   {
     prbs_.set(prb_idx);
     rbgs_.set(prb_to_rbg_idx(prb_idx));
+    free_intervals_valid = false;
   }
 
+  /// List of the free PRB intervals, in increasing order of PRB index. It is only recomputed after the bitmap changes,
+  /// given that the RAR and SI allocators search the same slot bitmap for several grant sizes
+  srsran::const_span<prb_interval> free_prb_intervals() const;
+
   const prb_bitmap& prbs() const { return prbs_; }
   const rbg_bitmap& rbgs() const { return rbgs_; }
   uint32_t          P() const { return P_; }
@@ -198,12 +209,17 @@ public:
   uint32_t prb_to_rbg_idx(uint32_t prb_idx) const;
 
 private:
+  using free_interval_list = srsran::bounded_vector<prb_interval, SRSRAN_MAX_PRB_NR / 2 + 1>;
+
   prb_bitmap prbs_;
   rbg_bitmap rbgs_;
   uint32_t   P_             = 0;
   uint32_t   Pnofbits       = 0;
   uint32_t   first_rbg_size = 0;
 
+  mutable free_interval_list free_intervals;
+  mutable bool               free_intervals_valid = false;
+
   void add_prbs_to_rbgs(const prb_bitmap& grant);
   void add_prbs_to_rbgs(const prb_interval& grant);
   void add_rbgs_to_prbs(const rbg_bitmap& grant);
@@ -240,6 +256,9 @@ inline prb_interval find_empty_interval_of_length(const prb_bitmap& mask, size_t
   return max_interv;
 }
 
+/// Equivalent to find_empty_interval_of_length(bitmap.prbs(), ...), but using the cached list of free PRB intervals
+prb_interval find_empty_interval_of_length(const bwp_rb_bitmap& bitmap, size_t nof_prbs, uint32_t start_prb_idx = 0);
+
 } // namespace sched_nr_impl
 } // namespace srsenb
 
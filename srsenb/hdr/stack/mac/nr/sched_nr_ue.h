@@ -25,6 +25,7 @@
 #include "sched_nr_cfg.h"
 #include "sched_nr_harq.h"
 #include "sched_nr_interface.h"
+#include "sched_nr_link_adaptation.h"
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
 #include "srsenb/hdr/stack/mac/common/ue_buffer_manager.h"
 #include "srsran/adt/circular_map.h"
@@ -62,7 +63,8 @@ public:
   slot_point          pusch_slot;
   slot_point          uci_slot;
   uint32_t            dl_cqi  = 0;
-  uint32_t            ul_cqi  = 0;
+  uint32_t            dl_mcs  = 0;
+  uint32_t            ul_mcs  = 0;
   dl_harq_proc*       h_dl    = nullptr;
   ul_harq_proc*       h_ul    = nullptr;
   srsran_uci_cfg_nr_t uci_cfg = {};
@@ -83,8 +85,7 @@ public:
   const uint32_t cc;
 
   // Channel state
-  uint32_t dl_cqi = 1;
-  uint32_t ul_cqi = 0;
+  link_adaptation la;
 
   harq_entity harq_ent;
 
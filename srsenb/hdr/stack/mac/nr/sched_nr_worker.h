@@ -27,10 +27,13 @@
 #include "sched_nr_grant_allocator.h"
 #include "sched_nr_ue.h"
 #include "srsran/adt/circular_array.h"
+#include "srsran/adt/mpsc_queue.h"
 #include "srsran/adt/optional.h"
 #include "srsran/adt/pool/cached_alloc.h"
 #include "srsran/adt/span.h"
-#include <condition_variable>
+#include "srsran/common/thread_pool.h"
+#include <atomic>
+#include <limits>
 #include <mutex>
 
 namespace srsenb {
@@ -39,6 +42,99 @@ struct mac_metrics_t;
 
 namespace sched_nr_impl {
 
+/**
+ * Lock-free queue of events directed at the scheduler, with multiple producers and a single consumer. If the queue
+ * is full, the events are stored in a locked overflow list, which the consumer only accesses while it is not empty.
+ */
+template <typename T>
+class sched_event_queue
+{
+public:
+  explicit sched_event_queue(size_t capacity) : queue(capacity) {}
+
+  void push(T&& t)
+  {
+    if (not overflow_active.load(std::memory_order_acquire) and queue.try_push(std::move(t))) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(overflow_mutex);
+    overflow.push_back(std::move(t));
+    overflow_active.store(true, std::memory_order_release);
+  }
+
+  /// Consumer: pops all pending events, and calls func for each of them from the oldest to the newest
+  template <typename F>
+  void consume_all(const F& func)
+  {
+    queue.consume_all(func);
+    if (overflow_active.load(std::memory_order_acquire)) {
+      {
+        std::lock_guard<std::mutex> lock(overflow_mutex);
+        tmp_overflow.swap(overflow);
+        overflow_active.store(false, std::memory_order_relaxed);
+      }
+      for (T& t : tmp_overflow) {
+        func(t);
+      }
+      tmp_overflow.clear();
+    }
+  }
+
+private:
+  srsran::dyn_mpsc_queue<T> queue;
+  std::atomic<bool>         overflow_active{false};
+  std::mutex                overflow_mutex;
+  srsran::deque<T>          overflow, tmp_overflow;
+};
+
+/**
+ * Synchronization of the carrier workers of a slot, based on atomics. The first worker to enter a slot updates the
+ * state shared across carriers, while the other workers of the same slot wait for it. Workers of the next slot wait
+ * until all the workers of the current slot have left.
+ */
+class slot_sync_barrier
+{
+public:
+  explicit slot_sync_barrier(uint32_t nof_workers_) : nof_workers(nof_workers_) {}
+
+  /// Waits until the previous slot is finished. Returns true if the caller is the first worker of the slot, in which
+  /// case it must call finish_setup() once the shared state is updated. Otherwise, it must call wait_setup()
+  bool enter_slot(slot_point slot);
+  void finish_setup(slot_point slot);
+  void wait_setup(slot_point slot);
+
+  /// Called by each worker once it has generated its decisions. Returns true for the last worker of the slot
+  bool leave_slot();
+
+  /// Wakes up the workers blocked in the barrier, which then return without waiting for the other workers
+  void stop() { stopping.store(true, std::memory_order_release); }
+  bool stopped() const { return stopping.load(std::memory_order_acquire); }
+
+  /// Waits until cond() is true or the barrier is stopped. Yields the CPU while waiting
+  template <typename Condition>
+  bool wait_for(const Condition& cond) const
+  {
+    for (uint32_t count = 0; not cond(); ++count) {
+      if (stopped()) {
+        return false;
+      }
+      backoff(count);
+    }
+    return true;
+  }
+
+private:
+  static void backoff(uint32_t count);
+
+  const static uint32_t no_slot = std::numeric_limits<uint32_t>::max();
+
+  const uint32_t        nof_workers;
+  std::atomic<uint32_t> current_slot{no_slot}; ///< slot being processed by the workers
+  std::atomic<uint32_t> setup_slot{no_slot};   ///< last slot whose shared state was updated
+  std::atomic<int>      nof_remaining{0};      ///< workers of the current slot that have not left yet
+  std::atomic<bool>     stopping{false};
+};
+
 class slot_cc_worker
 {
 public:
@@ -74,24 +170,14 @@ private:
     uint16_t            rnti;
     feedback_callback_t fdbk;
   };
-  std::mutex                                    feedback_mutex;
-  srsran::deque<feedback_t>                     pending_feedback, tmp_feedback_to_run;
-  srsran::deque<srsran::move_callback<void()> > pending_events, tmp_events_to_run;
+  sched_event_queue<feedback_t>                     pending_feedback;
+  sched_event_queue<srsran::move_callback<void()> > pending_events;
 
   slot_ue_map_t slot_ues;
 };
 
 class sched_worker_manager
 {
-  struct slot_worker_ctxt {
-    std::mutex                  slot_mutex; // lock of all workers of the same slot.
-    std::condition_variable     cvar;
-    slot_point                  slot_rx;
-    int                         nof_workers_waiting = 0;
-    std::atomic<int>            worker_count{0}; // variable shared across slot_cc_workers
-    std::vector<slot_cc_worker> workers;
-  };
-
 public:
   explicit sched_worker_manager(ue_map_t&                                         ue_db_,
                                 const sched_params&                               cfg_,
@@ -112,7 +198,11 @@ public:
   }
 
 private:
-  void update_ue_db(slot_point slot_tx, bool locked_context);
+  /// Generates the {slot, cc} decisions in the scheduler grid
+  void generate_slot(slot_point slot_tx, uint32_t cc);
+  /// Waits for the {slot, cc} decisions generated ahead by the pipeline, and requests the generation of the next slots
+  void fetch_pipelined_slot(slot_point slot_tx, uint32_t cc);
+  void update_ue_db(slot_point slot_tx);
   void get_metrics_nolocking(mac_metrics_t& metrics);
   bool save_sched_result(slot_point pdcch_slot, uint32_t cc, dl_sched_res_t& dl_res, ul_sched_t& ul_res);
 
@@ -125,22 +215,24 @@ private:
     uint16_t                      rnti;
     srsran::move_callback<void()> callback;
   };
-  std::mutex                event_mutex;
-  srsran::deque<ue_event_t> next_slot_events, slot_events;
+  sched_event_queue<ue_event_t> pending_events;
 
-  std::vector<std::unique_ptr<slot_worker_ctxt> > slot_worker_ctxts;
   struct cc_context {
-    std::condition_variable cvar;
-    int                     waiting = 0;
-    slot_cc_worker          worker;
+    slot_cc_worker worker;
+
+    // Look-ahead pipeline. The counters of requested and fetched slots are only accessed by the caller of run_slot
+    std::unique_ptr<srsran::task_worker> pipeline;
+    slot_point                           next_fetch_slot;
+    uint32_t                             nof_requested = 0;
+    uint32_t                             nof_fetched   = 0;
+    std::atomic<uint32_t>                nof_generated{0};
 
     cc_context(serv_cell_manager& sched) : worker(sched) {}
   };
 
-  std::mutex                                slot_mutex;
-  std::condition_variable                   cvar;
-  slot_point                                current_slot;
-  std::atomic<int>                          worker_count{0}; // variable shared across slot_cc_workers
+  // Protects the UE database from concurrent metrics reads, while UEs are added or removed
+  std::mutex                                ue_db_mutex;
+  slot_sync_barrier                         slot_barrier;
   std::vector<std::unique_ptr<cc_context> > cc_worker_list;
 };
 
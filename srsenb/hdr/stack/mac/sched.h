@@ -26,7 +26,11 @@
 #include "sched_interface.h"
 #include "sched_ue.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsran/adt/move_callback.h"
+#include "srsran/adt/mpsc_queue.h"
+#include "srsran/common/thread_pool.h"
 #include <atomic>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 
@@ -86,15 +90,36 @@ public:
   std::array<int, SRSRAN_MAX_CARRIERS> get_enb_ue_cc_map(uint16_t rnti) final;
   std::array<int, SRSRAN_MAX_CARRIERS> get_enb_ue_activ_cc_map(uint16_t rnti) final;
   int                                  ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes) final;
+  ue_dl_tx_metrics_t                   read_dl_tx_metrics(uint16_t rnti) final;
+  pdcch_metrics_t                      read_pdcch_metrics(uint32_t enb_cc_idx) final;
 
   class carrier_sched;
 
 protected:
+  /// Feedback/buffer state update of a UE. It is queued without taking the sched lock, and applied at the start of
+  /// the next TTI
+  struct ue_event_t {
+    uint16_t                               rnti      = SRSRAN_INVALID_RNTI;
+    const char*                            func_name = nullptr;
+    srsran::move_callback<void(sched_ue&)> callback;
+  };
+  using ue_event_queue_t = srsran::dyn_mpsc_queue<ue_event_t>;
+
   void new_tti(srsran::tti_point tti_rx);
+  void generate_cc_results(srsran::tti_point tti_rx);
+  void generate_cc_group(srsran::tti_point tti_rx, uint32_t group_idx);
+  void update_cc_groups();
   bool is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
   // Helper methods
   template <typename Func>
-  int ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
+  int        ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
+  template <typename Func>
+  int        enqueue_ue_event(uint16_t rnti, Func&& f, const char* func_name = nullptr);
+  template <typename Func>
+  int        enqueue_cc_event(uint32_t enb_cc_idx, uint16_t rnti, Func&& f, const char* func_name = nullptr);
+  int        apply_or_enqueue_event(ue_event_queue_t& q, ue_event_t& ev);
+  void       apply_pending_events();
+  static int apply_ue_event(sched_ue_list& ue_db, ue_event_t& ev);
 
   // args
   rrc_interface_mac*               rrc       = nullptr;
@@ -109,6 +134,18 @@ protected:
   // Storage of past scheduling results
   sched_result_ringbuffer sched_results;
 
+  // UE events that are not specific to a carrier (SR, BSR, PHR, buffer states). Each carrier has its own queue for the
+  // PHY feedback
+  ue_event_queue_t ue_events;
+
+  // Carriers that share UEs must be generated sequentially. Each group of carriers is generated by a different thread
+  std::vector<std::vector<uint32_t> >       cc_groups;
+  bool                                      cc_groups_outdated = true;
+  std::unique_ptr<srsran::task_thread_pool> cc_workers;
+  std::mutex                                cc_workers_mutex;
+  std::condition_variable                   cc_workers_cvar;
+  uint32_t                                  nof_pending_cc_groups = 0;
+
   srsran::tti_point last_tti;
   std::mutex        sched_mutex;
   bool              configured;
@@ -46,6 +46,14 @@ public:
   const cc_sched_result& generate_tti_result(srsran::tti_point tti_rx);
   int                    dl_rach_info(dl_sched_rar_info_t rar_info);
 
+  /// Queues of PHY feedback for this carrier. Pushing is thread-safe and lock-free
+  ue_event_queue_t& get_feedback_queue() { return feedback_queue; }
+  bool              enqueue_rach_info(const dl_sched_rar_info_t& rar_info) { return rach_queue.try_push(rar_info); }
+  //! Apply the PHY feedback and RACHs received since the last call. Called with the sched lock held
+  void apply_pending_events();
+  //! Get the PDCCH allocation statistics accumulated since the last call, and reset them
+  sched_interface::pdcch_metrics_t read_pdcch_metrics();
+
   // getters
   const ra_sched* get_ra_sched() const { return ra_sched_ptr.get(); }
   //! Get a subframe result for a given tti
@@ -74,9 +82,15 @@ private:
 
   std::vector<uint8_t> sf_dl_mask; ///< Some TTIs may be forbidden for DL sched due to MBMS
 
+  sched_interface::pdcch_metrics_t pdcch_metrics; ///< PDCCH allocation statistics of the generated subframes
+
   std::unique_ptr<bc_sched>   bc_sched_ptr;
   std::unique_ptr<ra_sched>   ra_sched_ptr;
   std::unique_ptr<sched_base> sched_algo;
+
+  // PHY feedback of this carrier, pending to be applied
+  ue_event_queue_t                            feedback_queue;
+  srsran::dyn_mpsc_queue<dl_sched_rar_info_t> rach_queue;
 };
 
 //! Broadcast (SIB + paging) scheduler
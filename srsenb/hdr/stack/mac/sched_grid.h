@@ -53,8 +53,9 @@ struct sf_sched_result {
     assert(enb_cc_idx < enb_cc_list.size());
     return &enb_cc_list[enb_cc_idx];
   }
-  bool is_ul_alloc(uint16_t rnti) const;
-  bool is_dl_alloc(uint16_t rnti) const;
+  /// Only the carriers configured for the UE are visited, as the others may be generated concurrently
+  bool is_ul_alloc(const sched_ue& user) const;
+  bool is_dl_alloc(const sched_ue& user) const;
 };
 
 struct sched_result_ringbuffer {
@@ -92,7 +93,7 @@ public:
   void         init(const sched_cell_params_t& cell_params_);
   void         new_tti(tti_point tti_rx);
   alloc_result alloc_dl_ctrl(uint32_t aggr_lvl, rbg_interval rbg_range, alloc_type_t alloc_type);
-  alloc_result alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask, bool has_pusch_grant);
+  alloc_result alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask, bool has_pusch_grant, bool mu_mimo = false);
   bool         reserve_dl_rbgs(uint32_t start_rbg, uint32_t end_rbg);
   void         rem_last_alloc_dl(rbg_interval rbgs);
 
@@ -113,7 +114,8 @@ private:
                         alloc_type_t alloc_type,
                         rbgmask_t    alloc_mask,
                         sched_ue*    user            = nullptr,
-                        bool         has_pusch_grant = false);
+                        bool         has_pusch_grant = false,
+                        bool         mu_mimo         = false);
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
@@ -155,6 +157,7 @@ public:
     uint16_t  rnti;
     rbgmask_t user_mask;
     uint32_t  pid;
+    uint16_t  mu_pair_rnti = SRSRAN_INVALID_RNTI; ///< UE co-scheduled in the same RBGs (MU-MIMO)
   };
   struct ul_alloc_t {
     enum type_t { NEWTX, NOADAPT_RETX, ADAPT_RETX };
@@ -199,6 +202,7 @@ public:
   void generate_sched_results(sched_ue_list& ue_db);
 
   alloc_result                    alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask, uint32_t pid);
+  alloc_result                    alloc_dl_mu_user(sched_ue* user, uint32_t pid, sched_ue* paired_user);
   tti_point                       get_tti_tx_dl() const { return to_tx_dl(tti_rx); }
   uint32_t                        get_nof_ctrl_symbols() const;
   const rbgmask_t&                get_dl_mask() const { return tti_alloc.get_dl_mask(); }
@@ -206,15 +210,19 @@ public:
   const prbmask_t&                get_ul_mask() const { return tti_alloc.get_ul_mask(); }
   tti_point                       get_tti_tx_ul() const { return to_tx_ul(tti_rx); }
   srsran::const_span<rar_alloc_t> get_allocated_rars() const { return rar_allocs; }
+  srsran::const_span<dl_alloc_t>  get_allocated_dl_users() const { return data_allocs; }
 
   // getters
-  tti_point                  get_tti_rx() const { return tti_rx; }
-  bool                       is_dl_alloc(uint16_t rnti) const;
-  bool                       is_ul_alloc(uint16_t rnti) const;
-  uint32_t                   get_enb_cc_idx() const { return cc_cfg->enb_cc_idx; }
-  const sched_cell_params_t* get_cc_cfg() const { return cc_cfg; }
+  tti_point                               get_tti_rx() const { return tti_rx; }
+  bool                                    is_dl_alloc(uint16_t rnti) const;
+  bool                                    is_ul_alloc(uint16_t rnti) const;
+  uint32_t                                get_enb_cc_idx() const { return cc_cfg->enb_cc_idx; }
+  const sched_cell_params_t*              get_cc_cfg() const { return cc_cfg; }
+  const sched_interface::pdcch_metrics_t& get_pdcch_metrics() const { return tti_alloc.get_pdcch_grid().get_metrics(); }
 
 private:
+  alloc_result alloc_dl_user_common(sched_ue* user, const rbgmask_t& user_mask, uint32_t pid, bool mu_mimo);
+
   void set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t& dci_result,
                                 sched_interface::dl_sched_res_t*        dl_result,
                                 sched_ue_list&                          ue_list);
@@ -83,6 +83,20 @@ uint32_t get_aggr_level(uint32_t nof_bits,
                         uint32_t cell_nof_prb,
                         bool     use_tbs_index_alt);
 
+/**
+ * Squared correlation |w1^H w2|^2 between two rank-1 precoders of the TS 36.211 codebook (Tables 6.3.4.2.3-1 and -2)
+ * @param nof_ports number of cell antenna ports (2 or 4)
+ * @return value in [0, 1], where 0 means orthogonal precoders. Returns 1 for invalid PMIs
+ */
+float get_pmi_correlation(uint32_t nof_ports, uint32_t pmi1, uint32_t pmi2);
+
+/**
+ * Derives the CQI of a UE paired in MU-MIMO from its single-user CQI. The transmit power is split between the two
+ * co-scheduled layers and the layer of the paired UE leaks into the UE's effective channel proportionally to the
+ * precoder correlation, i.e. SINR_mu = 1 / (2 / SINR_su + corr)
+ */
+uint32_t get_mu_mimo_cqi(uint32_t su_cqi, float corr);
+
 /*******************************************************
  *          sched_interface helper functions
  *******************************************************/
@@ -79,6 +79,10 @@ public:
     int         init_dl_cqi               = 5;
     float       max_sib_coderate          = 0.8;
     int         pdcch_cqi_offset          = 0;
+    bool        mcs_tbs_tables            = true; ///< Precompute the MCS/TBS derivation for each cell
+    uint32_t    nof_cc_workers            = 0; ///< Threads generating carriers without common UEs in parallel
+    bool        mu_mimo                   = false; ///< Pair TM4 UEs in the same RBGs (time_pf, simulation only)
+    float       mu_mimo_max_corr          = 0.1; ///< Max squared correlation between the PMIs of paired UEs
   };
 
   struct cell_cfg_t {
@@ -291,6 +295,20 @@ public:
    */
   virtual int dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds) = 0;
 
+  /// DL transmission counters derived from the HARQ-ACK feedback of a UE
+  struct ue_dl_tx_metrics_t {
+    uint64_t tx_bytes  = 0;
+    uint32_t tx_errors = 0;
+    uint32_t tx_pkts   = 0;
+  };
+
+  /// PDCCH allocation statistics of a carrier
+  struct pdcch_metrics_t {
+    uint32_t nof_dci_allocs  = 0; ///< DCI allocation attempts
+    uint32_t nof_dci_blocked = 0; ///< DCI allocation attempts that did not find space in the PDCCH or PUCCH
+    uint64_t alloc_time_ns   = 0; ///< Total time spent in the DCI allocation attempts
+  };
+
   /* DL information */
   virtual int dl_ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)        = 0;
   virtual int dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)                                 = 0;
@@ -315,6 +333,12 @@ public:
   virtual std::array<int, SRSRAN_MAX_CARRIERS> get_enb_ue_cc_map(uint16_t rnti)                            = 0;
   virtual std::array<int, SRSRAN_MAX_CARRIERS> get_enb_ue_activ_cc_map(uint16_t rnti)                      = 0;
   virtual int                                  ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes) = 0;
+
+  /// Returns the DL transmission counters accumulated since the last call for the given UE, and resets them
+  virtual ue_dl_tx_metrics_t read_dl_tx_metrics(uint16_t rnti) = 0;
+
+  /// Returns the PDCCH allocation statistics accumulated since the last call for the given carrier, and resets them
+  virtual pdcch_metrics_t read_pdcch_metrics(uint32_t enb_cc_idx) = 0;
 };
 
 } // namespace srsenb
@@ -51,6 +51,84 @@ using cce_sf_position_table = std::array<std::array<cce_position_list, NOF_AGGR_
 /// Map {sf, cfi, L} -> list of CCE positions
 using cce_frame_position_table = std::array<cce_sf_position_table, SRSRAN_NOF_SF_X_FRAME>;
 
+/// Transport block size (in bytes) and MCS derived for a grant
+struct tbs_info {
+  int tbs_bytes = -1;
+  int mcs       = 0;
+  tbs_info()    = default;
+  tbs_info(int tbs_bytes_, int mcs_) : tbs_bytes(tbs_bytes_), mcs(mcs_) {}
+};
+inline bool operator==(const tbs_info& lhs, const tbs_info& rhs)
+{
+  return lhs.mcs == rhs.mcs and lhs.tbs_bytes == rhs.tbs_bytes;
+}
+inline bool operator!=(const tbs_info& lhs, const tbs_info& rhs)
+{
+  return not(lhs == rhs);
+}
+
+class sched_cell_params_t;
+
+/**
+ * Precomputed derivation of MCS/TBS from CQI for the {nof_prb, nof_re} pairs over which the scheduler searches, i.e.
+ * the lower bound of DL REs of each subframe and the PUSCH REs without SRS/UCI. The table is generated once per cell
+ * configuration and stores, for every {nof_prb, nof_re, cqi, max_mcs} and UL/DL MCS table, the result of the
+ * iterative search in sched_dci.h. Queries for other nof_re values, or when the table was not generated, fall back
+ * to the iterative search, so that both paths always give the same result.
+ */
+class sched_mcs_tbs_table
+{
+public:
+  void generate(const sched_cell_params_t& cell_params);
+  void clear();
+  bool empty() const { return entries.empty(); }
+
+  /// Same as compute_mcs_and_tbs() of sched_dci.h
+  tbs_info compute_mcs_and_tbs(uint32_t nof_prb,
+                               uint32_t nof_re,
+                               uint32_t cqi,
+                               uint32_t max_mcs,
+                               bool     is_ul,
+                               bool     ulqam64_enabled,
+                               bool     use_tbs_index_alt) const;
+
+  /// Same as compute_min_mcs_and_tbs_from_required_bytes() of sched_dci.h
+  tbs_info compute_min_mcs_and_tbs_from_required_bytes(uint32_t nof_prb,
+                                                       uint32_t nof_re,
+                                                       uint32_t cqi,
+                                                       uint32_t max_mcs,
+                                                       uint32_t req_bytes,
+                                                       bool     is_ul,
+                                                       bool     ulqam64_enabled,
+                                                       bool     use_tbs_index_alt) const;
+
+private:
+  /// MCS tables for which results are stored
+  enum table_idx { dl_table, dl_256qam_table, ul_table, ul_64qam_table, nof_tables };
+  /// Beyond MCS 28, max_mcs does not constrain the result anymore
+  static const uint32_t nof_max_mcs = 29;
+  static const uint32_t nof_cqis    = 16;
+
+  struct mcs_tbs {
+    int16_t tbs_bytes;
+    uint8_t mcs;
+  };
+  /// Results stored for one nof_re value of a given nof_prb, starting at entries[offset]
+  struct re_bucket {
+    uint32_t nof_re;
+    uint32_t offset;
+  };
+  using prb_buckets = srsran::bounded_vector<re_bucket, SRSRAN_NOF_SF_X_FRAME>;
+
+  static table_idx get_table_idx(bool is_ul, bool ulqam64_enabled, bool use_tbs_index_alt);
+  void             add_bucket(table_idx t, uint32_t nof_prb, uint32_t nof_re);
+  /// Returns the results for all max_mcs values of {nof_prb, nof_re, cqi}, or nullptr if they were not precomputed
+  const mcs_tbs* find_row(table_idx t, uint32_t nof_prb, uint32_t nof_re, uint32_t cqi) const;
+
+  std::array<std::vector<prb_buckets>, nof_tables> buckets; ///< map {table, nof_prb - 1} -> nof_re buckets
+  std::vector<mcs_tbs>                             entries;
+};
+
 /// structs to bundle together all the sched arguments, and share them with all the sched sub-components
 class sched_cell_params_t
 {
@@ -88,6 +166,8 @@ public:
   dl_nof_re_table nof_re_table;
   /// Cached computation of Lower bound of nof REs
   dl_lb_nof_re_table nof_re_lb_table;
+  /// Precomputed MCS/TBS derivation for the lower bound of nof REs
+  sched_mcs_tbs_table mcs_tbs_table;
 };
 
 /// Type of Allocation stored in PDSCH/PUSCH
@@ -30,21 +30,29 @@ namespace srsenb {
 class sched_ue;
 
 /// Class responsible for managing a PDCCH CCE grid, namely CCE allocs, and avoid collisions.
+/// The CCE occupancy of each CFI is kept as an independent bitmask tree that is extended incrementally, one DCI at a
+/// time. Previous DCIs are only moved to other positions when a new DCI does not fit, with a bounded backtracking.
 class sf_cch_allocator
 {
 public:
   const static uint32_t MAX_CFI = 3;
+  /// Maximum number of DCI position changes attempted per CFI when a new DCI does not fit in the current allocation
+  const static uint32_t MAX_BACKTRACK_STEPS = 64;
   struct tree_node {
     int8_t                pucch_n_prb = -1; ///< this PUCCH resource identifier
     uint16_t              rnti        = SRSRAN_INVALID_RNTI;
     uint32_t              record_idx  = 0;
-    uint32_t              dci_pos_idx = 0;
+    uint32_t              dci_pos_idx = 0; ///< index of the chosen position in the DCI candidate list
     srsran_dci_location_t dci_pos     = {0, 0};
     /// Accumulation of all PDCCH masks for the current solution (DFS path)
     pdcch_mask_t total_mask, current_mask;
     prbmask_t    total_pucch_mask;
   };
-  using alloc_result_t = srsran::bounded_vector<const tree_node*, 16>;
+  /// Maximum number of DCIs per subframe, given the limits of broadcast, RAR and DL/UL data allocations
+  const static uint32_t MAX_NOF_DCIS = sched_interface::MAX_BC_LIST + sched_interface::MAX_RAR_LIST +
+                                       2 * sched_interface::MAX_DATA_LIST;
+  using alloc_result_t  = srsran::bounded_vector<const tree_node*, MAX_NOF_DCIS>;
+  using pdcch_metrics_t = sched_interface::pdcch_metrics_t;
 
   sf_cch_allocator() : logger(srslog::fetch_basic_logger("MAC")) {}
 
@@ -68,20 +76,37 @@ public:
   uint32_t    nof_cces() const { return cc_cfg->nof_cce_table[current_cfix]; }
   size_t      nof_allocs() const { return dci_record_list.size(); }
   std::string result_to_string(bool verbose = false) const;
+  /// Allocation attempts, blocked DCIs and time spent in alloc_dci() since the last new_tti()
+  const pdcch_metrics_t& get_metrics() const { return metrics; }
 
 private:
+  /// Possible position of a DCI, with its CCE mask and, if the DCI carries a HARQ-ACK in PUCCH, its PUCCH PRB
+  struct dci_candidate {
+    uint32_t     ncce;
+    uint32_t     dci_pos_idx;
+    int8_t       pucch_n_prb;
+    pdcch_mask_t mask;
+  };
+  using candidate_list_t = srsran::bounded_vector<dci_candidate, 6>;
+
   /// DCI allocation parameters
   struct alloc_record {
     bool         pusch_uci;
     uint32_t     aggr_idx;
     alloc_type_t alloc_type;
     sched_ue*    user;
+    /// Candidate positions per CFI, computed once per subframe when the CFI is first tried for this DCI
+    std::array<candidate_list_t, MAX_CFI> candidates;
+    std::array<bool, MAX_CFI>             candidates_set;
   };
+  using alloc_tree_t = std::vector<tree_node>;
+
   const cce_cfi_position_table* get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const;
+  const candidate_list_t&       get_candidates(alloc_record& record, uint32_t cfix);
 
   // PDCCH allocation algorithm
-  bool alloc_dfs_node(const alloc_record& record, uint32_t start_child_idx);
-  bool get_next_dfs();
+  bool alloc_tree(uint32_t cfix);
+  bool push_node(uint32_t cfix, alloc_record& record, uint32_t start_cand_idx);
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
@@ -89,11 +114,13 @@ private:
   srsran_pucch_cfg_t         pucch_cfg_common = {};
 
   // tti vars
-  tti_point                 tti_rx;
-  uint32_t                  current_cfix     = 0;
-  uint32_t                  current_max_cfix = 0;
-  std::vector<tree_node>    last_dci_dfs, temp_dci_dfs;
-  std::vector<alloc_record> dci_record_list; ///< Keeps a record of all the PDCCH allocations done so far
+  tti_point                         tti_rx;
+  uint32_t                          current_cfix     = 0;
+  uint32_t                          current_max_cfix = 0;
+  std::array<alloc_tree_t, MAX_CFI> cfi_trees;       ///< DCI positions of each CFI, valid for a prefix of the records
+  alloc_tree_t                      temp_tree;       ///< Backup of the tree being rearranged
+  std::vector<alloc_record>         dci_record_list; ///< Keeps a record of all the PDCCH allocations done so far
+  pdcch_metrics_t                   metrics;
 };
 
 // Helper methods
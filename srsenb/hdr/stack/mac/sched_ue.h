@@ -83,6 +83,10 @@ public:
   uint32_t                  get_aggr_level(uint32_t enb_cc_idx, uint32_t nof_bits);
   void                      ul_buffer_add(uint8_t lcid, uint32_t bytes);
 
+  /// Accounts a DL HARQ-ACK in the DL transmission counters. tbs is the number of bytes of the acknowledged TB
+  void                                save_dl_tx_metrics(bool ack, uint32_t tbs);
+  sched_interface::ue_dl_tx_metrics_t read_dl_tx_metrics();
+
   /*******************************************************
    * Functions used by scheduler metric objects
    *******************************************************/
@@ -125,7 +129,8 @@ public:
                              tti_point                         tti_tx_dl,
                              uint32_t                          enb_cc_idx,
                              uint32_t                          cfi,
-                             const rbgmask_t&                  user_mask);
+                             const rbgmask_t&                  user_mask,
+                             float                             mu_corr = -1);
   int generate_format0(sched_interface::ul_sched_data_t* data,
                        tti_point                         tti_tx_ul,
                        uint32_t                          enb_cc_idx,
@@ -136,6 +141,8 @@ public:
                        uci_pusch_t                       uci_type     = UCI_PUSCH_NONE);
 
   srsran_dci_format_t           get_dci_format();
+  /// PMI of the UE if it can be paired with other UEs in the same RBGs (MU-MIMO), or -1 otherwise
+  int                           get_dl_mu_mimo_pmi(uint32_t enb_cc_idx) const;
   const cce_cfi_position_table* get_locations(uint32_t enb_cc_idx, uint32_t current_cfi, uint32_t sf_idx) const;
 
   sched_ue_cell*                   find_ue_carrier(uint32_t enb_cc_idx);
@@ -158,13 +165,15 @@ private:
                                    tti_point                         tti_tx_dl,
                                    uint32_t                          enb_cc_idx,
                                    uint32_t                          cfi,
-                                   uint32_t                          tb);
+                                   uint32_t                          tb,
+                                   float                             mu_corr = -1);
 
   tbs_info compute_mcs_and_tbs(uint32_t               enb_cc_idx,
                                tti_point              tti_tx_dl,
                                const rbgmask_t&       rbgs,
                                uint32_t               cfi,
-                               const srsran_dci_dl_t& dci);
+                               const srsran_dci_dl_t& dci,
+                               float                  mu_corr = -1);
 
   bool needs_cqi(uint32_t tti, uint32_t enb_cc_idx, bool will_send = false);
 
@@ -191,13 +200,15 @@ private:
                         tti_point                         tti_tx_dl,
                         uint32_t                          enb_cc_idx,
                         uint32_t                          cfi,
-                        const rbgmask_t&                  user_mask);
+                        const rbgmask_t&                  user_mask,
+                        float                             mu_corr = -1);
   int generate_format2(uint32_t                          pid,
                        sched_interface::dl_sched_data_t* data,
                        tti_point                         tti_tx_dl,
                        uint32_t                          enb_cc_idx,
                        uint32_t                          cfi,
-                       const rbgmask_t&                  user_mask);
+                       const rbgmask_t&                  user_mask,
+                       float                             mu_corr = -1);
 
   /* Args */
   ue_cfg_t                   cfg  = {};
@@ -215,6 +226,8 @@ private:
 
   bool phy_config_dedicated_enabled = false;
 
+  sched_interface::ue_dl_tx_metrics_t dl_tx_metrics;
+
   tti_point                  current_tti;
   std::vector<sched_ue_cell> cells; ///< List of eNB cells that may be configured/activated/deactivated for the UE
 };
@@ -116,11 +116,13 @@ private:
  ************************************************************/
 
 /// Compute DL grant optimal TBS and MCS given UE cell context and DL grant parameters
+/// \param mu_corr precoder correlation with the UE paired in the same RBGs (MU-MIMO), or negative if not paired
 tbs_info cqi_to_tbs_dl(const sched_ue_cell& cell,
                        const rbgmask_t&     rbgs,
                        uint32_t             nof_re,
                        srsran_dci_format_t  dci_format,
-                       uint32_t             req_bytes = std::numeric_limits<uint32_t>::max());
+                       uint32_t             req_bytes = std::numeric_limits<uint32_t>::max(),
+                       float                mu_corr   = -1);
 
 /// Compute UL grant optimal TBS and MCS given UE cell context and UL grant parameters
 tbs_info
@@ -0,0 +1,64 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_FREQ_PF_H
+#define SRSRAN_SCHED_FREQ_PF_H
+
+#include "sched_time_pf.h"
+
+namespace srsenb {
+
+/**
+ * Frequency-selective proportional fair scheduler.
+ * DL new transmissions are assigned per RBG. Each free RBG goes to the UE with the highest PF metric in that RBG,
+ * i.e. the spectral efficiency of the RBG subband CQI over the UE average rate, until the UE has enough RBGs for its
+ * pending data. Retransmissions, UEs restricted to DCI format 1A and the UL follow the time-domain PF policy.
+ */
+class sched_freq_pf final : public sched_time_pf
+{
+public:
+  sched_freq_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args);
+  void sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched) override;
+
+private:
+  /// UE waiting for a DL newtx allocation in the current TTI
+  struct newtx_candidate {
+    ue_ctxt*                   ctxt;
+    sched_ue*                  ue;
+    srsran::interval<uint32_t> req_bytes;
+    float                      weight;    ///< inverse of the UE average rate raised to the fairness coefficient
+    float                      rem_bytes; ///< pending bytes not yet covered by the assigned RBGs
+    rbgmask_t                  mask;
+    alloc_result               code;
+    uint32_t                   alloc_bytes;
+  };
+
+  void     assign_rbgs(const rbgmask_t& dl_mask, tti_point tti_tx_dl);
+  uint32_t try_dl_newtx_alloc(newtx_candidate& cand, sf_sched* tti_sched);
+
+  srsran::bounded_vector<newtx_candidate, SRSENB_MAX_UES> candidates;
+  /// Spectral efficiency and PF metric of each {candidate, free RBG}, stored per candidate
+  std::vector<float> rbg_eff, rbg_metrics;
+};
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_FREQ_PF_H
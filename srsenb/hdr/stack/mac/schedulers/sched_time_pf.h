@@ -29,7 +29,7 @@
 
 namespace srsenb {
 
-class sched_time_pf final : public sched_base
+class sched_time_pf : public sched_base
 {
   using ue_cit_t = sched_ue_list::const_iterator;
 
@@ -38,11 +38,13 @@ public:
   void sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched) override;
   void sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched) override;
 
-private:
+protected:
   void new_tti(sched_ue_list& ue_db, sf_sched* tti_sched);
 
-  const sched_cell_params_t* cc_cfg         = nullptr;
-  float                      fairness_coeff = 1;
+  const sched_cell_params_t* cc_cfg           = nullptr;
+  float                      fairness_coeff   = 1;
+  bool                       mu_mimo          = false;
+  float                      mu_mimo_max_corr = 0;
 
   srsran::tti_point current_tti_rx;
 
@@ -88,7 +90,11 @@ private:
   ue_dl_queue_t dl_queue;
   ue_ul_queue_t ul_queue;
 
+  /// UEs without SU-MIMO allocation that may be paired with already allocated UEs, in decreasing priority
+  std::vector<ue_ctxt*> dl_mu_candidates;
+
   uint32_t try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
+  uint32_t try_dl_mu_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sched_ue_list& ue_db, sf_sched* tti_sched);
   uint32_t try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
 };
 
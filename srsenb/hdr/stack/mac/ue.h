@@ -69,6 +69,14 @@ struct ue_cc_softbuffers {
   srsran_softbuffer_rx_t& get_rx(uint32_t tti) { return softbuffer_rx_list.at(tti % nof_rx_harq_proc); }
 };
 
+/**
+ * Creates the pool of UE carrier softbuffers shared by all UEs of the eNB. The pool starts with nof_prealloc_ues
+ * entries and is refilled in the background when it falls below half of that number, so that a burst of UE attaches
+ * does not construct softbuffers in the caller thread. The softbuffers of removed UEs are reset in the background too.
+ */
+std::unique_ptr<srsran::obj_pool_itf<ue_cc_softbuffers> > make_ue_cc_softbuffer_pool(uint32_t nof_prb,
+                                                                                     uint32_t nof_prealloc_ues);
+
 /// Class to manage the allocation, deallocation & access to pending UL HARQ buffers
 class cc_used_buffers_map
 {
@@ -192,7 +192,7 @@ private:
 
   // state
   std::unique_ptr<freq_res_common_list>    cell_res_list;
-  std::map<uint16_t, unique_rnti_ptr<ue> > users; // NOTE: has to have fixed addr
+  rnti_map_t<unique_rnti_ptr<ue> >         users; // NOTE: has to have fixed addr
   std::unique_ptr<paging_manager>          pending_paging;
 
   void     process_release_complete(uint16_t rnti);
@@ -132,8 +132,9 @@ private:
   pdcp_interface_gtpu*      pdcp      = nullptr;
   srslog::basic_logger&     logger;
 
+  // Hash map rather than rnti_map_t: LTE and EN-DC NR RNTIs share this table and can map to the same slot
   std::unordered_map<uint16_t, ue_bearer_tunnel_list> ue_teidin_db;
-  tunnel_list_t                     tunnels;
+  tunnel_list_t                                       tunnels;
 };
 
 using gtpu_tunnel_state = gtpu_tunnel_manager::tunnel_state;
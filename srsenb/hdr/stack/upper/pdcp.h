@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsran/common/timers.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
@@ -55,7 +56,7 @@ public:
   // pdcp_interface_rrc
   void set_enabled(uint16_t rnti, uint32_t lcid, bool enabled) override;
   void reset(uint16_t rnti) override;
-  void add_user(uint16_t rnti) override;
+  int  add_user(uint16_t rnti) override;
   void rem_user(uint16_t rnti) override;
   void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn = -1) override;
   void add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cnfg) override;
@@ -125,7 +126,8 @@ private:
 
   void clear_user(user_interface* ue);
 
-  std::map<uint32_t, user_interface> users;
+  // Users are direct-indexed by RNTI, so that the per-SDU lookups do not need to walk a tree
+  rnti_map_t<user_interface> users;
 
   rlc_interface_pdcp*       rlc  = nullptr;
   rrc_interface_pdcp*       rrc  = nullptr;
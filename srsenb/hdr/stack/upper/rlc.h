@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
@@ -54,7 +55,7 @@ public:
 
   // rlc_interface_rrc
   void clear_buffer(uint16_t rnti);
-  void add_user(uint16_t rnti);
+  int  add_user(uint16_t rnti);
   void rem_user(uint16_t rnti);
   void add_bearer(uint16_t rnti, uint32_t lcid, srsran::rlc_config_t cnfg);
   void add_bearer_mrb(uint16_t rnti, uint32_t lcid);
@@ -102,8 +103,9 @@ private:
 
   pthread_rwlock_t rwlock;
 
-  std::map<uint32_t, user_interface> users;
-  std::vector<mch_service_t>         mch_services;
+  // Users are direct-indexed by RNTI, so that the per-PDU lookups do not need to walk a tree
+  rnti_map_t<user_interface> users;
+  std::vector<mch_service_t> mch_services;
 
   mac_interface_rlc*     mac  = nullptr;
   pdcp_interface_rlc*    pdcp = nullptr;
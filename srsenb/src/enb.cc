@@ -27,6 +27,7 @@
 #include "srsran/build_info.h"
 #include "srsran/common/enb_events.h"
 #include "srsran/radio/radio_null.h"
+#include <algorithm>
 #include <iostream>
 
 namespace srsenb {
@@ -211,9 +212,25 @@ bool enb::get_metrics(enb_metrics_t* m)
     return false;
   }
   radio->get_metrics(&m->rf);
-  phy->get_metrics(m->phy);
+  std::vector<phy_metrics_t> phy_metrics;
+  phy->get_metrics(phy_metrics);
+  phy->get_tti_profiler_metrics(m->tti_stages);
   if (eutra_stack) {
-    eutra_stack->get_metrics(&m->stack);
+    // The LTE stack returns the metrics it collected after the previous call, so they are reported with the PHY
+    // metrics of the previous call, with one PHY row per stack UE
+    m->phy.clear();
+    if (eutra_stack->get_metrics(&m->stack)) {
+      for (const mac_ue_metrics_t& ue : m->stack.mac.ues) {
+        auto it = std::find_if(prev_phy_metrics.begin(), prev_phy_metrics.end(), [&ue](const phy_metrics_t& row) {
+          return row.rnti == ue.rnti;
+        });
+        m->phy.push_back(it != prev_phy_metrics.end() ? *it : phy_metrics_t{});
+        m->phy.back().rnti = ue.rnti;
+      }
+    }
+    prev_phy_metrics.swap(phy_metrics);
+  } else {
+    m->phy = std::move(phy_metrics);
   }
   if (nr_stack) {
     nr_stack->get_metrics(&m->nr_stack);
@@ -1656,6 +1656,7 @@ int set_derived_args_nr(all_args_t* args_, rrc_nr_cfg_t* rrc_nr_cfg_, phy_cfg_t*
 
   // MAC-NR PCAP options
   args_->nr_stack.mac.pcap.enable = args_->stack.mac_pcap.enable;
+  args_->nr_stack.mac.pcap_writer = args_->stack.pcap_writer;
   args_->nr_stack.log             = args_->stack.log;
 
   return SRSRAN_SUCCESS;
@@ -30,6 +30,7 @@
 #include "srsran/common/config_file.h"
 #include "srsran/common/crash_handler.h"
 #include "srsran/common/tsan_options.h"
+#include "srsran/phy/utils/vec_arena.h"
 #include "srsran/srslog/event_trace.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/support/emergency_handlers.h"
@@ -45,6 +46,7 @@
 #include "srsenb/hdr/enb.h"
 #include "srsenb/hdr/metrics_csv.h"
 #include "srsenb/hdr/metrics_json.h"
+#include "srsenb/hdr/metrics_kpi_stream.h"
 #include "srsenb/hdr/metrics_stdout.h"
 #include "srsran/common/enb_events.h"
 
@@ -64,8 +66,10 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 {
   string mcc;
   string mnc;
-  string enb_id;
-  bool   use_standard_lte_rates = false;
+  string   enb_id;
+  bool     use_standard_lte_rates = false;
+  string   pcap_format;
+  uint32_t pcap_max_file_size = 0;
 
   // Command line only options
   bpo::options_description general("General options");
@@ -139,6 +143,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     ("log.filename",      bpo::value<string>(&args->log.filename)->default_value("/tmp/ue.log"),"Log filename")
     ("log.file_max_size", bpo::value<int>(&args->log.file_max_size)->default_value(-1), "Maximum file size (in kilobytes). When passed, multiple files are created. Default -1 (single file)")
+    ("log.binary",        bpo::value<bool>(&args->log.binary)->default_value(false), "Write a binary log file that is rendered offline with srslog_decode")
 
     /* PCAP */
     ("pcap.enable",    bpo::value<bool>(&args->stack.mac_pcap.enable)->default_value(false),         "Enable MAC packet captures for wireshark")
@@ -146,6 +151,10 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("pcap.nr_filename",  bpo::value<string>(&args->nr_stack.mac.pcap.filename)->default_value("enb_mac_nr.pcap"), "NR MAC layer capture filename")
     ("pcap.s1ap_enable",   bpo::value<bool>(&args->stack.s1ap_pcap.enable)->default_value(false),         "Enable S1AP packet captures for wireshark")
     ("pcap.s1ap_filename", bpo::value<string>(&args->stack.s1ap_pcap.filename)->default_value("enb_s1ap.pcap"), "S1AP layer capture filename")
+    ("pcap.format",        bpo::value<string>(&pcap_format)->default_value("pcap"),                                  "Capture file format: pcap or pcapng (one interface per layer)")
+    ("pcap.max_file_size", bpo::value<uint32_t>(&pcap_max_file_size)->default_value(0),                                "Maximum capture file size (in megabytes) before rotating to a new file. Default 0 (no rotation)")
+    ("pcap.max_file_duration", bpo::value<uint32_t>(&args->stack.pcap_writer.max_file_duration_s)->default_value(0),   "Maximum capture file duration (in seconds) before rotating to a new file. Default 0 (no rotation)")
+    ("pcap.ring_size",     bpo::value<uint32_t>(&args->stack.pcap_writer.ring_size)->default_value(0),                 "Number of PDUs buffered by each capture writer. Default 0 (per-layer default)")
     ("pcap.mac_net_enable", bpo::value<bool>(&args->stack.mac_pcap_net.enable)->default_value(false),         "Enable MAC network captures")
     ("pcap.bind_ip", bpo::value<string>(&args->stack.mac_pcap_net.bind_ip)->default_value("0.0.0.0"),         "Bind IP address for MAC network trace")
     ("pcap.bind_port", bpo::value<uint16_t>(&args->stack.mac_pcap_net.bind_port)->default_value(5687),        "Bind port for MAC network trace")
@@ -153,7 +162,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("pcap.client_port", bpo::value<uint16_t>(&args->stack.mac_pcap_net.client_port)->default_value(5847),    "Enable MAC network captures")
 
     /* Scheduling section */
-    ("scheduler.policy", bpo::value<string>(&args->stack.mac.sched.sched_policy)->default_value("time_pf"), "DL and UL data scheduling policy (E.g. time_rr, time_pf)")
+    ("scheduler.policy", bpo::value<string>(&args->stack.mac.sched.sched_policy)->default_value("time_pf"), "DL and UL data scheduling policy (E.g. time_rr, time_pf, freq_pf)")
     ("scheduler.policy_args", bpo::value<string>(&args->stack.mac.sched.sched_policy_args)->default_value("2"), "Scheduler policy-specific arguments")
     ("scheduler.pdsch_mcs", bpo::value<int>(&args->stack.mac.sched.pdsch_mcs)->default_value(-1), "Optional fixed PDSCH MCS (ignores reported CQIs if specified)")
     ("scheduler.pdsch_max_mcs", bpo::value<int>(&args->stack.mac.sched.pdsch_max_mcs)->default_value(-1), "Optional PDSCH MCS limit")
@@ -177,6 +186,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.init_dl_cqi", bpo::value<int>(&args->stack.mac.sched.init_dl_cqi)->default_value(5), "DL CQI value used before any CQI report is available to the eNB")
     ("scheduler.max_sib_coderate", bpo::value<float>(&args->stack.mac.sched.max_sib_coderate)->default_value(0.8), "Upper bound on SIB and RAR grants coderate")
     ("scheduler.pdcch_cqi_offset", bpo::value<int>(&args->stack.mac.sched.pdcch_cqi_offset)->default_value(0), "CQI offset in derivation of PDCCH aggregation level")
+    ("scheduler.nof_cc_workers", bpo::value<uint32_t>(&args->stack.mac.sched.nof_cc_workers)->default_value(0), "Number of threads generating in parallel the carriers that have no UEs in common (0 to generate all carriers in the PHY thread)")
 
 
 
@@ -223,6 +233,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.metrics_period_secs", bpo::value<float>(&args->general.metrics_period_secs)->default_value(1.0), "Periodicity for metrics in seconds.")
     ("expert.metrics_csv_enable",  bpo::value<bool>(&args->general.metrics_csv_enable)->default_value(false), "Write metrics to CSV file.")
     ("expert.metrics_csv_filename", bpo::value<string>(&args->general.metrics_csv_filename)->default_value("/tmp/enb_metrics.csv"), "Metrics CSV filename.")
+    ("expert.metrics_kpi_enable",  bpo::value<bool>(&args->general.metrics_kpi_enable)->default_value(false), "Write metrics to a binary columnar KPI stream.")
+    ("expert.metrics_kpi_filename", bpo::value<string>(&args->general.metrics_kpi_filename)->default_value("/tmp/enb_metrics.kpi"), "Metrics KPI stream filename.")
     ("expert.pusch_max_its", bpo::value<uint32_t>(&args->phy.pusch_max_its)->default_value(8), "Maximum number of turbo decoder iterations for LTE.")
     ("expert.pusch_8bit_decoder", bpo::value<bool>(&args->phy.pusch_8bit_decoder)->default_value(false), "Use 8-bit for LLR representation and turbo decoder trellis computation (Experimental).")
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure.")
@@ -241,6 +253,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.tracing_enable",  bpo::value<bool>(&args->general.tracing_enable)->default_value(false), "Events tracing.")
     ("expert.tracing_filename", bpo::value<string>(&args->general.tracing_filename)->default_value("/tmp/enb_tracing.log"), "Tracing events filename.")
     ("expert.tracing_buffcapacity", bpo::value<std::size_t>(&args->general.tracing_buffcapacity)->default_value(1000000), "Tracing buffer capcity.")
+    ("expert.tracing_format", bpo::value<string>(&args->general.tracing_format)->default_value("log"), "Tracing events format: log, chrome or perfetto.")
     ("expert.stdout_ts_enable", bpo::value<bool>(&stdout_ts_enable)->default_value(false), "Prints once per second the timestamp into stdout.")
     ("expert.rrc_inactivity_timer", bpo::value<uint32_t>(&args->general.rrc_inactivity_timer)->default_value(30000), "Inactivity timer in ms.")
     ("expert.print_buffer_state", bpo::value<bool>(&args->general.print_buffer_state)->default_value(false), "Prints on the console the buffer state every 10 seconds.")
@@ -253,6 +266,9 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.gtpu_tunnel_timeout", bpo::value<uint32_t>(&args->stack.gtpu_indirect_tunnel_timeout_msec)->default_value(0), "Maximum time that GTPU takes to release indirect forwarding tunnel since the last received GTPU PDU (0 for infinity).")
     ("expert.rlf_release_timer_ms", bpo::value<uint32_t>(&args->general.rlf_release_timer_ms)->default_value(4000), "Time taken by eNB to release UE context after it detects an RLF.")
     ("expert.extended_cp", bpo::value<bool>(&args->phy.extended_cp)->default_value(false), "Use extended cyclic prefix")
+    ("expert.phy_arena", bpo::value<string>(&args->phy.arena_mode)->default_value("none"), "Memory arena for the PHY worker sample buffers: none, thp, 2M or 1G (hugepages).")
+    ("expert.phy_arena_numa_node", bpo::value<int>(&args->phy.arena_numa_node)->default_value(-1), "NUMA node the PHY worker arenas are bound to (-1 for no binding).")
+    ("expert.perf_counters", bpo::value<bool>(&args->phy.perf_counters)->default_value(false), "Sample hardware performance counters around the PHY and scheduler stages.")
     ("expert.ts1_reloc_prep_timeout", bpo::value<uint32_t>(&args->stack.s1ap.ts1_reloc_prep_timeout)->default_value(10000), "S1AP TS 36.413 TS1RelocPrep Expiry Timeout value in milliseconds.")
     ("expert.ts1_reloc_overall_timeout", bpo::value<uint32_t>(&args->stack.s1ap.ts1_reloc_overall_timeout)->default_value(10000), "S1AP TS 36.413 TS1RelocOverall Expiry Timeout value in milliseconds.")
     ("expert.rlf_min_ul_snr_estim", bpo::value<int>(&args->stack.mac.rlf_min_ul_snr_estim)->default_value(-2), "SNR threshold in dB below which the eNB is notified with rlf ko.")
@@ -266,6 +282,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     // NR section
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
+    ("scheduler.nr_lookahead_slots", bpo::value<uint32_t>(&args->nr_stack.mac.sched_cfg.lookahead_slots)->default_value(0), "Number of NR slots scheduled ahead in a separate thread per carrier (0 to schedule each slot when requested by the PHY).")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
 
     // VNF params
@@ -345,6 +362,17 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     cout << "Error parsing enb.mnc:" << mnc << " - must be a 2 or 3-digit string." << endl;
   }
 
+  // Convert PCAP writer options
+  if (pcap_format == "pcapng") {
+    args->stack.pcap_writer.format = srsran::pcap_format_t::pcapng;
+  } else if (pcap_format == "pcap") {
+    args->stack.pcap_writer.format = srsran::pcap_format_t::pcap;
+  } else {
+    cout << "Error parsing pcap.format:" << pcap_format << " - must be pcap or pcapng." << endl;
+    exit(1);
+  }
+  args->stack.pcap_writer.max_file_size = uint64_t(pcap_max_file_size) * 1024 * 1024;
+
   if (args->stack.embms.enable) {
     if (args->stack.mac.sched.max_nof_ctrl_symbols == 3) {
       fprintf(stderr,
@@ -363,6 +391,16 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     exit(1);
   }
 
+  // The NR scheduler uses the same outer-loop link adaptation parameters as the LTE one
+  args->nr_stack.mac.sched_cfg.target_bler               = args->stack.mac.sched.target_bler;
+  args->nr_stack.mac.sched_cfg.max_delta_dl_cqi          = args->stack.mac.sched.max_delta_dl_cqi;
+  args->nr_stack.mac.sched_cfg.max_delta_ul_snr          = args->stack.mac.sched.max_delta_ul_snr;
+  args->nr_stack.mac.sched_cfg.adaptive_dl_mcs_step_size = args->stack.mac.sched.adaptive_dl_mcs_step_size;
+  args->nr_stack.mac.sched_cfg.adaptive_ul_mcs_step_size = args->stack.mac.sched.adaptive_ul_mcs_step_size;
+  args->nr_stack.mac.sched_cfg.ul_snr_avg_alpha          = args->stack.mac.sched.ul_snr_avg_alpha;
+  args->nr_stack.mac.sched_cfg.init_ul_snr_value         = args->stack.mac.sched.init_ul_snr_value;
+  args->nr_stack.mac.sched_cfg.init_dl_cqi               = args->stack.mac.sched.init_dl_cqi;
+
   // Convert eNB Id
   std::size_t pos = {};
   try {
@@ -454,6 +492,12 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     exit(1);
   }
 
+  srsran_vec_arena_mode_t arena_mode;
+  if (srsran_vec_arena_mode_parse(args->phy.arena_mode.c_str(), &arena_mode) != SRSRAN_SUCCESS) {
+    cout << "Error parsing expert.phy_arena: " << args->phy.arena_mode << " - must be none, thp, 2M or 1G." << endl;
+    exit(1);
+  }
+
   srsran_use_standard_symbol_size(use_standard_lte_rates);
 }
 
@@ -584,10 +628,15 @@ int main(int argc, char* argv[])
   parse_args(&args, argc, argv);
 
   // Setup the default log sink.
-  srslog::set_default_sink(
-      (args.log.filename == "stdout")
-          ? srslog::fetch_stdout_sink()
-          : srslog::fetch_file_sink(args.log.filename, fixup_log_file_maxsize(args.log.file_max_size)));
+  if (args.log.filename == "stdout") {
+    srslog::set_default_sink(srslog::fetch_stdout_sink());
+  } else if (args.log.binary) {
+    srslog::set_default_sink(
+        srslog::fetch_binary_file_sink(args.log.filename, fixup_log_file_maxsize(args.log.file_max_size)));
+  } else {
+    srslog::set_default_sink(
+        srslog::fetch_file_sink(args.log.filename, fixup_log_file_maxsize(args.log.file_max_size)));
+  }
 
   // Alarms log channel creation.
   srslog::sink&        alarm_sink     = srslog::fetch_file_sink(args.general.alarms_filename, 0, true);
@@ -596,7 +645,19 @@ int main(int argc, char* argv[])
 
 #ifdef ENABLE_SRSLOG_EVENT_TRACE
   if (args.general.tracing_enable) {
-    if (!srslog::event_trace_init(args.general.tracing_filename, args.general.tracing_buffcapacity)) {
+    bool tracing_ok = false;
+    if (args.general.tracing_format == "log") {
+      tracing_ok = srslog::event_trace_init(args.general.tracing_filename, args.general.tracing_buffcapacity);
+    } else if (args.general.tracing_format == "chrome") {
+      tracing_ok = srslog::event_trace_init_ring(
+          args.general.tracing_filename, srslog::event_trace_format::chrome_json, args.general.tracing_buffcapacity);
+    } else if (args.general.tracing_format == "perfetto") {
+      tracing_ok = srslog::event_trace_init_ring(
+          args.general.tracing_filename, srslog::event_trace_format::perfetto, args.general.tracing_buffcapacity);
+    } else {
+      cout << "Invalid tracing format " << args.general.tracing_format << ". Valid values: log, chrome, perfetto" << endl;
+    }
+    if (!tracing_ok) {
       return SRSRAN_ERROR;
     }
   }
@@ -647,6 +708,12 @@ int main(int argc, char* argv[])
     metrics_file.set_handle(enb.get());
   }
 
+  std::unique_ptr<srsenb::metrics_kpi_stream> kpi_metrics;
+  if (args.general.metrics_kpi_enable) {
+    kpi_metrics.reset(new srsenb::metrics_kpi_stream(args.general.metrics_kpi_filename));
+    metricshub.add_listener(kpi_metrics.get());
+  }
+
   srsenb::metrics_json json_metrics(json_channel, enb.get());
   if (args.general.report_json_enable) {
     metricshub.add_listener(&json_metrics);
@@ -78,16 +78,51 @@ DECLARE_METRIC_SET("ue_container",
 DECLARE_METRIC("carrier_id", metric_carrier_id, uint32_t, "");
 DECLARE_METRIC("pci", metric_pci, uint32_t, "");
 DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
+DECLARE_METRIC("pdcch_alloc_time", metric_pdcch_alloc_time, float, "us");
+DECLARE_METRIC("pdcch_blocking_rate", metric_pdcch_blocking_rate, float, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
-DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
+DECLARE_METRIC_SET("cell_container",
+                   mset_cell_container,
+                   metric_carrier_id,
+                   metric_pci,
+                   metric_nof_rach,
+                   metric_pdcch_alloc_time,
+                   metric_pdcch_blocking_rate,
+                   mlist_ues);
+
+/// TTI processing stage container metrics.
+DECLARE_METRIC("stage", metric_stage, std::string, "");
+DECLARE_METRIC("count", metric_stage_count, uint64_t, "");
+DECLARE_METRIC("p50", metric_stage_p50, float, "us");
+DECLARE_METRIC("p99", metric_stage_p99, float, "us");
+DECLARE_METRIC("max", metric_stage_max, float, "us");
+DECLARE_METRIC("deadline", metric_stage_deadline, float, "us");
+DECLARE_METRIC("deadline_misses", metric_stage_deadline_misses, uint64_t, "");
+DECLARE_METRIC("ipc", metric_stage_ipc, float, "");
+DECLARE_METRIC("llc_mpki", metric_stage_llc_mpki, float, "");
+DECLARE_METRIC("branch_mpki", metric_stage_branch_mpki, float, "");
+DECLARE_METRIC_SET("tti_stage_container",
+                   mset_tti_stage_container,
+                   metric_stage,
+                   metric_stage_count,
+                   metric_stage_p50,
+                   metric_stage_p99,
+                   metric_stage_max,
+                   metric_stage_deadline,
+                   metric_stage_deadline_misses,
+                   metric_stage_ipc,
+                   metric_stage_llc_mpki,
+                   metric_stage_branch_mpki);
 
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
+DECLARE_METRIC_LIST("tti_stage_list", mlist_tti_stage, std::vector<mset_tti_stage_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t =
+    srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell, mlist_tti_stage>;
 
 } // namespace
 
@@ -192,6 +227,8 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     cell.write<metric_carrier_id>(cc_idx);
     cell.write<metric_nof_rach>(m.stack.mac.cc_info[cc_idx].cc_rach_counter);
     cell.write<metric_pci>(m.stack.mac.cc_info[cc_idx].pci);
+    cell.write<metric_pdcch_alloc_time>(m.stack.mac.cc_info[cc_idx].pdcch_alloc_time_us);
+    cell.write<metric_pdcch_blocking_rate>(m.stack.mac.cc_info[cc_idx].pdcch_blocking_rate);
 
     // For each UE in this cell...
     for (unsigned i = 0; i != m.stack.rrc.ues.size(); ++i) {
@@ -208,6 +245,25 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  // For each TTI processing stage...
+  auto& stage_list = ctx.get<mlist_tti_stage>();
+  for (const auto& stage_metrics : m.tti_stages) {
+    stage_list.emplace_back();
+    auto& stage = stage_list.back();
+    stage.write<metric_stage>(stage_metrics.name);
+    stage.write<metric_stage_count>(stage_metrics.count);
+    stage.write<metric_stage_p50>(stage_metrics.p50_us);
+    stage.write<metric_stage_p99>(stage_metrics.p99_us);
+    stage.write<metric_stage_max>(stage_metrics.max_us);
+    stage.write<metric_stage_deadline>(stage_metrics.deadline_us);
+    stage.write<metric_stage_deadline_misses>(stage_metrics.nof_deadline_misses);
+    if (stage_metrics.nof_perf_samples > 0) {
+      stage.write<metric_stage_ipc>(stage_metrics.ipc);
+      stage.write<metric_stage_llc_mpki>(stage_metrics.llc_mpki);
+      stage.write<metric_stage_branch_mpki>(stage_metrics.branch_mpki);
+    }
+  }
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
@@ -0,0 +1,247 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/metrics_kpi_stream.h"
+#include <iostream>
+
+namespace srsenb {
+
+using namespace srsran::kpi_stream;
+
+namespace {
+
+/// Column indexes of each group, in the order of the schemas below
+enum cell_column { cell_nof_rach, cell_pdcch_alloc_time_us, cell_pdcch_blocking_rate, cell_nof_columns };
+enum ue_column {
+  ue_cc_idx,
+  ue_nof_tti,
+  ue_dl_cqi,
+  ue_dl_ri,
+  ue_dl_mcs,
+  ue_dl_pkts,
+  ue_dl_errors,
+  ue_dl_bits,
+  ue_dl_buffer,
+  ue_ul_mcs,
+  ue_ul_pusch_sinr,
+  ue_ul_pucch_sinr,
+  ue_ul_rssi,
+  ue_ul_turbo_iters,
+  ue_ul_pkts,
+  ue_ul_errors,
+  ue_ul_bits,
+  ue_ul_buffer,
+  ue_ul_phr,
+  ue_pdcp_dl_acked_bytes,
+  ue_pdcp_ul_bytes,
+  ue_nof_columns
+};
+enum tti_stage_column {
+  stage_count,
+  stage_p50_us,
+  stage_p99_us,
+  stage_max_us,
+  stage_deadline_misses,
+  stage_ipc,
+  stage_llc_mpki,
+  stage_branch_mpki,
+  stage_nof_columns
+};
+enum sys_column { sys_proc_rmem_kB, sys_proc_cpu_usage, sys_mem, sys_thread_count, sys_nof_columns };
+
+const static column_kind_t counter = column_kind_t::counter;
+const static column_kind_t gauge   = column_kind_t::gauge;
+
+uint64_t get_timestamp_us()
+{
+  auto tp = std::chrono::system_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::microseconds>(tp).count();
+}
+
+} // namespace
+
+metrics_kpi_stream::metrics_kpi_stream(const std::string& filename) : last_flush(std::chrono::steady_clock::now())
+{
+  if (not writer.open(filename)) {
+    std::cout << "Error, couldn't open KPI stream file " << filename << std::endl;
+    return;
+  }
+  group_schema_t cell;
+  cell.name     = "cell";
+  cell.key_name = "cc_idx";
+  cell.columns  = {{"nof_rach", counter}, {"pdcch_alloc_time_us", gauge}, {"pdcch_blocking_rate", gauge}};
+  cell_group = writer.add_group(cell);
+
+  group_schema_t ue;
+  ue.name     = "ue";
+  ue.key_name = "rnti";
+  ue.columns  = {{"cc_idx", counter},
+                 {"nof_tti", counter},
+                 {"dl_cqi", gauge},
+                 {"dl_ri", gauge},
+                 {"dl_mcs", gauge},
+                 {"dl_pkts", counter},
+                 {"dl_errors", counter},
+                 {"dl_bits", counter},
+                 {"dl_buffer", counter},
+                 {"ul_mcs", gauge},
+                 {"ul_pusch_sinr", gauge},
+                 {"ul_pucch_sinr", gauge},
+                 {"ul_rssi", gauge},
+                 {"ul_turbo_iters", gauge},
+                 {"ul_pkts", counter},
+                 {"ul_errors", counter},
+                 {"ul_bits", counter},
+                 {"ul_buffer", counter},
+                 {"ul_phr", gauge},
+                 {"pdcp_dl_acked_bytes", counter},
+                 {"pdcp_ul_bytes", counter}};
+  ue_group = writer.add_group(ue);
+
+  // The rows are keyed by the index of the stage in enb_metrics_t::tti_stages
+  group_schema_t tti_stage;
+  tti_stage.name     = "tti_stage";
+  tti_stage.key_name = "stage";
+  tti_stage.columns  = {{"count", counter},
+                        {"p50_us", gauge},
+                        {"p99_us", gauge},
+                        {"max_us", gauge},
+                        {"deadline_misses", counter},
+                        {"ipc", gauge},
+                        {"llc_mpki", gauge},
+                        {"branch_mpki", gauge}};
+  tti_stage_group = writer.add_group(tti_stage);
+
+  group_schema_t sys;
+  sys.name     = "sys";
+  sys.key_name = "id";
+  sys.columns  = {{"proc_rmem_kB", counter}, {"proc_cpu_usage", gauge}, {"sys_mem", gauge}, {"thread_count", counter}};
+  sys_group = writer.add_group(sys);
+}
+
+void metrics_kpi_stream::stop()
+{
+  writer.close();
+}
+
+void metrics_kpi_stream::set_metrics(const enb_metrics_t& m, const uint32_t period_usec)
+{
+  if (not writer.is_open() or not m.running) {
+    return;
+  }
+  uint64_t ts = get_timestamp_us();
+  write_cells(m, ts);
+  write_ues(m, ts);
+  write_tti_stages(m, ts);
+  write_sys(m, ts);
+
+  // Bound the delay of the live readers of the file, without a system call per report
+  auto now = std::chrono::steady_clock::now();
+  if (now - last_flush >= std::chrono::seconds(1)) {
+    writer.flush();
+    last_flush = now;
+  }
+}
+
+void metrics_kpi_stream::write_cells(const enb_metrics_t& m, uint64_t ts)
+{
+  writer.begin_block(cell_group, ts);
+  for (uint32_t cc_idx = 0; cc_idx < m.stack.mac.cc_info.size(); ++cc_idx) {
+    const mac_cc_info_t& cc = m.stack.mac.cc_info[cc_idx];
+    writer.add_row(cc_idx);
+    writer.set_counter(cell_nof_rach, cc.cc_rach_counter);
+    writer.set_gauge(cell_pdcch_alloc_time_us, cc.pdcch_alloc_time_us);
+    writer.set_gauge(cell_pdcch_blocking_rate, cc.pdcch_blocking_rate);
+  }
+  writer.end_block();
+}
+
+void metrics_kpi_stream::write_ues(const enb_metrics_t& m, uint64_t ts)
+{
+  writer.begin_block(ue_group, ts);
+  for (uint32_t i = 0; i < m.stack.mac.ues.size(); ++i) {
+    const mac_ue_metrics_t& mac = m.stack.mac.ues[i];
+    writer.add_row(mac.rnti);
+    writer.set_counter(ue_cc_idx, mac.cc_idx);
+    writer.set_counter(ue_nof_tti, mac.nof_tti);
+    writer.set_gauge(ue_dl_cqi, mac.dl_cqi);
+    writer.set_gauge(ue_dl_ri, mac.dl_ri);
+    writer.set_counter(ue_dl_pkts, mac.tx_pkts);
+    writer.set_counter(ue_dl_errors, mac.tx_errors);
+    writer.set_counter(ue_dl_bits, mac.tx_brate);
+    writer.set_counter(ue_dl_buffer, mac.dl_buffer);
+    writer.set_counter(ue_ul_pkts, mac.rx_pkts);
+    writer.set_counter(ue_ul_errors, mac.rx_errors);
+    writer.set_counter(ue_ul_bits, mac.rx_brate);
+    writer.set_counter(ue_ul_buffer, mac.ul_buffer);
+    writer.set_gauge(ue_ul_phr, mac.phr);
+    if (i < m.phy.size()) {
+      const phy_metrics_t& phy = m.phy[i];
+      writer.set_gauge(ue_dl_mcs, phy.dl.mcs);
+      writer.set_gauge(ue_ul_mcs, phy.ul.mcs);
+      writer.set_gauge(ue_ul_pusch_sinr, phy.ul.pusch_sinr);
+      writer.set_gauge(ue_ul_pucch_sinr, phy.ul.pucch_sinr);
+      writer.set_gauge(ue_ul_rssi, phy.ul.rssi);
+      writer.set_gauge(ue_ul_turbo_iters, phy.ul.turbo_iters);
+    }
+    if (i < m.stack.pdcp.ues.size()) {
+      uint64_t dl_bytes = 0, ul_bytes = 0;
+      for (const auto& bearer : m.stack.pdcp.ues[i].bearer) {
+        dl_bytes += bearer.num_tx_acked_bytes;
+        ul_bytes += bearer.num_rx_pdu_bytes;
+      }
+      writer.set_counter(ue_pdcp_dl_acked_bytes, dl_bytes);
+      writer.set_counter(ue_pdcp_ul_bytes, ul_bytes);
+    }
+  }
+  writer.end_block();
+}
+
+void metrics_kpi_stream::write_tti_stages(const enb_metrics_t& m, uint64_t ts)
+{
+  writer.begin_block(tti_stage_group, ts);
+  for (uint32_t i = 0; i < m.tti_stages.size(); ++i) {
+    const tti_stage_metrics_t& stage = m.tti_stages[i];
+    writer.add_row(i);
+    writer.set_counter(stage_count, stage.count);
+    writer.set_gauge(stage_p50_us, stage.p50_us);
+    writer.set_gauge(stage_p99_us, stage.p99_us);
+    writer.set_gauge(stage_max_us, stage.max_us);
+    writer.set_counter(stage_deadline_misses, stage.nof_deadline_misses);
+    writer.set_gauge(stage_ipc, stage.ipc);
+    writer.set_gauge(stage_llc_mpki, stage.llc_mpki);
+    writer.set_gauge(stage_branch_mpki, stage.branch_mpki);
+  }
+  writer.end_block();
+}
+
+void metrics_kpi_stream::write_sys(const enb_metrics_t& m, uint64_t ts)
+{
+  writer.begin_block(sys_group, ts);
+  writer.add_row(0);
+  writer.set_counter(sys_proc_rmem_kB, m.sys.process_realmem_kB);
+  writer.set_gauge(sys_proc_cpu_usage, m.sys.process_cpu_usage);
+  writer.set_gauge(sys_mem, m.sys.system_mem);
+  writer.set_counter(sys_thread_count, m.sys.thread_count);
+  writer.end_block();
+}
+
+} // namespace srsenb
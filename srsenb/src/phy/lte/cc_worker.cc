@@ -65,7 +65,7 @@ cc_worker::~cc_worker()
   srsran_enb_dl_free(&enb_dl);
   srsran_enb_ul_free(&enb_ul);
 
-  for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
+  for (int p = 0; p < SRSRAN_MAX_PORTS && not signal_buffers_in_arena; p++) {
     if (signal_buffer_rx[p]) {
       free(signal_buffer_rx[p]);
     }
@@ -84,7 +84,13 @@ cc_worker::~cc_worker()
 FILE* f;
 #endif
 
-void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
+size_t cc_worker::get_arena_size(phy_common* phy, uint32_t cc_idx)
+{
+  uint32_t sf_len = SRSRAN_SF_LEN_PRB(phy->get_nof_prb(cc_idx));
+  return 2 * phy->get_nof_ports(cc_idx) * srsran_vec_arena_alloc_size(2 * sf_len * sizeof(cf_t));
+}
+
+void cc_worker::init(phy_common* phy_, uint32_t cc_idx_, srsran_vec_arena_t* arena)
 {
   phy                   = phy_;
   cc_idx                = cc_idx_;
@@ -93,14 +99,17 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
   uint32_t      sf_len  = SRSRAN_SF_LEN_PRB(nof_prb);
 
   // Init cell here
+  signal_buffers_in_arena = srsran_vec_arena_is_active(arena);
   for (uint32_t p = 0; p < phy->get_nof_ports(cc_idx); p++) {
-    signal_buffer_rx[p] = srsran_vec_cf_malloc(2 * sf_len);
+    signal_buffer_rx[p] =
+        signal_buffers_in_arena ? srsran_vec_arena_cf_alloc(arena, 2 * sf_len) : srsran_vec_cf_malloc(2 * sf_len);
     if (!signal_buffer_rx[p]) {
       ERROR("Error allocating memory");
       return;
     }
     srsran_vec_cf_zero(signal_buffer_rx[p], 2 * sf_len);
-    signal_buffer_tx[p] = srsran_vec_cf_malloc(2 * sf_len);
+    signal_buffer_tx[p] =
+        signal_buffers_in_arena ? srsran_vec_arena_cf_alloc(arena, 2 * sf_len) : srsran_vec_cf_malloc(2 * sf_len);
     if (!signal_buffer_tx[p]) {
       ERROR("Error allocating memory");
       return;
@@ -185,7 +194,7 @@ int cc_worker::add_rnti(uint16_t rnti)
 
   // Create user unless already exists
   if (ue_db.count(rnti) == 0) {
-    ue_db[rnti] = new ue(rnti);
+    ue_db[rnti] = new ue(rnti, next_ue_id++);
   }
   return SRSRAN_SUCCESS;
 }
@@ -212,7 +221,12 @@ void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy
   logger.set_context(ul_sf.tti);
 
   // Process UL signal
-  srsran_enb_ul_fft(&enb_ul);
+  {
+    tti_profiler::scoped_measure meas(phy->tti_prof, tti_stage_t::ul_fft);
+    srsran_enb_ul_fft(&enb_ul);
+  }
+
+  tti_profiler::scoped_measure meas(phy->tti_prof, tti_stage_t::ul_decode);
 
   // Decode pending UL grants for the tti they were scheduled
   decode_pusch(ul_grants.pusch, ul_grants.nof_grants);
@@ -235,6 +249,7 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   // Put DL grants to resource grid. PDSCH data will be encoded as well.
   if (dl_sf_cfg.sf_type == SRSRAN_SF_NORM) {
     encode_pdcch_dl(dl_grants.pdsch, dl_grants.nof_grants);
+    tti_profiler::scoped_measure meas(phy->tti_prof, tti_stage_t::dl_encode);
     encode_pdsch(dl_grants.pdsch, dl_grants.nof_grants);
   } else {
     if (mbsfn_cfg->enable) {
@@ -251,6 +266,9 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   // Generate signal and transmit
   srsran_enb_dl_gen_signal(&enb_dl);
 
+  // The metrics of this TTI are complete
+  publish_metrics();
+
   // Scale if cell gain is set
   float cell_gain_db = phy->get_cell_gain(cc_idx);
   if (std::isnormal(cell_gain_db)) {
@@ -624,47 +642,44 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
 }
 
 /************ METRICS interface ********************/
-uint32_t cc_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
+void cc_worker::publish_metrics()
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  uint32_t                    cnt = 0;
-  metrics.resize(ue_db.size());
+  std::vector<ue_metrics_sums_t>& snapshot = metrics_snapshot.write_buffer();
+  snapshot.clear();
   for (auto& ue : ue_db) {
     if ((SRSRAN_RNTI_ISUSER(ue.first) || ue.first == SRSRAN_MRNTI)) {
-      ue.second->metrics_read(&metrics[cnt++]);
+      snapshot.push_back(ue.second->get_metrics());
     }
   }
-  metrics.resize(cnt);
-  return cnt;
+  metrics_snapshot.publish();
 }
 
-void cc_worker::ue::metrics_read(phy_metrics_t* metrics_)
+uint32_t cc_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
 {
-  if (metrics_) {
-    *metrics_ = metrics;
-  }
-  bzero(&metrics, sizeof(phy_metrics_t));
+  // Keeps the previous snapshot if no TTI was processed since the last call
+  metrics_snapshot.fetch();
+  return metrics_reader.read(metrics_snapshot.read_buffer(), metrics);
 }
 
 void cc_worker::ue::metrics_dl(uint32_t mcs)
 {
-  metrics.dl.mcs = SRSRAN_VEC_CMA(mcs, metrics.dl.mcs, metrics.dl.n_samples);
-  metrics.dl.n_samples++;
+  metrics.dl_mcs += mcs;
+  metrics.dl_n_samples++;
 }
 
 void cc_worker::ue::metrics_ul(uint32_t mcs, float rssi, float sinr, float turbo_iters)
 {
-  metrics.ul.mcs         = SRSRAN_VEC_CMA((float)mcs, metrics.ul.mcs, metrics.ul.n_samples);
-  metrics.ul.pusch_sinr  = SRSRAN_VEC_CMA((float)sinr, metrics.ul.pusch_sinr, metrics.ul.n_samples);
-  metrics.ul.rssi        = SRSRAN_VEC_CMA((float)rssi, metrics.ul.rssi, metrics.ul.n_samples);
-  metrics.ul.turbo_iters = SRSRAN_VEC_CMA((float)turbo_iters, metrics.ul.turbo_iters, metrics.ul.n_samples);
-  metrics.ul.n_samples++;
+  metrics.ul_mcs += mcs;
+  metrics.ul_pusch_sinr += sinr;
+  metrics.ul_rssi += rssi;
+  metrics.ul_turbo_iters += turbo_iters;
+  metrics.ul_n_samples++;
 }
 
 void cc_worker::ue::metrics_ul_pucch(float sinr)
 {
-  metrics.ul.pucch_sinr = SRSRAN_VEC_CMA((float)sinr, metrics.ul.pucch_sinr, metrics.ul.n_samples_pucch);
-  metrics.ul.n_samples_pucch++;
+  metrics.ul_pucch_sinr += sinr;
+  metrics.ul_n_samples_pucch++;
 }
 
 int cc_worker::read_ce_abs(float* ce_abs)
@@ -20,9 +20,11 @@
  */
 
 #include "srsran/common/threads.h"
+#include "srsran/srslog/event_trace.h"
 #include "srsran/srsran.h"
 
 #include "srsenb/hdr/phy/lte/sf_worker.h"
+#include <algorithm>
 
 #define Error(fmt, ...)                                                                                                \
   if (SRSRAN_DEBUG_ENABLED)                                                                                            \
@@ -76,13 +78,32 @@ void sf_worker::init(phy_common* phy_)
 {
   phy = phy_;
 
+  // Reserve a single arena for the sample buffers of all the carriers, if enabled
+  srsran_vec_arena_mode_t arena_mode = SRSRAN_VEC_ARENA_DISABLED;
+  srsran_vec_arena_mode_parse(phy->params.arena_mode.c_str(), &arena_mode);
+  if (arena_mode != SRSRAN_VEC_ARENA_DISABLED) {
+    size_t arena_size = 0;
+    for (uint32_t i = 0; i < phy->get_nof_carriers_lte(); i++) {
+      arena_size += cc_worker::get_arena_size(phy, i);
+    }
+    if (srsran_vec_arena_init(&arena, arena_size, arena_mode, phy->params.arena_numa_node) == SRSRAN_SUCCESS) {
+      Info("Worker %d buffers allocated in %zd bytes arena of %s pages (NUMA node %d)",
+           get_id(),
+           arena.size,
+           srsran_vec_arena_mode_string(arena.mode),
+           arena.numa_node);
+    } else {
+      logger.warning("Worker %d could not reserve buffer arena, using regular allocations", get_id());
+    }
+  }
+
   // Initialise each component carrier workers
   for (uint32_t i = 0; i < phy->get_nof_carriers_lte(); i++) {
     // Create pointer
     auto q = new cc_worker(logger);
 
     // Initialise
-    q->init(phy, i);
+    q->init(phy, i, &arena);
 
     // Create unique pointer
     cc_workers.push_back(std::unique_ptr<cc_worker>(q));
@@ -150,6 +171,7 @@ uint32_t sf_worker::get_nof_rnti()
 void sf_worker::work_imp()
 {
   std::lock_guard<std::mutex> lock(work_mutex);
+  trace_complete_event("sf_worker", "work_imp");
 
   srsran_ul_sf_cfg_t ul_sf = {};
   srsran_dl_sf_cfg_t dl_sf = {};
@@ -193,29 +215,32 @@ void sf_worker::work_imp()
     cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
   }
 
-  // Get DL scheduling for the TX TTI from MAC
-  if (sf_type == SRSRAN_SF_NORM) {
-    if (stack->get_dl_sched(tti_tx_dl, dl_grants) < 0) {
-      Error("Getting DL scheduling from MAC");
-      phy->worker_end(context, true, tx_buffer);
-      return;
+  // Get DL and UL scheduling for the TX TTI from MAC
+  {
+    tti_profiler::scoped_measure meas(phy->tti_prof, tti_stage_t::mac_sched);
+    if (sf_type == SRSRAN_SF_NORM) {
+      if (stack->get_dl_sched(tti_tx_dl, dl_grants) < 0) {
+        Error("Getting DL scheduling from MAC");
+        phy->worker_end(context, true, tx_buffer);
+        return;
+      }
+    } else {
+      dl_grants[0].cfi = mbsfn_cfg.non_mbsfn_region_length;
+      if (stack->get_mch_sched(tti_tx_dl, mbsfn_cfg.is_mcch, dl_grants)) {
+        Error("Getting MCH packets from MAC");
+        phy->worker_end(context, true, tx_buffer);
+        return;
+      }
     }
-  } else {
-    dl_grants[0].cfi = mbsfn_cfg.non_mbsfn_region_length;
-    if (stack->get_mch_sched(tti_tx_dl, mbsfn_cfg.is_mcch, dl_grants)) {
-      Error("Getting MCH packets from MAC");
+
+    // Get UL scheduling for the TX TTI from MAC
+    if (stack->get_ul_sched(tti_tx_ul, ul_grants_tx) < 0) {
+      Error("Getting UL scheduling from MAC");
       phy->worker_end(context, true, tx_buffer);
       return;
     }
   }
 
-  // Get UL scheduling for the TX TTI from MAC
-  if (stack->get_ul_sched(tti_tx_ul, ul_grants_tx) < 0) {
-    Error("Getting UL scheduling from MAC");
-    phy->worker_end(context, true, tx_buffer);
-    return;
-  }
-
   // Configure DL subframe
   dl_sf.tti              = tti_tx_dl;
   dl_sf.sf_type          = sf_type;
@@ -269,14 +294,20 @@ void sf_worker::work_imp()
 /************ METRICS interface ********************/
 uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
 {
-  uint32_t                   cnt = 0;
   std::vector<phy_metrics_t> metrics_;
+  metrics.clear();
   for (uint32_t cc = 0; cc < phy->get_nof_carriers_lte(); cc++) {
-    cnt = cc_workers[cc]->get_metrics(metrics_);
-    metrics.resize(std::max(metrics_.size(), metrics.size()));
-    for (uint32_t r = 0; r < cnt; r++) {
-      phy_metrics_t* m  = &metrics[r];
-      phy_metrics_t* m_ = &metrics_[r];
+    cc_workers[cc]->get_metrics(metrics_);
+    // The carriers do not hold the same UEs, so the rows are matched by RNTI
+    for (const phy_metrics_t& row : metrics_) {
+      auto it = std::find_if(
+          metrics.begin(), metrics.end(), [&row](const phy_metrics_t& m) { return m.rnti == row.rnti; });
+      if (it == metrics.end()) {
+        metrics.push_back(row);
+        continue;
+      }
+      phy_metrics_t*       m  = &(*it);
+      const phy_metrics_t* m_ = &row;
       m->dl.mcs         = SRSRAN_VEC_PMA(m->dl.mcs, m->dl.n_samples, m_->dl.mcs, m_->dl.n_samples);
       m->dl.n_samples += m_->dl.n_samples;
       m->ul.n          = SRSRAN_VEC_PMA(m->ul.n, m->ul.n_samples, m_->ul.n, m_->ul.n_samples);
@@ -290,7 +321,7 @@ uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
       m->ul.n_samples_pucch += m_->ul.n_samples_pucch;
     }
   }
-  return cnt;
+  return metrics.size();
 }
 
 void sf_worker::start_plot()
@@ -339,6 +370,10 @@ int sf_worker::read_pucch_d(uint32_t cc_idx, cf_t* pdsch_d)
 sf_worker::~sf_worker()
 {
   srsran_softbuffer_tx_free(&temp_mbsfn_softbuffer);
+
+  // The carrier workers buffers may live in the arena, so they must be destroyed first
+  cc_workers.clear();
+  srsran_vec_arena_free(&arena);
 }
 
 } // namespace lte
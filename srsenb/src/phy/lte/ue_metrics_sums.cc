@@ -0,0 +1,66 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/phy/lte/ue_metrics_sums.h"
+
+namespace srsenb {
+namespace lte {
+
+uint32_t ue_metrics_reader::read(const std::vector<ue_metrics_sums_t>& snapshot, std::vector<phy_metrics_t>& metrics)
+{
+  std::map<uint16_t, ue_metrics_sums_t> cur_read;
+  metrics.resize(snapshot.size());
+  for (uint32_t i = 0; i < snapshot.size(); i++) {
+    const ue_metrics_sums_t& cur  = snapshot[i];
+    ue_metrics_sums_t        prev = {};
+    auto                     it   = last_read.find(cur.rnti);
+    // A UE removed and added again restarts its sums
+    if (it != last_read.end() and it->second.ue_id == cur.ue_id) {
+      prev = it->second;
+    }
+    cur_read[cur.rnti] = cur;
+
+    phy_metrics_t& m = metrics[i];
+    m                = {};
+    m.rnti           = cur.rnti;
+    m.dl.n_samples   = cur.dl_n_samples - prev.dl_n_samples;
+    if (m.dl.n_samples > 0) {
+      m.dl.mcs = (cur.dl_mcs - prev.dl_mcs) / m.dl.n_samples;
+    }
+    m.ul.n_samples = cur.ul_n_samples - prev.ul_n_samples;
+    if (m.ul.n_samples > 0) {
+      m.ul.mcs         = (cur.ul_mcs - prev.ul_mcs) / m.ul.n_samples;
+      m.ul.pusch_sinr  = (cur.ul_pusch_sinr - prev.ul_pusch_sinr) / m.ul.n_samples;
+      m.ul.rssi        = (cur.ul_rssi - prev.ul_rssi) / m.ul.n_samples;
+      m.ul.turbo_iters = (cur.ul_turbo_iters - prev.ul_turbo_iters) / m.ul.n_samples;
+    }
+    m.ul.n_samples_pucch = cur.ul_n_samples_pucch - prev.ul_n_samples_pucch;
+    if (m.ul.n_samples_pucch > 0) {
+      m.ul.pucch_sinr = (cur.ul_pucch_sinr - prev.ul_pucch_sinr) / m.ul.n_samples_pucch;
+    }
+  }
+  last_read.swap(cur_read);
+  return snapshot.size();
+}
+
+} // namespace lte
+} // namespace srsenb
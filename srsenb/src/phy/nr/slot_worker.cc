@@ -22,6 +22,7 @@
 #include "srsenb/hdr/phy/nr/slot_worker.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
+#include "srsran/srslog/event_trace.h"
 
 namespace srsenb {
 namespace nr {
@@ -44,6 +45,7 @@ bool slot_worker::init(const args_t& args)
   // Copy common configurations
   cell_index = args.cell_index;
   rf_port    = args.rf_port;
+  tti_prof   = args.tti_prof;
 
   // Allocate Tx buffers
   tx_buffer.resize(args.nof_tx_ports);
@@ -151,11 +153,17 @@ void slot_worker::set_context(const srsran::phy_common_interface::worker_context
 
 bool slot_worker::work_ul()
 {
-  stack_interface_phy_nr::ul_sched_t ul_sched = {};
-  if (stack.get_ul_sched(ul_slot_cfg, ul_sched) < SRSRAN_SUCCESS) {
+  stack_interface_phy_nr::ul_sched_t ul_sched      = {};
+  bool                               ul_sched_fail = false;
+  {
+    tti_profiler::scoped_measure meas(tti_prof, tti_stage_t::nr_ul_sched);
+    ul_sched_fail = stack.get_ul_sched(ul_slot_cfg, ul_sched) < SRSRAN_SUCCESS;
+  }
+  if (ul_sched_fail) {
     logger.error("Error retrieving UL scheduling");
     return false;
   }
+  tti_profiler::scoped_measure meas(tti_prof, tti_stage_t::nr_ul);
 
   if (ul_sched.pucch.empty() && ul_sched.pusch.empty()) {
     // early exit if nothing has been scheduled
@@ -275,7 +283,11 @@ bool slot_worker::work_dl()
 
   // Retrieve Scheduling for the current processing DL slot
   stack_interface_phy_nr::dl_sched_t dl_sched      = {};
-  bool                               dl_sched_fail = stack.get_dl_sched(dl_slot_cfg, dl_sched) < SRSRAN_SUCCESS;
+  bool                               dl_sched_fail = false;
+  {
+    tti_profiler::scoped_measure meas(tti_prof, tti_stage_t::nr_dl_sched);
+    dl_sched_fail = stack.get_dl_sched(dl_slot_cfg, dl_sched) < SRSRAN_SUCCESS;
+  }
 
   // Releases synchronization lock and allow next worker to retrieve scheduling results
   sync.release();
@@ -285,6 +297,7 @@ bool slot_worker::work_dl()
     logger.error("Error retrieving DL scheduling");
     return false;
   }
+  tti_profiler::scoped_measure meas(tti_prof, tti_stage_t::nr_dl);
 
   if (srsran_gnb_dl_base_zero(&gnb_dl) < SRSRAN_SUCCESS) {
     logger.error("Error zeroeing RE grid");
@@ -390,6 +403,8 @@ bool slot_worker::work_dl()
 
 void slot_worker::work_imp()
 {
+  trace_complete_event("slot_worker", "work_imp");
+
   // Inform Scheduler about new slot
   stack.slot_indication(dl_slot_cfg);
 
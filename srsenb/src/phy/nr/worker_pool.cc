@@ -73,6 +73,7 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.srate_hz                = srate_hz;
     w_args.pusch_max_its           = args.pusch_max_its;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
+    w_args.tti_prof                = args.tti_prof;
 
     if (not w->init(w_args)) {
       return false;
@@ -88,7 +89,8 @@ void worker_pool::start_worker(slot_worker* w)
   slot_sync.push(w);
 
   // Feed PRACH detection before start processing
-  prach.new_tti(0, current_tti, w->get_buffer_rx(0));
+  cf_t* prach_buffer[SRSRAN_MAX_PORTS] = {w->get_buffer_rx(0)};
+  prach.new_tti(0, current_tti, prach_buffer);
 
   // Start actual worker
   pool.start_worker(w);
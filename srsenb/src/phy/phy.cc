@@ -21,6 +21,7 @@
 
 #include "srsenb/hdr/phy/phy.h"
 #include "srsran/common/band_helper.h"
+#include "srsran/common/perf_counters.h"
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/threads.h"
 #include <pthread.h>
@@ -171,6 +172,11 @@ int phy::init_lte(const phy_args_t&            args,
   radio       = radio_;
   nof_workers = args.nof_phy_threads;
 
+  if (args.perf_counters and not srsran::perf_counters_enable()) {
+    phy_log.warning("Hardware performance counters are not available. Check that srsRAN is built with "
+                    "ENABLE_PERF_COUNTERS and that kernel.perf_event_paranoid allows user-space counting");
+  }
+
   workers_common.params = args;
 
   workers_common.init(cfg.phy_cell_cfg, cfg.phy_cell_cfg_nr, radio, stack_lte_);
@@ -191,7 +197,8 @@ int phy::init_lte(const phy_args_t&            args,
                stack_lte_,
                phy_log,
                PRACH_WORKER_THREAD_PRIO,
-               args.nof_prach_threads);
+               args.nof_prach_threads,
+               cfg.phy_cell_cfg[cc].cell.nof_ports);
   }
   prach.set_max_prach_offset_us(args.max_prach_offset_us);
 
@@ -247,21 +254,30 @@ void phy::set_activation_deactivation_scell(uint16_t rnti, const std::array<bool
 void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
 {
   std::vector<phy_metrics_t> metrics_tmp;
+  metrics.clear();
   for (uint32_t i = 0; i < nof_workers; i++) {
     lte_workers[i]->get_metrics(metrics_tmp);
-    metrics.resize(std::max(metrics_tmp.size(), metrics.size()));
-    for (uint32_t j = 0; j < metrics_tmp.size(); j++) {
-      metrics[j].dl.n_samples += metrics_tmp[j].dl.n_samples;
-      metrics[j].dl.mcs += metrics_tmp[j].dl.n_samples * metrics_tmp[j].dl.mcs;
-
-      metrics[j].ul.n_samples += metrics_tmp[j].ul.n_samples;
-      metrics[j].ul.n_samples_pucch += metrics_tmp[j].ul.n_samples_pucch;
-      metrics[j].ul.mcs += metrics_tmp[j].ul.n_samples * metrics_tmp[j].ul.mcs;
-      metrics[j].ul.n += metrics_tmp[j].ul.n_samples * metrics_tmp[j].ul.n;
-      metrics[j].ul.rssi += metrics_tmp[j].ul.n_samples * metrics_tmp[j].ul.rssi;
-      metrics[j].ul.pusch_sinr += metrics_tmp[j].ul.n_samples * metrics_tmp[j].ul.pusch_sinr;
-      metrics[j].ul.pucch_sinr += metrics_tmp[j].ul.n_samples_pucch * metrics_tmp[j].ul.pucch_sinr;
-      metrics[j].ul.turbo_iters += metrics_tmp[j].ul.n_samples * metrics_tmp[j].ul.turbo_iters;
+    for (uint32_t k = 0; k < metrics_tmp.size(); k++) {
+      // The workers do not hold the same UEs while a UE is added or removed, so the rows are matched by RNTI
+      uint32_t j = 0;
+      while (j < metrics.size() and metrics[j].rnti != metrics_tmp[k].rnti) {
+        j++;
+      }
+      if (j == metrics.size()) {
+        metrics.emplace_back();
+        metrics[j].rnti = metrics_tmp[k].rnti;
+      }
+      metrics[j].dl.n_samples += metrics_tmp[k].dl.n_samples;
+      metrics[j].dl.mcs += metrics_tmp[k].dl.n_samples * metrics_tmp[k].dl.mcs;
+
+      metrics[j].ul.n_samples += metrics_tmp[k].ul.n_samples;
+      metrics[j].ul.n_samples_pucch += metrics_tmp[k].ul.n_samples_pucch;
+      metrics[j].ul.mcs += metrics_tmp[k].ul.n_samples * metrics_tmp[k].ul.mcs;
+      metrics[j].ul.n += metrics_tmp[k].ul.n_samples * metrics_tmp[k].ul.n;
+      metrics[j].ul.rssi += metrics_tmp[k].ul.n_samples * metrics_tmp[k].ul.rssi;
+      metrics[j].ul.pusch_sinr += metrics_tmp[k].ul.n_samples * metrics_tmp[k].ul.pusch_sinr;
+      metrics[j].ul.pucch_sinr += metrics_tmp[k].ul.n_samples_pucch * metrics_tmp[k].ul.pucch_sinr;
+      metrics[j].ul.turbo_iters += metrics_tmp[k].ul.n_samples * metrics_tmp[k].ul.turbo_iters;
     }
   }
   for (uint32_t j = 0; j < metrics.size(); j++) {
@@ -275,6 +291,11 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
   }
 }
 
+void phy::get_tti_profiler_metrics(std::vector<tti_stage_metrics_t>& metrics)
+{
+  workers_common.tti_prof.get_metrics(metrics);
+}
+
 void phy::cmd_cell_gain(uint32_t cell_id, float gain_db)
 {
   Info("set_cell_gain: cell_id=%d, gain_db=%.2f", cell_id, gain_db);
@@ -358,6 +379,7 @@ int phy::init_nr(const phy_args_t& args, const phy_cfg_t& cfg, stack_interface_p
   worker_args.log.phy_level           = args.log.phy_level;
   worker_args.log.phy_hex_limit       = args.log.phy_hex_limit;
   worker_args.pusch_max_its           = args.nr_pusch_max_its;
+  worker_args.tti_prof                = &workers_common.tti_prof;
 
   if (not nr_workers->init(worker_args, cfg.phy_cell_cfg_nr)) {
     return SRSRAN_ERROR;
@@ -154,7 +154,11 @@ void phy_common::worker_end(const worker_context_t& w_ctx, const bool& tx_enable
   }
 
   // Always transmit on single radio
-  radio->tx(tx_buffer, tx_time);
+  {
+    tti_profiler::scoped_measure meas(tti_prof, tti_stage_t::rf_tx);
+    radio->tx(tx_buffer, tx_time);
+  }
+  tti_prof.tti_end(w_ctx.sf_idx);
 
   // Reset transmit buffer
   tx_buffer = {};
@@ -29,12 +29,14 @@ int prach_worker::init(const srsran_cell_t&      cell_,
                        const srsran_prach_cfg_t& prach_cfg_,
                        stack_interface_phy_lte*  stack_,
                        int                       priority,
-                       uint32_t                  nof_workers_)
+                       uint32_t                  nof_workers_,
+                       uint32_t                  nof_rx_ant_)
 {
   stack       = stack_;
   prach_cfg   = prach_cfg_;
   cell        = cell_;
   nof_workers = nof_workers_;
+  nof_rx_ant  = SRSRAN_MAX(1, SRSRAN_MIN(nof_rx_ant_, SRSRAN_MAX_PORTS));
 
   max_prach_offset_us = 50;
 
@@ -51,6 +53,13 @@ int prach_worker::init(const srsran_cell_t&      cell_,
 
   nof_sf = (uint32_t)ceilf(prach.T_tot * 1000);
 
+  // The samples of all antennas share the same buffer, long preamble formats may not fit them all
+  uint32_t occasion_len = nof_sf * SRSRAN_SF_LEN_PRB(cell.nof_prb);
+  if (nof_rx_ant * occasion_len > sf_buffer_sz) {
+    nof_rx_ant = SRSRAN_MAX(1, sf_buffer_sz / occasion_len);
+    logger.warning("PRACH: Combining only %d antennas for preamble format %d", nof_rx_ant, prach.f);
+  }
+
   if (nof_workers > 0) {
     start(priority);
   }
@@ -96,7 +105,7 @@ void prach_worker::set_max_prach_offset_us(float delay_us)
   max_prach_offset_us = delay_us;
 }
 
-int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
+int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx[SRSRAN_MAX_PORTS])
 {
   // Save buffer only if it's a PRACH TTI
   if (srsran_prach_tti_opportunity(&prach, tti_rx, -1) || sf_cnt) {
@@ -112,9 +121,11 @@ int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
       return -1;
     }
     if (current_buffer->nof_samples + SRSRAN_SF_LEN_PRB(cell.nof_prb) < sf_buffer_sz) {
-      memcpy(&current_buffer->samples[sf_cnt * SRSRAN_SF_LEN_PRB(cell.nof_prb)],
-             buffer_rx,
-             sizeof(cf_t) * SRSRAN_SF_LEN_PRB(cell.nof_prb));
+      for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+        memcpy(&current_buffer->samples[(ant * nof_sf + sf_cnt) * SRSRAN_SF_LEN_PRB(cell.nof_prb)],
+               buffer_rx[ant],
+               sizeof(cf_t) * SRSRAN_SF_LEN_PRB(cell.nof_prb));
+      }
       current_buffer->nof_samples += SRSRAN_SF_LEN_PRB(cell.nof_prb);
       if (sf_cnt == 0) {
         current_buffer->tti = tti_rx;
@@ -142,15 +153,21 @@ int prach_worker::run_tti(sf_buffer* b)
 {
   uint32_t prach_nof_det = 0;
   if (srsran_prach_tti_opportunity(&prach, b->tti, -1)) {
-    // Detect possible PRACHs
-    if (srsran_prach_detect_offset(&prach,
-                                   prach_cfg.freq_offset,
-                                   &b->samples[prach.N_cp],
-                                   nof_sf * SRSRAN_SF_LEN_PRB(cell.nof_prb) - prach.N_cp,
-                                   prach_indices,
-                                   prach_offsets,
-                                   prach_p2avg,
-                                   &prach_nof_det)) {
+    cf_t* signal[SRSRAN_MAX_PORTS] = {};
+    for (uint32_t ant = 0; ant < nof_rx_ant; ant++) {
+      signal[ant] = &b->samples[ant * nof_sf * SRSRAN_SF_LEN_PRB(cell.nof_prb) + prach.N_cp];
+    }
+
+    // Detect possible PRACHs, combining all receive antennas
+    if (srsran_prach_detect_offset_multi(&prach,
+                                         prach_cfg.freq_offset,
+                                         signal,
+                                         nof_rx_ant,
+                                         nof_sf * SRSRAN_SF_LEN_PRB(cell.nof_prb) - prach.N_cp,
+                                         prach_indices,
+                                         prach_offsets,
+                                         prach_p2avg,
+                                         &prach_nof_det)) {
       logger.error("Error detecting PRACH");
       return SRSRAN_ERROR;
     }
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/tti_profiler.h"
+#include "srsran/common/common.h"
+
+namespace srsenb {
+
+using std::chrono::microseconds;
+using std::chrono::nanoseconds;
+
+const char* to_string(tti_stage_t stage)
+{
+  switch (stage) {
+    case tti_stage_t::rx:
+      return "rx";
+    case tti_stage_t::ul_fft:
+      return "ul_fft";
+    case tti_stage_t::ul_decode:
+      return "ul_decode";
+    case tti_stage_t::dl_encode:
+      return "dl_encode";
+    case tti_stage_t::mac_sched:
+      return "mac_sched";
+    case tti_stage_t::rf_tx:
+      return "rf_tx";
+    case tti_stage_t::total:
+      return "total";
+    case tti_stage_t::nr_ul_sched:
+      return "nr_ul_sched";
+    case tti_stage_t::nr_ul:
+      return "nr_ul";
+    case tti_stage_t::nr_dl_sched:
+      return "nr_dl_sched";
+    case tti_stage_t::nr_dl:
+      return "nr_dl";
+    default:
+      break;
+  }
+  return "unknown";
+}
+
+static nanoseconds steady_now()
+{
+  return std::chrono::duration_cast<nanoseconds>(std::chrono::steady_clock::now().time_since_epoch());
+}
+
+// The stages other than the total must keep up with one TTI per millisecond, whereas the TX subframe is due
+// FDD_HARQ_DELAY_UL_MS after the reception, from which one millisecond is spent receiving the subframe
+tti_profiler::tti_profiler()
+{
+  for (auto& s : stages) {
+    s.set_deadline(microseconds{1000});
+  }
+  stages[(size_t)tti_stage_t::total].set_deadline(microseconds{(FDD_HARQ_DELAY_UL_MS - 1) * 1000});
+  for (auto& t : tti_start_ns) {
+    t.store(0, std::memory_order_relaxed);
+  }
+}
+
+void tti_profiler::tti_start(uint32_t tti)
+{
+  tti_start_ns[tti % nof_tti_start].store(steady_now().count(), std::memory_order_relaxed);
+}
+
+void tti_profiler::tti_end(uint32_t tti)
+{
+  int64_t start = tti_start_ns[tti % nof_tti_start].exchange(0, std::memory_order_relaxed);
+  if (start > 0) {
+    record(tti_stage_t::total, steady_now() - nanoseconds{start});
+  }
+}
+
+void tti_profiler::get_metrics(std::vector<tti_stage_metrics_t>& metrics)
+{
+  metrics.resize(stages.size());
+  for (size_t i = 0; i < stages.size(); ++i) {
+    srsran::latency_histogram::summary_t summary = stages[i].read_and_reset();
+
+    tti_stage_metrics_t& m = metrics[i];
+    m.name                 = to_string((tti_stage_t)i);
+    m.count                = summary.count;
+    m.p50_us               = summary.p50.count() / 1e3;
+    m.p99_us               = summary.p99.count() / 1e3;
+    m.max_us               = summary.max.count() / 1e3;
+    m.deadline_us          = stages[i].get_deadline().count() / 1e3;
+    m.nof_deadline_misses  = summary.nof_deadline_misses;
+
+    srsran::perf_counter_accumulator::summary_t perf_summary = perf[i].read_and_reset();
+    m.nof_perf_samples = perf_summary.nof_samples;
+    m.ipc              = perf_summary.ipc();
+    m.llc_mpki         = perf_summary.misses_per_kinstr(srsran::perf_event_t::llc_misses);
+    m.branch_mpki      = perf_summary.misses_per_kinstr(srsran::perf_event_t::branch_misses);
+  }
+}
+
+} // namespace srsenb
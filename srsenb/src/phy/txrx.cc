@@ -22,6 +22,7 @@
 #include <unistd.h>
 
 #include "srsran/common/threads.h"
+#include "srsran/srslog/event_trace.h"
 #include "srsran/srsran.h"
 
 #include "srsenb/hdr/phy/txrx.h"
@@ -172,7 +173,12 @@ void txrx::run_thread()
     }
 
     buffer.set_nof_samples(sf_len);
-    radio_h->rx_now(buffer, timestamp);
+    {
+      trace_complete_event("txrx", "rx_now");
+      tti_profiler::scoped_measure meas(worker_com->tti_prof, tti_stage_t::rx);
+      radio_h->rx_now(buffer, timestamp);
+    }
+    worker_com->tti_prof.tti_start(tti);
 
     if (ul_channel) {
       ul_channel->run(buffer.to_cf_t(), buffer.to_cf_t(), sf_len, timestamp.get(0));
@@ -189,7 +195,11 @@ void txrx::run_thread()
 
     // Trigger prach worker execution
     for (uint32_t cc = 0; cc < worker_com->get_nof_carriers_lte(); cc++) {
-      prach->new_tti(cc, tti, buffer.get(worker_com->get_rf_port(cc), 0, worker_com->get_nof_ports(0)));
+      cf_t* prach_buffer[SRSRAN_MAX_PORTS] = {};
+      for (uint32_t p = 0; p < worker_com->get_nof_ports(cc); p++) {
+        prach_buffer[p] = buffer.get(worker_com->get_rf_port(cc), p, worker_com->get_nof_ports(0));
+      }
+      prach->new_tti(cc, tti, prach_buffer);
     }
 
     // Set NR worker context and start
@@ -101,8 +101,7 @@ enb_stack_lte::enb_stack_lte(srslog::sink& log_sink) :
   gtpu(&task_sched, gtpu_logger, &rx_sockets),
   s1ap(&task_sched, s1ap_logger, &rx_sockets),
   rrc(&task_sched, bearers),
-  mac_pcap(),
-  pending_stack_metrics(64)
+  mac_pcap()
 {
   get_background_workers().set_nof_workers(2);
   enb_task_queue     = task_sched.make_task_queue();
@@ -153,7 +152,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
 
   // Set up pcap and trace
   if (args.mac_pcap.enable) {
-    mac_pcap.open(args.mac_pcap.filename);
+    mac_pcap.open(args.mac_pcap.filename, 0, args.pcap_writer);
     mac.start_pcap(&mac_pcap);
   }
 
@@ -166,7 +165,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   }
 
   if (args.s1ap_pcap.enable) {
-    s1ap_pcap.open(args.s1ap_pcap.filename.c_str());
+    s1ap_pcap.open(args.s1ap_pcap.filename.c_str(), args.pcap_writer);
     s1ap.start_pcap(&s1ap_pcap);
   }
 
@@ -224,6 +223,7 @@ void enb_stack_lte::tti_clock()
 
 void enb_stack_lte::tti_clock_impl()
 {
+  trace_complete_event("enb_stack_lte", "tti_clock");
   task_sched.tic();
   rrc.tti_clock();
 }
@@ -267,9 +267,11 @@ void enb_stack_lte::stop_impl()
 
 bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
 {
-  // use stack thread to query metrics
+  // use stack thread to query metrics, without waiting for the result. The metrics returned are the ones collected by
+  // the previous request, hence they lag one metrics period
   auto ret = metrics_task_queue.try_push([this]() {
-    stack_metrics_t metrics{};
+    stack_metrics_t& metrics = stack_metrics_snapshot.write_buffer();
+    metrics                  = {};
     mac.get_metrics(metrics.mac);
     if (not metrics.mac.ues.empty()) {
       rlc.get_metrics(metrics.rlc, metrics.mac.ues[0].nof_tti);
@@ -277,17 +279,18 @@ bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
     }
     rrc.get_metrics(metrics.rrc);
     s1ap.get_metrics(metrics.s1ap);
-    if (not pending_stack_metrics.try_push(metrics)) {
-      stack_logger.error("Unable to push metrics to queue");
-    }
+    stack_metrics_snapshot.publish();
   });
+  if (not ret.has_value()) {
+    stack_logger.warning("Unable to push metrics request to the stack thread");
+  }
 
-  if (ret.has_value()) {
-    // wait for result
-    *metrics = pending_stack_metrics.pop_blocking();
-    return true;
+  stack_metrics_valid |= stack_metrics_snapshot.fetch();
+  if (not stack_metrics_valid) {
+    return false;
   }
-  return false;
+  *metrics = stack_metrics_snapshot.read_buffer();
+  return true;
 }
 
 void enb_stack_lte::run_thread()
@@ -23,7 +23,6 @@
 #include <string.h>
 
 #include "srsenb/hdr/stack/mac/mac.h"
-#include "srsran/adt/pool/obj_pool.h"
 #include "srsran/common/rwlock_guard.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/time_prof.h"
@@ -80,13 +79,7 @@ bool mac::init(const mac_args_t&        args_,
   }
 
   // Initiate common pool of softbuffers
-  uint32_t nof_prb          = args.nof_prb;
-  auto     init_softbuffers = [nof_prb](void* ptr) {
-    new (ptr) ue_cc_softbuffers(nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ);
-  };
-  auto recycle_softbuffers = [](ue_cc_softbuffers& softbuffers) { softbuffers.clear(); };
-  softbuffer_pool.reset(new srsran::background_obj_pool<ue_cc_softbuffers>(
-      8, 8, args.nof_prealloc_ues, init_softbuffers, recycle_softbuffers));
+  softbuffer_pool = make_ue_cc_softbuffer_pool(args.nof_prb, args.nof_prealloc_ues);
 
   detected_rachs.resize(cells.size());
 
@@ -216,8 +209,15 @@ int mac::ue_rem(uint16_t rnti)
   // Note: Let any pending retx ACK to arrive, so that PHY recognizes rnti
   task_sched.defer_callback(FDD_HARQ_DELAY_DL_MS + FDD_HARQ_DELAY_UL_MS, [this, rnti]() {
     phy_h->rem_rnti(rnti);
-    srsran::rwlock_write_guard lock(rwlock);
-    ue_db.erase(rnti);
+    // The UE is destroyed after releasing the lock, so that PHY workers are not blocked meanwhile
+    unique_rnti_ptr<ue> removed_ue;
+    {
+      srsran::rwlock_write_guard lock(rwlock);
+      if (ue_db.contains(rnti)) {
+        removed_ue = std::move(ue_db[rnti]);
+        ue_db.erase(rnti);
+      }
+    }
     logger.info("User rnti=0x%x removed from MAC/PHY", rnti);
   });
   return SRSRAN_SUCCESS;
@@ -256,6 +256,14 @@ void mac::get_metrics(mac_metrics_t& metrics)
   for (unsigned cc = 0, e = detected_rachs.size(); cc != e; ++cc) {
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
     metrics.cc_info[cc].pci             = (cc < cell_config.size()) ? cell_config[cc].cell.id : 0;
+
+    sched_interface::pdcch_metrics_t pdcch_metrics = scheduler.read_pdcch_metrics(cc);
+    metrics.cc_info[cc].pdcch_alloc_time_us        = 0;
+    metrics.cc_info[cc].pdcch_blocking_rate        = 0;
+    if (pdcch_metrics.nof_dci_allocs > 0) {
+      metrics.cc_info[cc].pdcch_alloc_time_us = pdcch_metrics.alloc_time_ns / (1000.0f * pdcch_metrics.nof_dci_allocs);
+      metrics.cc_info[cc].pdcch_blocking_rate = pdcch_metrics.nof_dci_blocked / (float)pdcch_metrics.nof_dci_allocs;
+    }
   }
 }
 
@@ -290,8 +298,8 @@ int mac::ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
     return SRSRAN_ERROR;
   }
 
-  int nof_bytes = scheduler.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
-  ue_db[rnti]->metrics_tx(ack, nof_bytes);
+  // The DL tx metrics are updated by the scheduler, once the ACK is processed
+  scheduler.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
 
   rrc_h->set_radiolink_dl_state(rnti, ack);
 
@@ -64,7 +64,7 @@ int mac_nr::init(const mac_nr_args_t&    args_,
 
   if (args.pcap.enable) {
     pcap = std::unique_ptr<srsran::mac_pcap>(new srsran::mac_pcap());
-    pcap->open(args.pcap.filename);
+    pcap->open(args.pcap.filename, 0, args.pcap_writer);
   }
 
   logger.info("Started");
@@ -405,6 +405,13 @@ bool mac_nr::handle_uci_data(const uint16_t rnti, const srsran_uci_cfg_nr_t& cfg
   }
 
   // Process CQI
+  for (uint32_t i = 0; i < cfg_.nof_csi and value.valid; i++) {
+    // Only wideband CQI reports are used for link adaptation
+    if (cfg_.csi[i].cfg.quantity == SRSRAN_CSI_REPORT_QUANTITY_CRI_RI_PMI_CQI and
+        cfg_.csi[i].cfg.freq_cfg == SRSRAN_CSI_REPORT_FREQ_WIDEBAND) {
+      sched.dl_cqi_info(rnti, 0, value.csi[i].wideband_cri_ri_pmi_cqi.cqi);
+    }
+  }
   {
     srsran::rwlock_read_guard rw_lock(rwmutex);
     if (ue_db.contains(rnti) && value.valid) {
@@ -427,6 +434,7 @@ int mac_nr::pusch_info(const srsran_slot_cfg_t& slot_cfg, mac_interface_phy_nr::
   }
 
   sched.ul_crc_info(rnti, 0, pusch_info.pid, pusch_info.pusch_data.tb[0].crc);
+  sched.ul_sinr_info(rnti, 0, pusch_info.csi.snr_dB);
 
   // process only PDUs with CRC=OK
   if (pusch_info.pusch_data.tb[0].crc) {
@@ -77,7 +77,11 @@ private:
 
 sched_nr::sched_nr() : logger(&srslog::fetch_basic_logger("MAC-NR")) {}
 
-sched_nr::~sched_nr() {}
+sched_nr::~sched_nr()
+{
+  // Stop the scheduler workers before the cells and UEs they access are destroyed
+  sched_workers.reset();
+}
 
 int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<cell_cfg_t> cell_list)
 {
@@ -179,9 +183,12 @@ int sched_nr::dl_rach_info(uint32_t cc, const rar_info_t& rar_info)
 void sched_nr::dl_ack_info(uint16_t rnti, uint32_t cc, uint32_t pid, uint32_t tb_idx, bool ack)
 {
   sched_workers->enqueue_cc_feedback(rnti, cc, [this, pid, tb_idx, ack](ue_carrier& ue_cc) {
-    int tbs = ue_cc.harq_ent.dl_ack_info(pid, tb_idx, ack);
+    uint32_t mcs = ue_cc.harq_ent.dl_harq(pid).mcs();
+    int      tbs = ue_cc.harq_ent.dl_ack_info(pid, tb_idx, ack);
     if (tbs >= 0) {
+      ue_cc.la.dl_ack_info(ack, mcs);
       std::lock_guard<std::mutex> lock(ue_cc.metrics_mutex);
+      ue_cc.metrics.dl_cqi_offset = ue_cc.la.get_dl_cqi_offset();
       if (ack) {
         ue_cc.metrics.tx_brate += tbs;
       } else {
@@ -197,12 +204,27 @@ void sched_nr::dl_ack_info(uint16_t rnti, uint32_t cc, uint32_t pid, uint32_t tb
 void sched_nr::ul_crc_info(uint16_t rnti, uint32_t cc, uint32_t pid, bool crc)
 {
   sched_workers->enqueue_cc_feedback(rnti, cc, [this, pid, crc](ue_carrier& ue_cc) {
+    uint32_t mcs = ue_cc.harq_ent.ul_harq(pid).mcs();
     if (ue_cc.harq_ent.ul_crc_info(pid, crc) < 0) {
       logger->warning("SCHED: rnti=0x%x, received CRC for empty pid=%d", ue_cc.rnti, pid);
+      return;
     }
+    ue_cc.la.ul_crc_info(crc, mcs);
+    std::lock_guard<std::mutex> lock(ue_cc.metrics_mutex);
+    ue_cc.metrics.ul_snr_offset = ue_cc.la.get_ul_snr_offset();
   });
 }
 
+void sched_nr::dl_cqi_info(uint16_t rnti, uint32_t cc, uint32_t cqi)
+{
+  sched_workers->enqueue_cc_feedback(rnti, cc, [cqi](ue_carrier& ue_cc) { ue_cc.la.dl_cqi_info(cqi); });
+}
+
+void sched_nr::ul_sinr_info(uint16_t rnti, uint32_t cc, float sinr)
+{
+  sched_workers->enqueue_cc_feedback(rnti, cc, [sinr](ue_carrier& ue_cc) { ue_cc.la.ul_sinr_info(sinr); });
+}
+
 void sched_nr::ul_sr_info(uint16_t rnti)
 {
   sched_workers->enqueue_event(rnti, [this, rnti]() {
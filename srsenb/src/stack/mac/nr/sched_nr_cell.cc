@@ -32,9 +32,9 @@ si_sched::si_sched(const bwp_params_t& bwp_cfg_) :
 
 void si_sched::run_slot(bwp_slot_allocator& slot_alloc)
 {
-  const uint32_t    si_aggr_level = 2;
-  slot_point        pdcch_slot    = slot_alloc.get_pdcch_tti();
-  const prb_bitmap& prbs          = slot_alloc.res_grid()[pdcch_slot].dl_prbs.prbs();
+  const uint32_t       si_aggr_level = 2;
+  slot_point           pdcch_slot    = slot_alloc.get_pdcch_tti();
+  const bwp_rb_bitmap& prbs          = slot_alloc.res_grid()[pdcch_slot].dl_prbs;
 
   // Update SI windows
   uint32_t N = bwp_cfg->slots.size();
@@ -93,8 +93,8 @@ ra_sched::ra_sched(const bwp_params_t& bwp_cfg_) :
 alloc_result
 ra_sched::allocate_pending_rar(bwp_slot_allocator& slot_grid, const pending_rar_t& rar, uint32_t& nof_grants_alloc)
 {
-  const uint32_t    rar_aggr_level = 2;
-  const prb_bitmap& prbs           = slot_grid.res_grid()[slot_grid.get_pdcch_tti()].dl_prbs.prbs();
+  const uint32_t       rar_aggr_level = 2;
+  const bwp_rb_bitmap& prbs           = slot_grid.res_grid()[slot_grid.get_pdcch_tti()].dl_prbs;
 
   alloc_result                            ret = alloc_result::other_cause;
   srsran::const_span<dl_sched_rar_info_t> msg3_grants{rar.msg3_grant};
@@ -21,6 +21,7 @@
 
 #include "srsenb/hdr/stack/mac/nr/sched_nr_cfg.h"
 #include "srsenb/hdr/stack/mac/nr/sched_nr_helpers.h"
+#include "srsenb/hdr/stack/mac/nr/sched_nr_link_adaptation.h"
 #include "srsran/adt/optional_array.h"
 extern "C" {
 #include "srsran/phy/phch/ra_ul_nr.h"
@@ -112,8 +113,11 @@ cell_params_t::cell_params_t(uint32_t cc_, const cell_cfg_t& cell, const sched_a
 
 sched_params::sched_params(const sched_args_t& sched_cfg_) : sched_cfg(sched_cfg_)
 {
-  srsran_assert(sched_cfg.fixed_dl_mcs >= 0, "Dynamic DL MCS not supported");
-  srsran_assert(sched_cfg.fixed_ul_mcs >= 0, "Dynamic DL MCS not supported");
+  srsran_assert(sched_cfg.fixed_dl_mcs <= (int)max_mcs_64qam, "Invalid fixed DL MCS=%d", sched_cfg.fixed_dl_mcs);
+  srsran_assert(sched_cfg.fixed_ul_mcs <= (int)max_mcs_64qam, "Invalid fixed UL MCS=%d", sched_cfg.fixed_ul_mcs);
+  srsran_assert(sched_cfg.lookahead_slots <= SCHED_NR_MAX_LOOKAHEAD,
+                "Invalid number of look-ahead slots=%d",
+                sched_cfg.lookahead_slots);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -143,7 +143,7 @@ alloc_result bwp_slot_allocator::alloc_rar_and_msg3(uint16_t
   // Check Msg3 RB collision
   uint32_t     total_ul_nof_prbs = msg3_nof_prbs * pending_rars.size();
   uint32_t     total_ul_nof_rbgs = srsran::ceil_div(total_ul_nof_prbs, get_P(bwp_grid.nof_prbs(), false));
-  prb_interval msg3_rbs          = find_empty_interval_of_length(bwp_msg3_slot.ul_prbs.prbs(), total_ul_nof_rbgs);
+  prb_interval msg3_rbs          = find_empty_interval_of_length(bwp_msg3_slot.ul_prbs, total_ul_nof_rbgs);
   if (msg3_rbs.length() < total_ul_nof_rbgs) {
     logger.debug("SCHED: No space in PUSCH for Msg3.");
     return alloc_result::sch_collision;
@@ -267,7 +267,7 @@ alloc_result bwp_slot_allocator::alloc_pdsch(slot_ue& ue, const prb_grant& dl_gr
   }
 
   // Allocate HARQ
-  int mcs = ue.cfg->fixed_pdsch_mcs();
+  int mcs = ue.dl_mcs;
   if (ue.h_dl->empty()) {
     bool ret = ue.h_dl->new_tx(ue.pdsch_slot, ue.uci_slot, dl_grant, mcs, 4);
     srsran_assert(ret, "Failed to allocate DL HARQ");
@@ -363,7 +363,7 @@ alloc_result bwp_slot_allocator::alloc_pusch(slot_ue& ue, const prb_grant& ul_pr
   }
 
   if (ue.h_ul->empty()) {
-    int  mcs     = ue.cfg->fixed_pusch_mcs();
+    int  mcs     = ue.ul_mcs;
     int  tbs     = 100;
     bool success = ue.h_ul->new_tx(ue.pusch_slot, ue.pusch_slot, ul_prbs, mcs, ue.cfg->ue_cfg()->maxharq_tx);
     srsran_assert(success, "Failed to allocate UL HARQ");
@@ -0,0 +1,217 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/nr/sched_nr_link_adaptation.h"
+#include <array>
+#include <cmath>
+
+extern "C" {
+#include "srsran/phy/phch/cqi.h"
+#include "srsran/phy/phch/ra_nr.h"
+}
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+namespace {
+
+/// Resolution of the precomputed tables
+constexpr uint32_t cqi_table_steps_per_cqi = 8;
+constexpr int      sinr_table_min_dB       = -10;
+constexpr int      sinr_table_max_dB       = 35;
+constexpr uint32_t sinr_table_steps_per_dB = 4;
+constexpr uint32_t max_cqi                 = 15;
+
+using cqi_mcs_table_t  = std::array<uint8_t, max_cqi * cqi_table_steps_per_cqi + 1>;
+using sinr_mcs_table_t = std::array<uint8_t, (sinr_table_max_dB - sinr_table_min_dB) * sinr_table_steps_per_dB + 1>;
+
+float mcs_spectral_efficiency(uint32_t mcs)
+{
+  double       R   = srsran_ra_nr_R_from_mcs(srsran_mcs_table_64qam,
+                                             srsran_dci_format_nr_1_1,
+                                             srsran_search_space_type_ue,
+                                             srsran_rnti_type_c,
+                                             mcs);
+  srsran_mod_t mod = srsran_ra_nr_mod_from_mcs(srsran_mcs_table_64qam,
+                                               srsran_dci_format_nr_1_1,
+                                               srsran_search_space_type_ue,
+                                               srsran_rnti_type_c,
+                                               mcs);
+  return (float)R * srsran_mod_bits_x_symbol(mod);
+}
+
+/// Spectral efficiency of a fractional CQI, interpolated from the CQI table 1 (TS 38.214, Table 5.2.2.1-2). This
+/// table is the same as the LTE one, TS 36.213 Table 7.2.3-1
+float cqi_spectral_efficiency(float cqi)
+{
+  cqi           = std::max(0.0f, std::min(cqi, (float)max_cqi));
+  uint32_t low  = (uint32_t)cqi;
+  uint32_t high = std::min(low + 1, max_cqi);
+  float    frac = cqi - low;
+  return (1 - frac) * srsran_cqi_to_coderate(low, false) + frac * srsran_cqi_to_coderate(high, false);
+}
+
+/// Fractional CQI at a given SINR, interpolated between the SINR thresholds of consecutive CQIs
+float sinr_to_cqi(float sinr_dB)
+{
+  if (sinr_dB < srsran_cqi_to_snr(1)) {
+    return 0;
+  }
+  for (uint32_t cqi = 1; cqi < max_cqi; ++cqi) {
+    float low = srsran_cqi_to_snr(cqi), high = srsran_cqi_to_snr(cqi + 1);
+    if (sinr_dB < high) {
+      return cqi + (sinr_dB - low) / (high - low);
+    }
+  }
+  return max_cqi;
+}
+
+uint32_t spectral_efficiency_to_mcs(float eff)
+{
+  // Tolerance for the rounding of the tabulated values, so that equal efficiencies map to each other
+  const static float tol = 1e-3;
+
+  uint32_t mcs = 0;
+  while (mcs < max_mcs_64qam and mcs_spectral_efficiency(mcs + 1) <= eff + tol) {
+    mcs++;
+  }
+  return mcs;
+}
+
+const cqi_mcs_table_t& get_cqi_mcs_table()
+{
+  static const cqi_mcs_table_t table = []() {
+    cqi_mcs_table_t t;
+    for (uint32_t i = 0; i < t.size(); ++i) {
+      t[i] = spectral_efficiency_to_mcs(cqi_spectral_efficiency((float)i / cqi_table_steps_per_cqi));
+    }
+    return t;
+  }();
+  return table;
+}
+
+const sinr_mcs_table_t& get_sinr_mcs_table()
+{
+  static const sinr_mcs_table_t table = []() {
+    sinr_mcs_table_t t;
+    for (uint32_t i = 0; i < t.size(); ++i) {
+      float sinr_dB = sinr_table_min_dB + (float)i / sinr_table_steps_per_dB;
+      t[i]          = spectral_efficiency_to_mcs(cqi_spectral_efficiency(sinr_to_cqi(sinr_dB)));
+    }
+    return t;
+  }();
+  return table;
+}
+
+} // namespace
+
+link_adaptation::link_adaptation(const sched_nr_interface::sched_args_t& sched_args) :
+  fixed_dl_mcs(sched_args.fixed_dl_mcs),
+  fixed_ul_mcs(sched_args.fixed_ul_mcs),
+  target_bler(sched_args.target_bler),
+  ul_snr_avg_alpha(sched_args.ul_snr_avg_alpha),
+  dl_cqi(std::max(0, std::min(sched_args.init_dl_cqi, (int)max_cqi))),
+  ul_sinr(sched_args.init_ul_snr_value)
+{
+  if (target_bler > 0) {
+    dl_delta_inc = sched_args.adaptive_dl_mcs_step_size;
+    dl_delta_dec = (1 - target_bler) * dl_delta_inc / target_bler;
+    ul_delta_inc = sched_args.adaptive_ul_mcs_step_size;
+    ul_delta_dec = (1 - target_bler) * ul_delta_inc / target_bler;
+  }
+  max_cqi_coeff = sched_args.max_delta_dl_cqi;
+  max_snr_coeff = sched_args.max_delta_ul_snr;
+
+  // Make sure the tables are computed before the first slot is scheduled
+  get_cqi_mcs_table();
+  get_sinr_mcs_table();
+}
+
+void link_adaptation::dl_cqi_info(uint32_t cqi)
+{
+  dl_cqi = std::min(cqi, max_cqi);
+}
+
+void link_adaptation::ul_sinr_info(float sinr)
+{
+  if (not std::isfinite(sinr)) {
+    return;
+  }
+  ul_sinr         = ul_sinr_present ? ul_snr_avg_alpha * sinr + (1 - ul_snr_avg_alpha) * ul_sinr : sinr;
+  ul_sinr_present = true;
+}
+
+void link_adaptation::dl_ack_info(bool ack, uint32_t mcs)
+{
+  if (target_bler <= 0 or fixed_dl_mcs >= 0) {
+    return;
+  }
+  // Note: Avoid increasing the CQI offset any further if the MCS is already at its limit
+  float delta_dec_eff = mcs == 0 ? 0 : dl_delta_dec;
+  float delta_inc_eff = mcs >= max_mcs_64qam ? 0 : dl_delta_inc;
+  dl_cqi_coeff += ack ? delta_inc_eff : -delta_dec_eff;
+  dl_cqi_coeff = std::min(std::max(-max_cqi_coeff, dl_cqi_coeff), max_cqi_coeff);
+}
+
+void link_adaptation::ul_crc_info(bool crc, uint32_t mcs)
+{
+  if (target_bler <= 0 or fixed_ul_mcs >= 0) {
+    return;
+  }
+  // Note: Avoid increasing the SNR offset any further if the MCS is already at its limit
+  float delta_dec_eff = mcs == 0 ? 0 : ul_delta_dec;
+  float delta_inc_eff = mcs >= max_mcs_64qam ? 0 : ul_delta_inc;
+  ul_snr_coeff += crc ? delta_inc_eff : -delta_dec_eff;
+  ul_snr_coeff = std::min(std::max(-max_snr_coeff, ul_snr_coeff), max_snr_coeff);
+}
+
+uint32_t link_adaptation::get_dl_mcs() const
+{
+  if (fixed_dl_mcs >= 0) {
+    return fixed_dl_mcs;
+  }
+  return cqi_to_mcs(dl_cqi + dl_cqi_coeff);
+}
+
+uint32_t link_adaptation::get_ul_mcs() const
+{
+  if (fixed_ul_mcs >= 0) {
+    return fixed_ul_mcs;
+  }
+  return sinr_to_mcs(ul_sinr + ul_snr_coeff);
+}
+
+uint32_t link_adaptation::cqi_to_mcs(float cqi)
+{
+  const cqi_mcs_table_t& table = get_cqi_mcs_table();
+  int                    idx   = (int)std::floor(cqi * cqi_table_steps_per_cqi);
+  return table[std::max(0, std::min(idx, (int)table.size() - 1))];
+}
+
+uint32_t link_adaptation::sinr_to_mcs(float sinr_dB)
+{
+  const sinr_mcs_table_t& table = get_sinr_mcs_table();
+  int                     idx   = (int)std::floor((sinr_dB - sinr_table_min_dB) * sinr_table_steps_per_dB);
+  return table[std::max(0, std::min(idx, (int)table.size() - 1))];
+}
+
+} // namespace sched_nr_impl
+} // namespace srsenb
@@ -110,5 +110,37 @@ void bwp_rb_bitmap::add_rbgs_to_prbs(const rbg_bitmap& grant)
   } while (idx != (int)prbs_.size());
 }
 
+srsran::const_span<prb_interval> bwp_rb_bitmap::free_prb_intervals() const
+{
+  if (not free_intervals_valid) {
+    free_intervals.clear();
+    for (prb_interval interv = find_next_empty_interval(prbs_); not interv.empty();
+         interv              = find_next_empty_interval(prbs_, interv.stop())) {
+      free_intervals.push_back(interv);
+    }
+    free_intervals_valid = true;
+  }
+  return free_intervals;
+}
+
+prb_interval find_empty_interval_of_length(const bwp_rb_bitmap& bitmap, size_t nof_prbs, uint32_t start_prb_idx)
+{
+  prb_interval max_interv;
+  for (const prb_interval& free_interv : bitmap.free_prb_intervals()) {
+    if (free_interv.stop() <= start_prb_idx) {
+      continue;
+    }
+    prb_interval interv{std::max(free_interv.start(), start_prb_idx), free_interv.stop()};
+    if (interv.length() >= nof_prbs) {
+      max_interv.set(interv.start(), interv.start() + nof_prbs);
+      break;
+    }
+    if (interv.length() > max_interv.length()) {
+      max_interv = interv;
+    }
+  }
+  return max_interv;
+}
+
 } // namespace sched_nr_impl
 } // namespace srsenb
@@ -35,6 +35,7 @@ ue_carrier::ue_carrier(uint16_t rnti_, const ue_cfg_t& uecfg_, const cell_params
   cc(cell_params_.cc),
   bwp_cfg(rnti_, cell_params_.bwps[0], uecfg_),
   cell_params(cell_params_),
+  la(cell_params_.bwps[0].sched_cfg),
   harq_ent(rnti_, cell_params_.nof_prb(), SCHED_NR_MAX_HARQ, cell_params_.bwps[0].logger)
 {}
 
@@ -63,8 +64,9 @@ slot_ue ue_carrier::try_reserve(slot_point pdcch_slot, uint32_t dl_pending_bytes
   sfu.uci_slot      = sfu.pdsch_slot + k1;
   uint32_t k2       = bwp_cfg.active_bwp().pusch_ra_list[0].K;
   sfu.pusch_slot    = sfu.pdcch_slot + k2;
-  sfu.dl_cqi        = dl_cqi;
-  sfu.ul_cqi        = ul_cqi;
+  sfu.dl_cqi        = la.get_dl_cqi();
+  sfu.dl_mcs        = la.get_dl_mcs();
+  sfu.ul_mcs        = la.get_ul_mcs();
 
   // set UE-common parameters
   sfu.dl_pending_bytes = dl_pending_bytes;
@@ -23,56 +23,101 @@
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
 #include "srsenb/hdr/stack/mac/nr/sched_nr_signalling.h"
 #include "srsran/common/string_helpers.h"
+#include <thread>
 
 namespace srsenb {
 namespace sched_nr_impl {
 
+/// Capacity of the lock-free event queues. Additional events are stored in a locked overflow list
+const static size_t MAX_PENDING_CC_FEEDBACK = 2048;
+const static size_t MAX_PENDING_CC_EVENTS   = 256;
+const static size_t MAX_PENDING_UE_EVENTS   = 2048;
+
+bool slot_sync_barrier::enter_slot(slot_point slot)
+{
+  uint32_t slot_idx = slot.to_uint();
+  bool     first    = false;
+  wait_for([this, slot_idx, &first]() {
+    uint32_t cur = current_slot.load(std::memory_order_acquire);
+    if (cur == slot_idx) {
+      // Another worker of the same slot got there first
+      return true;
+    }
+    first = cur == no_slot and current_slot.compare_exchange_strong(cur, slot_idx, std::memory_order_acq_rel);
+    return first;
+  });
+  return first;
+}
+
+void slot_sync_barrier::finish_setup(slot_point slot)
+{
+  nof_remaining.store(static_cast<int>(nof_workers), std::memory_order_relaxed);
+  setup_slot.store(slot.to_uint(), std::memory_order_release);
+}
+
+void slot_sync_barrier::wait_setup(slot_point slot)
+{
+  uint32_t slot_idx = slot.to_uint();
+  wait_for([this, slot_idx]() { return setup_slot.load(std::memory_order_acquire) == slot_idx; });
+}
+
+bool slot_sync_barrier::leave_slot()
+{
+  int rem_workers = nof_remaining.fetch_sub(1, std::memory_order_acq_rel) - 1;
+  srsran_assert(rem_workers >= 0, "invalid number of calls to run_slot(slot, cc)");
+  if (rem_workers == 0) {
+    // Last worker of the slot. Release the slot for the workers of the next slot
+    current_slot.store(no_slot, std::memory_order_release);
+    return true;
+  }
+  return false;
+}
+
+void slot_sync_barrier::backoff(uint32_t count)
+{
+  // Waits are normally short, as they only last until the other carriers finish. Sleep if they are not
+  if (count < 1000) {
+    std::this_thread::yield();
+  } else {
+    std::this_thread::sleep_for(std::chrono::microseconds(10));
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 slot_cc_worker::slot_cc_worker(serv_cell_manager& cc_sched) :
   cell(cc_sched),
   cfg(cc_sched.cfg),
   bwp_alloc(cc_sched.bwps[0].grid),
-  logger(srslog::fetch_basic_logger(cc_sched.cfg.sched_args.logger_name))
+  logger(srslog::fetch_basic_logger(cc_sched.cfg.sched_args.logger_name)),
+  pending_feedback(MAX_PENDING_CC_FEEDBACK),
+  pending_events(MAX_PENDING_CC_EVENTS)
 {}
 
 void slot_cc_worker::enqueue_cc_event(srsran::move_callback<void()> ev)
 {
-  std::lock_guard<std::mutex> lock(feedback_mutex);
-  pending_events.emplace_back();
-  pending_events.back() = std::move(ev);
+  pending_events.push(std::move(ev));
 }
 
 void slot_cc_worker::enqueue_cc_feedback(uint16_t rnti, feedback_callback_t fdbk)
 {
-  std::lock_guard<std::mutex> lock(feedback_mutex);
-  pending_feedback.emplace_back();
-  pending_feedback.back().rnti = rnti;
-  pending_feedback.back().fdbk = std::move(fdbk);
+  pending_feedback.push(feedback_t{rnti, std::move(fdbk)});
 }
 
 void slot_cc_worker::run_feedback(ue_map_t& ue_db)
 {
-  {
-    std::lock_guard<std::mutex> lock(feedback_mutex);
-    tmp_feedback_to_run.swap(pending_feedback);
-    tmp_events_to_run.swap(pending_events);
-  }
-
-  for (srsran::move_callback<void()>& ev : tmp_events_to_run) {
-    ev();
-  }
-  tmp_events_to_run.clear();
+  pending_events.consume_all([](srsran::move_callback<void()>& ev) { ev(); });
 
-  for (feedback_t& f : tmp_feedback_to_run) {
+  pending_feedback.consume_all([this, &ue_db](feedback_t& f) {
     if (ue_db.contains(f.rnti) and ue_db[f.rnti]->carriers[cfg.cc] != nullptr) {
       f.fdbk(*ue_db[f.rnti]->carriers[cfg.cc]);
     } else {
       logger.info("SCHED: feedback received for rnti=0x%x, cc=%d that has been removed.", f.rnti, cfg.cc);
     }
-  }
-  tmp_feedback_to_run.clear();
+  });
 }
 
-/// Called within a locked context, to generate {slot, cc} scheduling decision
+/// Called within the slot barrier, to generate {slot, cc} scheduling decision
 void slot_cc_worker::run(slot_point pdcch_slot, ue_map_t& ue_db)
 {
   srsran_assert(not running(), "scheduler worker::start() called for active worker");
@@ -232,20 +277,38 @@ void slot_cc_worker::postprocess_decisions()
 sched_worker_manager::sched_worker_manager(ue_map_t&                                         ue_db_,
                                            const sched_params&                               cfg_,
                                            srsran::span<std::unique_ptr<serv_cell_manager> > cells_) :
-  cfg(cfg_), ue_db(ue_db_), logger(srslog::fetch_basic_logger(cfg_.sched_cfg.logger_name)), cells(cells_)
+  cfg(cfg_),
+  ue_db(ue_db_),
+  logger(srslog::fetch_basic_logger(cfg_.sched_cfg.logger_name)),
+  cells(cells_),
+  pending_events(MAX_PENDING_UE_EVENTS),
+  slot_barrier(cfg_.cells.size())
 {
   cc_worker_list.reserve(cfg.cells.size());
   for (uint32_t cc = 0; cc < cfg.cells.size(); ++cc) {
     cc_worker_list.emplace_back(new cc_context{*cells[cc]});
+    if (cfg.sched_cfg.lookahead_slots > 0) {
+      fmt::memory_buffer fmtbuf;
+      fmt::format_to(fmtbuf, "SCHED-NR{}", cc);
+      cc_worker_list.back()->pipeline.reset(new srsran::task_worker{to_string(fmtbuf), SCHED_NR_MAX_LOOKAHEAD + 1});
+    }
   }
 }
 
-sched_worker_manager::~sched_worker_manager() = default;
+sched_worker_manager::~sched_worker_manager()
+{
+  // Pipelined slots still waiting for other carriers must not block the destruction
+  slot_barrier.stop();
+  for (auto& c : cc_worker_list) {
+    if (c->pipeline != nullptr) {
+      c->pipeline->stop();
+    }
+  }
+}
 
 void sched_worker_manager::enqueue_event(uint16_t rnti, srsran::move_callback<void()> ev)
 {
-  std::lock_guard<std::mutex> lock(event_mutex);
-  next_slot_events.push_back(ue_event_t{rnti, std::move(ev)});
+  pending_events.push(ue_event_t{rnti, std::move(ev)});
 }
 
 void sched_worker_manager::enqueue_cc_event(uint32_t cc, srsran::move_callback<void()> ev)
@@ -254,23 +317,20 @@ void sched_worker_manager::enqueue_cc_event(uint32_t cc, srsran::move_callback<v
 }
 
 /**
- * Update UEs state that is non-CC specific (e.g. SRs, buffer status, UE configuration)
+ * Update UEs state that is non-CC specific (e.g. SRs, buffer status, UE configuration), and prepare the UEs with CA
+ * for the new slot. Only called by the first worker of the slot, so UEs can be safely added and removed
  * @param slot_tx
- * @param locked_context to update only UEs with CA enabled or not
  */
-void sched_worker_manager::update_ue_db(slot_point slot_tx, bool locked_context)
+void sched_worker_manager::update_ue_db(slot_point slot_tx)
 {
-  // process non-cc specific feedback if pending (e.g. SRs, buffer updates, UE config)
-  for (ue_event_t& ev : slot_events) {
-    if ((locked_context and not ue_db.contains(ev.rnti)) or
-        (ue_db.contains(ev.rnti) and ue_db[ev.rnti]->has_ca() == locked_context)) {
-      ev.callback();
-    }
+  {
+    std::lock_guard<std::mutex> lock(ue_db_mutex);
+    pending_events.consume_all([](ue_event_t& ev) { ev.callback(); });
   }
 
-  // prepare UEs internal state for new slot
+  // prepare UEs with CA for the new slot. UEs without CA are prepared by the worker of their PCell
   for (auto& u : ue_db) {
-    if (u.second->has_ca() == locked_context) {
+    if (u.second->has_ca()) {
       u.second->new_slot(slot_tx);
     }
   }
@@ -278,88 +338,101 @@ void sched_worker_manager::update_ue_db(slot_point slot_tx, bool locked_context)
 
 void sched_worker_manager::run_slot(slot_point slot_tx, uint32_t cc, dl_sched_res_t& dl_res, ul_sched_t& ul_res)
 {
+  if (cfg.sched_cfg.lookahead_slots == 0) {
+    generate_slot(slot_tx, cc);
+  } else {
+    fetch_pipelined_slot(slot_tx, cc);
+  }
+
+  // Post-process and copy results to intermediate buffer
+  save_sched_result(slot_tx, cc, dl_res, ul_res);
+}
+
+void sched_worker_manager::generate_slot(slot_point slot_tx, uint32_t cc)
+{
+  if (slot_barrier.stopped()) {
+    return;
+  }
+
   // Fill DL signalling messages that do not depend on UEs state
   serv_cell_manager& serv_cell = *cells[cc];
   bwp_slot_grid&     bwp_slot  = serv_cell.bwps[0].grid[slot_tx];
   sched_dl_signalling(*serv_cell.bwps[0].cfg, slot_tx, bwp_slot.ssb, bwp_slot.nzp_csi_rs);
 
   // Synchronization point between CC workers, to avoid concurrency in UE state access
-  srsran::bounded_vector<std::condition_variable*, SRSRAN_MAX_CARRIERS> waiting_cvars;
-  {
-    std::unique_lock<std::mutex> lock(slot_mutex);
-    while (current_slot.valid() and current_slot != slot_tx) {
-      // Wait for previous slot to finish
-      cc_worker_list[cc]->waiting++;
-      cc_worker_list[cc]->cvar.wait(lock);
-      cc_worker_list[cc]->waiting--;
-    }
-    if (not current_slot.valid()) {
-      /* First Worker to start slot */
-
-      // process non-cc specific feedback if pending for UEs with CA
-      // NOTE: there is no parallelism in these operations
-      slot_events.clear();
-      {
-        std::lock_guard<std::mutex> ev_lock(event_mutex);
-        next_slot_events.swap(slot_events);
-      }
-      update_ue_db(slot_tx, true);
-
-      // mark the start of slot. awake remaining workers if locking on the mutex
-      current_slot = slot_tx;
-      worker_count.store(static_cast<int>(cc_worker_list.size()), std::memory_order_relaxed);
-      for (auto& w : cc_worker_list) {
-        if (w->waiting > 0) {
-          waiting_cvars.push_back(&w->cvar);
-        }
-      }
-      lock.unlock();
-      for (auto& w : waiting_cvars) {
-        w->notify_one();
-      }
-      waiting_cvars.clear();
-    }
+  if (slot_barrier.enter_slot(slot_tx)) {
+    /* First Worker to start slot */
+
+    // process non-cc specific feedback if pending, and prepare UEs with CA for the new slot
+    // NOTE: there is no parallelism in these operations
+    update_ue_db(slot_tx);
+    slot_barrier.finish_setup(slot_tx);
+  } else {
+    slot_barrier.wait_setup(slot_tx);
+  }
+  if (slot_barrier.stopped()) {
+    return;
   }
 
   /* Parallel Region */
 
-  // process non-cc specific feedback if pending (e.g. SRs, buffer updates, UE config) for UEs without CA
-  update_ue_db(slot_tx, false);
+  // prepare UEs without CA whose PCell is this carrier for the new slot
+  for (auto& u : ue_db) {
+    if (not u.second->has_ca() and u.second->pcell_cc() == cc) {
+      u.second->new_slot(slot_tx);
+    }
+  }
 
   // process pending feedback, generate {slot, cc} scheduling decision
   cc_worker_list[cc]->worker.run(slot_tx, ue_db);
 
-  // decrement the number of active workers
-  int rem_workers = worker_count.fetch_sub(1, std::memory_order_release) - 1;
-  srsran_assert(rem_workers >= 0, "invalid number of calls to run_slot(slot, cc)");
-  if (rem_workers == 0) {
-    /* Last Worker to finish slot */
-
-    // Signal the release of slot if it is the last worker that finished its own generation
-    std::unique_lock<std::mutex> lock(slot_mutex);
-    current_slot = {};
+  // decrement the number of active workers. The last one releases the slot
+  slot_barrier.leave_slot();
+}
 
-    // All the workers of the same slot have finished. Synchronize scheduling decisions with UEs state
-    for (auto& c : cc_worker_list) {
-      if (c->waiting > 0) {
-        waiting_cvars.push_back(&c->cvar);
-      }
-    }
+void sched_worker_manager::fetch_pipelined_slot(slot_point slot_tx, uint32_t cc)
+{
+  cc_context& c          = *cc_worker_list[cc];
+  auto        is_ready   = [&c]() { return c.nof_generated.load(std::memory_order_acquire) != c.nof_fetched; };
+  uint32_t    lookahead  = cfg.sched_cfg.lookahead_slots;
+  bool        is_pending = c.nof_requested != c.nof_fetched;
+
+  // Discard the decisions of the slots that the caller skipped
+  while (is_pending and c.next_fetch_slot < slot_tx) {
+    slot_barrier.wait_for(is_ready);
+    logger.warning("SCHED: Discarding decisions of slot=%d, cc=%d", c.next_fetch_slot.to_uint(), cc);
+    cells[cc]->bwps[0].grid[c.next_fetch_slot].reset();
+    c.next_fetch_slot++;
+    c.nof_fetched++;
+    is_pending = c.nof_requested != c.nof_fetched;
+  }
+  if (not is_pending) {
+    // Empty pipeline (e.g. first slot). Start generating from slot_tx
+    c.next_fetch_slot = slot_tx;
+  } else if (c.next_fetch_slot != slot_tx) {
+    logger.error("SCHED: slot=%d, cc=%d was requested after its decisions were discarded", slot_tx.to_uint(), cc);
+    return;
+  }
 
-    // Awake waiting workers
-    lock.unlock();
-    for (auto& c : waiting_cvars) {
-      c->notify_one();
-    }
+  // Keep "lookahead" slots being generated ahead of slot_tx
+  while (c.nof_requested - c.nof_fetched <= lookahead) {
+    slot_point slot_gen = c.next_fetch_slot + (c.nof_requested - c.nof_fetched);
+    c.pipeline->push_task([this, slot_gen, cc]() {
+      generate_slot(slot_gen, cc);
+      cc_worker_list[cc]->nof_generated.fetch_add(1, std::memory_order_release);
+    });
+    c.nof_requested++;
   }
 
-  // Post-process and copy results to intermediate buffer
-  save_sched_result(slot_tx, cc, dl_res, ul_res);
+  // Wait for the decisions of slot_tx
+  slot_barrier.wait_for(is_ready);
+  c.next_fetch_slot++;
+  c.nof_fetched++;
 }
 
 void sched_worker_manager::get_metrics(mac_metrics_t& metrics)
 {
-  std::unique_lock<std::mutex> lock(slot_mutex);
+  std::lock_guard<std::mutex> lock(ue_db_mutex);
   get_metrics_nolocking(metrics);
 }
 
@@ -392,10 +465,15 @@ void sched_worker_manager::get_metrics_nolocking(mac_metrics_t& metrics)
     if (ue_db.contains(ue_metric.rnti) and ue_db[ue_metric.rnti]->carriers[0] != nullptr) {
       auto&                       ue_cc = *ue_db[ue_metric.rnti]->carriers[0];
       std::lock_guard<std::mutex> lock(ue_cc.metrics_mutex);
-      ue_metric.tx_brate  = ue_cc.metrics.tx_brate;
-      ue_metric.tx_errors = ue_cc.metrics.tx_errors;
-      ue_metric.tx_pkts   = ue_cc.metrics.tx_pkts;
-      ue_cc.metrics       = {};
+      ue_metric.tx_brate      = ue_cc.metrics.tx_brate;
+      ue_metric.tx_errors     = ue_cc.metrics.tx_errors;
+      ue_metric.tx_pkts       = ue_cc.metrics.tx_pkts;
+      ue_metric.dl_cqi_offset = ue_cc.metrics.dl_cqi_offset;
+      ue_metric.ul_snr_offset = ue_cc.metrics.ul_snr_offset;
+      ue_cc.metrics           = {};
+      // The link adaptation offsets are kept across metric periods
+      ue_cc.metrics.dl_cqi_offset = ue_metric.dl_cqi_offset;
+      ue_cc.metrics.ul_snr_offset = ue_metric.ul_snr_offset;
     }
   }
 }
@@ -25,7 +25,9 @@
 #include "srsenb/hdr/stack/mac/sched.h"
 #include "srsenb/hdr/stack/mac/sched_carrier.h"
 #include "srsenb/hdr/stack/mac/sched_helpers.h"
+#include "srsran/srslog/event_trace.h"
 #include "srsran/srslog/srslog.h"
+#include <numeric>
 
 #define Console(fmt, ...) srsran::console(fmt, ##__VA_ARGS__)
 #define Error(fmt, ...) srslog::fetch_basic_logger("MAC").error(fmt, ##__VA_ARGS__)
@@ -40,7 +42,10 @@ namespace srsenb {
  *
  *******************************************************/
 
-sched::sched() {}
+/// Max number of UE events pending to be applied. When full, the producer applies the pending events with the lock held
+static const size_t ue_event_queue_size = 4096;
+
+sched::sched() : ue_events(ue_event_queue_size) {}
 
 sched::~sched() {}
 
@@ -52,6 +57,11 @@ void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
   // Initialize first carrier scheduler
   carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, 0, &sched_results});
 
+  // Workers generating the carriers with no UEs in common in parallel
+  if (sched_cfg.nof_cc_workers > 0) {
+    cc_workers.reset(new srsran::task_thread_pool(sched_cfg.nof_cc_workers));
+  }
+
   reset();
 }
 
@@ -61,7 +71,9 @@ int sched::reset()
   for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
     c->reset();
   }
+  ue_events.clear();
   ue_db.clear();
+  cc_groups_outdated = true;
   return 0;
 }
 
@@ -91,7 +103,8 @@ int sched::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
     carrier_schedulers[i]->carrier_cfg(sched_cell_params[i]);
   }
 
-  configured = true;
+  cc_groups_outdated = true;
+  configured         = true;
   return 0;
 }
 
@@ -106,9 +119,11 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
   {
     // config existing user
     std::lock_guard<std::mutex> lock(sched_mutex);
-    auto                        it = ue_db.find(rnti);
+    apply_pending_events();
+    auto it = ue_db.find(rnti);
     if (it != ue_db.end()) {
       it->second->set_cfg(ue_cfg);
+      cc_groups_outdated = true;
       return SRSRAN_SUCCESS;
     }
   }
@@ -117,17 +132,24 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
   std::unique_ptr<sched_ue>   ue{new sched_ue(rnti, sched_cell_params, ue_cfg)};
   std::lock_guard<std::mutex> lock(sched_mutex);
   ue_db.insert(rnti, std::move(ue));
+  cc_groups_outdated = true;
   return SRSRAN_SUCCESS;
 }
 
 int sched::ue_rem(uint16_t rnti)
 {
-  std::lock_guard<std::mutex> lock(sched_mutex);
-  if (ue_db.contains(rnti)) {
+  // The UE is destroyed after releasing the lock, so that the removal of many UEs does not stall the TTI processing
+  std::unique_ptr<sched_ue> removed_ue;
+  {
+    std::lock_guard<std::mutex> lock(sched_mutex);
+    apply_pending_events();
+    if (not ue_db.contains(rnti)) {
+      Error("User rnti=0x%x not found", rnti);
+      return SRSRAN_ERROR;
+    }
+    removed_ue = std::move(ue_db[rnti]);
     ue_db.erase(rnti);
-  } else {
-    Error("User rnti=0x%x not found", rnti);
-    return SRSRAN_ERROR;
+    cc_groups_outdated = true;
   }
   return SRSRAN_SUCCESS;
 }
@@ -176,86 +198,106 @@ uint32_t sched::get_ul_buffer(uint16_t rnti)
 
 int sched::dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue)
 {
-  return ue_db_access_locked(rnti, [&](sched_ue& ue) { ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue); });
+  return enqueue_ue_event(rnti, [lc_id, tx_queue, prio_tx_queue](sched_ue& ue) {
+    ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue);
+  });
 }
 
 int sched::dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds)
 {
-  return ue_db_access_locked(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
+  return enqueue_ue_event(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
 }
 
 int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
 {
-  int ret = -1;
-  ue_db_access_locked(
+  return enqueue_cc_event(
+      enb_cc_idx,
       rnti,
-      [&](sched_ue& ue) { ret = ue.set_ack_info(tti_point{tti_rx}, enb_cc_idx, tb_idx, ack); },
+      [tti_rx, enb_cc_idx, tb_idx, ack](sched_ue& ue) {
+        int tbs = ue.set_ack_info(tti_point{tti_rx}, enb_cc_idx, tb_idx, ack);
+        if (tbs > 0) {
+          ue.save_dl_tx_metrics(ack, tbs);
+        }
+      },
       __PRETTY_FUNCTION__);
-  return ret;
 }
 
 int sched::ul_crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, bool crc)
 {
-  return ue_db_access_locked(
-      rnti, [tti_rx, enb_cc_idx, crc](sched_ue& ue) { ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc); });
+  return enqueue_cc_event(enb_cc_idx, rnti, [tti_rx, enb_cc_idx, crc](sched_ue& ue) {
+    ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc);
+  });
 }
 
 int sched::dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
 {
-  return ue_db_access_locked(
-      rnti, [tti, enb_cc_idx, ri_value](sched_ue& ue) { ue.set_dl_ri(tti_point{tti}, enb_cc_idx, ri_value); });
+  return enqueue_cc_event(enb_cc_idx, rnti, [tti, enb_cc_idx, ri_value](sched_ue& ue) {
+    ue.set_dl_ri(tti_point{tti}, enb_cc_idx, ri_value);
+  });
 }
 
 int sched::dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)
 {
-  return ue_db_access_locked(
-      rnti, [tti, enb_cc_idx, pmi_value](sched_ue& ue) { ue.set_dl_pmi(tti_point{tti}, enb_cc_idx, pmi_value); });
+  return enqueue_cc_event(enb_cc_idx, rnti, [tti, enb_cc_idx, pmi_value](sched_ue& ue) {
+    ue.set_dl_pmi(tti_point{tti}, enb_cc_idx, pmi_value);
+  });
 }
 
 int sched::dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(
-      rnti, [tti, enb_cc_idx, cqi_value](sched_ue& ue) { ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value); });
+  return enqueue_cc_event(enb_cc_idx, rnti, [tti, enb_cc_idx, cqi_value](sched_ue& ue) {
+    ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value);
+  });
 }
 
 int sched::dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(rnti, [tti, enb_cc_idx, cqi_value, sb_idx](sched_ue& ue) {
+  return enqueue_cc_event(enb_cc_idx, rnti, [tti, enb_cc_idx, cqi_value, sb_idx](sched_ue& ue) {
     ue.set_dl_sb_cqi(tti_point{tti}, enb_cc_idx, sb_idx, cqi_value);
   });
 }
 
 int sched::dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)
 {
+  if (enb_cc_idx >= carrier_schedulers.size()) {
+    Error("SCHED: Invalid carrier index %d for RACH of rnti=0x%x", enb_cc_idx, rar_info.temp_crnti);
+    return SRSRAN_ERROR;
+  }
+  if (carrier_schedulers[enb_cc_idx]->enqueue_rach_info(rar_info)) {
+    return SRSRAN_SUCCESS;
+  }
+  // Queue is full. Apply the RACH directly, after the ones already queued
   std::lock_guard<std::mutex> lock(sched_mutex);
+  apply_pending_events();
   return carrier_schedulers[enb_cc_idx]->dl_rach_info(rar_info);
 }
 
 int sched::ul_snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code)
 {
-  return ue_db_access_locked(rnti,
-                             [&](sched_ue& ue) { ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code); });
+  return enqueue_cc_event(enb_cc_idx, rnti, [tti_rx, enb_cc_idx, snr, ul_ch_code](sched_ue& ue) {
+    ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code);
+  });
 }
 
 int sched::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
 {
-  return ue_db_access_locked(rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
+  return enqueue_ue_event(rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
 }
 
 int sched::ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes)
 {
-  return ue_db_access_locked(rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
+  return enqueue_ue_event(rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
 }
 
 int sched::ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)
 {
-  return ue_db_access_locked(
+  return enqueue_ue_event(
       rnti, [phr, ul_nof_prb](sched_ue& ue) { ue.ul_phr(phr, ul_nof_prb); }, __PRETTY_FUNCTION__);
 }
 
 int sched::ul_sr_info(uint32_t tti, uint16_t rnti)
 {
-  return ue_db_access_locked(
+  return enqueue_ue_event(
       rnti, [](sched_ue& ue) { ue.set_sr(); }, __PRETTY_FUNCTION__);
 }
 
@@ -301,6 +343,23 @@ std::array<int, SRSRAN_MAX_CARRIERS> sched::get_enb_ue_activ_cc_map(uint16_t rnt
   return ret;
 }
 
+sched_interface::ue_dl_tx_metrics_t sched::read_dl_tx_metrics(uint16_t rnti)
+{
+  ue_dl_tx_metrics_t ret;
+  ue_db_access_locked(
+      rnti, [&ret](sched_ue& ue) { ret = ue.read_dl_tx_metrics(); }, nullptr, false);
+  return ret;
+}
+
+sched_interface::pdcch_metrics_t sched::read_pdcch_metrics(uint32_t enb_cc_idx)
+{
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (enb_cc_idx >= carrier_schedulers.size()) {
+    return {};
+  }
+  return carrier_schedulers[enb_cc_idx]->read_pdcch_metrics();
+}
+
 /*******************************************************
  *
  * Main sched functions
@@ -353,17 +412,109 @@ int sched::ul_sched(uint32_t tti, uint32_t enb_cc_idx, srsenb::sched_interface::
 ///       configurations (e.g. different set of activated SCells) in different CC decisions
 void sched::new_tti(tti_point tti_rx)
 {
+  trace_complete_event("sched", "new_tti");
   last_tti = std::max(last_tti, tti_rx);
 
+  // Apply the UE feedback received since the last call
+  apply_pending_events();
+
   // Generate sched results for all CCs, if not yet generated
-  for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+  generate_cc_results(tti_rx);
+}
+
+void sched::generate_cc_results(tti_point tti_rx)
+{
+  if (cc_workers == nullptr or carrier_schedulers.size() == 1) {
+    for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+      if (not is_generated(tti_rx, cc_idx)) {
+        carrier_schedulers[cc_idx]->generate_tti_result(tti_rx);
+      }
+    }
+    return;
+  }
+
+  if (cc_groups_outdated) {
+    update_cc_groups();
+  }
+  if (cc_groups.size() == 1) {
+    generate_cc_group(tti_rx, 0);
+    return;
+  }
+
+  // State shared by all carriers is updated before the carrier groups are generated in parallel
+  for (tti_point t : {tti_rx, tti_rx + MSG3_DELAY_MS}) {
+    if (not sched_results.has_sf(t)) {
+      sched_results.new_tti(t);
+    }
+  }
+  for (auto& u : ue_db) {
+    u.second->new_subframe(tti_rx, 0);
+  }
+
+  // The first group is generated by the calling thread
+  {
+    std::lock_guard<std::mutex> lock(cc_workers_mutex);
+    nof_pending_cc_groups = cc_groups.size() - 1;
+  }
+  for (uint32_t group_idx = 1; group_idx < cc_groups.size(); ++group_idx) {
+    cc_workers->push_task([this, tti_rx, group_idx]() {
+      generate_cc_group(tti_rx, group_idx);
+      std::lock_guard<std::mutex> lock(cc_workers_mutex);
+      if (--nof_pending_cc_groups == 0) {
+        cc_workers_cvar.notify_one();
+      }
+    });
+  }
+  generate_cc_group(tti_rx, 0);
+
+  std::unique_lock<std::mutex> lock(cc_workers_mutex);
+  while (nof_pending_cc_groups > 0) {
+    cc_workers_cvar.wait(lock);
+  }
+}
+
+void sched::generate_cc_group(tti_point tti_rx, uint32_t group_idx)
+{
+  for (uint32_t cc_idx : cc_groups[group_idx]) {
     if (not is_generated(tti_rx, cc_idx)) {
-      // Generate carrier scheduling result
       carrier_schedulers[cc_idx]->generate_tti_result(tti_rx);
     }
   }
 }
 
+/// Group the carriers that share UEs (i.e. are configured for the same CA UE). The carriers of a group are generated
+/// sequentially in increasing index, so that each carrier sees the decisions of the previous ones for the UEs in
+/// common, as in the single-threaded case
+void sched::update_cc_groups()
+{
+  std::vector<uint32_t> root(carrier_schedulers.size());
+  std::iota(root.begin(), root.end(), 0);
+  auto find_root = [&root](uint32_t cc_idx) {
+    while (root[cc_idx] != cc_idx) {
+      cc_idx = root[cc_idx];
+    }
+    return cc_idx;
+  };
+  for (auto& u : ue_db) {
+    const auto& cc_list = u.second->get_ue_cfg().supported_cc_list;
+    for (size_t i = 1; i < cc_list.size(); ++i) {
+      root[find_root(cc_list[i].enb_cc_idx)] = find_root(cc_list[0].enb_cc_idx);
+    }
+  }
+
+  cc_groups.clear();
+  std::vector<int> group_of_root(carrier_schedulers.size(), -1);
+  for (uint32_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+    uint32_t r = find_root(cc_idx);
+    if (group_of_root[r] < 0) {
+      group_of_root[r] = cc_groups.size();
+      cc_groups.emplace_back();
+    }
+    cc_groups[group_of_root[r]].push_back(cc_idx);
+  }
+  cc_groups_outdated = false;
+}
+
 /// Check if TTI result is generated
 bool sched::is_generated(srsran::tti_point tti_rx, uint32_t enb_cc_idx) const
 {
@@ -375,7 +526,8 @@ template <typename Func>
 int sched::ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name, bool log_fail)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
-  auto                        it = ue_db.find(rnti);
+  apply_pending_events();
+  auto it = ue_db.find(rnti);
   if (it != ue_db.end()) {
     f(*it->second);
   } else {
@@ -391,4 +543,66 @@ int sched::ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name, b
   return SRSRAN_SUCCESS;
 }
 
+/// Enqueue an update of the UE state that does not depend on the carrier. Lock-free, unless the queue is full
+template <typename Func>
+int sched::enqueue_ue_event(uint16_t rnti, Func&& f, const char* func_name)
+{
+  ue_event_t ev;
+  ev.rnti      = rnti;
+  ev.func_name = func_name;
+  ev.callback  = std::forward<Func>(f);
+  return apply_or_enqueue_event(ue_events, ev);
+}
+
+/// Enqueue PHY feedback of the given carrier. Lock-free, unless the queue is full
+template <typename Func>
+int sched::enqueue_cc_event(uint32_t enb_cc_idx, uint16_t rnti, Func&& f, const char* func_name)
+{
+  if (enb_cc_idx >= carrier_schedulers.size()) {
+    Error("SCHED: Invalid carrier index %d for rnti=0x%x", enb_cc_idx, rnti);
+    return SRSRAN_ERROR;
+  }
+  ue_event_t ev;
+  ev.rnti      = rnti;
+  ev.func_name = func_name;
+  ev.callback  = std::forward<Func>(f);
+  return apply_or_enqueue_event(carrier_schedulers[enb_cc_idx]->get_feedback_queue(), ev);
+}
+
+int sched::apply_or_enqueue_event(ue_event_queue_t& q, ue_event_t& ev)
+{
+  if (q.try_push(std::move(ev))) {
+    return SRSRAN_SUCCESS;
+  }
+  // Queue is full. Apply the event directly, after the ones already queued
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  apply_pending_events();
+  return apply_ue_event(ue_db, ev);
+}
+
+/// Apply all the pending UE events. Must be called with the sched lock held, which makes the caller the only consumer
+/// of the event queues
+void sched::apply_pending_events()
+{
+  ue_events.consume_all([this](ue_event_t& ev) { apply_ue_event(ue_db, ev); });
+  for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
+    c->apply_pending_events();
+  }
+}
+
+int sched::apply_ue_event(sched_ue_list& ue_db, ue_event_t& ev)
+{
+  auto it = ue_db.find(ev.rnti);
+  if (it == ue_db.end()) {
+    if (ev.func_name != nullptr) {
+      Error("SCHED: User rnti=0x%x not found. Failed to call %s.", ev.rnti, ev.func_name);
+    } else {
+      Error("SCHED: User rnti=0x%x not found.", ev.rnti);
+    }
+    return SRSRAN_ERROR;
+  }
+  ev.callback(*it->second);
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
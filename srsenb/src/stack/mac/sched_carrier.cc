@@ -21,6 +21,7 @@
 
 #include "srsenb/hdr/stack/mac/sched_carrier.h"
 #include "srsenb/hdr/stack/mac/sched_helpers.h"
+#include "srsenb/hdr/stack/mac/schedulers/sched_freq_pf.h"
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_rr.h"
 #include "srsran/common/standard_streams.h"
@@ -330,6 +331,10 @@ void ra_sched::reset()
  *                 Carrier scheduling
  *******************************************************/
 
+/// Max number of PHY feedback events and RACHs of a carrier pending to be applied
+static const size_t feedback_queue_size = 4096;
+static const size_t rach_queue_size     = 64;
+
 sched::carrier_sched::carrier_sched(rrc_interface_mac*       rrc_,
                                     sched_ue_list*           ue_db_,
                                     uint32_t                 enb_cc_idx_,
@@ -338,7 +343,9 @@ sched::carrier_sched::carrier_sched(rrc_interface_mac*       rrc_,
   ue_db(ue_db_),
   logger(srslog::fetch_basic_logger("MAC")),
   enb_cc_idx(enb_cc_idx_),
-  prev_sched_results(sched_results_)
+  prev_sched_results(sched_results_),
+  feedback_queue(feedback_queue_size),
+  rach_queue(rach_queue_size)
 {
   sf_dl_mask.resize(1, 0);
 }
@@ -349,6 +356,16 @@ void sched::carrier_sched::reset()
 {
   ra_sched_ptr.reset();
   bc_sched_ptr.reset();
+  feedback_queue.clear();
+  rach_queue.clear();
+  pdcch_metrics = {};
+}
+
+sched_interface::pdcch_metrics_t sched::carrier_sched::read_pdcch_metrics()
+{
+  sched_interface::pdcch_metrics_t ret = pdcch_metrics;
+  pdcch_metrics                        = {};
+  return ret;
 }
 
 void sched::carrier_sched::carrier_cfg(const sched_cell_params_t& cell_params_)
@@ -364,6 +381,9 @@ void sched::carrier_sched::carrier_cfg(const sched_cell_params_t& cell_params_)
   if (cell_params_.sched_cfg->sched_policy == "time_rr") {
     sched_algo.reset(new sched_time_rr{*cc_cfg, *cell_params_.sched_cfg});
     logger.info("Using time-domain RR scheduling policy for cc=%d", cc_cfg->enb_cc_idx);
+  } else if (cell_params_.sched_cfg->sched_policy == "freq_pf") {
+    sched_algo.reset(new sched_freq_pf{*cc_cfg, *cell_params_.sched_cfg});
+    logger.info("Using frequency-selective PF scheduling policy for cc=%d", cc_cfg->enb_cc_idx);
   } else {
     sched_algo.reset(new sched_time_pf{*cc_cfg, *cell_params_.sched_cfg});
     logger.info("Using time-domain PF scheduling policy for cc=%d", cc_cfg->enb_cc_idx);
@@ -428,6 +448,11 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
   /* Select the winner DCI allocation combination, store all the scheduling results */
   tti_sched->generate_sched_results(*ue_db);
 
+  const sched_interface::pdcch_metrics_t& sf_pdcch_metrics = tti_sched->get_pdcch_metrics();
+  pdcch_metrics.nof_dci_allocs += sf_pdcch_metrics.nof_dci_allocs;
+  pdcch_metrics.nof_dci_blocked += sf_pdcch_metrics.nof_dci_blocked;
+  pdcch_metrics.alloc_time_ns += sf_pdcch_metrics.alloc_time_ns;
+
   /* Reset ue harq pending ack state, clean-up blocked pids */
   for (auto& user : *ue_db) {
     user.second->finish_tti(tti_rx, enb_cc_idx);
@@ -490,4 +515,15 @@ int sched::carrier_sched::dl_rach_info(dl_sched_rar_info_t rar_info)
   return ra_sched_ptr->dl_rach_info(rar_info);
 }
 
+void sched::carrier_sched::apply_pending_events()
+{
+  dl_sched_rar_info_t rar_info;
+  while (rach_queue.try_pop(rar_info)) {
+    if (ra_sched_ptr != nullptr) {
+      ra_sched_ptr->dl_rach_info(rar_info);
+    }
+  }
+  feedback_queue.consume_all([this](ue_event_t& ev) { apply_ue_event(*ue_db, ev); });
+}
+
 } // namespace srsenb
@@ -34,22 +34,28 @@ void sf_sched_result::new_tti(tti_point tti_rx_)
   }
 }
 
-bool sf_sched_result::is_ul_alloc(uint16_t rnti) const
+bool sf_sched_result::is_ul_alloc(const sched_ue& user) const
 {
-  for (const auto& cc : enb_cc_list) {
-    for (const auto& pusch : cc.ul_sched_result.pusch) {
-      if (pusch.dci.rnti == rnti) {
+  for (uint32_t enb_cc_idx = 0; enb_cc_idx < enb_cc_list.size(); ++enb_cc_idx) {
+    if (user.enb_to_ue_cc_idx(enb_cc_idx) < 0) {
+      continue;
+    }
+    for (const auto& pusch : enb_cc_list[enb_cc_idx].ul_sched_result.pusch) {
+      if (pusch.dci.rnti == user.get_rnti()) {
         return true;
       }
     }
   }
   return false;
 }
-bool sf_sched_result::is_dl_alloc(uint16_t rnti) const
+bool sf_sched_result::is_dl_alloc(const sched_ue& user) const
 {
-  for (const auto& cc : enb_cc_list) {
-    for (const auto& data : cc.dl_sched_result.data) {
-      if (data.dci.rnti == rnti) {
+  for (uint32_t enb_cc_idx = 0; enb_cc_idx < enb_cc_list.size(); ++enb_cc_idx) {
+    if (user.enb_to_ue_cc_idx(enb_cc_idx) < 0) {
+      continue;
+    }
+    for (const auto& data : enb_cc_list[enb_cc_idx].dl_sched_result.data) {
+      if (data.dci.rnti == user.get_rnti()) {
         return true;
       }
     }
@@ -135,10 +141,11 @@ alloc_result sf_grid_t::alloc_dl(uint32_t     aggr_idx,
                                  alloc_type_t alloc_type,
                                  rbgmask_t    alloc_mask,
                                  sched_ue*    user,
-                                 bool         has_pusch_grant)
+                                 bool         has_pusch_grant,
+                                 bool         mu_mimo)
 {
-  // Check RBG collision
-  if ((dl_mask & alloc_mask).any()) {
+  // Check RBG collision. UEs paired in MU-MIMO reuse the RBGs of a previous allocation
+  if (not mu_mimo and dl_mask.intersects(alloc_mask)) {
     logger.debug("SCHED: Provided RBG mask collides with allocation previously made.\n");
     return alloc_result::sch_collision;
   }
@@ -184,12 +191,12 @@ alloc_result sf_grid_t::alloc_dl_ctrl(uint32_t aggr_idx, rbg_interval rbg_range,
 }
 
 //! Allocates CCEs and RBs for a user DL data alloc.
-alloc_result sf_grid_t::alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask, bool has_pusch_grant)
+alloc_result sf_grid_t::alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask, bool has_pusch_grant, bool mu_mimo)
 {
   srsran_dci_format_t dci_format = user->get_dci_format();
   uint32_t            nof_bits   = srsran_dci_format_sizeof(&cc_cfg->cfg.cell, nullptr, nullptr, dci_format);
   uint32_t            aggr_idx   = user->get_aggr_level(cc_cfg->enb_cc_idx, nof_bits);
-  alloc_result        ret        = alloc_dl(aggr_idx, alloc_type_t::DL_DATA, user_mask, user, has_pusch_grant);
+  alloc_result        ret        = alloc_dl(aggr_idx, alloc_type_t::DL_DATA, user_mask, user, has_pusch_grant, mu_mimo);
 
   return ret;
 }
@@ -202,7 +209,7 @@ alloc_result sf_grid_t::alloc_ul_data(sched_ue* user, prb_interval alloc, bool n
 
   prbmask_t newmask(ul_mask.size());
   newmask.fill(alloc.start(), alloc.stop());
-  if (strict and (ul_mask & newmask).any()) {
+  if (strict and ul_mask.intersects(newmask)) {
     logger.debug("SCHED: Failed UL allocation. Cause: %s", to_string(alloc_result::sch_collision));
     return alloc_result::sch_collision;
   }
@@ -259,7 +266,7 @@ alloc_result sf_grid_t::reserve_ul_prbs(prb_interval alloc, bool strict)
 alloc_result sf_grid_t::reserve_ul_prbs(const prbmask_t& prbmask, bool strict)
 {
   alloc_result ret = alloc_result::success;
-  if (strict and (ul_mask & prbmask).any()) {
+  if (strict and ul_mask.intersects(prbmask)) {
     if (logger.info.enabled()) {
       fmt::memory_buffer tmp_buffer;
       fmt::format_to(
@@ -465,6 +472,38 @@ bool is_periodic_cqi_expected(const sched_interface::ue_cfg_t& ue_cfg, tti_point
 }
 
 alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask, uint32_t pid)
+{
+  return alloc_dl_user_common(user, user_mask, pid, false);
+}
+
+/// Allocates a UE in the same RBGs of the previously allocated paired_user, with a different precoder (MU-MIMO)
+alloc_result sf_sched::alloc_dl_mu_user(sched_ue* user, uint32_t pid, sched_ue* paired_user)
+{
+  auto pair_it = std::find_if(data_allocs.begin(), data_allocs.end(), [paired_user](const dl_alloc_t& u) {
+    return u.rnti == paired_user->get_rnti();
+  });
+  if (pair_it == data_allocs.end() or pair_it->mu_pair_rnti != SRSRAN_INVALID_RNTI) {
+    return alloc_result::no_rnti_opportunity;
+  }
+  if (user->get_dl_mu_mimo_pmi(get_enb_cc_idx()) < 0 or paired_user->get_dl_mu_mimo_pmi(get_enb_cc_idx()) < 0) {
+    return alloc_result::no_rnti_opportunity;
+  }
+  // The MCS of both UEs is lowered to account for the inter-UE interference, which is not possible for retxs
+  if (not user->get_dl_harq(pid, get_enb_cc_idx()).is_empty() or
+      not paired_user->get_dl_harq(pair_it->pid, get_enb_cc_idx()).is_empty()) {
+    return alloc_result::invalid_grant_params;
+  }
+
+  size_t       pair_idx = pair_it - data_allocs.begin();
+  alloc_result ret      = alloc_dl_user_common(user, pair_it->user_mask, pid, true);
+  if (ret == alloc_result::success) {
+    data_allocs[pair_idx].mu_pair_rnti = user->get_rnti();
+    data_allocs.back().mu_pair_rnti    = paired_user->get_rnti();
+  }
+  return ret;
+}
+
+alloc_result sf_sched::alloc_dl_user_common(sched_ue* user, const rbgmask_t& user_mask, uint32_t pid, bool mu_mimo)
 {
   if (data_allocs.full()) {
     logger.warning("SCHED: Maximum number of DL allocations reached");
@@ -503,7 +542,7 @@ alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask,
     }
   }
 
-  bool has_pusch_grant = is_ul_alloc(user->get_rnti()) or cc_results->is_ul_alloc(user->get_rnti());
+  bool has_pusch_grant = is_ul_alloc(user->get_rnti()) or cc_results->is_ul_alloc(*user);
 
   // Check if there is space in the PUCCH for HARQ ACKs
   const sched_interface::ue_cfg_t& ue_cfg    = user->get_ue_cfg();
@@ -524,7 +563,7 @@ alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask,
   }
 
   // Try to allocate RBGs, PDCCH, and PUCCH
-  alloc_result ret = tti_alloc.alloc_dl_data(user, user_mask, has_pusch_grant);
+  alloc_result ret = tti_alloc.alloc_dl_data(user, user_mask, has_pusch_grant, mu_mimo);
 
   if (ret == alloc_result::no_cch_space and not has_pusch_grant and not data_allocs.empty() and
       user->get_ul_harq(get_tti_tx_ul(), get_enb_cc_idx())->is_empty()) {
@@ -534,7 +573,7 @@ alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask,
     tti_alloc.find_ul_alloc(L, &alloc);
     has_pusch_grant = alloc.length() > 0 and alloc_ul_user(user, alloc) == alloc_result::success;
     if (has_pusch_grant) {
-      ret = tti_alloc.alloc_dl_data(user, user_mask, has_pusch_grant);
+      ret = tti_alloc.alloc_dl_data(user, user_mask, has_pusch_grant, mu_mimo);
     }
   }
   if (ret != alloc_result::success) {
@@ -681,8 +720,27 @@ void sf_sched::set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t&
     const dl_harq_proc& dl_harq     = user->get_dl_harq(data_alloc.pid, cc_cfg->enb_cc_idx);
     bool                is_newtx    = dl_harq.is_empty();
 
-    int tbs = user->generate_dl_dci_format(
-        data_alloc.pid, data, get_tti_tx_dl(), cc_cfg->enb_cc_idx, tti_alloc.get_cfi(), data_alloc.user_mask);
+    // Account for the interference of the UE paired in the same RBGs
+    float mu_corr = -1;
+    if (data_alloc.mu_pair_rnti != SRSRAN_INVALID_RNTI) {
+      mu_corr      = 1;
+      auto pair_it = ue_list.find(data_alloc.mu_pair_rnti);
+      int  pmi     = user->get_dl_mu_mimo_pmi(cc_cfg->enb_cc_idx);
+      if (pair_it != ue_list.end() and pmi >= 0) {
+        int pair_pmi = pair_it->second->get_dl_mu_mimo_pmi(cc_cfg->enb_cc_idx);
+        if (pair_pmi >= 0) {
+          mu_corr = get_pmi_correlation(cc_cfg->cfg.cell.nof_ports, pmi, pair_pmi);
+        }
+      }
+    }
+
+    int tbs = user->generate_dl_dci_format(data_alloc.pid,
+                                           data,
+                                           get_tti_tx_dl(),
+                                           cc_cfg->enb_cc_idx,
+                                           tti_alloc.get_cfi(),
+                                           data_alloc.user_mask,
+                                           mu_corr);
 
     if (tbs <= 0) {
       fmt::memory_buffer str_buffer;
@@ -787,12 +845,16 @@ uci_pusch_t is_uci_included(const sf_sched*        sf_sched,
   }
 
   for (uint32_t enbccidx = 0; enbccidx < other_cc_results.enb_cc_list.size(); ++enbccidx) {
+    // Only the carriers of the UE are visited, as the others may be generated concurrently
+    auto p = user->get_active_cell_index(enbccidx);
+    if (not p.first) {
+      continue;
+    }
     for (uint32_t j = 0; j < other_cc_results.enb_cc_list[enbccidx].ul_sched_result.pusch.size(); ++j) {
       // Checks all the UL grants already allocated for the given rnti
       if (other_cc_results.enb_cc_list[enbccidx].ul_sched_result.pusch[j].dci.rnti == user->get_rnti()) {
-        auto p = user->get_active_cell_index(enbccidx);
         // If the UE CC Idx is the lowest so far
-        if (p.first and p.second < ue_cc_idx) {
+        if (p.second < ue_cc_idx) {
           ue_cc_idx      = p.second;
           sel_enb_cc_idx = enbccidx;
         }
@@ -25,6 +25,7 @@
 #include "srsran/mac/pdu.h"
 #include "srsran/srslog/bundled/fmt/format.h"
 #include <array>
+#include <complex>
 
 #define Debug(fmt, ...) get_mac_logger().debug(fmt, ##__VA_ARGS__)
 #define Info(fmt, ...) get_mac_logger().info(fmt, ##__VA_ARGS__)
@@ -312,6 +313,11 @@ bool sched_cell_params_t::set_cfg(uint32_t                             enb_cc_id
 
   nof_re_table    = generate_nof_re_table(cfg.cell);
   nof_re_lb_table = get_lb_nof_re_x_prb(nof_re_table);
+  if (sched_cfg->mcs_tbs_tables) {
+    mcs_tbs_table.generate(*this);
+  } else {
+    mcs_tbs_table.clear();
+  }
 
   return true;
 }
@@ -423,6 +429,62 @@ uint32_t get_aggr_level(uint32_t nof_bits,
   return l;
 }
 
+float get_pmi_correlation(uint32_t nof_ports, uint32_t pmi1, uint32_t pmi2)
+{
+  using cf = std::complex<float>;
+  const static float sqrt1_2 = 1.0f / std::sqrt(2.0f);
+  const static cf    j{0, 1};
+
+  if (nof_ports == 2) {
+    // Rank-1 codebook for 2 antenna ports, w = [1, v] / sqrt(2)
+    const static std::array<cf, 4> cb2 = {cf{1}, cf{-1}, j, -j};
+    if (pmi1 >= cb2.size() or pmi2 >= cb2.size()) {
+      return 1;
+    }
+    return std::norm(1.0f + cb2[pmi2] * std::conj(cb2[pmi1])) / 4;
+  }
+  if (nof_ports == 4) {
+    // Elements 1..3 of the vectors u_n. The rank-1 precoder is the first column of W_n = I - 2 u_n u_n^H / u_n^H u_n,
+    // i.e. w = [1, -u_n1, -u_n2, -u_n3] / 2
+    const static cf                                a = cf{-1, -1} * sqrt1_2, b = cf{1, -1} * sqrt1_2;
+    const static std::array<std::array<cf, 3>, 16> u = {{{cf{-1}, cf{-1}, cf{-1}},
+                                                         {-j, cf{1}, j},
+                                                         {cf{1}, cf{-1}, cf{1}},
+                                                         {j, cf{1}, -j},
+                                                         {a, -j, b},
+                                                         {b, j, a},
+                                                         {-a, -j, -b},
+                                                         {-b, j, -a},
+                                                         {cf{-1}, cf{1}, cf{1}},
+                                                         {-j, cf{-1}, -j},
+                                                         {cf{1}, cf{1}, cf{-1}},
+                                                         {j, cf{-1}, j},
+                                                         {cf{-1}, cf{-1}, cf{1}},
+                                                         {cf{-1}, cf{1}, cf{-1}},
+                                                         {cf{1}, cf{-1}, cf{-1}},
+                                                         {cf{1}, cf{1}, cf{1}}}};
+    if (pmi1 >= u.size() or pmi2 >= u.size()) {
+      return 1;
+    }
+    cf prod = 1;
+    for (uint32_t i = 0; i < 3; ++i) {
+      prod += std::conj(u[pmi1][i]) * u[pmi2][i];
+    }
+    return std::norm(prod) / 16;
+  }
+  return 1;
+}
+
+uint32_t get_mu_mimo_cqi(uint32_t su_cqi, float corr)
+{
+  if (su_cqi == 0) {
+    return 0;
+  }
+  float sinr_su = srsran_convert_dB_to_power(srsran_cqi_to_snr(su_cqi));
+  float sinr_mu = 1.0f / (2.0f / sinr_su + std::max(corr, 0.0f));
+  return std::min((uint32_t)srsran_cqi_from_snr(srsran_convert_power_to_dB(sinr_mu)), su_cqi);
+}
+
 /*******************************************************
  *          sched_interface helper functions
  *******************************************************/
@@ -149,17 +149,17 @@ tbs_info compute_mcs_and_tbs(uint32_t nof_prb,
   return tbs_info{};
 }
 
-tbs_info compute_min_mcs_and_tbs_from_required_bytes(uint32_t nof_prb,
-                                                     uint32_t nof_re,
-                                                     uint32_t cqi,
-                                                     uint32_t max_mcs,
-                                                     uint32_t req_bytes,
-                                                     bool     is_ul,
-                                                     bool     ulqam64_enabled,
-                                                     bool     use_tbs_index_alt)
+/// Search of the lowest MCS that fits req_bytes, given a function that returns the max MCS/TBS for a given max_mcs
+template <typename MaxMcsToTbs>
+tbs_info compute_min_mcs_and_tbs_from_required_bytes(uint32_t           nof_prb,
+                                                     uint32_t           max_mcs,
+                                                     uint32_t           req_bytes,
+                                                     bool               is_ul,
+                                                     bool               use_tbs_index_alt,
+                                                     const MaxMcsToTbs& max_mcs_to_tbs)
 {
   // get max MCS/TBS that meets max coderate requirements
-  tbs_info tb_max = compute_mcs_and_tbs(nof_prb, nof_re, cqi, max_mcs, is_ul, ulqam64_enabled, use_tbs_index_alt);
+  tbs_info tb_max = max_mcs_to_tbs(max_mcs);
   if (tb_max.tbs_bytes + 8 <= (int)req_bytes or tb_max.mcs == 0) {
     // if mcs cannot be lowered or a decrease in TBS index won't meet req_bytes requirement
     return tb_max;
@@ -173,7 +173,7 @@ tbs_info compute_min_mcs_and_tbs_from_required_bytes(uint32_t nof_prb,
   if (compute_mcs_from_max_tbs(nof_prb, req_bytes * 8U - 1, max_mcs, is_ul, use_tbs_index_alt, mcs_min, tbs_idx_min) !=
       SRSRAN_SUCCESS) {
     // Failed to compute maximum MCS that leads to TBS < req bytes. MCS=0 is likely a valid solution
-    tbs_info tb2 = compute_mcs_and_tbs(nof_prb, nof_re, cqi, 0, is_ul, ulqam64_enabled, use_tbs_index_alt);
+    tbs_info tb2 = max_mcs_to_tbs(0);
     if (tb2.tbs_bytes >= (int)req_bytes) {
       return tb2;
     }
@@ -182,7 +182,7 @@ tbs_info compute_min_mcs_and_tbs_from_required_bytes(uint32_t nof_prb,
 
   // Iterate from min to max MCS until a solution is found
   for (int mcs = mcs_min + 1; mcs < tb_max.mcs; ++mcs) {
-    tbs_info tb2 = compute_mcs_and_tbs(nof_prb, nof_re, cqi, mcs, is_ul, ulqam64_enabled, use_tbs_index_alt);
+    tbs_info tb2 = max_mcs_to_tbs(mcs);
     if (tb2.tbs_bytes >= (int)req_bytes) {
       return tb2;
     }
@@ -190,6 +190,142 @@ tbs_info compute_min_mcs_and_tbs_from_required_bytes(uint32_t nof_prb,
   return tb_max;
 }
 
+tbs_info compute_min_mcs_and_tbs_from_required_bytes(uint32_t nof_prb,
+                                                     uint32_t nof_re,
+                                                     uint32_t cqi,
+                                                     uint32_t max_mcs,
+                                                     uint32_t req_bytes,
+                                                     bool     is_ul,
+                                                     bool     ulqam64_enabled,
+                                                     bool     use_tbs_index_alt)
+{
+  auto max_mcs_to_tbs = [&](uint32_t max_mcs_) {
+    return compute_mcs_and_tbs(nof_prb, nof_re, cqi, max_mcs_, is_ul, ulqam64_enabled, use_tbs_index_alt);
+  };
+  return compute_min_mcs_and_tbs_from_required_bytes(
+      nof_prb, max_mcs, req_bytes, is_ul, use_tbs_index_alt, max_mcs_to_tbs);
+}
+
+/*******************************************************
+ *              Precomputed MCS/TBS table
+ *******************************************************/
+
+sched_mcs_tbs_table::table_idx
+sched_mcs_tbs_table::get_table_idx(bool is_ul, bool ulqam64_enabled, bool use_tbs_index_alt)
+{
+  if (is_ul) {
+    return ulqam64_enabled ? ul_64qam_table : ul_table;
+  }
+  return use_tbs_index_alt ? dl_256qam_table : dl_table;
+}
+
+void sched_mcs_tbs_table::clear()
+{
+  for (auto& t : buckets) {
+    t.clear();
+  }
+  entries.clear();
+}
+
+void sched_mcs_tbs_table::generate(const sched_cell_params_t& cell_params)
+{
+  clear();
+  uint32_t nof_prb = cell_params.nof_prb();
+  for (auto& t : buckets) {
+    t.resize(nof_prb);
+  }
+
+  for (uint32_t n = 1; n <= nof_prb; ++n) {
+    // DL: Lower bound of nof REs of each subframe. Most subframes share the same value
+    for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; ++sf_idx) {
+      uint32_t nof_re = cell_params.nof_re_lb_table[sf_idx][n - 1];
+      add_bucket(dl_table, n, nof_re);
+      add_bucket(dl_256qam_table, n, nof_re);
+    }
+
+    // UL: PUSCH REs without SRS
+    const uint32_t N_srs    = 0;
+    uint32_t       nof_symb = 2 * (SRSRAN_CP_NSYMB(cell_params.cfg.cell.cp) - 1) - N_srs;
+    add_bucket(ul_table, n, nof_symb * n * SRSRAN_NRE);
+    add_bucket(ul_64qam_table, n, nof_symb * n * SRSRAN_NRE);
+  }
+}
+
+void sched_mcs_tbs_table::add_bucket(table_idx t, uint32_t nof_prb, uint32_t nof_re)
+{
+  prb_buckets& prb_bucket_list = buckets[t][nof_prb - 1];
+  for (const re_bucket& b : prb_bucket_list) {
+    if (b.nof_re == nof_re) {
+      return;
+    }
+  }
+  prb_bucket_list.push_back(re_bucket{nof_re, static_cast<uint32_t>(entries.size())});
+
+  bool is_ul             = t == ul_table or t == ul_64qam_table;
+  bool ulqam64_enabled   = t == ul_64qam_table;
+  bool use_tbs_index_alt = t == dl_256qam_table;
+  for (uint32_t cqi = 0; cqi < nof_cqis; ++cqi) {
+    for (uint32_t max_mcs = 0; max_mcs < nof_max_mcs; ++max_mcs) {
+      tbs_info tb =
+          srsenb::compute_mcs_and_tbs(nof_prb, nof_re, cqi, max_mcs, is_ul, ulqam64_enabled, use_tbs_index_alt);
+      entries.push_back(mcs_tbs{static_cast<int16_t>(tb.tbs_bytes), static_cast<uint8_t>(tb.mcs)});
+    }
+  }
+}
+
+const sched_mcs_tbs_table::mcs_tbs*
+sched_mcs_tbs_table::find_row(table_idx t, uint32_t nof_prb, uint32_t nof_re, uint32_t cqi) const
+{
+  if (nof_prb == 0 or nof_prb > buckets[t].size()) {
+    return nullptr;
+  }
+  for (const re_bucket& b : buckets[t][nof_prb - 1]) {
+    if (b.nof_re == nof_re) {
+      // CQIs above 14 lead to the same max coderate
+      return &entries[b.offset + std::min(cqi, nof_cqis - 1) * nof_max_mcs];
+    }
+  }
+  return nullptr;
+}
+
+tbs_info sched_mcs_tbs_table::compute_mcs_and_tbs(uint32_t nof_prb,
+                                                  uint32_t nof_re,
+                                                  uint32_t cqi,
+                                                  uint32_t max_mcs,
+                                                  bool     is_ul,
+                                                  bool     ulqam64_enabled,
+                                                  bool     use_tbs_index_alt) const
+{
+  const mcs_tbs* row = find_row(get_table_idx(is_ul, ulqam64_enabled, use_tbs_index_alt), nof_prb, nof_re, cqi);
+  if (row == nullptr) {
+    return srsenb::compute_mcs_and_tbs(nof_prb, nof_re, cqi, max_mcs, is_ul, ulqam64_enabled, use_tbs_index_alt);
+  }
+  const mcs_tbs& e = row[std::min(max_mcs, nof_max_mcs - 1)];
+  return tbs_info{e.tbs_bytes, e.mcs};
+}
+
+tbs_info sched_mcs_tbs_table::compute_min_mcs_and_tbs_from_required_bytes(uint32_t nof_prb,
+                                                                          uint32_t nof_re,
+                                                                          uint32_t cqi,
+                                                                          uint32_t max_mcs,
+                                                                          uint32_t req_bytes,
+                                                                          bool     is_ul,
+                                                                          bool     ulqam64_enabled,
+                                                                          bool     use_tbs_index_alt) const
+{
+  const mcs_tbs* row = find_row(get_table_idx(is_ul, ulqam64_enabled, use_tbs_index_alt), nof_prb, nof_re, cqi);
+  if (row == nullptr) {
+    return srsenb::compute_min_mcs_and_tbs_from_required_bytes(
+        nof_prb, nof_re, cqi, max_mcs, req_bytes, is_ul, ulqam64_enabled, use_tbs_index_alt);
+  }
+  auto max_mcs_to_tbs = [row](uint32_t max_mcs_) {
+    const mcs_tbs& e = row[std::min(max_mcs_, nof_max_mcs - 1)];
+    return tbs_info{e.tbs_bytes, e.mcs};
+  };
+  return srsenb::compute_min_mcs_and_tbs_from_required_bytes(
+      nof_prb, max_mcs, req_bytes, is_ul, use_tbs_index_alt, max_mcs_to_tbs);
+}
+
 int generate_ra_bc_dci_format1a_common(srsran_dci_dl_t&           dci,
                                        uint16_t                   rnti,
                                        tti_point                  tti_tx_dl,
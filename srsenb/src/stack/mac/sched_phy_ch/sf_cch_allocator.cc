@@ -22,6 +22,7 @@
 #include "srsenb/hdr/stack/mac/sched_phy_ch/sf_cch_allocator.h"
 #include "srsenb/hdr/stack/mac/sched_grid.h"
 #include "srsran/srslog/bundled/fmt/format.h"
+#include <chrono>
 
 namespace srsenb {
 
@@ -38,8 +39,10 @@ void sf_cch_allocator::init(const sched_cell_params_t& cell_params_)
   cc_cfg           = &cell_params_;
   pucch_cfg_common = cc_cfg->pucch_cfg_common;
   dci_record_list.reserve(16);
-  last_dci_dfs.reserve(16);
-  temp_dci_dfs.reserve(16);
+  for (alloc_tree_t& tree : cfi_trees) {
+    tree.reserve(16);
+  }
+  temp_tree.reserve(16);
 }
 
 void sf_cch_allocator::new_tti(tti_point tti_rx_)
@@ -47,9 +50,12 @@ void sf_cch_allocator::new_tti(tti_point tti_rx_)
   tti_rx = tti_rx_;
 
   dci_record_list.clear();
-  last_dci_dfs.clear();
+  for (alloc_tree_t& tree : cfi_trees) {
+    tree.clear();
+  }
   current_cfix     = cc_cfg->sched_cfg->min_nof_ctrl_symbols - 1;
   current_max_cfix = cc_cfg->sched_cfg->max_nof_ctrl_symbols - 1;
+  metrics          = {};
 }
 
 const cce_cfi_position_table*
@@ -70,18 +76,70 @@ sf_cch_allocator::get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uin
   return nullptr;
 }
 
+const sf_cch_allocator::candidate_list_t& sf_cch_allocator::get_candidates(alloc_record& record, uint32_t cfix)
+{
+  candidate_list_t& cands = record.candidates[cfix];
+  if (record.candidates_set[cfix]) {
+    return cands;
+  }
+  record.candidates_set[cfix] = true;
+  cands.clear();
+
+  // Get DCI Location Table
+  const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, cfix);
+  if (dci_locs == nullptr) {
+    return cands;
+  }
+  const cce_position_list& dci_pos_list = (*dci_locs)[record.aggr_idx];
+
+  // Filter out the positions that are never valid for this DCI, independently of the other allocations
+  for (uint32_t pos_idx = 0; pos_idx < dci_pos_list.size(); ++pos_idx) {
+    dci_candidate cand;
+    cand.ncce        = dci_pos_list[pos_idx];
+    cand.dci_pos_idx = pos_idx;
+    cand.pucch_n_prb = -1;
+
+    if (record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci) {
+      // The UE needs to allocate space in PUCCH for HARQ-ACK
+      pucch_cfg_common.n_pucch = cand.ncce + pucch_cfg_common.N_pucch_1;
+
+      if (is_pucch_sr_collision(record.user->get_ue_cfg().pucch_cfg, to_tx_dl_ack(tti_rx), pucch_cfg_common.n_pucch)) {
+        // avoid collision of HARQ-ACK with own SR n(1)_pucch
+        continue;
+      }
+
+      cand.pucch_n_prb = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg_common, 0);
+      int low_rb       = cand.pucch_n_prb < (int)cc_cfg->cfg.cell.nof_prb / 2
+                             ? cand.pucch_n_prb
+                             : cc_cfg->cfg.cell.nof_prb - cand.pucch_n_prb - 1;
+      if (cc_cfg->sched_cfg->pucch_harq_max_rb > 0 && low_rb >= cc_cfg->sched_cfg->pucch_harq_max_rb) {
+        // PUCCH allocation would fall outside the maximum allowed PUCCH HARQ region. Try another CCE position
+        logger.info("Skipping PDCCH allocation for CCE=%d due to PUCCH HARQ falling outside region\n", cand.ncce);
+        continue;
+      }
+    }
+
+    cand.mask.resize(cc_cfg->nof_cce_table[cfix]);
+    cand.mask.fill(cand.ncce, cand.ncce + (1U << record.aggr_idx));
+    cands.push_back(cand);
+  }
+  return cands;
+}
+
 bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sched_ue* user, bool has_pusch_grant)
 {
-  temp_dci_dfs.clear();
+  auto     tp_start   = std::chrono::steady_clock::now();
   uint32_t start_cfix = current_cfix;
 
-  alloc_record record;
-  record.user       = user;
-  record.aggr_idx   = aggr_idx;
-  record.alloc_type = alloc_type;
-  record.pusch_uci  = has_pusch_grant;
+  dci_record_list.emplace_back();
+  alloc_record& record = dci_record_list.back();
+  record.user          = user;
+  record.aggr_idx      = aggr_idx;
+  record.alloc_type    = alloc_type;
+  record.pusch_uci     = has_pusch_grant;
+  record.candidates_set.fill(false);
 
-  if (is_dl_ctrl_alloc(alloc_type) and nof_allocs() == 0 and cc_cfg->nof_prb() <= 25 and
+  if (is_dl_ctrl_alloc(alloc_type) and nof_allocs() == 1 and cc_cfg->nof_prb() <= 25 and
       current_max_cfix > current_cfix) {
     // Given that CFI is not currently dynamic for ctrl allocs, in case of SIB/RAR alloc and a low number of PRBs,
     // start with an CFI that maximizes nof potential CCE locs
@@ -97,123 +155,108 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
     }
   }
 
-  // Try to allocate grant. If it fails, attempt the same grant, but using a different permutation of past grant DCI
-  // positions
-  do {
-    bool success = alloc_dfs_node(record, 0);
-    if (success) {
-      // DCI record allocation successful
-      dci_record_list.push_back(record);
-
-      if (is_dl_ctrl_alloc(alloc_type)) {
-        // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
-        current_max_cfix = current_cfix;
-      }
-      return true;
+  // Try to fit the grant in the allocation of the current CFI. If it fails, attempt the same with the higher CFIs
+  bool success = false;
+  for (uint32_t cfix = current_cfix; cfix <= current_max_cfix and not success; ++cfix) {
+    if (alloc_tree(cfix)) {
+      success      = true;
+      current_cfix = cfix;
     }
-    if (temp_dci_dfs.empty()) {
-      temp_dci_dfs = last_dci_dfs;
+  }
+
+  if (success) {
+    if (is_dl_ctrl_alloc(alloc_type)) {
+      // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
+      current_max_cfix = current_cfix;
     }
-  } while (get_next_dfs());
+  } else {
+    // Revert steps to initial state, before dci record allocation was attempted. No CFI tree contains the new DCI
+    dci_record_list.pop_back();
+    current_cfix = start_cfix;
+    metrics.nof_dci_blocked++;
+  }
 
-  // Revert steps to initial state, before dci record allocation was attempted
-  last_dci_dfs.swap(temp_dci_dfs);
-  current_cfix = start_cfix;
-  return false;
+  metrics.nof_dci_allocs++;
+  metrics.alloc_time_ns +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp_start).count();
+  return success;
 }
 
-bool sf_cch_allocator::get_next_dfs()
+bool sf_cch_allocator::alloc_tree(uint32_t cfix)
 {
-  do {
-    uint32_t start_child_idx = 0;
-    if (last_dci_dfs.empty()) {
-      // If we reach root, increase CFI
-      current_cfix++;
-      if (current_cfix > current_max_cfix) {
-        return false;
-      }
-    } else {
-      // Attempt to re-add last tree node, but with a higher node child index
-      start_child_idx = last_dci_dfs.back().dci_pos_idx + 1;
-      last_dci_dfs.pop_back();
+  alloc_tree_t& tree = cfi_trees[cfix];
+
+  // Place the DCIs still missing in this CFI without moving the ones already placed. If a DCI does not fit, move the
+  // previous DCIs to their next candidate positions, in DFS order, until all DCIs fit or the step budget runs out
+  bool     backed_up      = false;
+  uint32_t nof_steps      = 0;
+  uint32_t start_cand_idx = 0;
+  while (true) {
+    while (tree.size() < dci_record_list.size() and push_node(cfix, dci_record_list[tree.size()], start_cand_idx)) {
+      start_cand_idx = 0;
     }
-    while (last_dci_dfs.size() < dci_record_list.size() and
-           alloc_dfs_node(dci_record_list[last_dci_dfs.size()], start_child_idx)) {
-      start_child_idx = 0;
+    if (tree.size() == dci_record_list.size()) {
+      return true;
     }
-  } while (last_dci_dfs.size() < dci_record_list.size());
+    if (tree.empty() or nof_steps >= MAX_BACKTRACK_STEPS) {
+      break;
+    }
+    if (not backed_up) {
+      temp_tree = tree;
+      backed_up = true;
+    }
+    start_cand_idx = tree.back().dci_pos_idx + 1;
+    tree.pop_back();
+    nof_steps++;
+  }
 
-  // Finished computation of next DFS node
-  return true;
+  // Restore the last valid allocation of this CFI
+  if (backed_up) {
+    tree.swap(temp_tree);
+  }
+  return false;
 }
 
-bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
+bool sf_cch_allocator::push_node(uint32_t cfix, alloc_record& record, uint32_t start_cand_idx)
 {
-  // Get DCI Location Table
-  const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, current_cfix);
-  if (dci_locs == nullptr or (*dci_locs)[record.aggr_idx].empty()) {
-    return false;
-  }
-  const cce_position_list& dci_pos_list = (*dci_locs)[record.aggr_idx];
-  if (start_dci_idx >= dci_pos_list.size()) {
-    return false;
-  }
+  alloc_tree_t&           tree  = cfi_trees[cfix];
+  const candidate_list_t& cands = get_candidates(record, cfix);
 
   tree_node node;
-  node.dci_pos_idx = start_dci_idx;
-  node.dci_pos.L   = record.aggr_idx;
-  node.rnti        = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
-  node.current_mask.resize(nof_cces());
+  node.record_idx = tree.size();
+  node.dci_pos.L  = record.aggr_idx;
+  node.rnti       = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
   // get cumulative pdcch & pucch masks
-  if (not last_dci_dfs.empty()) {
-    node.total_mask       = last_dci_dfs.back().total_mask;
-    node.total_pucch_mask = last_dci_dfs.back().total_pucch_mask;
+  if (not tree.empty()) {
+    node.total_mask       = tree.back().total_mask;
+    node.total_pucch_mask = tree.back().total_pucch_mask;
   } else {
-    node.total_mask.resize(nof_cces());
+    node.total_mask.resize(cc_cfg->nof_cce_table[cfix]);
     node.total_pucch_mask.resize(cc_cfg->nof_prb());
   }
 
-  for (; node.dci_pos_idx < dci_pos_list.size(); ++node.dci_pos_idx) {
-    node.dci_pos.ncce = dci_pos_list[node.dci_pos_idx];
-
-    if (record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci) {
-      // The UE needs to allocate space in PUCCH for HARQ-ACK
-      pucch_cfg_common.n_pucch = node.dci_pos.ncce + pucch_cfg_common.N_pucch_1;
-
-      if (is_pucch_sr_collision(record.user->get_ue_cfg().pucch_cfg, to_tx_dl_ack(tti_rx), pucch_cfg_common.n_pucch)) {
-        // avoid collision of HARQ-ACK with own SR n(1)_pucch
-        continue;
-      }
-
-      node.pucch_n_prb = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg_common, 0);
-      if (not cc_cfg->sched_cfg->pucch_mux_enabled and node.total_pucch_mask.test(node.pucch_n_prb)) {
-        // PUCCH allocation would collide with other PUCCH/PUSCH grants. Try another CCE position
-        continue;
-      }
-      int low_rb = node.pucch_n_prb < (int)cc_cfg->cfg.cell.nof_prb / 2
-                       ? node.pucch_n_prb
-                       : cc_cfg->cfg.cell.nof_prb - node.pucch_n_prb - 1;
-      if (cc_cfg->sched_cfg->pucch_harq_max_rb > 0 && low_rb >= cc_cfg->sched_cfg->pucch_harq_max_rb) {
-        // PUCCH allocation would fall outside the maximum allowed PUCCH HARQ region. Try another CCE position
-        logger.info("Skipping PDCCH allocation for CCE=%d due to PUCCH HARQ falling outside region\n",
-                    node.dci_pos.ncce);
-        continue;
-      }
+  for (uint32_t cand_idx = start_cand_idx; cand_idx < cands.size(); ++cand_idx) {
+    const dci_candidate& cand = cands[cand_idx];
+    if (cand.pucch_n_prb >= 0 and not cc_cfg->sched_cfg->pucch_mux_enabled and
+        node.total_pucch_mask.test(cand.pucch_n_prb)) {
+      // PUCCH allocation would collide with other PUCCH/PUSCH grants. Try another CCE position
+      continue;
     }
-
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
+    if ((node.total_mask & cand.mask).any()) {
       // there is a PDCCH collision. Try another CCE position
       continue;
     }
 
     // Allocation successful
-    node.total_mask |= node.current_mask;
+    node.dci_pos_idx  = cand_idx;
+    node.dci_pos.ncce = cand.ncce;
+    node.pucch_n_prb  = cand.pucch_n_prb;
+    node.current_mask = cand.mask;
+    node.total_mask |= cand.mask;
     if (node.pucch_n_prb >= 0) {
       node.total_pucch_mask.set(node.pucch_n_prb);
     }
-    last_dci_dfs.push_back(node);
+    tree.push_back(node);
     return true;
   }
 
@@ -224,9 +267,13 @@ void sf_cch_allocator::rem_last_dci()
 {
   assert(not dci_record_list.empty());
 
-  // Remove DCI record
-  last_dci_dfs.pop_back();
+  // Remove DCI record, and its position in the CFI trees that contain it
   dci_record_list.pop_back();
+  for (alloc_tree_t& tree : cfi_trees) {
+    if (tree.size() > dci_record_list.size()) {
+      tree.pop_back();
+    }
+  }
 }
 
 void sf_cch_allocator::get_allocs(alloc_result_t* vec, pdcch_mask_t* tot_mask, size_t idx) const
@@ -234,18 +281,18 @@ void sf_cch_allocator::get_allocs(alloc_result_t* vec, pdcch_mask_t* tot_mask, s
   if (vec != nullptr) {
     vec->clear();
 
-    vec->resize(last_dci_dfs.size());
-    for (uint32_t i = 0; i < last_dci_dfs.size(); ++i) {
-      (*vec)[i] = &last_dci_dfs[i];
+    vec->resize(cfi_trees[current_cfix].size());
+    for (uint32_t i = 0; i < cfi_trees[current_cfix].size(); ++i) {
+      (*vec)[i] = &cfi_trees[current_cfix][i];
     }
   }
 
   if (tot_mask != nullptr) {
-    if (last_dci_dfs.empty()) {
+    if (cfi_trees[current_cfix].empty()) {
       tot_mask->resize(nof_cces());
       tot_mask->reset();
     } else {
-      *tot_mask = last_dci_dfs.back().total_mask;
+      *tot_mask = cfi_trees[current_cfix].back().total_mask;
     }
   }
 }
@@ -261,7 +308,7 @@ std::string sf_cch_allocator::result_to_string(bool verbose) const
                    get_cfi(),
                    nof_cces(),
                    nof_allocs(),
-                   last_dci_dfs.back().total_mask);
+                   cfi_trees[current_cfix].back().total_mask);
     alloc_result_t vec;
     get_allocs(&vec);
     if (verbose) {
@@ -140,6 +140,23 @@ void sched_ue::ul_buffer_add(uint8_t lcid, uint32_t bytes)
   lch_handler.ul_buffer_add(lcid, bytes);
 }
 
+void sched_ue::save_dl_tx_metrics(bool ack, uint32_t tbs)
+{
+  if (ack) {
+    dl_tx_metrics.tx_bytes += tbs;
+  } else {
+    dl_tx_metrics.tx_errors++;
+  }
+  dl_tx_metrics.tx_pkts++;
+}
+
+sched_interface::ue_dl_tx_metrics_t sched_ue::read_dl_tx_metrics()
+{
+  sched_interface::ue_dl_tx_metrics_t ret = dl_tx_metrics;
+  dl_tx_metrics                           = {};
+  return ret;
+}
+
 void sched_ue::ul_phr(int phr, uint32_t grant_nof_prb)
 {
   cells[cfg.supported_cc_list[0].enb_cc_idx].tpc_fsm.set_phr(phr, grant_nof_prb);
@@ -313,10 +330,11 @@ tbs_info sched_ue::allocate_new_dl_mac_pdu(sched::dl_sched_data_t* data,
                                            tti_point               tti_tx_dl,
                                            uint32_t                enb_cc_idx,
                                            uint32_t                cfi,
-                                           uint32_t                tb)
+                                           uint32_t                tb,
+                                           float                   mu_corr)
 {
   srsran_dci_dl_t* dci     = &data->dci;
-  tbs_info         tb_info = compute_mcs_and_tbs(enb_cc_idx, tti_tx_dl, user_mask, cfi, *dci);
+  tbs_info         tb_info = compute_mcs_and_tbs(enb_cc_idx, tti_tx_dl, user_mask, cfi, *dci, mu_corr);
 
   // Allocate MAC PDU (subheaders, CEs, and SDUS)
   int rem_tbs = tb_info.tbs_bytes;
@@ -354,7 +372,8 @@ int sched_ue::generate_dl_dci_format(uint32_t                          pid,
                                      tti_point                         tti_tx_dl,
                                      uint32_t                          enb_cc_idx,
                                      uint32_t                          cfi,
-                                     const rbgmask_t&                  user_mask)
+                                     const rbgmask_t&                  user_mask,
+                                     float                             mu_corr)
 {
   srsran_dci_format_t dci_format = get_dci_format();
   int                 tbs_bytes  = 0;
@@ -374,10 +393,10 @@ int sched_ue::generate_dl_dci_format(uint32_t                          pid,
       tbs_bytes = generate_format1(pid, data, tti_tx_dl, enb_cc_idx, cfi, user_mask);
       break;
     case SRSRAN_DCI_FORMAT2:
-      tbs_bytes = generate_format2(pid, data, tti_tx_dl, enb_cc_idx, cfi, user_mask);
+      tbs_bytes = generate_format2(pid, data, tti_tx_dl, enb_cc_idx, cfi, user_mask, mu_corr);
       break;
     case SRSRAN_DCI_FORMAT2A:
-      tbs_bytes = generate_format2a(pid, data, tti_tx_dl, enb_cc_idx, cfi, user_mask);
+      tbs_bytes = generate_format2a(pid, data, tti_tx_dl, enb_cc_idx, cfi, user_mask, mu_corr);
       break;
     default:
       logger.error("DCI format (%d) not implemented", dci_format);
@@ -466,13 +485,15 @@ int sched_ue::generate_format1(uint32_t                          pid,
  * @param rbgs RBG mask
  * @param cfi Number of control symbols in Subframe
  * @param dci contains the RBG mask, and alloc type
+ * @param mu_corr precoder correlation with the UE paired in the same RBGs (MU-MIMO), or negative if not paired
  * @return pair with MCS and TBS (in bytes)
  */
 tbs_info sched_ue::compute_mcs_and_tbs(uint32_t               enb_cc_idx,
                                        tti_point              tti_tx_dl,
                                        const rbgmask_t&       rbg_mask,
                                        uint32_t               cfi,
-                                       const srsran_dci_dl_t& dci)
+                                       const srsran_dci_dl_t& dci,
+                                       float                  mu_corr)
 {
   srsran_assert(cells[enb_cc_idx].configured(), "computation of MCS/TBS called for non-configured CC");
   srsran::interval<uint32_t> req_bytes = get_requested_dl_bytes(enb_cc_idx);
@@ -481,7 +502,7 @@ tbs_info sched_ue::compute_mcs_and_tbs(uint32_t               enb_cc_idx,
   uint32_t nof_re = cells[enb_cc_idx].cell_cfg->get_dl_nof_res(tti_tx_dl, dci, cfi);
 
   // Compute MCS+TBS
-  tbs_info tb = cqi_to_tbs_dl(cells[enb_cc_idx], rbg_mask, nof_re, dci.format, req_bytes.stop());
+  tbs_info tb = cqi_to_tbs_dl(cells[enb_cc_idx], rbg_mask, nof_re, dci.format, req_bytes.stop(), mu_corr);
 
   if (tb.tbs_bytes > 0 and tb.tbs_bytes < (int)req_bytes.start()) {
     logger.info("SCHED: Could not get PRB allocation that avoids MAC CE or RLC SRB0 PDU segmentation");
@@ -497,7 +518,8 @@ int sched_ue::generate_format2a(uint32_t                          pid,
                                 tti_point                         tti_tx_dl,
                                 uint32_t                          enb_cc_idx,
                                 uint32_t                          cfi,
-                                const rbgmask_t&                  user_mask)
+                                const rbgmask_t&                  user_mask,
+                                float                             mu_corr)
 {
   dl_harq_proc* h                    = &cells[enb_cc_idx].harq_ent.dl_harq_procs()[pid];
   bool          tb_en[SRSRAN_MAX_TB] = {false};
@@ -537,7 +559,7 @@ int sched_ue::generate_format2a(uint32_t                          pid,
     if (!h->is_empty(tb)) {
       h->new_retx(user_mask, tb, tti_tx_dl, &tbinfo.mcs, &tbinfo.tbs_bytes, data->dci.location.ncce);
     } else if (tb_en[tb] && no_retx) {
-      tbinfo = allocate_new_dl_mac_pdu(data, h, user_mask, tti_tx_dl, enb_cc_idx, cfi, tb);
+      tbinfo = allocate_new_dl_mac_pdu(data, h, user_mask, tti_tx_dl, enb_cc_idx, cfi, tb, mu_corr);
     }
 
     /* Fill DCI TB dedicated fields */
@@ -566,14 +588,20 @@ int sched_ue::generate_format2(uint32_t                          pid,
                                tti_point                         tti_tx_dl,
                                uint32_t                          enb_cc_idx,
                                uint32_t                          cfi,
-                               const rbgmask_t&                  user_mask)
+                               const rbgmask_t&                  user_mask,
+                               float                             mu_corr)
 {
   /* Call Format 2a (common) */
-  int ret = generate_format2a(pid, data, tti_tx_dl, enb_cc_idx, cfi, user_mask);
+  int ret = generate_format2a(pid, data, tti_tx_dl, enb_cc_idx, cfi, user_mask, mu_corr);
 
   /* Compute precoding information */
   if ((SRSRAN_DCI_IS_TB_EN(data->dci.tb[0]) + SRSRAN_DCI_IS_TB_EN(data->dci.tb[1])) == 1) {
-    data->dci.pinfo = (uint8_t)(cells[enb_cc_idx].dl_pmi + 1) % (uint8_t)5;
+    if (cells[enb_cc_idx].cell_cfg->cfg.cell.nof_ports == 4) {
+      // One layer, TPMI equal to the reported PMI (TS 36.212 Table 5.3.3.1.5-5)
+      data->dci.pinfo = (uint8_t)cells[enb_cc_idx].dl_pmi;
+    } else {
+      data->dci.pinfo = (uint8_t)(cells[enb_cc_idx].dl_pmi + 1) % (uint8_t)5;
+    }
   } else {
     data->dci.pinfo = (uint8_t)(cells[enb_cc_idx].dl_pmi & 1u);
   }
@@ -1034,6 +1062,18 @@ srsran_dci_format_t sched_ue::get_dci_format()
   return ret;
 }
 
+int sched_ue::get_dl_mu_mimo_pmi(uint32_t enb_cc_idx) const
+{
+  const sched_ue_cell& cc = cells[enb_cc_idx];
+  // Only single-layer closed-loop spatial multiplexing with valid PMI feedback can be paired
+  if (not phy_config_dedicated_enabled or cfg.dl_ant_info.tx_mode != sched_interface::ant_info_ded_t::tx_mode_t::tm4 or
+      cc.cc_state() != cc_st::active or cc.cell_cfg->cfg.cell.nof_ports < 2 or cc.dl_ri != 0 or
+      not cc.dl_pmi_tti_rx.is_valid()) {
+    return -1;
+  }
+  return (int)cc.dl_pmi;
+}
+
 const cce_cfi_position_table* sched_ue::get_locations(uint32_t enb_cc_idx, uint32_t cfi, uint32_t sf_idx) const
 {
   if (cfi > 0 && cfi <= 3) {
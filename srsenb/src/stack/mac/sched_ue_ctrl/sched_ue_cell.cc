@@ -401,7 +401,8 @@ tbs_info cqi_to_tbs_dl(const sched_ue_cell& cell,
                        const rbgmask_t&     rbgs,
                        uint32_t             nof_re,
                        srsran_dci_format_t  dci_format,
-                       uint32_t             req_bytes)
+                       uint32_t             req_bytes,
+                       float                mu_corr)
 {
   bool     use_tbs_index_alt = cell.get_ue_cfg()->use_tbs_index_alt and dci_format != SRSRAN_DCI_FORMAT1A;
   uint32_t nof_prbs          = count_prb_per_tb(rbgs);
@@ -410,8 +411,11 @@ tbs_info cqi_to_tbs_dl(const sched_ue_cell& cell,
   if (cell.fixed_mcs_dl < 0 or not cell.dl_cqi().is_cqi_info_received()) {
     // Dynamic MCS configured or first Tx
     uint32_t dl_cqi = cell.get_dl_cqi(rbgs);
+    if (mu_corr >= 0) {
+      dl_cqi = get_mu_mimo_cqi(dl_cqi, mu_corr);
+    }
 
-    ret = compute_min_mcs_and_tbs_from_required_bytes(
+    ret = cell.cell_cfg->mcs_tbs_table.compute_min_mcs_and_tbs_from_required_bytes(
         nof_prbs, nof_re, dl_cqi, cell.max_mcs_dl, req_bytes, false, false, use_tbs_index_alt);
 
     // If coderate > SRSRAN_MIN(max_coderate, 0.932 * Qm) we should set TBS=0. We don't because it's not correctly
@@ -437,7 +441,7 @@ tbs_info cqi_to_tbs_ul(const sched_ue_cell& cell, uint32_t nof_prb, uint32_t nof
   tbs_info ret;
   if (mcs < 0) {
     // Dynamic MCS
-    ret = compute_min_mcs_and_tbs_from_required_bytes(
+    ret = cell.cell_cfg->mcs_tbs_table.compute_min_mcs_and_tbs_from_required_bytes(
         nof_prb, nof_re, cell.get_ul_cqi(), cell.max_mcs_ul, req_bytes, true, ulqam64_enabled, false);
 
     // If coderate > SRSRAN_MIN(max_coderate, 0.932 * Qm) we should set TBS=0. We don't because it's not correctly
@@ -0,0 +1,230 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/schedulers/sched_freq_pf.h"
+#include "srsran/phy/phch/cqi.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+#include <algorithm>
+#include <cfloat>
+
+namespace srsenb {
+
+using srsran::tti_point;
+
+/// Weight of the UEs that were never allocated. It is larger than the weight of any UE with a non-zero average rate
+static const float max_pf_weight = 1e12;
+
+/// Updates the best PF metric of each RBG, and the candidate that achieves it, with the metrics of one candidate
+static void update_best_metrics(const float* metrics, int cand_idx, float* best, int* best_idx, uint32_t len)
+{
+  uint32_t i = 0;
+#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_I_SIZE
+  simd_i_t cand_simd = srsran_simd_i_set1(cand_idx);
+  for (; i + SRSRAN_SIMD_F_SIZE <= len; i += SRSRAN_SIMD_F_SIZE) {
+    simd_f_t   m  = srsran_simd_f_loadu(&metrics[i]);
+    simd_f_t   b  = srsran_simd_f_load(&best[i]);
+    simd_sel_t gt = srsran_simd_f_max(m, b);
+    srsran_simd_f_store(&best[i], srsran_simd_f_select(b, m, gt));
+    srsran_simd_i_store(&best_idx[i], srsran_simd_i_select(srsran_simd_i_load(&best_idx[i]), cand_simd, gt));
+  }
+#endif
+  for (; i < len; ++i) {
+    if (metrics[i] > best[i]) {
+      best[i]     = metrics[i];
+      best_idx[i] = cand_idx;
+    }
+  }
+}
+
+sched_freq_pf::sched_freq_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args) :
+  sched_time_pf(cell_params_, sched_args)
+{
+  rbg_eff.resize(SRSENB_MAX_UES * MAX_NOF_RBGS);
+  rbg_metrics.resize(SRSENB_MAX_UES * MAX_NOF_RBGS);
+}
+
+void sched_freq_pf::sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched)
+{
+  srsran::tti_point tti_rx{tti_sched->get_tti_rx()};
+  if (current_tti_rx != tti_rx) {
+    new_tti(ue_db, tti_sched);
+  }
+
+  // Retransmissions are allocated first, in PF order. The UEs with new data are collected in the same order
+  candidates.clear();
+  while (not dl_queue.empty()) {
+    ue_ctxt&  ctxt = *dl_queue.top();
+    sched_ue& ue   = *ue_db[ctxt.rnti];
+    dl_queue.pop();
+
+    alloc_result code = alloc_result::other_cause;
+    if (ctxt.dl_retx_h != nullptr) {
+      code = try_dl_retx_alloc(*tti_sched, ue, *ctxt.dl_retx_h);
+      if (code == alloc_result::success) {
+        ctxt.save_dl_alloc(ctxt.dl_retx_h->get_tbs(0) + ctxt.dl_retx_h->get_tbs(1), 0.01);
+        continue;
+      }
+    }
+    srsran::interval<uint32_t> req_bytes = ue.get_requested_dl_bytes(cc_cfg->enb_cc_idx);
+    if (code == alloc_result::no_cch_space or ctxt.dl_newtx_h == nullptr or req_bytes.stop() == 0) {
+      ctxt.save_dl_alloc(0, 0.01);
+      continue;
+    }
+    if (ue.get_dci_format() == SRSRAN_DCI_FORMAT1A) {
+      // Only contiguous allocations are possible with DCI format 1A. These are mostly UEs in RRC connection setup, so
+      // their signalling is served before the frequency-selective allocation of the other UEs
+      uint32_t  alloc_bytes = 0;
+      rbgmask_t alloc_mask;
+      code = try_dl_newtx_alloc_greedy(*tti_sched, ue, *ctxt.dl_newtx_h, &alloc_mask);
+      if (code == alloc_result::success) {
+        alloc_bytes = ue.get_expected_dl_bitrate(cc_cfg->enb_cc_idx, alloc_mask.count()) * tti_duration_ms / 8;
+      }
+      ctxt.save_dl_alloc(alloc_bytes, 0.01);
+      continue;
+    }
+
+    float R = ctxt.dl_avg_rate();
+    candidates.emplace_back();
+    newtx_candidate& cand = candidates.back();
+    cand.ctxt             = &ctxt;
+    cand.ue               = &ue;
+    cand.req_bytes        = req_bytes;
+    cand.weight           = (R != 0) ? 1 / pow(R, fairness_coeff) : max_pf_weight;
+    cand.code             = alloc_result::other_cause;
+    cand.alloc_bytes      = 0;
+  }
+  if (candidates.empty()) {
+    return;
+  }
+
+  assign_rbgs(tti_sched->get_dl_mask(), tti_sched->get_tti_tx_dl());
+
+  // Allocate the RBGs assigned to each UE, in PF order
+  for (newtx_candidate& cand : candidates) {
+    if (cand.mask.any()) {
+      cand.alloc_bytes = try_dl_newtx_alloc(cand, tti_sched);
+    }
+  }
+
+  // The UEs without RBGs, or whose RBGs could not be allocated, get the RBGs that remain free
+  for (newtx_candidate& cand : candidates) {
+    if (cand.code != alloc_result::success and cand.code != alloc_result::no_cch_space) {
+      rbgmask_t alloc_mask;
+      cand.code = try_dl_newtx_alloc_greedy(*tti_sched, *cand.ue, *cand.ctxt->dl_newtx_h, &alloc_mask);
+      if (cand.code == alloc_result::success) {
+        cand.alloc_bytes =
+            cand.ue->get_expected_dl_bitrate(cc_cfg->enb_cc_idx, alloc_mask.count()) * tti_duration_ms / 8;
+      }
+    }
+    cand.ctxt->save_dl_alloc(cand.alloc_bytes, 0.01);
+  }
+}
+
+void sched_freq_pf::assign_rbgs(const rbgmask_t& dl_mask, tti_point tti_tx_dl)
+{
+  srsran::bounded_vector<uint32_t, MAX_NOF_RBGS> free_rbgs;
+  for (uint32_t rbg = 0; rbg < dl_mask.size(); ++rbg) {
+    if (not dl_mask.test(rbg)) {
+      free_rbgs.push_back(rbg);
+    }
+  }
+  uint32_t nof_free = free_rbgs.size();
+
+  // Compute the spectral efficiency and the PF metric of each candidate in each free RBG
+  std::array<bool, SRSENB_MAX_UES> active = {};
+  for (uint32_t c = 0; c < candidates.size(); ++c) {
+    newtx_candidate& cand = candidates[c];
+    cand.mask             = rbgmask_t(cc_cfg->nof_rbgs);
+    cand.rem_bytes        = cand.req_bytes.stop();
+    if (nof_free == 0) {
+      continue;
+    }
+    const sched_ue_cell* ue_cell = cand.ue->find_ue_carrier(cc_cfg->enb_cc_idx);
+    bool                 alt_cqi = ue_cell->get_ue_cfg()->use_tbs_index_alt;
+    float*               eff     = &rbg_eff[c * nof_free];
+    for (uint32_t i = 0; i < nof_free; ++i) {
+      eff[i] = srsran_cqi_to_coderate(ue_cell->dl_cqi().get_rbg_cqi(free_rbgs[i]), alt_cqi);
+    }
+    srsran_vec_sc_prod_fff(eff, cand.weight, &rbg_metrics[c * nof_free], nof_free);
+    active[c] = true;
+  }
+
+  // Assign the free RBGs in decreasing order of their best metric. When a UE gets enough RBGs for its pending data,
+  // the best metrics of the RBGs not yet assigned are recomputed without it
+  float bytes_per_prb = cc_cfg->get_dl_lb_nof_re(tti_tx_dl, cc_cfg->nof_prb()) / (8.0F * cc_cfg->nof_prb());
+
+  srsran_simd_aligned float                      best[MAX_NOF_RBGS];
+  srsran_simd_aligned int                        best_idx[MAX_NOF_RBGS];
+  std::array<bool, MAX_NOF_RBGS>                 assigned = {};
+  srsran::bounded_vector<uint32_t, MAX_NOF_RBGS> order;
+  bool                                           ue_full = true;
+  while (ue_full) {
+    ue_full = false;
+    for (uint32_t i = 0; i < nof_free; ++i) {
+      best[i]     = assigned[i] ? FLT_MAX : 0;
+      best_idx[i] = -1;
+    }
+    for (uint32_t c = 0; c < candidates.size(); ++c) {
+      if (active[c]) {
+        update_best_metrics(&rbg_metrics[c * nof_free], c, best, best_idx, nof_free);
+      }
+    }
+
+    order.clear();
+    for (uint32_t i = 0; i < nof_free; ++i) {
+      if (not assigned[i] and best_idx[i] >= 0) {
+        order.push_back(i);
+      }
+    }
+    std::stable_sort(order.begin(), order.end(), [&best](uint32_t lhs, uint32_t rhs) { return best[lhs] > best[rhs]; });
+
+    for (uint32_t i : order) {
+      uint32_t         rbg  = free_rbgs[i];
+      newtx_candidate& cand = candidates[best_idx[i]];
+      assigned[i]           = true;
+      cand.mask.set(rbg);
+      uint32_t rbg_nof_prb = std::min(cc_cfg->P, cc_cfg->nof_prb() - rbg * cc_cfg->P);
+      cand.rem_bytes -= rbg_eff[best_idx[i] * nof_free + i] * bytes_per_prb * rbg_nof_prb;
+      if (cand.rem_bytes <= 0) {
+        active[best_idx[i]] = false;
+        ue_full             = true;
+        break;
+      }
+    }
+  }
+}
+
+uint32_t sched_freq_pf::try_dl_newtx_alloc(newtx_candidate& cand, sf_sched* tti_sched)
+{
+  // The grant must fit the minimum number of bytes required, e.g. a non-segmentable SRB0 PDU
+  const sched_ue_cell* ue_cell = cand.ue->find_ue_carrier(cc_cfg->enb_cc_idx);
+  tbs_info             tb =
+      compute_mcs_and_tbs_lower_bound(*ue_cell, tti_sched->get_tti_tx_dl(), cand.mask, cand.ue->get_dci_format());
+  if (tb.tbs_bytes < (int)cand.req_bytes.start()) {
+    cand.code = alloc_result::invalid_grant_params;
+    return 0;
+  }
+  cand.code = tti_sched->alloc_dl_user(cand.ue, cand.mask, cand.ctxt->dl_newtx_h->get_id());
+  return cand.code == alloc_result::success ? tb.tbs_bytes : 0;
+}
+
+} // namespace srsenb
@@ -20,6 +20,8 @@
  */
 
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
+#include "srsenb/hdr/stack/mac/sched_helpers.h"
+#include "srsran/phy/phch/cqi.h"
 #include <vector>
 
 namespace srsenb {
@@ -32,6 +34,9 @@ sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sche
   if (not sched_args.sched_policy_args.empty()) {
     fairness_coeff = std::stof(sched_args.sched_policy_args);
   }
+  mu_mimo          = sched_args.mu_mimo;
+  mu_mimo_max_corr = sched_args.mu_mimo_max_corr;
+  dl_mu_candidates.reserve(SRSENB_MAX_UES);
 
   std::vector<ue_ctxt*> dl_storage;
   dl_storage.reserve(SRSENB_MAX_UES);
@@ -86,11 +91,22 @@ void sched_time_pf::sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched)
     new_tti(ue_db, tti_sched);
   }
 
+  dl_mu_candidates.clear();
   while (not dl_queue.empty()) {
-    ue_ctxt& ue = *dl_queue.top();
-    ue.save_dl_alloc(try_dl_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
+    ue_ctxt& ue          = *dl_queue.top();
+    uint32_t alloc_bytes = try_dl_alloc(ue, *ue_db[ue.rnti], tti_sched);
+    if (mu_mimo and alloc_bytes == 0 and ue.dl_retx_h == nullptr and ue.dl_newtx_h != nullptr) {
+      // The UE may still be paired with an allocated UE, once all RBGs are taken
+      dl_mu_candidates.push_back(&ue);
+    } else {
+      ue.save_dl_alloc(alloc_bytes, 0.01);
+    }
     dl_queue.pop();
   }
+
+  for (ue_ctxt* ue : dl_mu_candidates) {
+    ue->save_dl_alloc(try_dl_mu_alloc(*ue, *ue_db[ue->rnti], ue_db, tti_sched), 0.01);
+  }
 }
 
 uint32_t sched_time_pf::try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched)
@@ -114,6 +130,59 @@ uint32_t sched_time_pf::try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* t
   return 0;
 }
 
+/// Pairs the UE with the allocated UE that maximizes the sum of the spectral efficiencies of both UEs, provided that
+/// it is higher than the spectral efficiency of the allocated UE alone
+uint32_t sched_time_pf::try_dl_mu_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sched_ue_list& ue_db, sf_sched* tti_sched)
+{
+  uint32_t enb_cc_idx = cc_cfg->enb_cc_idx;
+  int      pmi        = ue.get_dl_mu_mimo_pmi(enb_cc_idx);
+  if (pmi < 0) {
+    return 0;
+  }
+  const sched_ue_cell& ue_cell = *ue.find_ue_carrier(enb_cc_idx);
+
+  sched_ue*        best_pair = nullptr;
+  const rbgmask_t* best_mask = nullptr;
+  float            best_gain = 0;
+  for (const sf_sched::dl_alloc_t& alloc : tti_sched->get_allocated_dl_users()) {
+    if (alloc.mu_pair_rnti != SRSRAN_INVALID_RNTI) {
+      continue;
+    }
+    auto it = ue_db.find(alloc.rnti);
+    if (it == ue_db.end()) {
+      continue;
+    }
+    sched_ue& pair     = *it->second;
+    int       pair_pmi = pair.get_dl_mu_mimo_pmi(enb_cc_idx);
+    if (pair_pmi < 0 or not pair.get_dl_harq(alloc.pid, enb_cc_idx).is_empty()) {
+      continue;
+    }
+    float corr = get_pmi_correlation(cc_cfg->cfg.cell.nof_ports, pmi, pair_pmi);
+    if (corr > mu_mimo_max_corr) {
+      continue;
+    }
+    uint32_t cqi         = ue_cell.get_dl_cqi(alloc.user_mask);
+    uint32_t pair_cqi    = pair.find_ue_carrier(enb_cc_idx)->get_dl_cqi(alloc.user_mask);
+    float    ue_mu_eff   = srsran_cqi_to_coderate(get_mu_mimo_cqi(cqi, corr), false);
+    float    pair_mu_eff = srsran_cqi_to_coderate(get_mu_mimo_cqi(pair_cqi, corr), false);
+    float    gain        = ue_mu_eff + pair_mu_eff - srsran_cqi_to_coderate(pair_cqi, false);
+    if (gain > best_gain) {
+      best_pair = &pair;
+      best_mask = &alloc.user_mask;
+      best_gain = gain;
+    }
+  }
+  if (best_pair == nullptr) {
+    return 0;
+  }
+
+  uint32_t nof_rbgs = best_mask->count();
+  if (tti_sched->alloc_dl_mu_user(&ue, ue_ctxt.dl_newtx_h->get_id(), best_pair) != alloc_result::success) {
+    return 0;
+  }
+  return ue.get_expected_dl_bitrate(enb_cc_idx, nof_rbgs) * tti_duration_ms / 8;
+}
+
 /*****************************************************************
  *                         Uplink
  *****************************************************************/
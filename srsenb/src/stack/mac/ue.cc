@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include "srsenb/hdr/stack/mac/ue.h"
+#include "srsran/adt/pool/obj_pool.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
@@ -71,6 +72,18 @@ void ue_cc_softbuffers::clear()
   }
 }
 
+std::unique_ptr<srsran::obj_pool_itf<ue_cc_softbuffers> > make_ue_cc_softbuffer_pool(uint32_t nof_prb,
+                                                                                     uint32_t nof_prealloc_ues)
+{
+  auto init_softbuffers = [nof_prb](void* ptr) {
+    new (ptr) ue_cc_softbuffers(nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ);
+  };
+  auto   recycle_softbuffers = [](ue_cc_softbuffers& softbuffers) { softbuffers.clear(); };
+  size_t thres               = std::max(nof_prealloc_ues / 2, 8U);
+  return std::unique_ptr<srsran::obj_pool_itf<ue_cc_softbuffers> >(new srsran::background_obj_pool<ue_cc_softbuffers>(
+      8, thres, nof_prealloc_ues, init_softbuffers, recycle_softbuffers, true));
+}
+
 cc_used_buffers_map::cc_used_buffers_map() : logger(&srslog::fetch_basic_logger("MAC")) {}
 
 cc_used_buffers_map::~cc_used_buffers_map()
@@ -611,10 +624,16 @@ void ue::metrics_read(mac_ue_metrics_t* metrics_)
   uint32_t ul_buffer = sched->get_ul_buffer(rnti);
   uint32_t dl_buffer = sched->get_dl_buffer(rnti);
 
+  // The DL HARQ-ACKs are processed by the scheduler
+  sched_interface::ue_dl_tx_metrics_t dl_tx = sched->read_dl_tx_metrics(rnti);
+
   std::lock_guard<std::mutex> lock(metrics_mutex);
   ue_metrics.rnti      = rnti;
   ue_metrics.ul_buffer = ul_buffer;
   ue_metrics.dl_buffer = dl_buffer;
+  ue_metrics.tx_brate += dl_tx.tx_bytes * 8;
+  ue_metrics.tx_errors += dl_tx.tx_errors;
+  ue_metrics.tx_pkts += dl_tx.tx_pkts;
 
   // set PCell sector id
   std::array<int, SRSRAN_MAX_CARRIERS> cc_list = sched->get_enb_ue_cc_map(rnti);
@@ -242,10 +242,22 @@ int rrc::add_user(uint16_t rnti, const sched_interface::ue_cfg_t& sched_ue_cfg)
         logger.error("Adding user rnti=0x%x - Failed to allocate user resources", rnti);
         return SRSRAN_ERROR;
       }
-      users.insert(std::make_pair(rnti, std::move(u)));
+      if (not users.insert(rnti, std::move(u))) {
+        logger.error("Adding user rnti=0x%x - RNTI slot already in use", rnti);
+        return SRSRAN_ERROR;
+      }
+    }
+    if (rlc->add_user(rnti) != SRSRAN_SUCCESS) {
+      logger.error("Adding user rnti=0x%x - Failed to allocate RLC user", rnti);
+      users.erase(rnti);
+      return SRSRAN_ERROR;
+    }
+    if (pdcp->add_user(rnti) != SRSRAN_SUCCESS) {
+      logger.error("Adding user rnti=0x%x - Failed to allocate PDCP user", rnti);
+      rlc->rem_user(rnti);
+      users.erase(rnti);
+      return SRSRAN_ERROR;
     }
-    rlc->add_user(rnti);
-    pdcp->add_user(rnti);
     logger.info("Added new user rnti=0x%x", rnti);
   } else {
     logger.error("Adding user rnti=0x%x (already exists)", rnti);
@@ -559,7 +571,7 @@ void rrc::ho_preparation_complete(uint16_t                     rnti,
                                   const asn1::s1ap::ho_cmd_s&  msg,
                                   srsran::unique_byte_buffer_t rrc_container)
 {
-  users.at(rnti)->mobility_handler->handle_ho_preparation_complete(result, msg, std::move(rrc_container));
+  users[rnti]->mobility_handler->handle_ho_preparation_complete(result, msg, std::move(rrc_container));
 }
 
 void rrc::set_erab_status(uint16_t rnti, const asn1::s1ap::bearers_subject_to_status_transfer_list_l& erabs)
@@ -175,8 +175,17 @@ int rrc_nr::add_user(uint16_t rnti, const sched_nr_ue_cfg_t& uecfg, bool start_m
   if (users.count(rnti) == 0) {
     // If in the ue ctor, "start_msg3_timer" is set to true, this will start the MSG3 RX TIMEOUT at ue creation
     users.insert(std::make_pair(rnti, std::unique_ptr<ue>(new ue(this, rnti, uecfg, start_msg3_timer))));
-    rlc->add_user(rnti);
-    pdcp->add_user(rnti);
+    if (rlc->add_user(rnti) != SRSRAN_SUCCESS) {
+      logger.error("Adding user rnti=0x%x - Failed to allocate RLC user", rnti);
+      users.erase(rnti);
+      return SRSRAN_ERROR;
+    }
+    if (pdcp->add_user(rnti) != SRSRAN_SUCCESS) {
+      logger.error("Adding user rnti=0x%x - Failed to allocate PDCP user", rnti);
+      rlc->rem_user(rnti);
+      users.erase(rnti);
+      return SRSRAN_ERROR;
+    }
     logger.info("Added new user rnti=0x%x", rnti);
     return SRSRAN_SUCCESS;
   } else {
@@ -60,7 +60,7 @@ const gtpu_tunnel_manager::tunnel* gtpu_tunnel_manager::find_tunnel(uint32_t tei
 gtpu_tunnel_manager::ue_bearer_tunnel_list* gtpu_tunnel_manager::find_rnti_tunnels(uint16_t rnti)
 {
   auto it = ue_teidin_db.find(rnti);
-  return it != ue_teidin_db.end() ? &ue_teidin_db[rnti] : nullptr;
+  return it != ue_teidin_db.end() ? &it->second : nullptr;
 }
 
 srsran::span<gtpu_tunnel_manager::bearer_teid_pair>
@@ -103,6 +103,7 @@ gtpu_tunnel_manager::add_tunnel(uint16_t rnti, uint32_t eps_bearer_id, uint32_t
     auto ret = ue_teidin_db.emplace(rnti, ue_bearer_tunnel_list());
     if (!ret.second) {
       logger.error("Failed to allocate rnti=0x%x", rnti);
+      tunnels.erase(tun->teid_in);
       return nullptr;
     }
   }
@@ -166,8 +167,8 @@ bool gtpu_tunnel_manager::update_rnti(uint16_t old_rnti, uint16_t new_rnti)
     to_remove.pop_back();
   }
 
-  // Leave old_rnti as zombie to be removed later
-  old_rnti_ptr->clear();
+  // The old rnti has no tunnels left
+  ue_teidin_db.erase(old_rnti);
 
   return true;
 }
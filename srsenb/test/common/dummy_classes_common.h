@@ -31,7 +31,7 @@ class rlc_dummy : public rlc_interface_rrc
 {
 public:
   void clear_buffer(uint16_t rnti) override {}
-  void add_user(uint16_t rnti) override {}
+  int  add_user(uint16_t rnti) override { return SRSRAN_SUCCESS; }
   void rem_user(uint16_t rnti) override {}
   void add_bearer(uint16_t rnti, uint32_t lcid, srsran::rlc_config_t cnfg) override {}
   void add_bearer_mrb(uint16_t rnti, uint32_t lcid) override {}
@@ -51,7 +51,7 @@ class pdcp_dummy : public pdcp_interface_rrc, public pdcp_interface_gtpu
 public:
   void set_enabled(uint16_t rnti, uint32_t lcid, bool enabled) override {}
   void reset(uint16_t rnti) override {}
-  void add_user(uint16_t rnti) override {}
+  int  add_user(uint16_t rnti) override { return SRSRAN_SUCCESS; }
   void rem_user(uint16_t rnti) override {}
   void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn) override {}
   void add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cnfg) override {}
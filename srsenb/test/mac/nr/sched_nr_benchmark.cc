@@ -0,0 +1,234 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "../sched_benchmark_common.h"
+#include "sched_nr_cfg_generators.h"
+#include "sched_nr_sim_ue.h"
+#include "srsran/common/phy_cfg_nr_default.h"
+#include "srsran/common/test_common.h"
+
+/*
+ * Large-scale benchmark of the NR scheduler. Tens of UEs with a configurable traffic mix are attached to one or more
+ * carriers, and the latency of every scheduler call is reported as percentiles and as a histogram, in the same JSON
+ * format as the LTE scheduler benchmark.
+ */
+
+namespace srsenb {
+
+/// LCID and LCG of the data bearer of the benchmark UEs
+const static uint32_t bench_drb_lcid = 4;
+const static uint32_t bench_drb_lcg  = 1;
+
+class sched_nr_bench_tester : public sched_nr_base_tester
+{
+public:
+  sched_nr_bench_tester(const sched_nr_interface::sched_args_t&            sched_args,
+                        const std::vector<sched_nr_interface::cell_cfg_t>& cell_params_,
+                        const bench_scale_args&                            args_,
+                        bench_scale_report&                                report_) :
+    sched_nr_base_tester(sched_args, cell_params_, "NR scheduler benchmark", args_.nof_workers + 1),
+    args(args_),
+    report(report_)
+  {}
+
+  uint32_t slot_count = 0;
+
+  void set_external_slot_events(const sim_nr_ue_ctxt_t& ue_ctxt, ue_nr_slot_events& pending_events) override
+  {
+    if (args.traffic == bench_traffic_t::full_buffer) {
+      // The buffers are refilled by the scheduler itself
+      return;
+    }
+    auto gen_it = ue_traffic.find(ue_ctxt.rnti);
+    if (gen_it == ue_traffic.end()) {
+      gen_it = ue_traffic.emplace(ue_ctxt.rnti, ue_traffic_ctxt{bench_traffic_gen{args.traffic, ue_ctxt.rnti}}).first;
+    }
+    ue_traffic_ctxt& ue = gen_it->second;
+
+    // The RLC buffers are emulated, given that the NR scheduler relies on the MAC to report their updated occupancy
+    uint32_t dl_bytes = 0, ul_bytes = 0;
+    if (ue.gen.new_tti(slot_count, dl_bytes, ul_bytes)) {
+      ue.dl_pending += dl_bytes;
+      ue.ul_pending += ul_bytes;
+      ue.updated = true;
+    }
+    if (ue.updated) {
+      sched_ptr->dl_buffer_state(ue_ctxt.rnti, bench_drb_lcid, ue.dl_pending, 0);
+      sched_ptr->ul_bsr(ue_ctxt.rnti, bench_drb_lcg, ue.ul_pending);
+      ue.updated = false;
+    }
+  }
+
+  void process_slot_result(const sim_nr_enb_ctxt_t& enb_ctxt, srsran::const_span<cc_result_t> cc_list) override
+  {
+    std::chrono::nanoseconds slot_latency{0};
+    for (const cc_result_t& cc_out : cc_list) {
+      report.dl_latency.push(cc_out.dl_latency_ns);
+      report.ul_latency.push(cc_out.ul_latency_ns);
+      slot_latency = std::max(slot_latency, cc_out.cc_latency_ns);
+
+      for (const auto& pdsch : cc_out.dl_res.pdsch) {
+        if (enb_ctxt.ue_db.count(pdsch.sch.grant.rnti) > 0) {
+          report.nof_dl_allocs++;
+          dl_bits += pdsch.sch.grant.tb[0].tbs;
+          drain(pdsch.sch.grant.rnti, pdsch.sch.grant.tb[0].tbs / 8, true);
+        }
+      }
+      for (const auto& pusch : cc_out.ul_res.pusch) {
+        if (enb_ctxt.ue_db.count(pusch.sch.grant.rnti) > 0) {
+          report.nof_ul_allocs++;
+          ul_bits += pusch.sch.grant.tb[0].tbs;
+          drain(pusch.sch.grant.rnti, pusch.sch.grant.tb[0].tbs / 8, false);
+        }
+      }
+    }
+    report.tti_latency.push(slot_latency);
+  }
+
+  uint64_t dl_bits = 0;
+  uint64_t ul_bits = 0;
+
+private:
+  struct ue_traffic_ctxt {
+    explicit ue_traffic_ctxt(const bench_traffic_gen& gen_) : gen(gen_) {}
+
+    bench_traffic_gen gen;
+    uint32_t          dl_pending = 0;
+    uint32_t          ul_pending = 0;
+    bool              updated    = false;
+  };
+
+  void drain(uint16_t rnti, uint32_t nof_bytes, bool dl)
+  {
+    auto it = ue_traffic.find(rnti);
+    if (it == ue_traffic.end()) {
+      return;
+    }
+    uint32_t& pending = dl ? it->second.dl_pending : it->second.ul_pending;
+    pending -= std::min(pending, nof_bytes);
+    it->second.updated = true;
+  }
+
+  const bench_scale_args&             args;
+  bench_scale_report&                 report;
+  std::map<uint16_t, ue_traffic_ctxt> ue_traffic;
+};
+
+int run_nr_scale_benchmark(const bench_scale_args& args)
+{
+  if (args.nof_ues > SRSENB_MAX_UES) {
+    fmt::print("Error: {} UEs exceed SRSENB_MAX_UES={}. Rebuild with a larger SRSENB_MAX_UES\n",
+               args.nof_ues,
+               SRSENB_MAX_UES);
+    return SRSRAN_ERROR;
+  }
+  if (args.nof_ccs > 1 and not args.ca) {
+    // The UE simulator requires the PCell of all UEs to be the first carrier
+    fmt::print("Error: multiple carriers are only supported with ca=1\n");
+    return SRSRAN_ERROR;
+  }
+  srsran::phy_cfg_nr_default_t::reference_cfg_t ref_cfg{};
+  if (args.nof_prbs == 0 or args.nof_prbs == 52) {
+    ref_cfg.carrier = srsran::phy_cfg_nr_default_t::reference_cfg_t::R_CARRIER_CUSTOM_10MHZ;
+  } else if (args.nof_prbs == 106) {
+    ref_cfg.carrier = srsran::phy_cfg_nr_default_t::reference_cfg_t::R_CARRIER_CUSTOM_20MHZ;
+  } else {
+    fmt::print("Error: only 52 and 106 PRBs are supported\n");
+    return SRSRAN_ERROR;
+  }
+  if (args.lookahead > SCHED_NR_MAX_LOOKAHEAD) {
+    fmt::print("Error: at most {} look-ahead slots are supported\n", SCHED_NR_MAX_LOOKAHEAD);
+    return SRSRAN_ERROR;
+  }
+  srsran::phy_cfg_nr_t phy_cfg = srsran::phy_cfg_nr_default_t{ref_cfg};
+
+  bench_scale_report report;
+  report.rat  = "nr";
+  report.args = args;
+  // The NR scheduler has a single scheduling policy
+  report.args.sched_policy = "default";
+  report.nof_prbs          = phy_cfg.carrier.nof_prb;
+  report.dl_latency.reserve(args.nof_ttis * args.nof_ccs);
+  report.ul_latency.reserve(args.nof_ttis * args.nof_ccs);
+  report.tti_latency.reserve(args.nof_ttis);
+  report.rss_start_kB = bench_rss_kB();
+
+  sched_nr_interface::sched_args_t cfg;
+  cfg.auto_refill_buffer = args.traffic == bench_traffic_t::full_buffer;
+  cfg.lookahead_slots    = args.lookahead;
+  std::vector<sched_nr_interface::cell_cfg_t> cells_cfg = get_default_cells_cfg(args.nof_ccs, phy_cfg);
+  sched_nr_bench_tester                       tester(cfg, cells_cfg, args, report);
+
+  uint16_t rnti = 0x4601;
+  for (uint32_t slot_count = 0, ue_idx = 0; slot_count < args.nof_ttis; ++slot_count) {
+    slot_point slot_rx(0, slot_count % 10240);
+    slot_point slot_tx = slot_rx + TX_ENB_DELAY;
+
+    // Attach one UE per slot, each with a different preamble
+    if (ue_idx < args.nof_ues) {
+      sched_nr_interface::ue_cfg_t uecfg         = get_default_ue_cfg(args.nof_ccs, phy_cfg);
+      uecfg.ue_bearers[bench_drb_lcid].direction = mac_lc_ch_cfg_t::BOTH;
+      uecfg.ue_bearers[bench_drb_lcid].group     = bench_drb_lcg;
+      tester.add_user(rnti + ue_idx, uecfg, slot_rx, ue_idx % 64);
+      ue_idx++;
+    }
+
+    tester.slot_count = slot_count;
+    tester.run_slot(slot_tx);
+  }
+  tester.stop();
+
+  // 15 kHz subcarrier spacing, hence 1 msec slots
+  double duration_sec = args.nof_ttis * 1e-3;
+  report.dl_mbps      = tester.dl_bits / duration_sec / 1e6;
+  report.ul_mbps      = tester.ul_bits / duration_sec / 1e6;
+  report.rss_end_kB   = bench_rss_kB();
+  report.peak_rss_kB  = std::max(bench_peak_rss_kB(), report.rss_end_kB);
+  report.finish();
+
+  srslog::flush();
+  if (not args.json_file.empty()) {
+    report.print_summary();
+  }
+  return report.write_json();
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  auto& test_logger = srslog::fetch_basic_logger("TEST");
+  test_logger.set_level(srslog::basic_levels::warning);
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  mac_nr_logger.set_level(srslog::basic_levels::warning);
+
+  // Start the log backend.
+  srslog::init();
+
+  srsenb::bench_scale_args args;
+  if (not args.parse(argc, argv, 1)) {
+    srsenb::bench_scale_args::print_usage(argv[0], "");
+    return SRSRAN_ERROR;
+  }
+  TESTASSERT(srsenb::run_nr_scale_benchmark(args) == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
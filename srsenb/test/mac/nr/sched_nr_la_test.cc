@@ -0,0 +1,151 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/nr/sched_nr_link_adaptation.h"
+#include "srsran/common/test_common.h"
+
+using namespace srsenb;
+using namespace srsenb::sched_nr_impl;
+
+void test_la_tables()
+{
+  // TEST: CQI to MCS mapping is monotonic and covers the whole MCS table
+  TESTASSERT(link_adaptation::cqi_to_mcs(0) == 0);
+  TESTASSERT(link_adaptation::cqi_to_mcs(15) == max_mcs_64qam);
+  TESTASSERT(link_adaptation::cqi_to_mcs(20) == max_mcs_64qam);
+  TESTASSERT(link_adaptation::cqi_to_mcs(-3) == 0);
+  for (float cqi = 0; cqi < 15; cqi += 0.125) {
+    TESTASSERT(link_adaptation::cqi_to_mcs(cqi) <= link_adaptation::cqi_to_mcs(cqi + 0.125));
+  }
+  // CQIs with the same spectral efficiency as a MCS map to it (e.g. CQI 7 and MCS 11, 16QAM with R=378/1024)
+  TESTASSERT(link_adaptation::cqi_to_mcs(7) == 11);
+  // Fractional CQIs select intermediate MCSs
+  TESTASSERT(link_adaptation::cqi_to_mcs(7.5) > link_adaptation::cqi_to_mcs(7));
+  TESTASSERT(link_adaptation::cqi_to_mcs(7.5) < link_adaptation::cqi_to_mcs(8));
+
+  // TEST: SINR to MCS mapping is monotonic and covers the whole MCS table
+  TESTASSERT(link_adaptation::sinr_to_mcs(-20) == 0);
+  TESTASSERT(link_adaptation::sinr_to_mcs(40) == max_mcs_64qam);
+  for (float sinr = -10; sinr < 35; sinr += 0.25) {
+    TESTASSERT(link_adaptation::sinr_to_mcs(sinr) <= link_adaptation::sinr_to_mcs(sinr + 0.25));
+  }
+}
+
+void test_la_fixed_mcs()
+{
+  sched_nr_interface::sched_args_t args;
+  args.fixed_dl_mcs = 10;
+  args.fixed_ul_mcs = 20;
+  link_adaptation la(args);
+
+  // TEST: The CSI and HARQ feedback are ignored if the MCS is fixed
+  la.dl_cqi_info(15);
+  la.ul_sinr_info(30);
+  for (uint32_t i = 0; i < 100; ++i) {
+    la.dl_ack_info(false, 10);
+    la.ul_crc_info(false, 20);
+  }
+  TESTASSERT(la.get_dl_mcs() == 10);
+  TESTASSERT(la.get_ul_mcs() == 20);
+  TESTASSERT(la.get_dl_cqi_offset() == 0);
+  TESTASSERT(la.get_ul_snr_offset() == 0);
+}
+
+void test_la_csi()
+{
+  sched_nr_interface::sched_args_t args;
+  args.fixed_dl_mcs = -1;
+  args.fixed_ul_mcs = -1;
+  link_adaptation la(args);
+
+  // TEST: Before any report, the initial CQI and SNR are used
+  TESTASSERT(la.get_dl_cqi() == (uint32_t)args.init_dl_cqi);
+  TESTASSERT(la.get_dl_mcs() == link_adaptation::cqi_to_mcs(args.init_dl_cqi));
+  TESTASSERT(la.get_ul_mcs() == link_adaptation::sinr_to_mcs(args.init_ul_snr_value));
+
+  // TEST: The DL MCS follows the last CQI, while the UL SINR is averaged
+  la.dl_cqi_info(12);
+  TESTASSERT(la.get_dl_mcs() == link_adaptation::cqi_to_mcs(12));
+  la.ul_sinr_info(20);
+  TESTASSERT(la.get_ul_mcs() == link_adaptation::sinr_to_mcs(20));
+  la.ul_sinr_info(0);
+  TESTASSERT(la.get_ul_sinr() < 20 and la.get_ul_sinr() > 0);
+  la.ul_sinr_info(NAN);
+  TESTASSERT(std::isfinite(la.get_ul_sinr()));
+}
+
+/// Emulates a channel where the reported CQI is optimistic, and only the MCSs up to max_mcs are decoded
+void test_la_outer_loop()
+{
+  const uint32_t reported_cqi = 12, max_mcs = 14, nof_tx = 20000;
+
+  sched_nr_interface::sched_args_t args;
+  args.fixed_dl_mcs              = -1;
+  args.fixed_ul_mcs              = -1;
+  args.adaptive_dl_mcs_step_size = 0.01;
+  args.adaptive_ul_mcs_step_size = 0.01;
+  link_adaptation la(args);
+  la.dl_cqi_info(reported_cqi);
+  la.ul_sinr_info(19);
+  TESTASSERT(la.get_dl_mcs() > max_mcs and la.get_ul_mcs() > max_mcs);
+
+  uint32_t dl_nacks = 0, ul_nacks = 0;
+  for (uint32_t i = 0; i < nof_tx; ++i) {
+    uint32_t dl_mcs = la.get_dl_mcs(), ul_mcs = la.get_ul_mcs();
+    bool     dl_ack = dl_mcs <= max_mcs, ul_crc = ul_mcs <= max_mcs;
+    la.dl_ack_info(dl_ack, dl_mcs);
+    la.ul_crc_info(ul_crc, ul_mcs);
+    if (i >= nof_tx / 2) {
+      dl_nacks += dl_ack ? 0 : 1;
+      ul_nacks += ul_crc ? 0 : 1;
+    }
+  }
+
+  // TEST: The offsets converge to values for which the BLER is close to the target
+  float dl_bler = dl_nacks / (nof_tx / 2.0f), ul_bler = ul_nacks / (nof_tx / 2.0f);
+  TESTASSERT(la.get_dl_cqi_offset() < 0 and la.get_ul_snr_offset() < 0);
+  TESTASSERT(std::abs(dl_bler - args.target_bler) < args.target_bler / 2);
+  TESTASSERT(std::abs(ul_bler - args.target_bler) < args.target_bler / 2);
+
+  // TEST: The offsets are bounded
+  for (uint32_t i = 0; i < nof_tx; ++i) {
+    la.dl_ack_info(false, 10);
+    la.ul_crc_info(false, 10);
+  }
+  TESTASSERT(la.get_dl_cqi_offset() == -args.max_delta_dl_cqi);
+  TESTASSERT(la.get_ul_snr_offset() == -args.max_delta_ul_snr);
+
+  // TEST: The offsets do not grow further once the highest MCS is reached
+  la.dl_cqi_info(15);
+  for (uint32_t i = 0; i < nof_tx; ++i) {
+    la.dl_ack_info(true, la.get_dl_mcs());
+  }
+  TESTASSERT(la.get_dl_mcs() == max_mcs_64qam);
+  TESTASSERT(la.get_dl_cqi_offset() < args.max_delta_dl_cqi);
+}
+
+int main()
+{
+  test_la_tables();
+  test_la_fixed_mcs();
+  test_la_csi();
+  test_la_outer_loop();
+}
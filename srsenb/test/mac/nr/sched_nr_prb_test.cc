@@ -135,9 +135,40 @@ void test_bwp_rb_bitmap_search()
   TESTASSERT(prbs == prb_interval(5, 10));
 }
 
+void test_bwp_rb_bitmap_free_intervals()
+{
+  bwp_rb_bitmap rb_bitmap(275, 0, true);
+  TESTASSERT(rb_bitmap.free_prb_intervals().size() == 1);
+  TESTASSERT(rb_bitmap.free_prb_intervals()[0] == prb_interval(0, 275));
+
+  // The cached list must be refreshed after every new allocation
+  rb_bitmap |= prb_interval{1, 5};
+  rb_bitmap |= prb_interval{16, 32};
+  rb_bitmap |= prb_interval{270, 275};
+  srsran::const_span<prb_interval> free_intervs = rb_bitmap.free_prb_intervals();
+  TESTASSERT(free_intervs.size() == 3);
+  TESTASSERT(free_intervs[0] == prb_interval(0, 1));
+  TESTASSERT(free_intervs[1] == prb_interval(5, 16));
+  TESTASSERT(free_intervs[2] == prb_interval(32, 270));
+
+  // The search over the cached intervals must match the search over the bitmap
+  for (uint32_t start = 0; start < rb_bitmap.nof_prbs(); start += 3) {
+    for (uint32_t len = 1; len <= rb_bitmap.nof_prbs(); len += 7) {
+      TESTASSERT(find_empty_interval_of_length(rb_bitmap, len, start) ==
+                 find_empty_interval_of_length(rb_bitmap.prbs(), len, start));
+    }
+  }
+
+  rb_bitmap.reset();
+  TESTASSERT(rb_bitmap.free_prb_intervals().size() == 1);
+  rb_bitmap.set(0);
+  TESTASSERT(rb_bitmap.free_prb_intervals()[0] == prb_interval(1, 275));
+}
+
 int main()
 {
   test_bwp_prb_grant();
   test_bwp_rb_bitmap();
   test_bwp_rb_bitmap_search();
+  test_bwp_rb_bitmap_free_intervals();
 }
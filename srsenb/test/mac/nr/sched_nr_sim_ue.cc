@@ -217,11 +217,15 @@ void sched_nr_base_tester::generate_cc_result(uint32_t cc)
 {
   // Run scheduler
   sched_nr_interface::dl_res_t dl_sched(cc_results[cc].rar, cc_results[cc].dl_res);
+  auto                         tp0 = std::chrono::steady_clock::now();
   sched_ptr->run_slot(current_slot_tx, cc, dl_sched);
+  auto tp1           = std::chrono::steady_clock::now();
   cc_results[cc].rar = dl_sched.rar;
   sched_ptr->get_ul_sched(current_slot_tx, cc, cc_results[cc].ul_res);
   auto tp2                     = std::chrono::steady_clock::now();
   cc_results[cc].cc_latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - slot_start_tp);
+  cc_results[cc].dl_latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tp1 - tp0);
+  cc_results[cc].ul_latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp1);
 
   if (--nof_cc_remaining > 0) {
     // there are still missing CC results
@@ -131,6 +131,8 @@ public:
     sched_nr_interface::sched_rar_list_t rar;
     sched_nr_interface::ul_res_t         ul_res;
     std::chrono::nanoseconds             cc_latency_ns;
+    std::chrono::nanoseconds             dl_latency_ns; ///< duration of the DL scheduler call of this carrier
+    std::chrono::nanoseconds             ul_latency_ns; ///< duration of the UL scheduler call of this carrier
   };
 
   sched_nr_base_tester(const sched_nr_interface::sched_args_t&            sched_args,
@@ -44,6 +44,12 @@ public:
           return lhs.cc_latency_ns < rhs.cc_latency_ns;
         })->cc_latency_ns.count();
 
+    if (not slot_ctxt.ue_db.empty() and not first_ue_slot.valid()) {
+      first_ue_slot = current_slot_tx;
+    }
+    // With look-ahead, the slots generated before the UE was added have no UE allocations
+    bool ue_visible = first_ue_slot.valid() and current_slot_tx >= first_ue_slot + lookahead_slots;
+
     for (auto& cc_out : cc_list) {
       pdsch_count += cc_out.dl_res.pdcch_dl.size();
       cc_res_count++;
@@ -52,7 +58,7 @@ public:
 
       if (is_dl_slot) {
         if (cc_out.dl_res.ssb.empty()) {
-          TESTASSERT(slot_ctxt.ue_db.empty() or cc_out.dl_res.pdcch_dl.size() == 1);
+          TESTASSERT(not ue_visible or cc_out.dl_res.pdcch_dl.size() == 1);
         } else {
           TESTASSERT(cc_out.dl_res.pdcch_dl.size() == 0);
         }
@@ -68,12 +74,15 @@ public:
 
   srslog::basic_logger& test_logger = srslog::fetch_basic_logger("TEST");
 
+  uint32_t   lookahead_slots = 0;
+  slot_point first_ue_slot;
+
   uint64_t tot_latency_sched_ns = 0;
   uint32_t cc_res_count         = 0;
   uint32_t pdsch_count          = 0;
 };
 
-void run_sched_nr_test(uint32_t nof_workers)
+void run_sched_nr_test(uint32_t nof_workers, uint32_t lookahead_slots = 0, bool dynamic_mcs = false)
 {
   srsran_assert(nof_workers > 0, "There must be at least one worker");
   uint32_t max_nof_ttis = 1000, nof_sectors = 4;
@@ -81,6 +90,11 @@ void run_sched_nr_test(uint32_t nof_workers)
 
   sched_nr_interface::sched_args_t cfg;
   cfg.auto_refill_buffer = true;
+  cfg.lookahead_slots    = lookahead_slots;
+  if (dynamic_mcs) {
+    cfg.fixed_dl_mcs = -1;
+    cfg.fixed_ul_mcs = -1;
+  }
 
   std::vector<sched_nr_interface::cell_cfg_t> cells_cfg = get_default_cells_cfg(nof_sectors);
 
@@ -88,7 +102,14 @@ void run_sched_nr_test(uint32_t nof_workers)
   if (nof_workers > 1) {
     test_name = fmt::format("Parallel Test with {} workers", nof_workers);
   }
+  if (lookahead_slots > 0) {
+    test_name += fmt::format(" and {} look-ahead slots", lookahead_slots);
+  }
+  if (dynamic_mcs) {
+    test_name += " and dynamic MCS";
+  }
   sched_nr_tester tester(cfg, cells_cfg, test_name, nof_workers);
+  tester.lookahead_slots = lookahead_slots;
 
   for (uint32_t nof_slots = 0; nof_slots < max_nof_ttis; ++nof_slots) {
     slot_point slot_rx(0, nof_slots % 10240);
@@ -126,4 +147,7 @@ int main()
   srsenb::run_sched_nr_test(1);
   srsenb::run_sched_nr_test(2);
   srsenb::run_sched_nr_test(4);
+  srsenb::run_sched_nr_test(1, 2);
+  srsenb::run_sched_nr_test(4, 2);
+  srsenb::run_sched_nr_test(1, 0, true);
 }
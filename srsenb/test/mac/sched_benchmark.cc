@@ -19,20 +19,33 @@
  *
  */
 
+#include "sched_benchmark_common.h"
 #include "sched_test_common.h"
 #include "srsenb/hdr/stack/mac/sched.h"
+#include "srsenb/hdr/stack/mac/ue.h"
 #include "srsran/adt/accumulators.h"
+#include "srsran/adt/pool/obj_pool.h"
 #include "srsran/common/common_lte.h"
 #include <chrono>
+#include <deque>
+#include <random>
 
 namespace srsenb {
 
 struct run_params {
-  uint32_t    nof_prbs;
-  uint32_t    nof_ues;
-  uint32_t    nof_ttis;
-  uint32_t    cqi;
-  const char* sched_policy;
+  uint32_t        nof_prbs;
+  uint32_t        nof_ues;
+  uint32_t        nof_ttis;
+  uint32_t        cqi;
+  const char*     sched_policy;
+  bool            mcs_tbs_tables;
+  uint32_t        nof_ccs;
+  uint32_t        nof_cc_workers;
+  bool            freq_selective;
+  bench_traffic_t traffic;
+  bool            ca;
+  uint32_t        nof_ports;
+  bool            mu_mimo;
 };
 
 struct run_params_range {
@@ -40,13 +53,29 @@ struct run_params_range {
   std::vector<uint32_t>    nof_ues      = {1, 2, 5, 32};
   uint32_t                 nof_ttis     = 10000;
   std::vector<uint32_t>    cqi          = {5, 10, 15};
-  std::vector<const char*> sched_policy = {"time_rr", "time_pf"};
+  std::vector<const char*> sched_policy = {"time_rr", "time_pf", "freq_pf"};
+  bool                     mcs_tbs_tables = true;
+  uint32_t                 nof_ccs        = 1;
+  uint32_t                 nof_cc_workers = 0;
+  bool                     freq_selective = false;
+  bench_traffic_t          traffic        = bench_traffic_t::full_buffer;
+  bool                     ca             = false;
+  uint32_t                 nof_ports      = 1;
+  bool                     mu_mimo        = false;
 
   size_t     nof_runs() const { return nof_prbs.size() * nof_ues.size() * cqi.size() * sched_policy.size(); }
   run_params get_params(size_t idx) const
   {
     run_params r = {};
-    r.nof_ttis   = nof_ttis;
+    r.nof_ttis       = nof_ttis;
+    r.mcs_tbs_tables = mcs_tbs_tables;
+    r.nof_ccs        = nof_ccs;
+    r.nof_cc_workers = nof_cc_workers;
+    r.freq_selective = freq_selective;
+    r.traffic        = traffic;
+    r.ca             = ca;
+    r.nof_ports      = nof_ports;
+    r.mu_mimo        = mu_mimo;
     r.nof_prbs   = nof_prbs[idx % nof_prbs.size()];
     idx /= nof_prbs.size();
     r.nof_ues = nof_ues[idx % nof_ues.size()];
@@ -81,8 +110,6 @@ public:
 
   srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
   sched*                sched_ptr;
-  uint32_t              dl_bytes_per_tti   = 100000;
-  uint32_t              ul_bytes_per_tti   = 100000;
   run_params            current_run_params = {};
 
   std::vector<sched_interface::dl_sched_res_t> dl_result;
@@ -92,24 +119,37 @@ public:
     srsran::rolling_average<float>  mean_dl_tbs, mean_ul_tbs, avg_dl_mcs, avg_ul_mcs;
     srsran::rolling_average<double> avg_latency;
     std::vector<uint32_t>           latency_samples;
+    bench_latency_stats             dl_latency, ul_latency, tti_latency;
+    uint64_t                        nof_dl_allocs = 0, nof_ul_allocs = 0;
   };
   throughput_stats total_stats;
 
+  /// Traffic generators of the UEs, and number of TTIs since the start of the run
+  std::map<uint16_t, bench_traffic_gen> traffic_gens;
+  uint32_t                              tti_count = 0;
+
   int advance_tti()
   {
     tti_point tti_rx = get_tti_rx().is_valid() ? get_tti_rx() + 1 : tti_point(0);
     mac_logger.set_context(tti_rx.to_uint());
     new_tti(tti_rx);
 
+    std::chrono::nanoseconds tti_dur{0};
     for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
       std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
       TESTASSERT(sched_ptr->dl_sched(to_tx_dl(tti_rx).to_uint(), cc, dl_result[cc]) == SRSRAN_SUCCESS);
+      std::chrono::time_point<std::chrono::steady_clock> tp1 = std::chrono::steady_clock::now();
       TESTASSERT(sched_ptr->ul_sched(to_tx_ul(tti_rx).to_uint(), cc, ul_result[cc]) == SRSRAN_SUCCESS);
       std::chrono::time_point<std::chrono::steady_clock> tp2 = std::chrono::steady_clock::now();
       std::chrono::nanoseconds tdur = std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp);
       total_stats.avg_latency.push(tdur.count());
       total_stats.latency_samples.push_back(tdur.count());
+      total_stats.dl_latency.push(std::chrono::duration_cast<std::chrono::nanoseconds>(tp1 - tp));
+      total_stats.ul_latency.push(std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp1));
+      tti_dur += tdur;
     }
+    total_stats.tti_latency.push(tti_dur);
+    tti_count++;
 
     sf_output_res_t sf_out{get_cell_params(), tti_rx, ul_result, dl_result};
     update(sf_out);
@@ -122,18 +162,64 @@ public:
   {
     // do nothing
     if (ue_ctxt.conres_rx) {
-      sched_ptr->ul_bsr(ue_ctxt.rnti, 1, dl_bytes_per_tti);
-      sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, 3, ul_bytes_per_tti, 0);
+      auto     gen_it   = traffic_gens.find(ue_ctxt.rnti);
+      uint32_t dl_bytes = 0, ul_bytes = 0;
+      if (gen_it == traffic_gens.end()) {
+        gen_it = traffic_gens.emplace(ue_ctxt.rnti, bench_traffic_gen{current_run_params.traffic, ue_ctxt.rnti}).first;
+      }
+      if (gen_it->second.new_tti(tti_count, dl_bytes, ul_bytes)) {
+        sched_ptr->ul_bsr(ue_ctxt.rnti, 1, ul_bytes);
+        sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, 3, dl_bytes, 0);
+      }
 
       if (get_tti_rx().to_uint() % 5 == 0) {
-        for (auto& cc : pending_events.cc_list) {
+        for (uint32_t enb_cc_idx = 0; enb_cc_idx < pending_events.cc_list.size(); ++enb_cc_idx) {
+          auto& cc  = pending_events.cc_list[enb_cc_idx];
           cc.dl_cqi = current_run_params.cqi;
           cc.ul_snr = 40;
+          if (current_run_params.freq_selective and cc.configured) {
+            // Non-contiguous allocations require the dedicated DCI formats
+            sched_ptr->phy_config_enabled(ue_ctxt.rnti, true);
+            cc.dl_cqi = report_subband_cqis(ue_ctxt.rnti, enb_cc_idx);
+          }
+          if (current_run_params.nof_ports > 1 and cc.configured) {
+            // Closed-loop spatial multiplexing requires the dedicated DCI formats
+            sched_ptr->phy_config_enabled(ue_ctxt.rnti, true);
+            report_pmi(ue_ctxt.rnti, enb_cc_idx);
+          }
         }
       }
     }
   }
 
+  /// Reports rank 1 and a PMI that is different for each UE and changes every 200 TTIs, as UEs spread in the cell
+  void report_pmi(uint16_t rnti, uint32_t enb_cc_idx)
+  {
+    uint32_t         nof_pmis = current_run_params.nof_ports == 2 ? 4 : 16;
+    std::minstd_rand rgen((get_tti_rx().to_uint() / 200) * 65536U + rnti + 1);
+    rgen.discard(1);
+    uint32_t pmi = std::uniform_int_distribution<uint32_t>{0, nof_pmis - 1}(rgen);
+    sched_ptr->dl_ri_info(get_tti_rx().to_uint(), rnti, enb_cc_idx, 0);
+    sched_ptr->dl_pmi_info(get_tti_rx().to_uint(), rnti, enb_cc_idx, pmi);
+  }
+
+  /// Reports the subband CQIs of a UE in a frequency-selective channel, and returns the wideband CQI. Each subband
+  /// fades independently of the others and of the other UEs, and the fading changes every 100 TTIs
+  int report_subband_cqis(uint16_t rnti, uint32_t enb_cc_idx)
+  {
+    uint32_t nof_sb  = std::max(1, srsran_cqi_hl_get_no_subbands(get_cell_params()[enb_cc_idx].nof_prb()));
+    uint32_t cqi_sum = 0;
+    for (uint32_t sb = 0; sb < nof_sb; ++sb) {
+      std::minstd_rand rgen(((get_tti_rx().to_uint() / 100) * 65536U + rnti) * 16U + sb + 1);
+      rgen.discard(1);
+      int fading = std::uniform_int_distribution<int>{0, 6}(rgen);
+      int cqi    = std::max(1, (int)current_run_params.cqi - fading);
+      sched_ptr->dl_sb_cqi_info(get_tti_rx().to_uint(), rnti, enb_cc_idx, sb, cqi);
+      cqi_sum += cqi;
+    }
+    return cqi_sum / nof_sb;
+  }
+
   void process_stats(sf_output_res_t& sf_out)
   {
     for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
@@ -143,6 +229,8 @@ public:
         dl_tbs += data.tbs[1];
         dl_mcs = std::max(dl_mcs, data.dci.tb[0].mcs_idx);
       }
+      total_stats.nof_dl_allocs += sf_out.dl_cc_result[cc].data.size();
+      total_stats.nof_ul_allocs += sf_out.ul_cc_result[cc].pusch.size();
       total_stats.mean_dl_tbs.push(dl_tbs);
       if (not sf_out.dl_cc_result[cc].data.empty()) {
         total_stats.avg_dl_mcs.push(dl_mcs);
@@ -167,14 +255,39 @@ struct run_data {
   float                     avg_ul_mcs;
   std::chrono::microseconds avg_latency;
   std::chrono::microseconds q0_9_latency;
+  double                    avg_latency_usec;
 };
 
-int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results)
+/// Runs a benchmark scenario, and optionally fills the latency, allocation and memory statistics of the scale report
+int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results, bench_scale_report* report = nullptr)
 {
-  std::vector<sched_interface::cell_cfg_t> cell_list(1, generate_default_cell_cfg(params.nof_prbs));
+  std::vector<sched_interface::cell_cfg_t> cell_list(params.nof_ccs, generate_default_cell_cfg(params.nof_prbs));
   sched_interface::ue_cfg_t                ue_cfg_default = generate_default_ue_cfg();
   sched_interface::sched_args_t            sched_args     = {};
   sched_args.sched_policy                                 = params.sched_policy;
+  sched_args.mcs_tbs_tables                               = params.mcs_tbs_tables;
+  sched_args.nof_cc_workers                               = params.nof_cc_workers;
+  sched_args.mu_mimo                                      = params.mu_mimo;
+  for (uint32_t cc = 0; cc < cell_list.size(); ++cc) {
+    cell_list[cc].cell.id = cc;
+  }
+  if (params.nof_ports > 1) {
+    // Closed-loop spatial multiplexing (TM4)
+    for (auto& cell : cell_list) {
+      cell.cell.nof_ports = params.nof_ports;
+    }
+    ue_cfg_default.dl_ant_info.tx_mode            = sched_interface::ant_info_ded_t::tx_mode_t::tm4;
+    ue_cfg_default.supported_cc_list[0].dl_cfg.tm = SRSRAN_TM4;
+  }
+  if (params.freq_selective and params.nof_prbs > 6) {
+    // Enable subband CQI reports
+    ue_cfg_default.supported_cc_list[0].dl_cfg.cqi_report.periodic_configured    = true;
+    ue_cfg_default.supported_cc_list[0].dl_cfg.cqi_report.subband_wideband_ratio = 1;
+  }
+  if (params.ca) {
+    // The SCells are activated once the UE is connected
+    ue_cfg_default.supported_cc_list.resize(params.nof_ccs, ue_cfg_default.supported_cc_list[0]);
+  }
 
   sched     sched_obj;
   rrc_dummy rrc{};
@@ -184,16 +297,25 @@ int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results
   tester.total_stats        = {};
   tester.current_run_params = params;
 
-  for (uint32_t ue_idx = 0; ue_idx < params.nof_ues; ++ue_idx) {
-    uint16_t rnti = 0x46 + ue_idx;
-    // Add user (first need to advance to a PRACH TTI)
+  size_t rss_start_kB = bench_rss_kB();
+
+  // Up to "max_ues_per_prach" UEs, with different preambles, are added in each PRACH opportunity
+  const uint32_t max_ues_per_prach = 4;
+  for (uint32_t ue_idx = 0; ue_idx < params.nof_ues;) {
+    // Add users (first need to advance to a PRACH TTI)
     while (not srsran_prach_tti_opportunity_config_fdd(
-        tester.get_cell_params()[ue_cfg_default.supported_cc_list[0].enb_cc_idx].cfg.prach_config,
-        tester.get_tti_rx().to_uint(),
-        -1)) {
+        tester.get_cell_params()[0].cfg.prach_config, tester.get_tti_rx().to_uint(), -1)) {
       TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
     }
-    TESTASSERT(tester.add_user(rnti, ue_cfg_default, 16) == SRSRAN_SUCCESS);
+    for (uint32_t i = 0; i < max_ues_per_prach and ue_idx < params.nof_ues; ++i, ++ue_idx) {
+      uint16_t rnti = 0x46 + ue_idx;
+      // UEs are evenly distributed across PCells. With CA, the remaining carriers are configured as SCells
+      for (uint32_t ue_cc_idx = 0; ue_cc_idx < ue_cfg_default.supported_cc_list.size(); ++ue_cc_idx) {
+        ue_cfg_default.supported_cc_list[ue_cc_idx].active     = true;
+        ue_cfg_default.supported_cc_list[ue_cc_idx].enb_cc_idx = (ue_idx + ue_cc_idx) % params.nof_ccs;
+      }
+      TESTASSERT(tester.add_user(rnti, ue_cfg_default, 16 + i) == SRSRAN_SUCCESS);
+    }
     TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
   }
 
@@ -209,11 +331,32 @@ int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results
   // Run benchmark
   tester.total_stats = {};
   tester.total_stats.latency_samples.reserve(params.nof_ttis);
+  if (report != nullptr) {
+    tester.total_stats.dl_latency.reserve(params.nof_ttis * params.nof_ccs);
+    tester.total_stats.ul_latency.reserve(params.nof_ttis * params.nof_ccs);
+    tester.total_stats.tti_latency.reserve(params.nof_ttis);
+  }
   for (uint32_t count = 0; count < params.nof_ttis; ++count) {
     tester.advance_tti();
   }
   std::sort(tester.total_stats.latency_samples.begin(), tester.total_stats.latency_samples.end());
 
+  if (report != nullptr) {
+    report->rat           = "lte";
+    report->nof_prbs      = params.nof_prbs;
+    report->dl_latency    = std::move(tester.total_stats.dl_latency);
+    report->ul_latency    = std::move(tester.total_stats.ul_latency);
+    report->tti_latency   = std::move(tester.total_stats.tti_latency);
+    report->nof_dl_allocs = tester.total_stats.nof_dl_allocs;
+    report->nof_ul_allocs = tester.total_stats.nof_ul_allocs;
+    report->dl_mbps       = tester.total_stats.mean_dl_tbs.value() * 8.0 * params.nof_ccs / 1e3;
+    report->ul_mbps       = tester.total_stats.mean_ul_tbs.value() * 8.0 * params.nof_ccs / 1e3;
+    report->rss_start_kB  = rss_start_kB;
+    report->rss_end_kB    = bench_rss_kB();
+    report->peak_rss_kB   = std::max(bench_peak_rss_kB(), report->rss_end_kB);
+    report->finish();
+  }
+
   run_data run_result          = {};
   run_result.params            = params;
   run_result.avg_dl_throughput = tester.total_stats.mean_dl_tbs.value() * 8.0F / 1e-3F;
@@ -223,6 +366,7 @@ int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results
   run_result.avg_latency  = std::chrono::microseconds(static_cast<int>(tester.total_stats.avg_latency.value() / 1000));
   run_result.q0_9_latency = std::chrono::microseconds(
       tester.total_stats.latency_samples[static_cast<size_t>(tester.total_stats.latency_samples.size() * 0.9)] / 1000);
+  run_result.avg_latency_usec = tester.total_stats.avg_latency.value() / 1000;
   run_results.push_back(run_result);
 
   return SRSRAN_SUCCESS;
@@ -394,6 +538,442 @@ int run_benchmark()
   return SRSRAN_SUCCESS;
 }
 
+/// Compares the per-TTI scheduling latency with the MCS/TBS derivation precomputed per cell and computed iteratively
+int run_mcs_table_benchmark()
+{
+  run_params_range      run_param_list{};
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  run_param_list.nof_ttis = 100000;
+  run_param_list.nof_prbs = {25, 100};
+  run_param_list.nof_ues  = {5, 32};
+  run_param_list.cqi      = {5, 15};
+
+  std::vector<run_data> iter_results, table_results;
+  size_t                nof_runs = run_param_list.nof_runs();
+  fmt::print("Running MCS/TBS table Benchmark\n");
+  for (size_t r = 0; r < nof_runs; ++r) {
+    run_params runparams = run_param_list.get_params(r);
+
+    mac_logger.info("\n### New run {} ###\n", r);
+    runparams.mcs_tbs_tables = false;
+    TESTASSERT(run_benchmark_scenario(runparams, iter_results) == SRSRAN_SUCCESS);
+    runparams.mcs_tbs_tables = true;
+    TESTASSERT(run_benchmark_scenario(runparams, table_results) == SRSRAN_SUCCESS);
+  }
+
+  srslog::flush();
+  fmt::print("Nprb | cqi | sched pol | Nue | iterative [usec/TTI] | table [usec/TTI] | speedup\n");
+  fmt::print("-------------------------------------------------------------------------------\n");
+  for (size_t r = 0; r < nof_runs; ++r) {
+    const run_data& it = iter_results[r];
+    const run_data& tb = table_results[r];
+    // Both runs must have led to the same scheduling decisions
+    TESTASSERT(it.avg_dl_throughput == tb.avg_dl_throughput and it.avg_ul_throughput == tb.avg_ul_throughput);
+    fmt::print("{:>4d}{:>6d}{:>12}{:>6d}{:>23.2f}{:>19.2f}{:>10.2f}\n",
+               it.params.nof_prbs,
+               it.params.cqi,
+               it.params.sched_policy,
+               it.params.nof_ues,
+               it.avg_latency_usec,
+               tb.avg_latency_usec,
+               it.avg_latency_usec / tb.avg_latency_usec);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Compares the per-TTI scheduling latency when all carriers are generated by the calling thread and when the carriers
+/// with no UEs in common are generated in parallel
+int run_cc_workers_benchmark()
+{
+  run_params_range      run_param_list{};
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  run_param_list.nof_ttis     = 20000;
+  run_param_list.nof_prbs     = {100};
+  run_param_list.nof_ues      = {4, 32};
+  run_param_list.cqi          = {15};
+  run_param_list.sched_policy = {"time_pf"};
+
+  std::vector<uint32_t> nof_ccs_list = {2, 4};
+  fmt::print("Running carrier workers Benchmark\n");
+  fmt::print("Nprb | Ncc | Nue | sequential [usec/TTI] | parallel [usec/TTI] | speedup\n");
+  fmt::print("-------------------------------------------------------------------------\n");
+  for (uint32_t nof_ccs : nof_ccs_list) {
+    for (size_t r = 0; r < run_param_list.nof_runs(); ++r) {
+      run_params runparams = run_param_list.get_params(r);
+      runparams.nof_ccs    = nof_ccs;
+
+      std::vector<run_data> results;
+      mac_logger.info("\n### New run {} ###\n", r);
+      runparams.nof_cc_workers = 0;
+      TESTASSERT(run_benchmark_scenario(runparams, results) == SRSRAN_SUCCESS);
+      runparams.nof_cc_workers = nof_ccs - 1;
+      TESTASSERT(run_benchmark_scenario(runparams, results) == SRSRAN_SUCCESS);
+
+      // Carriers with no common UEs are independent, so the decisions must not change
+      TESTASSERT(results[0].avg_dl_throughput == results[1].avg_dl_throughput and
+                 results[0].avg_ul_throughput == results[1].avg_ul_throughput);
+      double seq_usec = results[0].avg_latency_usec * nof_ccs;
+      double par_usec = results[1].avg_latency_usec * nof_ccs;
+      fmt::print("{:>4d}{:>6d}{:>6d}{:>24.2f}{:>22.2f}{:>10.2f}\n",
+                 runparams.nof_prbs,
+                 nof_ccs,
+                 runparams.nof_ues,
+                 seq_usec,
+                 par_usec,
+                 seq_usec / par_usec);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Compares the cell throughput and the per-TTI scheduling latency of the time-domain and frequency-selective PF
+/// policies, when the UEs report different subband CQIs
+int run_freq_pf_benchmark()
+{
+  run_params_range      run_param_list{};
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  run_param_list.nof_ttis       = 20000;
+  run_param_list.nof_prbs       = {25, 50, 100};
+  run_param_list.nof_ues        = {8, 32};
+  run_param_list.cqi            = {15};
+  run_param_list.sched_policy   = {"time_pf"};
+  run_param_list.freq_selective = true;
+
+  std::vector<run_data> time_results, freq_results;
+  size_t                nof_runs = run_param_list.nof_runs();
+  fmt::print("Running frequency-selective PF Benchmark\n");
+  for (size_t r = 0; r < nof_runs; ++r) {
+    run_params runparams = run_param_list.get_params(r);
+
+    mac_logger.info("\n### New run {} ###\n", r);
+    runparams.sched_policy = "time_pf";
+    TESTASSERT(run_benchmark_scenario(runparams, time_results) == SRSRAN_SUCCESS);
+    runparams.sched_policy = "freq_pf";
+    TESTASSERT(run_benchmark_scenario(runparams, freq_results) == SRSRAN_SUCCESS);
+  }
+
+  srslog::flush();
+  fmt::print(
+      "Nprb | Nue | time_pf DL [Mbps] | freq_pf DL [Mbps] | gain [%] | time_pf [usec/TTI] | freq_pf [usec/TTI]\n");
+  fmt::print(
+      "----------------------------------------------------------------------------------------------------------\n");
+  for (size_t r = 0; r < nof_runs; ++r) {
+    const run_data& t = time_results[r];
+    const run_data& f = freq_results[r];
+    fmt::print("{:>4d}{:>6d}{:>20.2f}{:>20.2f}{:>11.1f}{:>21.2f}{:>21.2f}\n",
+               t.params.nof_prbs,
+               t.params.nof_ues,
+               t.avg_dl_throughput / 1e6,
+               f.avg_dl_throughput / 1e6,
+               (f.avg_dl_throughput / t.avg_dl_throughput - 1) * 100,
+               t.avg_latency_usec,
+               f.avg_latency_usec);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Compares the cell throughput and the per-TTI scheduling latency of the time-domain PF policy with and without
+/// MU-MIMO pairing, in a 4T4R cell where the UEs report rank 1 and different PMIs
+int run_mu_mimo_benchmark()
+{
+  run_params_range      run_param_list{};
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  run_param_list.nof_ttis     = 10000;
+  run_param_list.nof_prbs     = {25, 50, 100};
+  run_param_list.nof_ues      = {4, 16, 32};
+  run_param_list.cqi          = {15};
+  run_param_list.sched_policy = {"time_pf"};
+  run_param_list.nof_ports    = 4;
+
+  std::vector<run_data> su_results, mu_results;
+  size_t                nof_runs = run_param_list.nof_runs();
+  fmt::print("Running MU-MIMO Benchmark\n");
+  for (size_t r = 0; r < nof_runs; ++r) {
+    run_params runparams = run_param_list.get_params(r);
+
+    mac_logger.info("\n### New run {} ###\n", r);
+    runparams.mu_mimo = false;
+    TESTASSERT(run_benchmark_scenario(runparams, su_results) == SRSRAN_SUCCESS);
+    runparams.mu_mimo = true;
+    TESTASSERT(run_benchmark_scenario(runparams, mu_results) == SRSRAN_SUCCESS);
+  }
+
+  srslog::flush();
+  fmt::print(
+      "Nprb | Nue | SU-MIMO DL [Mbps] | MU-MIMO DL [Mbps] | gain [%] | SU-MIMO [usec/TTI] | MU-MIMO [usec/TTI]\n");
+  fmt::print(
+      "----------------------------------------------------------------------------------------------------------\n");
+  for (size_t r = 0; r < nof_runs; ++r) {
+    const run_data& su = su_results[r];
+    const run_data& mu = mu_results[r];
+    fmt::print("{:>4d}{:>6d}{:>20.2f}{:>20.2f}{:>11.1f}{:>21.2f}{:>21.2f}\n",
+               su.params.nof_prbs,
+               su.params.nof_ues,
+               su.avg_dl_throughput / 1e6,
+               mu.avg_dl_throughput / 1e6,
+               (mu.avg_dl_throughput / su.avg_dl_throughput - 1) * 100,
+               su.avg_latency_usec,
+               mu.avg_latency_usec);
+    if (su.params.nof_ues > 1) {
+      // With several UEs, there are always UEs with orthogonal precoders to pair
+      TESTASSERT(mu.avg_dl_throughput > su.avg_dl_throughput);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Runs a scenario with many UEs and the given traffic profile, and reports the DL/UL scheduling latency
+/// distribution, allocation rate and memory usage in JSON format
+int run_scale_benchmark(const bench_scale_args& args)
+{
+  if (args.nof_ues > SRSENB_MAX_UES) {
+    fmt::print("Error: {} UEs exceed SRSENB_MAX_UES={}. Rebuild with a larger SRSENB_MAX_UES\n",
+               args.nof_ues,
+               SRSENB_MAX_UES);
+    return SRSRAN_ERROR;
+  }
+  run_params params     = {};
+  params.nof_prbs       = args.nof_prbs == 0 ? 100 : args.nof_prbs;
+  params.nof_ues        = args.nof_ues;
+  params.nof_ttis       = args.nof_ttis;
+  params.cqi            = 15;
+  params.sched_policy   = args.sched_policy.c_str();
+  params.mcs_tbs_tables = true;
+  params.nof_ccs        = args.nof_ccs;
+  params.nof_cc_workers = args.nof_workers;
+  params.traffic        = args.traffic;
+  params.ca             = args.ca and args.nof_ccs > 1;
+
+  bench_scale_report    report;
+  std::vector<run_data> results;
+  report.args = args;
+  TESTASSERT(run_benchmark_scenario(params, results, &report) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  if (not args.json_file.empty()) {
+    report.print_summary();
+  }
+  return report.write_json();
+}
+
+/// Arguments of the attach storm benchmark
+struct attach_storm_args {
+  uint32_t nof_ues       = 64;
+  uint32_t ues_per_prach = 16;
+  uint32_t nof_prbs      = 100;
+  uint32_t nof_prealloc  = 64;   ///< UE softbuffers constructed when the pool is created
+  uint32_t budget_usec   = 1000; ///< processing time of the stack thread per TTI
+  bool     legacy_pool   = false; ///< softbuffer pool with a fixed refill threshold and without background recycling
+
+  static void print_usage(const char* prog)
+  {
+    fmt::print("Usage: {} attach_storm [ues=N] [per_prach=N] [prbs=N] [prealloc=N] [budget=USEC] [legacy_pool=0|1]\n",
+               prog);
+  }
+
+  bool parse(int argc, char** argv, int first_arg)
+  {
+    for (int i = first_arg; i < argc; ++i) {
+      const char* sep = strchr(argv[i], '=');
+      if (sep == nullptr) {
+        return false;
+      }
+      std::string key(argv[i], sep - argv[i]), value(sep + 1);
+      if (key == "ues") {
+        nof_ues = std::stoul(value);
+      } else if (key == "per_prach") {
+        ues_per_prach = std::stoul(value);
+      } else if (key == "prbs") {
+        nof_prbs = std::stoul(value);
+      } else if (key == "prealloc") {
+        nof_prealloc = std::stoul(value);
+      } else if (key == "budget") {
+        budget_usec = std::stoul(value);
+      } else if (key == "legacy_pool") {
+        legacy_pool = std::stoul(value) > 0;
+      } else {
+        return false;
+      }
+    }
+    return nof_ues > 0 and ues_per_prach > 0 and budget_usec > 0;
+  }
+};
+
+/**
+ * Emulates the simultaneous re-attach of many UEs, e.g. after a cell restart. In every PRACH opportunity,
+ * "ues_per_prach" new UEs send a preamble. The stack thread has a processing budget per TTI, shared by the scheduler
+ * and by the creation of the MAC UE contexts, including their softbuffers. The RACH of a UE whose context is not ready
+ * in its PRACH TTI, or that does not fit in the RAR, is only forwarded to the scheduler in a later PRACH opportunity,
+ * which emulates a preamble retransmission after the RAR window expires. The same applies to the UEs whose RAR could
+ * not be scheduled within the window. The benchmark reports the RACH-to-Msg4 latency, the latency of UE
+ * context creation and the latency of the bulk removal of all UEs.
+ */
+int run_attach_storm_benchmark(const attach_storm_args& args)
+{
+  if (args.nof_ues > SRSENB_MAX_UES) {
+    fmt::print("Error: {} UEs exceed SRSENB_MAX_UES={}. Rebuild with a larger SRSENB_MAX_UES\n",
+               args.nof_ues,
+               SRSENB_MAX_UES);
+    return SRSRAN_ERROR;
+  }
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+  // The DL HARQ payload buffers of the MAC UEs are taken from the byte buffer pool
+  srsran::byte_buffer_pool::get_instance(std::max(4096U, 2 * SRSRAN_FDD_NOF_HARQ * SRSRAN_MAX_TB * args.nof_ues));
+
+  // Softbuffer pool, either as configured by the MAC or as it was configured before the attach fast path
+  std::chrono::time_point<std::chrono::steady_clock>        tp_pool = std::chrono::steady_clock::now();
+  std::unique_ptr<srsran::obj_pool_itf<ue_cc_softbuffers> > softbuffer_pool;
+  if (args.legacy_pool) {
+    uint32_t nof_prb          = args.nof_prbs;
+    auto     init_softbuffers = [nof_prb](void* ptr) {
+      new (ptr) ue_cc_softbuffers(nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ);
+    };
+    auto recycle_softbuffers = [](ue_cc_softbuffers& softbuffers) { softbuffers.clear(); };
+    softbuffer_pool.reset(new srsran::background_obj_pool<ue_cc_softbuffers>(
+        8, 8, args.nof_prealloc, init_softbuffers, recycle_softbuffers));
+  } else {
+    softbuffer_pool = make_ue_cc_softbuffer_pool(args.nof_prbs, args.nof_prealloc);
+  }
+  auto pool_dur = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tp_pool);
+
+  std::vector<sched_interface::cell_cfg_t> cell_list{generate_default_cell_cfg(args.nof_prbs)};
+  sched_interface::ue_cfg_t                ue_cfg_default = generate_default_ue_cfg();
+  sched_interface::sched_args_t            sched_args     = {};
+  sched                                    sched_obj;
+  rrc_dummy                                rrc{};
+  sched_obj.init(&rrc, sched_args);
+  sched_tester tester(&sched_obj, sched_args, cell_list);
+  tester.current_run_params.cqi = 15;
+
+  struct storm_ue {
+    uint16_t            rnti;
+    uint32_t            first_prach_count; ///< TTI count of the first preamble, which, unlike tti_point, does not wrap
+    std::unique_ptr<ue> mac_ue;
+    bool                msg4_tx;
+  };
+  std::deque<storm_ue>  pending, ready;
+  std::vector<storm_ue> attached;
+  attached.reserve(args.nof_ues);
+
+  bench_latency_stats   create_latency, remove_latency;
+  std::vector<uint32_t> attach_ttis;
+  uint32_t              nof_retx     = 0; ///< emulated preamble retransmissions
+  const int64_t         budget_ns    = args.budget_usec * 1000LL;
+  int64_t               stack_budget = budget_ns;
+  const uint32_t        max_ttis     = 20000 + args.nof_ues * 10;
+  const uint32_t        rar_timeout  = 3 + cell_list[0].prach_rar_window + 10;
+
+  TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+  uint32_t nof_arrivals = 0;
+  for (uint32_t count = 0; attach_ttis.size() < args.nof_ues; ++count) {
+    if (count >= max_ttis) {
+      fmt::print("Error: only {}/{} UEs attached after {} TTIs\n", attach_ttis.size(), args.nof_ues, count);
+      return SRSRAN_ERROR;
+    }
+    tti_point tti_rx = tester.get_tti_rx();
+    bool      is_prach =
+        srsran_prach_tti_opportunity_config_fdd(tester.get_cell_params()[0].cfg.prach_config, tti_rx.to_uint(), -1);
+
+    // New preambles
+    for (uint32_t i = 0; is_prach and i < args.ues_per_prach and nof_arrivals < args.nof_ues; ++i, ++nof_arrivals) {
+      pending.push_back(storm_ue{static_cast<uint16_t>(0x46 + nof_arrivals), tester.tti_count, nullptr, false});
+    }
+
+    // The stack thread creates the MAC UE contexts while it has processing time left in this TTI
+    while (not pending.empty() and stack_budget > 0) {
+      storm_ue& u = pending.front();
+
+      std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
+      u.mac_ue.reset(new ue(u.rnti, 0, &sched_obj, nullptr, nullptr, nullptr, mac_logger, 1, softbuffer_pool.get()));
+      auto dur = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+      create_latency.push(dur);
+      stack_budget -= dur.count();
+      ready.push_back(std::move(u));
+      pending.pop_front();
+    }
+
+    // RACHs with a MAC context are forwarded to the scheduler, up to the number of grants that fit in a RAR. The
+    // remaining UEs retry in the next PRACH opportunity
+    for (uint32_t preamble = 0; is_prach and not ready.empty() and preamble < sched_interface::MAX_RAR_LIST;
+         ++preamble) {
+      storm_ue& u = ready.front();
+      nof_retx += u.first_prach_count != tester.tti_count ? 1 : 0;
+      std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
+      TESTASSERT(tester.add_user(u.rnti, ue_cfg_default, preamble) == SRSRAN_SUCCESS);
+      auto dur = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+      stack_budget -= dur.count();
+      attached.push_back(std::move(u));
+      ready.pop_front();
+    }
+
+    TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+
+    // Unused processing time is not carried over to the next TTI, but an overrun delays the next TTIs
+    stack_budget = std::min(stack_budget, (int64_t)0) + budget_ns - (int64_t)tester.total_stats.latency_samples.back();
+
+    sim_enb_ctxt_t enb_ctxt = tester.get_enb_ctxt();
+    for (size_t i = 0; i < attached.size();) {
+      storm_ue&            u    = attached[i];
+      const sim_ue_ctxt_t& ctxt = *enb_ctxt.ue_db.at(u.rnti);
+      if (not u.msg4_tx and ctxt.msg4_tti_rx.is_valid()) {
+        u.msg4_tx = true;
+        // Msg4 was scheduled in the last TTI
+        attach_ttis.push_back(tester.tti_count - 1 - u.first_prach_count);
+      }
+      if (not ctxt.rar_tti_rx.is_valid() and tester.get_tti_rx() > ctxt.prach_tti_rx + rar_timeout) {
+        // The scheduler could not fit the RAR in its window. The UE retries in a later PRACH opportunity
+        TESTASSERT(tester.rem_user(u.rnti) == SRSRAN_SUCCESS);
+        ready.push_back(std::move(u));
+        attached.erase(attached.begin() + i);
+        continue;
+      }
+      ++i;
+    }
+  }
+  std::sort(attach_ttis.begin(), attach_ttis.end());
+
+  // Bulk removal of all UEs, e.g. due to a new cell restart
+  for (storm_ue& u : attached) {
+    std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
+    TESTASSERT(tester.rem_user(u.rnti) == SRSRAN_SUCCESS);
+    u.mac_ue.reset();
+    remove_latency.push(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp));
+  }
+  create_latency.finish();
+  remove_latency.finish();
+
+  srslog::flush();
+  fmt::print("Attach storm: {} UEs, {} per PRACH, {} PRBs, {} pool with {} preallocated UEs (created in {} usec)\n",
+             args.nof_ues,
+             args.ues_per_prach,
+             args.nof_prbs,
+             args.legacy_pool ? "legacy" : "default",
+             args.nof_prealloc,
+             pool_dur.count());
+  fmt::print("  RACH-to-Msg4 [TTIs]: p50={} p99={} max={}, {} preamble retransmissions\n",
+             attach_ttis[attach_ttis.size() / 2],
+             attach_ttis[std::min(attach_ttis.size() * 99 / 100, attach_ttis.size() - 1)],
+             attach_ttis.back(),
+             nof_retx);
+  for (const auto& l : {std::make_pair("creation", &create_latency), std::make_pair("removal", &remove_latency)}) {
+    fmt::print("  UE context {} [usec]: mean={:.1f} p50={:.1f} p99={:.1f} max={:.1f}\n",
+               l.first,
+               l.second->mean_usec(),
+               l.second->percentile_usec(0.5),
+               l.second->percentile_usec(0.99),
+               l.second->max_usec());
+  }
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
 
 int main(int argc, char* argv[])
@@ -424,6 +1004,28 @@ int main(int argc, char* argv[])
     TESTASSERT(srsenb::run_rate_test() == SRSRAN_SUCCESS);
   } else if (strcmp(argv[1], "benchmark") == 0) {
     TESTASSERT(srsenb::run_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "mcs_table") == 0) {
+    TESTASSERT(srsenb::run_mcs_table_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "cc_workers") == 0) {
+    TESTASSERT(srsenb::run_cc_workers_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "freq_pf") == 0) {
+    TESTASSERT(srsenb::run_freq_pf_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "mu_mimo") == 0) {
+    TESTASSERT(srsenb::run_mu_mimo_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "scale") == 0) {
+    srsenb::bench_scale_args args;
+    if (not args.parse(argc, argv, 2)) {
+      srsenb::bench_scale_args::print_usage(argv[0], argv[1]);
+      return SRSRAN_ERROR;
+    }
+    TESTASSERT(srsenb::run_scale_benchmark(args) == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "attach_storm") == 0) {
+    srsenb::attach_storm_args args;
+    if (not args.parse(argc, argv, 2)) {
+      srsenb::attach_storm_args::print_usage(argv[0]);
+      return SRSRAN_ERROR;
+    }
+    TESTASSERT(srsenb::run_attach_storm_benchmark(args) == SRSRAN_SUCCESS);
   } else {
     TESTASSERT(srsenb::run_all() == SRSRAN_SUCCESS);
   }
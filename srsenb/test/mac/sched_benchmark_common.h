@@ -0,0 +1,415 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_BENCHMARK_COMMON_H
+#define SRSRAN_SCHED_BENCHMARK_COMMON_H
+
+/*
+ * Helpers shared by the large-scale benchmarks of the LTE and NR schedulers: UE traffic profiles, per-TTI latency
+ * statistics, memory usage and the machine-readable (JSON) report
+ */
+
+#include "srsran/srslog/srslog.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <vector>
+
+namespace srsenb {
+
+/// Traffic profiles of the UEs in the large-scale benchmarks
+enum class bench_traffic_t { full_buffer, voip, web, mixed };
+
+inline const char* to_string(bench_traffic_t traffic)
+{
+  switch (traffic) {
+    case bench_traffic_t::full_buffer:
+      return "full_buffer";
+    case bench_traffic_t::voip:
+      return "voip";
+    case bench_traffic_t::web:
+      return "web";
+    case bench_traffic_t::mixed:
+      return "mixed";
+  }
+  return "invalid";
+}
+
+inline bool from_string(const std::string& str, bench_traffic_t& traffic)
+{
+  for (bench_traffic_t t :
+       {bench_traffic_t::full_buffer, bench_traffic_t::voip, bench_traffic_t::web, bench_traffic_t::mixed}) {
+    if (str == to_string(t)) {
+      traffic = t;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Generates the DL and UL buffer occupancies of a UE. New data arrives every TTI for full buffer UEs, as a voice frame
+ * every 20 TTIs for VoIP UEs, and as a web page followed by an exponentially distributed reading time for web UEs.
+ * In the mixed profile, the UEs are evenly split between the other three profiles.
+ */
+class bench_traffic_gen
+{
+public:
+  bench_traffic_gen(bench_traffic_t profile_, uint16_t rnti) :
+    profile(profile_ == bench_traffic_t::mixed ? static_cast<bench_traffic_t>(rnti % 3) : profile_),
+    voip_offset(rnti % voip_period),
+    rgen(rnti)
+  {
+    next_page_tti = std::uniform_int_distribution<uint32_t>{0, web_reading_ttis}(rgen);
+  }
+
+  bench_traffic_t get_profile() const { return profile; }
+
+  /// Returns true if new data arrived in the given TTI, along with the DL and UL buffer occupancies to report
+  bool new_tti(uint32_t tti_count, uint32_t& dl_bytes, uint32_t& ul_bytes)
+  {
+    switch (profile) {
+      case bench_traffic_t::full_buffer:
+        dl_bytes = full_buffer_bytes;
+        ul_bytes = full_buffer_bytes;
+        return true;
+      case bench_traffic_t::voip:
+        if (tti_count % voip_period != voip_offset) {
+          return false;
+        }
+        dl_bytes = voip_frame_bytes;
+        ul_bytes = voip_frame_bytes;
+        return true;
+      case bench_traffic_t::web:
+        if (tti_count < next_page_tti) {
+          return false;
+        }
+        dl_bytes = std::min(static_cast<uint32_t>(std::lognormal_distribution<float>{web_page_mu, 1.0F}(rgen)),
+                            static_cast<uint32_t>(full_buffer_bytes));
+        ul_bytes = web_request_bytes;
+        next_page_tti =
+            tti_count + 1 + static_cast<uint32_t>(std::exponential_distribution<float>{1.0F / web_reading_ttis}(rgen));
+        return true;
+      default:
+        break;
+    }
+    return false;
+  }
+
+private:
+  static const uint32_t full_buffer_bytes = 100000;
+  static const uint32_t voip_period       = 20;
+  static const uint32_t voip_frame_bytes  = 40; // AMR-WB 12.65 frame with compressed RTP/UDP/IP headers
+  static const uint32_t web_request_bytes = 500;
+  static const uint32_t web_reading_ttis  = 200;
+  // Median page size of 30 kB
+  const float web_page_mu = std::log(30000.0F);
+
+  bench_traffic_t  profile;
+  uint32_t         voip_offset;
+  uint32_t         next_page_tti = 0;
+  std::minstd_rand rgen;
+};
+
+/// Latency samples of a scheduler call, and their percentiles and histogram
+class bench_latency_stats
+{
+public:
+  /// Upper edges of the histogram bins, in usec. The last bin collects the samples above the last edge
+  static const std::array<uint32_t, 10>& hist_edges_usec()
+  {
+    static const std::array<uint32_t, 10> edges = {{5, 10, 20, 50, 100, 200, 300, 500, 750, 1000}};
+    return edges;
+  }
+  using histogram_t = std::array<uint64_t, 11>;
+
+  void reserve(size_t nof_samples) { samples.reserve(nof_samples); }
+  void push(std::chrono::nanoseconds latency) { samples.push_back(latency.count()); }
+  void clear() { samples.clear(); }
+
+  /// Sorts the samples. Must be called before computing the statistics
+  void finish() { std::sort(samples.begin(), samples.end()); }
+
+  size_t size() const { return samples.size(); }
+  double percentile_usec(double q) const
+  {
+    if (samples.empty()) {
+      return 0;
+    }
+    size_t idx = std::min(static_cast<size_t>(q * samples.size()), samples.size() - 1);
+    return samples[idx] / 1000.0;
+  }
+  double max_usec() const { return samples.empty() ? 0 : samples.back() / 1000.0; }
+  double mean_usec() const
+  {
+    double sum = 0;
+    for (uint64_t s : samples) {
+      sum += s;
+    }
+    return samples.empty() ? 0 : sum / samples.size() / 1000.0;
+  }
+  /// Number of samples above the given latency budget
+  size_t count_above_usec(uint32_t budget_usec) const
+  {
+    return samples.end() - std::upper_bound(samples.begin(), samples.end(), budget_usec * 1000ULL);
+  }
+  histogram_t histogram() const
+  {
+    histogram_t hist = {};
+    size_t      bin  = 0;
+    for (uint64_t s : samples) {
+      while (bin < hist_edges_usec().size() and s > hist_edges_usec()[bin] * 1000ULL) {
+        bin++;
+      }
+      hist[bin]++;
+    }
+    return hist;
+  }
+
+private:
+  std::vector<uint64_t> samples;
+};
+
+/// Resident memory of the process, in kB
+inline size_t bench_rss_kB()
+{
+  size_t pages = 0, resident = 0;
+  FILE*  fp    = fopen("/proc/self/statm", "r");
+  if (fp != nullptr) {
+    if (fscanf(fp, "%zu %zu", &pages, &resident) != 2) {
+      resident = 0;
+    }
+    fclose(fp);
+  }
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+/// Peak resident memory of the process, in kB
+inline size_t bench_peak_rss_kB()
+{
+  struct rusage usage = {};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/// Arguments of the large-scale benchmarks, passed as "key=value" in the command line
+struct bench_scale_args {
+  uint32_t        nof_ues      = 64;
+  uint32_t        nof_ccs      = 1;
+  uint32_t        nof_prbs     = 0; ///< 0 selects the default bandwidth of the RAT
+  uint32_t        nof_ttis     = 10000;
+  bench_traffic_t traffic      = bench_traffic_t::mixed;
+  bool            ca           = false; ///< UEs are configured with all carriers, otherwise spread across carriers
+  std::string     sched_policy = "time_pf";
+  uint32_t        nof_workers  = 0;
+  uint32_t        lookahead    = 0;    ///< slots generated ahead by the NR scheduler
+  uint32_t        budget_usec  = 1000; ///< per-TTI latency budget
+  std::string     json_file;            ///< empty to write the report to stdout
+
+  static void print_usage(const char* prog, const char* mode)
+  {
+    fmt::print("Usage: {}{}{} [ues=N] [ccs=N] [prbs=N] [ttis=N] [traffic=full_buffer|voip|web|mixed] [ca=0|1] "
+               "[policy=NAME] [workers=N] [lookahead=N] [budget=USEC] [json=FILE]\n",
+               prog,
+               mode[0] != '\0' ? " " : "",
+               mode);
+  }
+
+  bool parse(int argc, char** argv, int first_arg)
+  {
+    for (int i = first_arg; i < argc; ++i) {
+      const char* sep = strchr(argv[i], '=');
+      if (sep == nullptr) {
+        return false;
+      }
+      std::string key(argv[i], sep - argv[i]), value(sep + 1);
+      if (key == "ues") {
+        nof_ues = std::stoul(value);
+      } else if (key == "ccs") {
+        nof_ccs = std::stoul(value);
+      } else if (key == "prbs") {
+        nof_prbs = std::stoul(value);
+      } else if (key == "ttis") {
+        nof_ttis = std::stoul(value);
+      } else if (key == "traffic") {
+        if (not from_string(value, traffic)) {
+          return false;
+        }
+      } else if (key == "ca") {
+        ca = std::stoul(value) > 0;
+      } else if (key == "policy") {
+        sched_policy = value;
+      } else if (key == "workers") {
+        nof_workers = std::stoul(value);
+      } else if (key == "lookahead") {
+        lookahead = std::stoul(value);
+      } else if (key == "budget") {
+        budget_usec = std::stoul(value);
+      } else if (key == "json") {
+        json_file = value;
+      } else {
+        return false;
+      }
+    }
+    return nof_ues > 0 and nof_ccs > 0 and nof_ttis > 0;
+  }
+};
+
+/// Outcome of a large-scale benchmark run
+struct bench_scale_report {
+  std::string         rat;
+  bench_scale_args    args;
+  uint32_t            nof_prbs = 0;
+  bench_latency_stats dl_latency;  ///< latency of each DL scheduler call, i.e. per {TTI, carrier}
+  bench_latency_stats ul_latency;  ///< latency of each UL scheduler call, i.e. per {TTI, carrier}
+  bench_latency_stats tti_latency; ///< time to generate the DL and UL results of all carriers of a TTI
+  uint64_t            nof_dl_allocs = 0;
+  uint64_t            nof_ul_allocs = 0;
+  double              dl_mbps       = 0;
+  double              ul_mbps       = 0;
+  size_t              rss_start_kB  = 0; ///< resident memory before the UEs are created
+  size_t              rss_end_kB    = 0;
+  size_t              peak_rss_kB   = 0;
+
+  void finish()
+  {
+    dl_latency.finish();
+    ul_latency.finish();
+    tti_latency.finish();
+  }
+
+  void print_summary() const
+  {
+    fmt::print("{} sched: {} UEs ({}), {} cc(s) of {} PRBs{}, policy={}, {} TTIs\n",
+               rat,
+               args.nof_ues,
+               to_string(args.traffic),
+               args.nof_ccs,
+               nof_prbs,
+               args.ca ? " with CA" : "",
+               args.sched_policy,
+               args.nof_ttis);
+    fmt::print("           p50 [usec] | p99 [usec] | max [usec]\n");
+    fmt::print("  dl_sched {:>11.1f}{:>13.1f}{:>13.1f}\n",
+               dl_latency.percentile_usec(0.5),
+               dl_latency.percentile_usec(0.99),
+               dl_latency.max_usec());
+    fmt::print("  ul_sched {:>11.1f}{:>13.1f}{:>13.1f}\n",
+               ul_latency.percentile_usec(0.5),
+               ul_latency.percentile_usec(0.99),
+               ul_latency.max_usec());
+    fmt::print("  TTI      {:>11.1f}{:>13.1f}{:>13.1f}  ({} TTIs above {} usec)\n",
+               tti_latency.percentile_usec(0.5),
+               tti_latency.percentile_usec(0.99),
+               tti_latency.max_usec(),
+               tti_latency.count_above_usec(args.budget_usec),
+               args.budget_usec);
+    fmt::print("  DL/UL allocs/s: {:.0f}/{:.0f}, DL/UL rate: {:.2f}/{:.2f} Mbps, RSS: {} kB (+{} kB), peak {} kB\n",
+               nof_dl_allocs / (args.nof_ttis * 1e-3),
+               nof_ul_allocs / (args.nof_ttis * 1e-3),
+               dl_mbps,
+               ul_mbps,
+               rss_end_kB,
+               rss_end_kB - std::min(rss_start_kB, rss_end_kB),
+               peak_rss_kB);
+  }
+
+  std::string to_json() const
+  {
+    fmt::memory_buffer buf;
+    fmt::format_to(buf,
+                   "{{\"rat\": \"{}\", \"nof_ues\": {}, \"traffic\": \"{}\", \"nof_ccs\": {}, \"ca\": {}, "
+                   "\"nof_prbs\": {}, \"sched_policy\": \"{}\", \"nof_workers\": {}, \"lookahead_slots\": {}, "
+                   "\"nof_ttis\": {}, ",
+                   rat,
+                   args.nof_ues,
+                   to_string(args.traffic),
+                   args.nof_ccs,
+                   args.ca ? "true" : "false",
+                   nof_prbs,
+                   args.sched_policy,
+                   args.nof_workers,
+                   args.lookahead,
+                   args.nof_ttis);
+    latency_to_json(buf, "dl_sched_latency", dl_latency);
+    latency_to_json(buf, "ul_sched_latency", ul_latency);
+    latency_to_json(buf, "tti_latency", tti_latency);
+    fmt::format_to(buf,
+                   "\"budget_usec\": {}, \"nof_ttis_over_budget\": {}, \"dl_allocs_per_sec\": {:.1f}, "
+                   "\"ul_allocs_per_sec\": {:.1f}, \"dl_mbps\": {:.3f}, \"ul_mbps\": {:.3f}, "
+                   "\"memory\": {{\"rss_start_kB\": {}, \"rss_end_kB\": {}, \"peak_rss_kB\": {}}}}}",
+                   args.budget_usec,
+                   tti_latency.count_above_usec(args.budget_usec),
+                   nof_dl_allocs / (args.nof_ttis * 1e-3),
+                   nof_ul_allocs / (args.nof_ttis * 1e-3),
+                   dl_mbps,
+                   ul_mbps,
+                   rss_start_kB,
+                   rss_end_kB,
+                   peak_rss_kB);
+    return fmt::to_string(buf);
+  }
+
+  /// Writes the JSON report to the file passed in the arguments, or to stdout
+  int write_json() const
+  {
+    std::string json = to_json();
+    if (args.json_file.empty()) {
+      fmt::print("{}\n", json);
+      return 0;
+    }
+    FILE* fp = fopen(args.json_file.c_str(), "w");
+    if (fp == nullptr) {
+      fmt::print("Error opening {}\n", args.json_file);
+      return -1;
+    }
+    fmt::print(fp, "{}\n", json);
+    fclose(fp);
+    return 0;
+  }
+
+private:
+  static void latency_to_json(fmt::memory_buffer& buf, const char* name, const bench_latency_stats& stats)
+  {
+    fmt::format_to(buf,
+                   "\"{}\": {{\"unit\": \"usec\", \"count\": {}, \"mean\": {:.2f}, \"p50\": {:.2f}, \"p99\": {:.2f}, "
+                   "\"max\": {:.2f}, \"hist_edges\": [{}], \"hist_counts\": [{}]}}, ",
+                   name,
+                   stats.size(),
+                   stats.mean_usec(),
+                   stats.percentile_usec(0.5),
+                   stats.percentile_usec(0.99),
+                   stats.max_usec(),
+                   fmt::join(bench_latency_stats::hist_edges_usec(), ", "),
+                   fmt::join(stats.histogram(), ", "));
+  }
+};
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_BENCHMARK_COMMON_H
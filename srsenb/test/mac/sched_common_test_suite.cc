@@ -136,9 +136,23 @@ int test_pdsch_collisions(const sf_output_res_t& sf_out, uint32_t enb_cc_idx, co
     }
   }
 
-  // Decode Data allocations, check collisions and fill cumulative mask
+  // Decode Data allocations, check collisions and fill cumulative mask. When MU-MIMO is enabled, two Format 2
+  // allocations with the same RBGs are UEs paired in MU-MIMO
+  bool              mu_mimo = cell_params.sched_cfg != nullptr and cell_params.sched_cfg->mu_mimo;
+  std::vector<bool> mu_paired(dl_result.data.size(), false);
   for (uint32_t i = 0; i < dl_result.data.size(); ++i) {
-    TESTASSERT(try_dl_mask_fill(dl_result.data[i].dci, "data") == SRSRAN_SUCCESS);
+    const srsran_dci_dl_t& dci = dl_result.data[i].dci;
+    for (uint32_t j = 0; j < i and mu_mimo and dci.format == SRSRAN_DCI_FORMAT2; ++j) {
+      const srsran_dci_dl_t& pair_dci = dl_result.data[j].dci;
+      if (not mu_paired[j] and pair_dci.format == SRSRAN_DCI_FORMAT2 and
+          pair_dci.type0_alloc.rbg_bitmask == dci.type0_alloc.rbg_bitmask) {
+        mu_paired[i] = mu_paired[j] = true;
+        break;
+      }
+    }
+    if (not mu_paired[i]) {
+      TESTASSERT(try_dl_mask_fill(dci, "data") == SRSRAN_SUCCESS);
+    }
   }
 
   // TEST: check for holes in the PRB mask (RBGs not fully filled)
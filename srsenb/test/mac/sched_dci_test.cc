@@ -20,6 +20,7 @@
  */
 
 #include "sched_test_utils.h"
+#include "srsenb/hdr/stack/mac/sched_helpers.h"
 #include "srsenb/hdr/stack/mac/sched_lte_common.h"
 #include "srsenb/hdr/stack/mac/sched_phy_ch/sched_dci.h"
 #include "srsran/common/common_lte.h"
@@ -280,6 +281,54 @@ int test_min_mcs_tbs_specific()
   return SRSRAN_SUCCESS;
 }
 
+/// Verify that the MCS/TBS table of each cell gives the same result as the iterative search
+int test_mcs_tbs_table_consistency()
+{
+  sched_interface::sched_args_t sched_args = {};
+  std::array<uint32_t, 5>       req_bytes_list{1, 10, 109, 1000, 10000};
+
+  for (auto& nof_prb_cell : srsran::lte_cell_nof_prbs) {
+    sched_interface::cell_cfg_t cell_cfg    = generate_default_cell_cfg(nof_prb_cell);
+    sched_cell_params_t         cell_params = {};
+    TESTASSERT(cell_params.set_cfg(0, cell_cfg, sched_args));
+    const sched_mcs_tbs_table& table = cell_params.mcs_tbs_table;
+    TESTASSERT(not table.empty());
+
+    uint32_t nof_symb = 2 * (SRSRAN_CP_NSYMB(cell_cfg.cell.cp) - 1);
+    for (uint32_t nof_prb = 1; nof_prb <= nof_prb_cell; ++nof_prb) {
+      // DL lower bound of REs of a few subframes, UL REs, and a number of REs that was not precomputed
+      std::array<uint32_t, 4> nof_re_list{cell_params.get_dl_lb_nof_re(tti_point{0}, nof_prb),
+                                          cell_params.get_dl_lb_nof_re(tti_point{1}, nof_prb),
+                                          nof_symb * nof_prb * SRSRAN_NRE,
+                                          cell_params.get_dl_lb_nof_re(tti_point{1}, nof_prb) + 1};
+      for (uint32_t nof_re : nof_re_list) {
+        for (uint32_t cqi = 0; cqi <= 15; ++cqi) {
+          for (uint32_t max_mcs : {0U, 6U, 17U, 27U, 28U, 31U}) {
+            // {is_ul, ulqam64_enabled, use_tbs_index_alt}
+            for (auto flags : {std::make_tuple(false, false, false),
+                               std::make_tuple(false, false, true),
+                               std::make_tuple(true, false, false),
+                               std::make_tuple(true, true, false)}) {
+              bool     is_ul = std::get<0>(flags), ulqam64 = std::get<1>(flags), alt = std::get<2>(flags);
+              tbs_info tb1 = table.compute_mcs_and_tbs(nof_prb, nof_re, cqi, max_mcs, is_ul, ulqam64, alt);
+              tbs_info tb2 = compute_mcs_and_tbs(nof_prb, nof_re, cqi, max_mcs, is_ul, ulqam64, alt);
+              TESTASSERT(tb1 == tb2);
+              for (uint32_t req_bytes : req_bytes_list) {
+                tb1 = table.compute_min_mcs_and_tbs_from_required_bytes(
+                    nof_prb, nof_re, cqi, max_mcs, req_bytes, is_ul, ulqam64, alt);
+                tb2 = compute_min_mcs_and_tbs_from_required_bytes(
+                    nof_prb, nof_re, cqi, max_mcs, req_bytes, is_ul, ulqam64, alt);
+                TESTASSERT(tb1 == tb2);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 void test_ul_mcs_tbs_derivation()
 {
   uint32_t cqi     = 15;
@@ -317,6 +366,41 @@ void test_ul_mcs_tbs_derivation()
   TESTASSERT_EQ(23, compute_tbs_mcs(100, 100 - 5).mcs);
 }
 
+void test_mu_mimo_link_adaptation()
+{
+  // 2 ports: w0=[1,1], w1=[1,-1], w2=[1,j], w3=[1,-j]
+  TESTASSERT(std::abs(get_pmi_correlation(2, 0, 0) - 1) < 1e-6);
+  TESTASSERT(std::abs(get_pmi_correlation(2, 0, 1)) < 1e-6);
+  TESTASSERT(std::abs(get_pmi_correlation(2, 2, 3)) < 1e-6);
+  TESTASSERT(std::abs(get_pmi_correlation(2, 0, 2) - 0.5) < 1e-6);
+  TESTASSERT_EQ(1.0f, get_pmi_correlation(2, 0, 4));
+
+  // 4 ports: all the precoders have unit norm, and w0 and w2 are orthogonal
+  for (uint32_t pmi1 = 0; pmi1 < 16; ++pmi1) {
+    TESTASSERT(std::abs(get_pmi_correlation(4, pmi1, pmi1) - 1) < 1e-5);
+    for (uint32_t pmi2 = 0; pmi2 < 16; ++pmi2) {
+      float corr = get_pmi_correlation(4, pmi1, pmi2);
+      TESTASSERT(corr >= 0 and corr <= 1 + 1e-5);
+      TESTASSERT(std::abs(corr - get_pmi_correlation(4, pmi2, pmi1)) < 1e-5);
+    }
+  }
+  TESTASSERT(std::abs(get_pmi_correlation(4, 0, 2)) < 1e-6);
+  TESTASSERT_EQ(1.0f, get_pmi_correlation(1, 0, 1));
+
+  // The power split alone costs 3 dB. The CQI decreases with the precoder correlation
+  TESTASSERT_EQ(0, get_mu_mimo_cqi(0, 0));
+  TESTASSERT_EQ(13, get_mu_mimo_cqi(15, 0));
+  TESTASSERT_EQ(0, get_mu_mimo_cqi(15, 1));
+  for (uint32_t cqi = 1; cqi <= 15; ++cqi) {
+    uint32_t prev_cqi = cqi;
+    for (float corr = 0; corr <= 1; corr += 0.05) {
+      uint32_t mu_cqi = get_mu_mimo_cqi(cqi, corr);
+      TESTASSERT(mu_cqi <= prev_cqi);
+      prev_cqi = mu_cqi;
+    }
+  }
+}
+
 } // namespace srsenb
 
 int main()
@@ -332,7 +416,9 @@ int main()
   TESTASSERT(srsenb::test_mcs_lookup_specific() == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_mcs_tbs_consistency_all() == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_min_mcs_tbs_specific() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_mcs_tbs_table_consistency() == SRSRAN_SUCCESS);
   srsenb::test_ul_mcs_tbs_derivation();
+  srsenb::test_mu_mimo_link_adaptation();
 
   printf("Success\n");
   return 0;
@@ -0,0 +1,211 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_utils.h"
+#include "srsenb/hdr/stack/mac/sched_grid.h"
+#include "srsenb/hdr/stack/mac/schedulers/sched_freq_pf.h"
+#include "srsran/common/test_common.h"
+
+namespace srsenb {
+
+/// Number of pending DL bytes that no RBG allocation can serve in one TTI
+const uint32_t full_buffer = 1000000;
+
+/// Drives the frequency-selective PF policy for one carrier. Each UE reports one CQI per bandwidth part, and the RBG
+/// masks allocated to each UE in a single TTI are compared against the expected ones
+struct freq_pf_tester {
+  explicit freq_pf_tester(uint32_t nof_prb) : cell_params(1)
+  {
+    sched_args.sched_policy = "freq_pf";
+    TESTASSERT(cell_params[0].set_cfg(0, generate_default_cell_cfg(nof_prb), sched_args));
+    sched_ptr.reset(new sched_freq_pf{cell_params[0], sched_args});
+    tti_result.enb_cc_list.resize(1);
+    tti_sched.init(cell_params[0]);
+  }
+
+  /// Adds a UE with "pending_bytes" DL bytes in a DRB and the given CQI in each bandwidth part. An empty CQI list
+  /// leaves the UE without dedicated PHY configuration, so it is restricted to DCI format 1A
+  void add_user(uint16_t rnti, uint32_t pending_bytes, const std::vector<uint32_t>& bp_cqis)
+  {
+    sched_interface::ue_cfg_t ue_cfg = generate_default_ue_cfg();
+    if (not bp_cqis.empty()) {
+      ue_cfg.supported_cc_list[0].dl_cfg.cqi_report.periodic_configured    = true;
+      ue_cfg.supported_cc_list[0].dl_cfg.cqi_report.subband_wideband_ratio = 1;
+    }
+    std::unique_ptr<sched_ue> ue{new sched_ue{rnti, cell_params, ue_cfg}};
+    ue->set_dl_cqi(tti_rx, 0, 15);
+    if (not bp_cqis.empty()) {
+      ue->phy_config_enabled(tti_rx, true);
+      const sched_dl_cqi& dl_cqi = ue->find_ue_carrier(0)->dl_cqi();
+      for (uint32_t bp = 0; bp < bp_cqis.size(); ++bp) {
+        // The subband CQI applies to the whole bandwidth part
+        uint32_t sb_idx = (bp * dl_cqi.nof_subbands() + bp_cqis.size() - 1) / bp_cqis.size();
+        ue->set_dl_sb_cqi(tti_rx, 0, sb_idx, bp_cqis[bp]);
+      }
+    }
+    ue->dl_buffer_state(drb_to_lcid(lte_drb::drb1), pending_bytes, 0);
+    TESTASSERT(ue_db.insert(rnti, std::move(ue)));
+  }
+
+  /// Runs the DL scheduling of the next TTI
+  void run_tti()
+  {
+    tti_rx++;
+    tti_result.new_tti(tti_rx);
+    tti_sched.new_tti(tti_rx, &tti_result);
+    for (auto& u : ue_db) {
+      u.second->new_subframe(tti_rx, 0);
+    }
+    sched_ptr->sched_dl_users(ue_db, &tti_sched);
+  }
+
+  /// RBG mask allocated to a UE in the last TTI. It is empty if the UE was not allocated
+  rbgmask_t get_user_mask(uint16_t rnti) const
+  {
+    for (const sf_sched::dl_alloc_t& alloc : tti_sched.get_allocated_dl_users()) {
+      if (alloc.rnti == rnti) {
+        return alloc.user_mask;
+      }
+    }
+    return rbgmask_t(cell_params[0].nof_rbgs);
+  }
+
+  /// RBG mask with the RBGs in [start, stop)
+  rbgmask_t rbgs(uint32_t start, uint32_t stop) const
+  {
+    rbgmask_t mask(cell_params[0].nof_rbgs);
+    mask.fill(start, stop);
+    return mask;
+  }
+
+  sched_interface::sched_args_t    sched_args{};
+  std::vector<sched_cell_params_t> cell_params;
+  std::unique_ptr<sched_freq_pf>   sched_ptr;
+  sched_ue_list                    ue_db;
+  sf_sched_result                  tti_result;
+  sf_sched                         tti_sched;
+  tti_point                        tti_rx{0};
+};
+
+/// Each RBG goes to the UE with the best CQI in its subband
+int test_best_subband_rbg_choice()
+{
+  // 50 PRBs: 17 RBGs of 3 PRBs and J=3 bandwidth parts, with RBGs {0-5}, {6-11} and {12-16}
+  freq_pf_tester tester(50);
+  TESTASSERT(tester.cell_params[0].nof_rbgs == 17);
+
+  tester.add_user(0x46, full_buffer, {15, 7, 4});
+  tester.add_user(0x47, full_buffer, {7, 15, 10});
+  tester.add_user(0x48, full_buffer, {4, 9, 15});
+  tester.run_tti();
+
+  TESTASSERT(tester.tti_sched.get_allocated_dl_users().size() == 3);
+  TESTASSERT(tester.get_user_mask(0x46) == tester.rbgs(0, 6));
+  TESTASSERT(tester.get_user_mask(0x47) == tester.rbgs(6, 12));
+  TESTASSERT(tester.get_user_mask(0x48) == tester.rbgs(12, 17));
+
+  // A UE that is best nowhere gets no RBGs, even if it has a good CQI everywhere
+  freq_pf_tester tester2(50);
+  tester2.add_user(0x46, full_buffer, {15, 15, 15});
+  tester2.add_user(0x47, full_buffer, {14, 14, 14});
+  tester2.run_tti();
+
+  TESTASSERT(tester2.get_user_mask(0x46) == tester2.rbgs(0, 17));
+  TESTASSERT(tester2.get_user_mask(0x47).none());
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Once a UE has enough RBGs for its pending data, the remaining RBGs are assigned as if it was not there
+int test_best_metric_recomputed_when_ue_is_satisfied()
+{
+  freq_pf_tester tester(50);
+
+  // 0x46 has the best CQI in every RBG, but its data fits in a single RBG of its best bandwidth part, i.e. RBG 6
+  tester.add_user(0x46, 50, {10, 15, 10});
+  tester.add_user(0x47, full_buffer, {7, 7, 7});
+  tester.run_tti();
+
+  rbgmask_t expected_mask = tester.rbgs(0, 17);
+  expected_mask.reset(6);
+  TESTASSERT(tester.get_user_mask(0x46) == tester.rbgs(6, 7));
+  TESTASSERT(tester.get_user_mask(0x47) == expected_mask);
+
+  // With two RBGs worth of data, 0x46 takes the two lowest RBGs of its best bandwidth part
+  freq_pf_tester tester2(50);
+  tester2.add_user(0x46, 400, {10, 15, 10});
+  tester2.add_user(0x47, full_buffer, {7, 7, 7});
+  tester2.run_tti();
+
+  expected_mask = tester2.rbgs(0, 17);
+  expected_mask.reset(6);
+  expected_mask.reset(7);
+  TESTASSERT(tester2.get_user_mask(0x46) == tester2.rbgs(6, 8));
+  TESTASSERT(tester2.get_user_mask(0x47) == expected_mask);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// The best UE changes within each block of RBGs compared with SIMD, and in the scalar tail. Some RBGs are taken
+/// beforehand by a UE restricted to DCI format 1A, so the free RBGs do not start at RBG 0
+int test_best_metric_across_simd_blocks()
+{
+  // 100 PRBs: 25 RBGs of 4 PRBs and J=4 bandwidth parts, with RBGs {0-5}, {6-11}, {12-17} and {18-24}
+  freq_pf_tester tester(100);
+  TESTASSERT(tester.cell_params[0].nof_rbgs == 25);
+
+  // The DCI format 1A UE gets the lowest RBG, which fits its data
+  tester.add_user(0x46, 50, {});
+  tester.add_user(0x47, full_buffer, {15, 4, 4, 9});
+  tester.add_user(0x48, full_buffer, {4, 15, 4, 10});
+  tester.add_user(0x49, full_buffer, {4, 4, 15, 11});
+  tester.add_user(0x4a, full_buffer, {9, 9, 9, 15});
+  tester.run_tti();
+
+  TESTASSERT(tester.tti_sched.get_allocated_dl_users().size() == 5);
+  TESTASSERT(tester.get_user_mask(0x46) == tester.rbgs(0, 1));
+  TESTASSERT(tester.get_user_mask(0x47) == tester.rbgs(1, 6));
+  TESTASSERT(tester.get_user_mask(0x48) == tester.rbgs(6, 12));
+  TESTASSERT(tester.get_user_mask(0x49) == tester.rbgs(12, 18));
+  TESTASSERT(tester.get_user_mask(0x4a) == tester.rbgs(18, 25));
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main()
+{
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::info);
+
+  // Start the log backend.
+  srslog::init();
+
+  TESTASSERT(srsenb::test_best_subband_rbg_choice() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_best_metric_recomputed_when_ue_is_satisfied() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_best_metric_across_simd_blocks() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -223,6 +223,7 @@ int test_6prbs()
   TESTASSERT(pdcch.alloc_dci(alloc_type_t::DL_DATA, ue_aggr_idx, &sched_ue, false));
   TESTASSERT(not pdcch.alloc_dci(alloc_type_t::DL_DATA, ue_aggr_idx, &sched_ue2, false));
   TESTASSERT(pdcch.nof_allocs() == 2);
+  TESTASSERT(pdcch.get_metrics().nof_dci_allocs == 3 and pdcch.get_metrics().nof_dci_blocked == 1);
 
   pdcch.get_allocs(&dci_result, &result_pdcch_mask);
   TESTASSERT(dci_result.size() == 2);
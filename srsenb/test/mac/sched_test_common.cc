@@ -264,6 +264,11 @@ int common_sched_tester::run_tti(const tti_ev& tti_events)
 
   sched_sim->new_tti(tti_rx);
   process_tti_events(tti_events);
+  {
+    // The scheduler applies the UE feedback at the start of the TTI. Apply it before the UE state is sampled
+    std::lock_guard<std::mutex> lock(sched_mutex);
+    apply_pending_events();
+  }
   before_sched();
 
   // Call scheduler for all carriers
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/phy/lte/ue_metrics_sums.h"
+#include "srsran/common/test_common.h"
+
+namespace srsenb {
+namespace lte {
+
+static ue_metrics_sums_t make_sums(uint16_t rnti, uint32_t ue_id, uint64_t n_dl, double dl_mcs_sum)
+{
+  ue_metrics_sums_t sums  = {};
+  sums.rnti               = rnti;
+  sums.ue_id              = ue_id;
+  sums.dl_n_samples       = n_dl;
+  sums.dl_mcs             = dl_mcs_sum;
+  sums.ul_n_samples       = 2 * n_dl;
+  sums.ul_mcs             = 2 * dl_mcs_sum;
+  sums.ul_pusch_sinr      = 20 * n_dl;
+  sums.ul_n_samples_pucch = n_dl;
+  sums.ul_pucch_sinr      = 5 * n_dl;
+  return sums;
+}
+
+void test_ue_metrics_period()
+{
+  ue_metrics_reader          reader;
+  std::vector<phy_metrics_t> metrics;
+
+  // The first read reports the sums since the UEs were added
+  std::vector<ue_metrics_sums_t> snapshot = {make_sums(0x46, 0, 10, 100), make_sums(0x47, 1, 4, 8)};
+  TESTASSERT_EQ(2, reader.read(snapshot, metrics));
+  TESTASSERT_EQ(0x46, metrics[0].rnti);
+  TESTASSERT_EQ(10, metrics[0].dl.n_samples);
+  TESTASSERT(metrics[0].dl.mcs == 10);
+  TESTASSERT_EQ(20, metrics[0].ul.n_samples);
+  TESTASSERT(metrics[0].ul.mcs == 10);
+  TESTASSERT(metrics[0].ul.pusch_sinr == 10);
+  TESTASSERT_EQ(10, metrics[0].ul.n_samples_pucch);
+  TESTASSERT(metrics[0].ul.pucch_sinr == 5);
+  TESTASSERT_EQ(0x47, metrics[1].rnti);
+  TESTASSERT(metrics[1].dl.mcs == 2);
+
+  // No TTI between two reads: same snapshot, empty period without NaNs
+  TESTASSERT_EQ(2, reader.read(snapshot, metrics));
+  for (const phy_metrics_t& m : metrics) {
+    TESTASSERT_EQ(0, m.dl.n_samples);
+    TESTASSERT_EQ(0, m.ul.n_samples);
+    TESTASSERT_EQ(0, m.ul.n_samples_pucch);
+    TESTASSERT(m.dl.mcs == 0 and m.ul.mcs == 0 and m.ul.pusch_sinr == 0 and m.ul.pucch_sinr == 0);
+  }
+
+  // Only the samples of the period are averaged
+  snapshot = {make_sums(0x46, 0, 15, 100 + 5 * 20), make_sums(0x47, 1, 4, 8)};
+  TESTASSERT_EQ(2, reader.read(snapshot, metrics));
+  TESTASSERT_EQ(5, metrics[0].dl.n_samples);
+  TESTASSERT(metrics[0].dl.mcs == 20);
+  TESTASSERT_EQ(0, metrics[1].dl.n_samples);
+
+  // 0x46 removed and added again with more samples than before, and 0x47 removed
+  snapshot = {make_sums(0x46, 2, 30, 30 * 3)};
+  TESTASSERT_EQ(1, reader.read(snapshot, metrics));
+  TESTASSERT_EQ(0x46, metrics[0].rnti);
+  TESTASSERT_EQ(30, metrics[0].dl.n_samples);
+  TESTASSERT(metrics[0].dl.mcs == 3);
+
+  // 0x47 added again with fewer samples than before
+  snapshot = {make_sums(0x46, 2, 30, 30 * 3), make_sums(0x47, 3, 1, 7)};
+  TESTASSERT_EQ(2, reader.read(snapshot, metrics));
+  TESTASSERT_EQ(0, metrics[0].dl.n_samples);
+  TESTASSERT_EQ(0x47, metrics[1].rnti);
+  TESTASSERT_EQ(1, metrics[1].dl.n_samples);
+  TESTASSERT(metrics[1].dl.mcs == 7);
+
+  // 0x46 removed and added again between two reads, without any TTI since then
+  snapshot = {make_sums(0x46, 4, 0, 0), make_sums(0x47, 3, 1, 7)};
+  TESTASSERT_EQ(2, reader.read(snapshot, metrics));
+  TESTASSERT_EQ(0, metrics[0].dl.n_samples);
+  TESTASSERT(metrics[0].dl.mcs == 0);
+  snapshot = {make_sums(0x46, 4, 2, 2 * 9), make_sums(0x47, 3, 1, 7)};
+  TESTASSERT_EQ(2, reader.read(snapshot, metrics));
+  TESTASSERT_EQ(2, metrics[0].dl.n_samples);
+  TESTASSERT(metrics[0].dl.mcs == 9);
+}
+
+} // namespace lte
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  srsenb::lte::test_ue_metrics_period();
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -213,6 +213,25 @@ void test_gtpu_tunnel_manager()
   tunnels.remove_tunnel(before_tun->teid_in);
   TESTASSERT(tunnels.find_rnti_bearer_tunnels(0x46, drb1_eps_bearer_id).size() == 1);
   TESTASSERT(after_tun->state == gtpu_tunnel_manager::tunnel_state::pdcp_active);
+
+  // TEST: EN-DC moves the tunnels of a LTE rnti to a NR rnti and back. NR rntis (from 0x4601) share the low bits of
+  //       the LTE ones, and both must coexist with other users
+  const uint16_t lte_rnti = 0x46, nr_rnti = 0x4606, other_rnti = 0x4646;
+  TESTASSERT(tunnels.add_tunnel(other_rnti, drb1_eps_bearer_id, 9, sgw_addr) != nullptr);
+  TESTASSERT(tunnels.update_rnti(lte_rnti, nr_rnti));
+  TESTASSERT(tunnels.find_rnti_tunnels(lte_rnti) == nullptr);
+  TESTASSERT(tunnels.find_rnti_bearer_tunnels(nr_rnti, drb1_eps_bearer_id).size() == 1);
+  TESTASSERT(tunnels.find_tunnel(after_tun->teid_in)->rnti == nr_rnti);
+  // The LTE rnti can be given new tunnels while the NR one holds the bearer
+  const gtpu_tunnel* lte_tun = tunnels.add_tunnel(lte_rnti, drb1_eps_bearer_id + 1, 10, sgw_addr);
+  TESTASSERT(lte_tun != nullptr);
+  TESTASSERT(tunnels.remove_tunnel(lte_tun->teid_in));
+  TESTASSERT(tunnels.update_rnti(nr_rnti, lte_rnti));
+  TESTASSERT(tunnels.find_rnti_tunnels(nr_rnti) == nullptr);
+  TESTASSERT(tunnels.find_rnti_bearer_tunnels(lte_rnti, drb1_eps_bearer_id).size() == 1);
+  TESTASSERT(tunnels.find_rnti_bearer_tunnels(other_rnti, drb1_eps_bearer_id).size() == 1);
+  TESTASSERT(tunnels.remove_rnti(lte_rnti));
+  TESTASSERT(tunnels.remove_rnti(other_rnti));
 }
 
 enum class tunnel_test_event { success, wait_end_marker_timeout, ue_removal_no_marker, reest_senb };
@@ -0,0 +1,135 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/common/common_enb.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <map>
+#include <random>
+#include <unordered_map>
+
+/*
+ * Micro-benchmark of the cost of the RNTI -> user lookup done by the eNB upper layers for every SDU/PDU.
+ * The std::map and std::unordered_map containers previously used by PDCP/RLC/RRC/GTPU are compared with the
+ * RNTI-indexed rnti_map_t that replaced them.
+ */
+
+namespace srsenb {
+
+/// Emulates the per-user state the upper layers reach through the lookup (entity pointer + interface adapters)
+struct dummy_user {
+  uint16_t rnti;
+  uint64_t nof_sdus;
+  void*    itfs[4];
+};
+
+struct bench_params {
+  uint32_t nof_ues;
+  uint32_t nof_lookups;
+};
+
+template <typename Container>
+uint64_t lookup_all(Container& users, const std::vector<uint16_t>& rntis)
+{
+  uint64_t sum = 0;
+  for (uint16_t rnti : rntis) {
+    auto it = users.find(rnti);
+    if (it != users.end()) {
+      it->second.nof_sdus++;
+      sum += it->second.rnti;
+    }
+  }
+  return sum;
+}
+
+template <typename Container>
+double run_lookups(const char* name, Container& users, const std::vector<uint16_t>& rntis, uint64_t expected_sum)
+{
+  // Warm-up pass, so that all containers are measured with hot caches
+  lookup_all(users, rntis);
+
+  auto     tp_start = std::chrono::steady_clock::now();
+  uint64_t sum      = lookup_all(users, rntis);
+  auto     tp_end   = std::chrono::steady_clock::now();
+  TESTASSERT(sum == expected_sum);
+
+  double ns_per_lookup =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(tp_end - tp_start).count() / (double)rntis.size();
+  fmt::print("  {:<20} {:>6.2f} ns/lookup\n", name, ns_per_lookup);
+  return ns_per_lookup;
+}
+
+int run_benchmark(const bench_params& params, std::mt19937& rgen)
+{
+  TESTASSERT(params.nof_ues <= SRSENB_MAX_UES);
+
+  // RNTIs are allocated by the MAC in increasing order, starting from the first C-RNTI
+  std::vector<uint16_t> ue_rntis(params.nof_ues);
+  for (uint32_t i = 0; i < params.nof_ues; ++i) {
+    ue_rntis[i] = 0x46 + i;
+  }
+
+  std::map<uint16_t, dummy_user>           tree_users;
+  std::unordered_map<uint16_t, dummy_user> hash_users;
+  rnti_map_t<dummy_user>                   slot_users;
+  for (uint16_t rnti : ue_rntis) {
+    dummy_user u{rnti, 0, {}};
+    tree_users.insert(std::make_pair(rnti, u));
+    hash_users.insert(std::make_pair(rnti, u));
+    TESTASSERT(slot_users.insert(rnti, u));
+  }
+
+  // Sequence of SDUs from random users, including a few from users that were already removed
+  std::vector<uint16_t>                   rntis(params.nof_lookups);
+  std::uniform_int_distribution<uint32_t> ue_dist(0, params.nof_ues);
+  uint64_t                                expected_sum = 0;
+  for (uint16_t& rnti : rntis) {
+    uint32_t idx = ue_dist(rgen);
+    rnti         = idx < params.nof_ues ? ue_rntis[idx] : 0x46 + SRSENB_MAX_UES + idx;
+    expected_sum += idx < params.nof_ues ? rnti : 0;
+  }
+
+  fmt::print("Nof UEs={}, Nof lookups={}:\n", params.nof_ues, params.nof_lookups);
+  run_lookups("std::map", tree_users, rntis, expected_sum);
+  run_lookups("std::unordered_map", hash_users, rntis, expected_sum);
+  run_lookups("rnti_map_t", slot_users, rntis, expected_sum);
+
+  // All containers must have seen the same SDUs
+  for (uint16_t rnti : ue_rntis) {
+    TESTASSERT(tree_users[rnti].nof_sdus == slot_users[rnti].nof_sdus);
+    TESTASSERT(hash_users[rnti].nof_sdus == slot_users[rnti].nof_sdus);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  uint32_t     nof_lookups = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  std::mt19937 rgen(0);
+
+  std::vector<srsenb::bench_params> runs = {{1, nof_lookups}, {8, nof_lookups}, {32, nof_lookups}, {64, nof_lookups}};
+  for (const srsenb::bench_params& p : runs) {
+    TESTASSERT(srsenb::run_benchmark(p, rgen) == SRSRAN_SUCCESS);
+  }
+  return SRSRAN_SUCCESS;
+}
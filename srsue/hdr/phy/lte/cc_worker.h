@@ -32,9 +32,16 @@ namespace lte {
 class cc_worker
 {
 public:
-  cc_worker(uint32_t cc_idx, uint32_t max_prb, phy_common* phy, srslog::basic_logger& logger);
+  cc_worker(uint32_t              cc_idx,
+            uint32_t              max_prb,
+            phy_common*           phy,
+            srslog::basic_logger& logger,
+            srsran_vec_arena_t*   arena = nullptr);
   ~cc_worker();
 
+  /// Arena bytes needed by the sample buffers of a carrier
+  static size_t get_arena_size(uint32_t max_prb, phy_common* phy);
+
   /* Functions used by main PHY thread */
   cf_t*    get_rx_buffer(uint32_t antenna_idx);
   cf_t*    get_tx_buffer(uint32_t antenna_idx);
@@ -105,6 +112,7 @@ private:
   cf_t*    signal_buffer_rx[SRSRAN_MAX_PORTS] = {};
   cf_t*    signal_buffer_tx[SRSRAN_MAX_PORTS] = {};
   uint32_t signal_buffer_max_samples          = 0;
+  bool     signal_buffers_in_arena            = false; // Buffers belong to the sf_worker arena, they are not freed
 
   /* Objects for DL */
   srsran_ue_dl_t     ue_dl     = {};
@@ -83,6 +83,9 @@ private:
 
   std::vector<cc_worker*> cc_workers;
 
+  // Memory arena the sample buffers of all carriers are allocated from, if enabled
+  srsran_vec_arena_t arena = {};
+
   phy_common* phy = nullptr;
 
   srslog::basic_logger& logger;
@@ -251,6 +251,14 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<int>(&args->phy.sync_cpu_affinity)->default_value(-1),
      "index of the core used by the sync thread")
 
+    ("phy.arena",
+     bpo::value<string>(&args->phy.arena_mode)->default_value("none"),
+     "Memory arena for the PHY worker sample buffers: none, thp, 2M or 1G (hugepages)")
+
+    ("phy.arena_numa_node",
+     bpo::value<int>(&args->phy.arena_numa_node)->default_value(-1),
+     "NUMA node the PHY worker arenas are bound to (-1 for the node of the first CPU in worker_cpu_mask)")
+
     ("phy.rx_gain_offset",
      bpo::value<float>(&args->phy.rx_gain_offset)->default_value(62),
      "RX Gain offset to add to rx_gain to correct RSRP value")
@@ -394,6 +402,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
       bpo::value<bool>(&args->phy.detect_cp)->default_value(false),
       "enable CP length detection")
 
+    ("phy.cell_search_joint",
+      bpo::value<bool>(&args->phy.cell_search_joint)->default_value(false),
+      "Search the three PSS in the same frames during cell search, instead of one after the other")
+
     ("phy.in_sync_rsrp_dbm_th",
      bpo::value<float>(&args->phy.in_sync_rsrp_dbm_th)->default_value(-130.0f),
      "RSRP threshold (in dBm) above which the UE considers to be in-sync")
@@ -551,6 +563,12 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     args->stack.usim.using_op = vm.count("usim.op");
   }
 
+  srsran_vec_arena_mode_t arena_mode;
+  if (srsran_vec_arena_mode_parse(args->phy.arena_mode.c_str(), &arena_mode) != SRSRAN_SUCCESS) {
+    cout << "Error parsing phy.arena: " << args->phy.arena_mode << " - must be none, thp, 2M or 1G." << endl;
+    return SRSRAN_ERROR;
+  }
+
   // Apply all_level to any unset layers
   if (vm.count("log.all_level")) {
     if (!vm.count("log.rf_level")) {
@@ -50,21 +50,33 @@ namespace lte {
  *
  */
 
-cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_, srslog::basic_logger& logger) :
+size_t cc_worker::get_arena_size(uint32_t max_prb, srsue::phy_common* phy)
+{
+  return 2 * phy->args->nof_rx_ant * srsran_vec_arena_alloc_size(3 * SRSRAN_SF_LEN_PRB(max_prb) * sizeof(cf_t));
+}
+
+cc_worker::cc_worker(uint32_t              cc_idx_,
+                     uint32_t              max_prb,
+                     srsue::phy_common*    phy_,
+                     srslog::basic_logger& logger,
+                     srsran_vec_arena_t*   arena) :
   logger(logger)
 {
   cc_idx = cc_idx_;
   phy    = phy_;
 
   signal_buffer_max_samples = 3 * SRSRAN_SF_LEN_PRB(max_prb);
+  signal_buffers_in_arena   = srsran_vec_arena_is_active(arena);
 
   for (uint32_t i = 0; i < phy->args->nof_rx_ant; i++) {
-    signal_buffer_rx[i] = srsran_vec_cf_malloc(signal_buffer_max_samples);
+    signal_buffer_rx[i] = signal_buffers_in_arena ? srsran_vec_arena_cf_alloc(arena, signal_buffer_max_samples)
+                                                  : srsran_vec_cf_malloc(signal_buffer_max_samples);
     if (!signal_buffer_rx[i]) {
       Error("Allocating memory");
       return;
     }
-    signal_buffer_tx[i] = srsran_vec_cf_malloc(signal_buffer_max_samples);
+    signal_buffer_tx[i] = signal_buffers_in_arena ? srsran_vec_arena_cf_alloc(arena, signal_buffer_max_samples)
+                                                  : srsran_vec_cf_malloc(signal_buffer_max_samples);
     if (!signal_buffer_tx[i]) {
       Error("Allocating memory");
       return;
@@ -105,7 +117,7 @@ cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_
 
 cc_worker::~cc_worker()
 {
-  for (uint32_t i = 0; i < phy->args->nof_rx_ant; i++) {
+  for (uint32_t i = 0; i < phy->args->nof_rx_ant && not signal_buffers_in_arena; i++) {
     if (signal_buffer_tx[i]) {
       free(signal_buffer_tx[i]);
     }
@@ -60,9 +60,29 @@ sf_worker::sf_worker(uint32_t max_prb, phy_common* phy_, srslog::basic_logger& l
 {
   phy = phy_;
 
+  // Reserve a single arena for the sample buffers of all the carriers, if enabled
+  srsran_vec_arena_mode_t arena_mode = SRSRAN_VEC_ARENA_DISABLED;
+  srsran_vec_arena_mode_parse(phy->args->arena_mode.c_str(), &arena_mode);
+  if (arena_mode != SRSRAN_VEC_ARENA_DISABLED) {
+    // Workers are pinned to the CPUs of worker_cpu_mask, so their memory follows the node of the first one
+    int numa_node = phy->args->arena_numa_node;
+    if (numa_node < 0 && phy->args->worker_cpu_mask > 0) {
+      numa_node = srsran_vec_arena_cpu_node(__builtin_ctz(phy->args->worker_cpu_mask));
+    }
+    size_t arena_size = phy->args->nof_lte_carriers * cc_worker::get_arena_size(max_prb, phy);
+    if (srsran_vec_arena_init(&arena, arena_size, arena_mode, numa_node) == SRSRAN_SUCCESS) {
+      logger.info("Worker buffers allocated in %zd bytes arena of %s pages (NUMA node %d)",
+                  arena.size,
+                  srsran_vec_arena_mode_string(arena.mode),
+                  arena.numa_node);
+    } else {
+      logger.warning("Could not reserve worker buffer arena, using regular allocations");
+    }
+  }
+
   // ue_sync in phy.cc requires a buffer for 3 subframes
   for (uint32_t r = 0; r < phy->args->nof_lte_carriers; r++) {
-    cc_workers.push_back(new cc_worker(r, max_prb, phy, logger));
+    cc_workers.push_back(new cc_worker(r, max_prb, phy, logger, &arena));
   }
 }
 
@@ -71,6 +91,7 @@ sf_worker::~sf_worker()
   for (uint32_t r = 0; r < phy->args->nof_lte_carriers; r++) {
     delete cc_workers[r];
   }
+  srsran_vec_arena_free(&arena);
 }
 
 void sf_worker::reset_cell_nolock(uint32_t cc_idx)
@@ -81,6 +81,11 @@ void search::set_cp_en(bool enable)
   srsran_set_detect_cp(&cs, enable);
 }
 
+void search::set_joint_search(bool enable)
+{
+  srsran_ue_cellsearch_set_joint_search(&cs, enable);
+}
+
 void search::reset()
 {
   srsran_ue_sync_reset(&ue_mib_sync.ue_sync);